@@ -91,7 +91,8 @@ def create_shell_commands_for_local_execution(arguments,
        arguments.render_neuron_morphology_progressive or    \
        arguments.export_morphology_swc or                   \
        arguments.export_morphology_segments or              \
-       arguments.export_morphology_blend:
+       arguments.export_morphology_blend or                 \
+       arguments.qa_render:
 
         # Add this command to the list
         shell_commands.append('%s -b --verbose 0 --python %s -- %s' %
@@ -126,6 +127,30 @@ def create_shell_commands_for_local_execution(arguments,
     return shell_commands
 
 
+####################################################################################################
+# @create_qa_contact_sheets_command
+####################################################################################################
+def create_qa_contact_sheets_command(arguments):
+    """Creates the shell command that assembles the quality assurance images of a batch into
+    contact sheets. It must be executed after all the neurons of the batch are rendered.
+
+    :param arguments:
+        Input arguments.
+    :return:
+        The shell command.
+    """
+
+    # Retrieve the path to the CLI
+    cli_interface_path = os.path.dirname(os.path.realpath(__file__)) + '/nmv/interface/cli'
+    cli_qa_contact_sheet = '%s/qa_contact_sheet.py' % cli_interface_path
+
+    # The quality assurance directory
+    qa_directory = '%s/%s' % (arguments.output_directory, file_ops.Paths.QA_FOLDER)
+
+    return '%s -b --verbose 0 --python %s -- --qa-directory=%s --qa-resolution=%d' % \
+           (arguments.blender, cli_qa_contact_sheet, qa_directory, arguments.qa_resolution)
+
+
 ####################################################################################################
 # @run_local_neuromorphovis
 ####################################################################################################
@@ -177,6 +202,10 @@ def run_local_neuromorphovis(arguments):
         for shell_command in shell_commands:
             subprocess.call(shell_command, shell=True)
 
+        # Assemble the quality assurance images of the target
+        if arguments.qa_render:
+            subprocess.call(create_qa_contact_sheets_command(arguments), shell=True)
+
 
     # Use a single GID
     elif arguments.input == 'gid':
@@ -235,6 +264,16 @@ def run_local_neuromorphovis(arguments):
         # A list of all the commands to be executed
         shell_commands = list()
 
+        # With prefetching, the morphology and the mesh reconstruction tasks process the whole
+        # directory in a single job each, while the next morphologies are read ahead
+        batch_interfaces = ['neuron_morphology_reconstruction.py', 'neuron_mesh_reconstruction.py']
+        if arguments.prefetch_morphologies > 0:
+            arguments_string = arguments_parser.get_arguments_string(arguments=arguments)
+            shell_commands.extend(
+                [shell_command for shell_command in
+                 create_shell_commands_for_local_execution(arguments, arguments_string)
+                 if any(interface in shell_command for interface in batch_interfaces)])
+
         # Construct the commands for every individual morphology file
         for morphology_file in morphology_files:
 
@@ -242,9 +281,13 @@ def run_local_neuromorphovis(arguments):
             arguments_string = arguments_parser.get_arguments_string_for_individual_file(
                 arguments=arguments, morphology_file=morphology_file)
 
-            # Construct the shell command to run the workflow
-            shell_commands.extend(
-                create_shell_commands_for_local_execution(arguments, arguments_string))
+            # Construct the shell command to run the workflow, except the batch tasks
+            for shell_command in create_shell_commands_for_local_execution(
+                    arguments, arguments_string):
+                if arguments.prefetch_morphologies > 0 and \
+                        any(interface in shell_command for interface in batch_interfaces):
+                    continue
+                shell_commands.append(shell_command)
 
         # Run NeuroMorphoVis from Blender in the background mode
         for shell_command in shell_commands:
@@ -254,6 +297,10 @@ def run_local_neuromorphovis(arguments):
             print('*******************************************************************************')
             subprocess.call(shell_command, shell=True)
 
+        # Assemble the quality assurance images of the batch
+        if arguments.qa_render:
+            subprocess.call(create_qa_contact_sheets_command(arguments), shell=True)
+
     else:
         print('ERROR: Input data source, use \'file, gid, target or directory\'')
         exit(0)
@@ -335,6 +382,11 @@ def run_cluster_neuromorphovis(arguments):
         print('ERROR: Input data source, use [file, gid, target or directory]')
         exit(0)
 
+    # The jobs run asynchronously, the contact sheets are assembled once they are all done
+    if arguments.qa_render:
+        print('Assemble the QA contact sheets once all the jobs are done with:')
+        print(create_qa_contact_sheets_command(arguments))
+
 
 ####################################################################################################
 # @ Run the main function if invoked from the command line.
@@ -17,6 +17,7 @@
 
 # System imports
 import math
+import numpy
 
 # Blender imports
 import bmesh
@@ -854,6 +855,67 @@ def get_indices_of_faces_intersecting_sphere(bmesh_object,
     return faces_indices
 
 
+####################################################################################################
+# @get_indices_of_faces_intersecting_spheres
+####################################################################################################
+def get_indices_of_faces_intersecting_spheres(bmesh_object,
+                                              spheres_centers,
+                                              spheres_radii):
+    """Returns a list of all the faces of a bmesh object that intersect any of the given spheres.
+    A face intersects a sphere if any of its edges passes through the sphere, which also covers
+    the case where a vertex of the face is located inside the sphere.
+
+    All the spheres are tested against all the edges at once, instead of walking the faces of the
+    bmesh once per sphere.
+
+    :param bmesh_object:
+        An input bmesh object.
+    :param spheres_centers:
+        A list of the centers of the spheres.
+    :param spheres_radii:
+        A list of the radii of the spheres.
+    :return:
+        A list of indices of the faces that intersect any of the given spheres.
+    """
+
+    # Nothing to test
+    if len(spheres_radii) == 0:
+        return list()
+
+    # The end points of all the edges
+    bmesh_object.edges.index_update()
+    edges_points = numpy.array(
+        [[edge.verts[0].co[:], edge.verts[1].co[:]] for edge in bmesh_object.edges])
+    starts = edges_points[:, 0, :]
+    segments = edges_points[:, 1, :] - starts
+    lengths = numpy.maximum(numpy.einsum('ij,ij->i', segments, segments), 1e-12)
+
+    # The spheres
+    centers = numpy.array([center[:] for center in spheres_centers])
+    radii = numpy.array(spheres_radii, dtype=numpy.float64)
+
+    # The distance between every sphere center and every edge segment, (spheres, edges)
+    t = numpy.einsum('sej,ej->se', centers[:, None, :] - starts[None, :, :], segments) / lengths
+    t = numpy.clip(t, 0.0, 1.0)
+    closest = starts[None, :, :] + t[:, :, None] * segments[None, :, :]
+    distances = numpy.linalg.norm(closest - centers[:, None, :], axis=2)
+
+    # The edges that intersect any of the spheres
+    intersecting_edges = numpy.any(distances < radii[:, None], axis=0)
+
+    # The faces that have at least one of these edges
+    faces_indices = list()
+    bmesh_object.faces.index_update()
+    for face in bmesh_object.faces:
+        for edge in face.edges:
+            if intersecting_edges[edge.index]:
+                faces_indices.append(face.index)
+                break
+
+    # Return the list
+    return faces_indices
+
+
 ####################################################################################################
 # @get_indices_of_faces_intersecting_sphere
 ####################################################################################################
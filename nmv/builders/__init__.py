@@ -20,3 +20,5 @@ from .nucleus import *
 from .morphology import *
 from .mesh import *
 from .spine import *
+from .astrocyte import *
+from .templates import *
@@ -30,14 +30,15 @@ import nmv.shading
 import nmv.skeleton
 import nmv.utilities
 import nmv.scene
+import nmv.geometry
 import nmv.physics
 import nmv.options
 
 
 ####################################################################################################
-# @AstroMetaBuilder
+# @AstrocyteMetaBuilder
 ####################################################################################################
-class AstroMetaBuilder:
+class AstrocyteMetaBuilder:
     """Mesh builder that creates high quality meshes with nice bifurcations based on meta objects
        for the astrocytes"""
 
@@ -48,8 +49,9 @@ class AstroMetaBuilder:
                  morphology,
                  soma_radius,
                  soma_style,
-                 end_feet_proxy_meshes=None,
-                 end_feet_thicknesses=None):
+                 endfeet_areas=None,
+                 endfeet_origin=None,
+                 options=None):
         """Constructor
 
         :param morphology:
@@ -58,10 +60,13 @@ class AstroMetaBuilder:
             The style of the astrocyte soma, either MetaBall or SoftBody.
         :param soma_radius:
             The radius of the astrocyte soma.
-        :param end_feet_proxy_meshes:
-            A list of the end-feet proxy meshes that will be used to create the actual end-feet.
-        :param end_feet_thicknesses:
-            A list of the end-feet thicknesses that will be used to create the actual end-feet.
+        :param endfeet_areas:
+            A list of EndfootArea objects that will be used to create the actual end-feet.
+        :param endfeet_origin:
+            An optional origin that is subtracted from the end-feet, i.e. the soma centroid of the
+            astrocyte in the circuit if the morphology is centered at the origin.
+        :param options:
+            The NeuroMorphoVis options of the reconstruction, the default options if not given.
         """
 
         # Morphology
@@ -73,11 +78,14 @@ class AstroMetaBuilder:
         # Soma radius
         self.soma_radius = soma_radius
 
-        # End feet proxy meshes
-        self.end_feet_proxy_meshes = end_feet_proxy_meshes
+        # End feet areas
+        self.endfeet_areas = endfeet_areas if endfeet_areas is not None else list()
 
-        # End feet thicknesses
-        self.end_feet_thicknesses = end_feet_thicknesses
+        # End feet origin
+        self.endfeet_origin = endfeet_origin
+
+        # Options
+        self.options = options if options is not None else nmv.options.NeuroMorphoVisOptions()
 
         # Meta object skeleton, used to build the skeleton of the morphology
         self.meta_skeleton = None
@@ -286,27 +294,28 @@ class AstroMetaBuilder:
     # @build_endfeet
     ################################################################################################
     def build_endfeet(self):
+        """Builds the end-feet of the astrocyte by sampling the triangulations of the end-feet areas
+        as arrays and adding all the meta elements at once.
+        """
 
-        for i, mesh in enumerate(self.end_feet_proxy_meshes):
-
-            vertex_list = list()
-            for v in mesh.data.vertices:
-                vertex_list.append(v.co)
-
-            # Vertex list
-            for v in vertex_list:
+        # Header
+        nmv.logger.header('Building End-feet')
 
-                # Add the meta element
-                meta_element = self.meta_skeleton.elements.new()
+        # Sample all the areas
+        locations, radii = nmv.builders.get_endfeet_meta_elements(
+            endfeet_areas=self.endfeet_areas, origin=self.endfeet_origin)
 
-                # Set its radius
-                meta_element.radius = self.end_feet_thicknesses[i]
+        # No end-feet
+        if len(radii) == 0:
+            return
+        nmv.logger.info('End-feet [%d], Meta Elements [%d]' % (len(self.endfeet_areas), len(radii)))
 
-                if self.end_feet_thicknesses[i] < self.smallest_radius:
-                    self.smallest_radius = self.end_feet_thicknesses[i]
+        # Update the smallest radius, used for the resolution of the meta object
+        self.smallest_radius = min(self.smallest_radius, float(radii.min()))
 
-                    # Update its coordinates
-                meta_element.co = v
+        # Add the meta elements in bulk
+        nmv.geometry.add_meta_elements_in_bulk(
+            meta_skeleton=self.meta_skeleton, locations=locations, radii=radii)
 
     ################################################################################################
     # @initialize_meta_object
@@ -392,24 +401,20 @@ class AstroMetaBuilder:
         the with soft-body algorithm.
         """
 
-        options = nmv.options.NeuroMorphoVisOptions()
         # Use the SomaSoftBodyBuilder to reconstruct the soma
         soft_body_soma_builder = nmv.builders.SomaSoftBodyBuilder(morphology=self.morphology,
-                                                                  options=options)
+                                                                  options=self.options)
 
         # Construct the soft-body-based soma and avoid adding noise to the profile
         soft_body_soma = soft_body_soma_builder.reconstruct_soma_mesh(
             apply_shader=False, add_noise_to_surface=False)
 
-        # Run the particles simulation remesher
+        # Run the particles simulation remesher within the time budget of the soma
         particle_remeshes = nmv.physics.ParticleRemesher()
-        stepper = particle_remeshes.run(mesh_object=soft_body_soma,
-                                        context=bpy.context, interactive=True)
-
-        for i in range(1000000):
-            finished = next(stepper)
-            if finished:
-                break
+        remeshing_statistics = particle_remeshes.run_batch(
+            mesh_object=soft_body_soma, context=bpy.context,
+            time_budget=self.options.soma.remeshing_time_budget)
+        nmv.logger.info(remeshing_statistics.get_report())
 
         # Remove the faces that are located around the initial segment
         valid_arbors = soft_body_soma_builder.remove_faces_within_arbor_initial_segment(
@@ -422,22 +427,16 @@ class AstroMetaBuilder:
             meta_element.radius = arbor.samples[0].radius * self.magic_scale_factor * 1.0
             meta_element.co = arbor.samples[0].point
 
-        # Build the soma profile from the soft-body mesh
-        for i, face in enumerate(soft_body_soma.data.polygons):
-
-            # Add a new meta element
-            meta_element = self.meta_skeleton.elements.new()
-
-            # Compute the largest radius in the triangle, but since we re-mesh the soma, we will
-            # get almost equi-sides faces
-            radius = nmv.mesh.get_largest_radius_in_face(
-                mesh_object=soft_body_soma, face_index=face.index)
-
-            # Compute the radius of the meta-element by trial-and-error
-            meta_element.radius = radius * 2 * self.magic_scale_factor
+        # Compute the largest radius in all the triangles at once, but since we re-mesh the soma,
+        # we will get almost equi-sides faces
+        centers, normals, radii = nmv.mesh.get_largest_radii_of_faces(mesh_object=soft_body_soma)
 
-            # Update its coordinates
-            meta_element.co = face.center - (face.normal * radius * self.soma_scaling_factor)
+        # Build the soma profile from the soft-body mesh in bulk, where the radii of the
+        # meta-elements are computed by trial-and-error
+        nmv.geometry.add_meta_elements_in_bulk(
+            meta_skeleton=self.meta_skeleton,
+            locations=centers - normals * (radii * self.soma_scaling_factor)[:, None],
+            radii=radii * 2 * self.magic_scale_factor)
 
         # Delete the mesh
         nmv.scene.delete_object_in_scene(scene_object=soft_body_soma)
@@ -490,7 +489,7 @@ class AstroMetaBuilder:
         '''
         # Clean the mesh object and remove the non-manifold edges
         nmv.logger.info('Cleaning Mesh Non-manifold Edges & Vertices')
-        nmv.mesh.clean_mesh_object(self.meta_mesh)
+        nmv.mesh.clean_mesh_object(self.meta_mesh, use_operators=False)
 
         # Remove the small partitions
         nmv.logger.info('Removing Partitions')
@@ -525,6 +524,7 @@ class AstroMetaBuilder:
         result, stats = nmv.utilities.profile_function(self.build_arbors)
         self.profiling_statistics += stats
 
+        # Build the end-feet
         result, stats = nmv.utilities.profile_function(self.build_endfeet)
         self.profiling_statistics += stats
 
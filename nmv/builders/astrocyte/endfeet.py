@@ -0,0 +1,161 @@
+####################################################################################################
+# Copyright (c) 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+# System imports
+import numpy
+
+# Internal imports
+import nmv.consts
+
+
+####################################################################################################
+# @EndfootArea
+####################################################################################################
+class EndfootArea:
+    """An endfoot area stored as flat arrays, independent of Blender and of the circuit API.
+    """
+
+    ################################################################################################
+    # @__init__
+    ################################################################################################
+    def __init__(self,
+                 points,
+                 triangles,
+                 thickness):
+        """Constructor
+
+        :param points:
+            An array of shape (N, 3) with the vertices of the endfoot area.
+        :param triangles:
+            An array of shape (M, 3) with the vertex indices of the triangles of the area.
+        :param thickness:
+            The thickness of the endfoot.
+        """
+
+        # The vertices of the area
+        self.points = numpy.asarray(points, dtype=numpy.float64).reshape((-1, 3))
+
+        # The triangles of the area
+        self.triangles = numpy.asarray(triangles, dtype=numpy.int64).reshape((-1, 3))
+
+        # The thickness of the endfoot
+        self.thickness = float(thickness)
+
+
+####################################################################################################
+# @get_barycentric_grid
+####################################################################################################
+def get_barycentric_grid(divisions):
+    """Returns the barycentric weights of a regular grid that splits every edge of a triangle into
+    a given number of divisions.
+
+    :param divisions:
+        The number of divisions per edge.
+    :return:
+        An array of shape ((divisions + 1) * (divisions + 2) / 2, 3) with the weights.
+    """
+
+    # All the (i, j) pairs where i + j <= divisions
+    i, j = numpy.meshgrid(numpy.arange(divisions + 1), numpy.arange(divisions + 1), indexing='ij')
+    mask = (i + j) <= divisions
+    i = i[mask]
+    j = j[mask]
+
+    # Weights of the three corners
+    return numpy.stack((divisions - i - j, i, j), axis=1).astype(numpy.float64) / divisions
+
+
+####################################################################################################
+# @subdivide_endfoot_area
+####################################################################################################
+def subdivide_endfoot_area(endfoot_area,
+                           levels=nmv.consts.MetaBall.ASTROCYTE_ENDFEET_SUBDIVISION_LEVELS,
+                           origin=None):
+    """Samples the surface of an endfoot area on a regular barycentric grid of every triangle,
+    where every edge is split into 2 ** levels divisions, without creating any mesh in the scene.
+    The grid differs from the vertices of a SIMPLE subsurf, which splits the triangles into quads.
+
+    :param endfoot_area:
+        A given EndfootArea.
+    :param levels:
+        The subdivision levels, each level doubles the number of divisions along every edge.
+    :param origin:
+        An optional origin that is subtracted from the samples, i.e. the soma centroid when the
+        morphology is centered.
+    :return:
+        An array of shape (K, 3) with the unique sample points of the area.
+    """
+
+    # Empty area
+    if len(endfoot_area.triangles) == 0:
+        return numpy.zeros((0, 3))
+
+    # The weights of the grid
+    weights = get_barycentric_grid(2 ** max(0, int(levels)))
+
+    # The corners of all the triangles, (M, 3, 3)
+    corners = endfoot_area.points[endfoot_area.triangles]
+
+    # Interpolate all the grid points of all the triangles at once, (M, K, 3)
+    samples = numpy.einsum('kc,mcd->mkd', weights, corners).reshape((-1, 3))
+
+    # The grid points along the shared edges are duplicated, remove them
+    scale = max(1.0, float(numpy.abs(endfoot_area.points).max()))
+    keys = numpy.round(samples / (scale * 1e-7)).astype(numpy.int64)
+    _, unique_indices = numpy.unique(keys, axis=0, return_index=True)
+    samples = samples[numpy.sort(unique_indices)]
+
+    # Translate the samples
+    if origin is not None:
+        samples = samples - numpy.asarray(origin, dtype=numpy.float64).reshape((1, 3))
+
+    # Return the samples
+    return samples
+
+
+####################################################################################################
+# @get_endfeet_meta_elements
+####################################################################################################
+def get_endfeet_meta_elements(endfeet_areas,
+                              levels=nmv.consts.MetaBall.ASTROCYTE_ENDFEET_SUBDIVISION_LEVELS,
+                              origin=None):
+    """Computes the locations and radii of the meta elements of a list of endfeet areas.
+
+    :param endfeet_areas:
+        A list of EndfootArea objects.
+    :param levels:
+        The subdivision levels of the areas.
+    :param origin:
+        An optional origin that is subtracted from the locations.
+    :return:
+        A tuple (locations, radii) with arrays of shape (N, 3) and (N,).
+    """
+
+    # Collect the samples of every area
+    locations = list()
+    radii = list()
+    for endfoot_area in endfeet_areas:
+        samples = subdivide_endfoot_area(endfoot_area, levels=levels, origin=origin)
+        locations.append(samples)
+        radii.append(numpy.full(len(samples), endfoot_area.thickness))
+
+    # No endfeet
+    if len(locations) == 0:
+        return numpy.zeros((0, 3)), numpy.zeros(0)
+
+    # Concatenate all the endfeet
+    return numpy.concatenate(locations), numpy.concatenate(radii)
@@ -23,6 +23,7 @@ import os
 import bpy
 
 # Internal imports
+import nmv.consts
 import nmv.scene
 import nmv.enums
 import nmv.geometry
@@ -464,24 +465,31 @@ def add_surface_noise_to_arbor(builder):
         stable_extent_center, stable_extent_radius = \
             nmv.skeleton.ops.get_stable_soma_extent_for_morphology(builder.morphology)
 
+        # The seed of the noise, derived from the run seed if given
+        noise_seed = nmv.utilities.RandomContext(builder.options.mesh.random_seed).get_stream_seed(
+            'surface_noise', default=nmv.consts.Meshing.SURFACE_NOISE_SEED)
+
         # The subdivision parameters are based on the mesh builder
         meshing_technique = builder.options.mesh.meshing_technique
         if meshing_technique == nmv.enums.Meshing.Technique.PIECEWISE_WATERTIGHT:
             for mesh_object in mesh_objects:
                 nmv.mesh.smooth_object(mesh_object=mesh_object, level=1)
                 nmv.mesh.add_surface_noise_to_mesh(
-                    mesh_object=mesh_object, subdivision_level=0, noise_strength=1.0)
+                    mesh_object=mesh_object, subdivision_level=0, noise_strength=1.0,
+                    seed=noise_seed)
 
         elif meshing_technique == nmv.enums.Meshing.Technique.SKINNING:
             for mesh_object in mesh_objects:
                 nmv.mesh.add_surface_noise_to_mesh(
-                    mesh_object=mesh_object, subdivision_level=0, noise_strength=1.0)
+                    mesh_object=mesh_object, subdivision_level=0, noise_strength=1.0,
+                    seed=noise_seed)
 
         elif meshing_technique == nmv.enums.Meshing.Technique.UNION:
             for mesh_object in mesh_objects:
                 nmv.mesh.decimate_mesh_object(mesh_object=mesh_object, decimation_ratio=0.2)
                 nmv.mesh.add_surface_noise_to_mesh(
-                    mesh_object=mesh_object, subdivision_level=0, noise_strength=1.0)
+                    mesh_object=mesh_object, subdivision_level=0, noise_strength=1.0,
+                    seed=noise_seed)
         else:
             return
 
@@ -500,6 +508,8 @@ def add_spines_to_surface(builder,
         An object of the builder that is used to reconstruct the neuron mesh.
     :param join_spine_meshes:
         Join all the spines meshes into a single mesh object for simplicity.
+    :return:
+        A list of the spines meshes, or None if the spines are ignored.
     """
 
     # Build spines from a BBP circuit
@@ -507,7 +517,8 @@ def add_spines_to_surface(builder,
         nmv.logger.info('Adding Spines from a BBP Circuit')
         spines_objects = nmv.builders.build_circuit_spines(
             morphology=builder.morphology, blue_config=builder.options.morphology.blue_config,
-            gid=builder.options.morphology.gid, material=builder.spines_materials[0])
+            gid=builder.options.morphology.gid, material=builder.spines_materials[0],
+            random_seed=builder.options.mesh.random_seed)
 
     # Just add some random spines for the look only
     elif builder.options.mesh.spines == nmv.enums.Meshing.Spines.Source.RANDOM:
@@ -518,12 +529,15 @@ def add_spines_to_surface(builder,
 
     # Otherwise ignore spines
     else:
-        return
+        return None
 
     # Join the spine objects into a single mesh, if required
     if join_spine_meshes:
         spine_mesh_name = '%s_spines' % builder.options.morphology.label
-        nmv.mesh.join_mesh_objects(spines_objects, spine_mesh_name)
+        return [nmv.mesh.join_mesh_objects(spines_objects, spine_mesh_name)]
+
+    # Return the spines meshes
+    return spines_objects
 
 
 ####################################################################################################
@@ -645,10 +659,61 @@ def write_statistics_to_file(builder, tag):
     stats_file.write('\n')
     stats_file.write(builder.mesh_statistics)
 
+    # The memory of the stages, if it was recorded
+    memory_profile = nmv.utilities.stop_memory_profile()
+    if memory_profile is not None:
+        memory_statistics = memory_profile.get_report()
+        nmv.logger.statistics(memory_statistics)
+        stats_file.write('\n')
+        stats_file.write(memory_statistics)
+
+        # Write the numbers next to the stats. file, with the size of the morphology
+        memory_profile.write('%s/%s-%s.%s' % (builder.options.io.statistics_directory,
+                                              builder.morphology.label, tag,
+                                              nmv.consts.Memory.REPORT_EXTENSION),
+                             properties=get_morphology_size_properties(builder, tag))
+
     # Close the file
     stats_file.close()
 
 
+####################################################################################################
+# @get_morphology_size_properties
+####################################################################################################
+def get_morphology_size_properties(builder,
+                                   tag):
+    """Gets the size of the morphology of the builder, to relate the memory of a run to it.
+
+    :param builder:
+        An object of the builder that is used to reconstruct the neuron mesh.
+    :param tag:
+        The tag of the builder.
+    :return:
+        A dictionary with the tag, the morphology file and its size in bytes (if the morphology is
+        loaded from a file) and the number of the samples of the morphology.
+    """
+
+    # The morphology file
+    morphology_file = builder.options.morphology.morphology_file_path
+    morphology_file_size = None
+    if morphology_file is not None and os.path.isfile(morphology_file):
+        morphology_file_size = os.path.getsize(morphology_file)
+
+    # The number of the samples, without materializing the lazily loaded sections
+    number_samples = [0]
+
+    def count_section_samples(section):
+        number_samples[0] += section.get_number_samples()
+
+    nmv.skeleton.ops.apply_operation_to_morphology(builder.morphology, count_section_samples)
+
+    return {'tag': tag,
+            'morphology': builder.morphology.label,
+            'morphology_file': morphology_file,
+            'morphology_file_size': morphology_file_size,
+            'number_samples': number_samples[0]}
+
+
 ####################################################################################################
 # @transform_to_global_coordinates
 ####################################################################################################
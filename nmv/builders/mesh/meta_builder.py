@@ -15,15 +15,13 @@
 # If not, see <http://www.gnu.org/licenses/>.
 ####################################################################################################
 
-# System imports
-import copy
-
 # Blender imports
 import bpy, mathutils
 from mathutils import Vector, Matrix
 
 # Internal modules
 import nmv.builders
+import nmv.consts
 import nmv.enums
 import nmv.mesh
 import nmv.shading
@@ -61,8 +59,8 @@ class MetaBuilder:
             Loaded options from NeuroMorphoVis.
         """
 
-        # Morphology
-        self.morphology = copy.deepcopy(morphology)
+        # Morphology, a copy-on-write view that shares the samples that are not modified
+        self.morphology = morphology.create_copy_on_write_view()
 
         # Loaded options from NeuroMorphoVis
         self.options = options
@@ -460,14 +458,12 @@ class MetaBuilder:
         soft_body_soma = soft_body_soma_builder.reconstruct_soma_mesh(
             apply_shader=False, add_noise_to_surface=False)
 
-        # Run the particles simulation remesher
-        mesher = nmv.physics.ParticleRemesher()
-        stepper = mesher.run(mesh_object=soft_body_soma, context=bpy.context, interactive=True)
-
-        for i in range(1000000):
-            finished = next(stepper)
-            if finished:
-                break
+        # Run the particles simulation remesher within the time budget of the soma
+        mesher = nmv.physics.ParticleRemesher(random_seed=self.options.mesh.random_seed)
+        remeshing_statistics = mesher.run_batch(
+            mesh_object=soft_body_soma, context=bpy.context,
+            time_budget=self.options.soma.remeshing_time_budget)
+        self.profiling_statistics += remeshing_statistics.get_report()
 
         # Remove the faces that are located around the initial segment
         valid_arbors = soft_body_soma_builder.remove_faces_within_arbor_initial_segment(
@@ -481,25 +477,20 @@ class MetaBuilder:
             meta_element.radius = arbor.samples[0].radius * self.magic_scale_factor * 1.0
             meta_element.co = arbor.samples[0].point
 
-        # Build the soma profile from the soft-body mesh
-        for face in soft_body_soma.data.polygons:
-
-            # Add a new meta element
-            meta_element = self.meta_skeleton.elements.new()
+        # Compute the largest radius in all the triangles at once, but since we re-mesh the soma,
+        # we will get almost equi-sides faces
+        centers, normals, radii = nmv.mesh.get_largest_radii_of_faces(mesh_object=soft_body_soma)
 
-            # Compute the largest radius in the triangle, but since we re-mesh the soma, we will
-            # get almost equi-sides faces
-            radius = nmv.mesh.get_largest_radius_in_face(
-                mesh_object=soft_body_soma, face_index=face.index)
+        # Compute the radii of the meta-elements by trial-and-error
+        meta_radii = radii * self.magic_scale_factor
+        if len(meta_radii) > 0:
+            self.smallest_radius = min(self.smallest_radius, float(meta_radii.min()))
 
-            # Compute the radius of the meta-element by trial-and-error
-            meta_element.radius = radius * self.magic_scale_factor
-
-            if meta_element.radius < self.smallest_radius:
-                self.smallest_radius = meta_element.radius
-
-            # Update its coordinates
-            meta_element.co = face.center - (face.normal * radius * self.soma_scaling_factor)
+        # Build the soma profile from the soft-body mesh in bulk
+        nmv.geometry.add_meta_elements_in_bulk(
+            meta_skeleton=self.meta_skeleton,
+            locations=centers - normals * (radii * self.soma_scaling_factor)[:, None],
+            radii=meta_radii)
 
         # Delete the mesh
         nmv.scene.delete_object_in_scene(scene_object=soft_body_soma)
@@ -606,7 +597,7 @@ class MetaBuilder:
         # Clean the mesh object and remove the non-manifold edges
         if not self.ignore_watertightness:
             nmv.logger.info('Cleaning Mesh Non-manifold Edges & Vertices')
-            nmv.mesh.clean_mesh_object(self.meta_mesh)
+            nmv.mesh.clean_mesh_object(self.meta_mesh, use_operators=False)
 
         # Remove the islands (or small partitions from the mesh) and smooth it to look nice
         if self.options.mesh.soma_type == nmv.enums.Soma.Representation.SOFT_BODY:
@@ -638,9 +629,11 @@ class MetaBuilder:
                 nmv.mesh.ops.decimate_mesh_object(mesh_object=self.meta_mesh,
                                                   decimation_ratio=self.meta_skeleton.resolution)
 
-            # Add the surface distortion map
-            nmv.mesh.add_surface_noise_to_mesh_using_displacement_modifier(
-                mesh_object=self.meta_mesh, strength=1.0)
+            # Add the surface distortion map, with the range of a unit-strength clouds texture
+            nmv.mesh.add_coherent_noise_to_mesh(
+                mesh_object=self.meta_mesh, amplitude=0.5, noise_scale=1.5,
+                seed=nmv.utilities.RandomContext(self.options.mesh.random_seed).get_stream_seed(
+                    'surface_roughness', default=nmv.consts.Meshing.SURFACE_NOISE_SEED))
 
             nmv.mesh.ops.decimate_mesh_object(mesh_object=self.meta_mesh,
                                               decimation_ratio=0.25)
@@ -674,14 +667,32 @@ class MetaBuilder:
         """Reconstructs the neuronal mesh using meta objects.
         """
 
+        return nmv.utilities.run_stages(self.reconstruct_mesh_in_stages())
+
+    ################################################################################################
+    # @reconstruct_mesh_in_stages
+    ################################################################################################
+    def reconstruct_mesh_in_stages(self):
+        """Reconstructs the mesh stage by stage, see reconstruct_mesh(). Yields the progress and
+        the name of every stage before running it.
+
+        :return:
+            The result of reconstruct_mesh(), once the generator is exhausted.
+        """
+
         nmv.logger.header('Building Mesh: MetaBuilder')
 
+        # Record the memory and the datablocks around every profiled stage
+        nmv.utilities.start_memory_profile(label='MetaBuilder')
+
         # Verify and repair the morphology, if required
+        yield 0.0, 'Updating the morphology skeleton'
         result, stats = nmv.utilities.profile_function(self.update_morphology_skeleton)
         self.profiling_statistics += stats
 
         # Initialize the meta object
         # Note that self.label should be replaced by self.options.morphology.label
+        yield 0.05, 'Initializing the meta object'
         result, stats = nmv.utilities.profile_function(
             self.initialize_meta_object, self.label)
         self.profiling_statistics += stats
@@ -692,33 +703,40 @@ class MetaBuilder:
             soma_building_function = self.build_soma_from_meta_objects
 
         # Build the soma
+        yield 0.1, 'Building the soma'
         result, stats = nmv.utilities.profile_function(soma_building_function)
         self.profiling_statistics += stats
 
         # Build the arbors
+        yield 0.2, 'Building the arbors'
         result, stats = nmv.utilities.profile_function(self.build_arbors)
         self.profiling_statistics += stats
 
         # Building the spines from morphologies
+        yield 0.5, 'Building the spines'
         result, stats = nmv.utilities.profile_function(self.build_spines)
         self.profiling_statistics += stats
 
         # Finalize the meta object and construct a solid object
+        yield 0.6, 'Finalizing the meta object'
         result, stats = nmv.utilities.profile_function(self.finalize_meta_object)
         self.profiling_statistics += stats
 
         # Surface roughness
+        yield 0.75, 'Adding the surface roughness'
         result, stats = nmv.utilities.profile_function(self.add_surface_roughness)
         self.profiling_statistics += stats
 
         # Tessellation
+        yield 0.8, 'Decimating the mesh'
         result, stats = nmv.utilities.profile_function(
             nmv.builders.mesh.common.decimate_neuron_mesh, self)
 
         # Clean the mesh object and remove the non-manifold edges
+        yield 0.85, 'Cleaning the mesh'
         if not self.ignore_watertightness:
             nmv.logger.info('Cleaning Mesh Non-manifold Edges & Vertices')
-            nmv.mesh.clean_mesh_object(self.meta_mesh)
+            nmv.mesh.clean_mesh_object(self.meta_mesh, use_operators=False)
             self.profiling_statistics += stats
 
         # NOTE: Before drawing the skeleton, create the materials once and for all to improve the
@@ -729,11 +747,13 @@ class MetaBuilder:
         self.assign_material_to_mesh()
 
         # Transform to the global coordinates, if required
+        yield 0.9, 'Transforming to the global coordinates'
         result, stats = nmv.utilities.profile_function(
             nmv.builders.mesh.common.transform_to_global_coordinates, self)
         self.profiling_statistics += stats
 
         # Collect the stats. of the mesh
+        yield 0.95, 'Collecting the mesh statistics'
         result, stats = nmv.utilities.profile_function(nmv.builders.collect_mesh_stats, self)
         self.profiling_statistics += stats
 
@@ -16,7 +16,6 @@
 ####################################################################################################
 
 # System imports
-import copy
 import time
 
 # Blender imports
@@ -56,8 +55,8 @@ class SkinningBuilder:
             Loaded options from NeuroMorphoVis.
         """
 
-        # Morphology
-        self.morphology = copy.deepcopy(morphology)
+        # Morphology, a copy-on-write view that shares the samples that are not modified
+        self.morphology = morphology.create_copy_on_write_view()
 
         # Loaded options from NeuroMorphoVis
         self.options = options
@@ -484,13 +483,30 @@ class SkinningBuilder:
         """Reconstructs the neuronal mesh using the skinning modifiers in Blender.
         """
 
+        return nmv.utilities.run_stages(self.reconstruct_mesh_in_stages())
+
+    ################################################################################################
+    # @reconstruct_mesh_in_stages
+    ################################################################################################
+    def reconstruct_mesh_in_stages(self):
+        """Reconstructs the mesh stage by stage, see reconstruct_mesh(). Yields the progress and
+        the name of every stage before running it.
+
+        :return:
+            The result of reconstruct_mesh(), once the generator is exhausted.
+        """
+
         nmv.logger.header('Building Mesh: SkinningBuilder')
 
+        # Record the memory and the datablocks around every profiled stage
+        nmv.utilities.start_memory_profile(label='SkinningBuilder')
+
         # NOTE: Before drawing the skeleton, create the materials once and for all to improve the
         # performance since this is way better than creating a new material per section or segment
         nmv.builders.create_skeleton_materials(builder=self)
 
         # Verify and repair the morphology, if required
+        yield 0.0, 'Updating the morphology skeleton'
         result, stats = nmv.utilities.profile_function(
             nmv.builders.mesh.update_morphology_skeleton, self)
         self.profiling_statistics += stats
@@ -500,6 +516,7 @@ class SkinningBuilder:
         nmv.skeleton.ops.verify_arbors_connectivity_to_soma(self.morphology)
 
         # Build the soma, with the default parameters
+        yield 0.1, 'Building the soma'
         result, stats = nmv.utilities.profile_function(nmv.builders.reconstruct_soma_mesh, self)
         self.profiling_statistics += stats
 
@@ -507,10 +524,12 @@ class SkinningBuilder:
         if self.options.mesh.soma_connection == nmv.enums.Meshing.SomaConnection.CONNECTED:
 
             # Build the arbors
+            yield 0.2, 'Building the arbors'
             result, stats = nmv.utilities.profile_function(self.build_arbors, True)
             self.profiling_statistics += stats
 
             # Connect to the soma
+            yield 0.5, 'Connecting the arbors to the soma'
             result, stats = nmv.utilities.profile_function(
                 nmv.builders.connect_arbors_to_soma, self)
             self.profiling_statistics += stats
@@ -518,6 +537,7 @@ class SkinningBuilder:
         # Build the arbors only without any connection to the soma
         else:
             # Build the arbors
+            yield 0.2, 'Building the arbors'
             result, stats = nmv.utilities.profile_function(self.build_arbors, False)
             self.profiling_statistics += stats
 
@@ -553,29 +573,35 @@ class SkinningBuilder:
                                                                    self.creating_modifier_time)
 
         # Tessellation
+        yield 0.6, 'Decimating the mesh'
         result, stats = nmv.utilities.profile_function(nmv.builders.decimate_neuron_mesh, self)
         self.profiling_statistics += stats
 
         # Surface roughness
+        yield 0.7, 'Adding the surface roughness'
         result, stats = nmv.utilities.profile_function(
             nmv.builders.add_surface_noise_to_arbor, self)
         self.profiling_statistics += stats
 
         # Add the spines
+        yield 0.75, 'Adding the spines'
         result, stats = nmv.utilities.profile_function(nmv.builders.add_spines_to_surface, self)
         self.profiling_statistics += stats
 
         # Join all the objects into a single object
+        yield 0.85, 'Joining the mesh objects'
         neuron_mesh, stats = nmv.utilities.profile_function(
             nmv.builders.join_mesh_object_into_single_object, self)
         self.profiling_statistics += stats
 
         # Transform to the global coordinates, if required
+        yield 0.9, 'Transforming to the global coordinates'
         result, stats = nmv.utilities.profile_function(
             nmv.builders.transform_to_global_coordinates, self)
         self.profiling_statistics += stats
 
         # Collect the stats. of the mesh
+        yield 0.95, 'Collecting the mesh statistics'
         result, stats = nmv.utilities.profile_function(nmv.builders.collect_mesh_stats, self)
         self.profiling_statistics += stats
 
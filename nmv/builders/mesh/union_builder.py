@@ -16,7 +16,7 @@
 ####################################################################################################
 
 # System imports
-import copy
+import numpy
 
 # Internal imports
 import nmv.builders
@@ -50,8 +50,8 @@ class UnionBuilder:
             Loaded options from NeuroMorphoVis.
         """
 
-        # Morphology
-        self.morphology = copy.deepcopy(morphology)
+        # Morphology, a copy-on-write view that shares the samples that are not modified
+        self.morphology = morphology.create_copy_on_write_view()
 
         # Loaded options from NeuroMorphoVis
         self.options = options
@@ -198,8 +198,10 @@ class UnionBuilder:
         for arbor_poly_line_object in arbor_poly_line_objects:
             nmv.scene.ops.convert_object_to_mesh(arbor_poly_line_object)
 
-        # Union all the mesh objects into a single object
-        arbor.mesh = nmv.mesh.ops.union_mesh_objects_in_list(arbor_poly_line_objects)
+        # Union all the mesh objects into a single object, in a balanced tree that is distributed
+        # over the worker processes for the large arbors
+        arbor.mesh = nmv.mesh.ops.union_mesh_objects_in_parallel(
+            arbor_poly_line_objects, number_workers=self.options.mesh.union_workers)
 
         # Rename the mesh
         arbor.mesh.name = name
@@ -357,6 +359,133 @@ class UnionBuilder:
         else:
             nmv.logger.log('ERROR')
 
+    ################################################################################################
+    # @add_arbor_to_distance_grid
+    ################################################################################################
+    def add_arbor_to_distance_grid(self,
+                                   grid,
+                                   section,
+                                   max_branching_order,
+                                   label,
+                                   branching_order=1):
+        """Adds the segments of an arbor to a distance grid as tapered tubes.
+
+        :param grid:
+            The distance grid of the voxel union.
+        :param section:
+            The root section of the arbor.
+        :param max_branching_order:
+            Maximum branching order.
+        :param label:
+            The label of the tubes, the index of the material of the arbor.
+        :param branching_order:
+            The branching order of the section.
+        """
+
+        # Ignore the sections beyond the maximum branching order
+        if section is None or branching_order > max_branching_order:
+            return
+
+        # The segments of the section, starting from the last sample of its parent
+        samples = section.samples
+        if section.parent is not None and len(section.parent.samples) > 0:
+            samples = [section.parent.samples[-1]] + samples
+
+        # A root section starts from the centroid of the soma, to weld the arbor to the soma
+        # although its first samples inside the soma are removed, unless it is far from the soma
+        elif section.is_root() and not section.far_from_soma and \
+                self.morphology.soma is not None and len(samples) > 0:
+            grid.add_tube(self.morphology.soma.centroid, samples[0].radius,
+                          samples[0].point, samples[0].radius, label)
+
+        for i in range(len(samples) - 1):
+            grid.add_tube(samples[i].point, samples[i].radius,
+                          samples[i + 1].point, samples[i + 1].radius, label)
+
+        # The children
+        for child in section.children:
+            self.add_arbor_to_distance_grid(grid, child, max_branching_order, label,
+                                            branching_order + 1)
+
+    ################################################################################################
+    # @build_voxel_union
+    ################################################################################################
+    def build_voxel_union(self):
+        """Merges the arbors, the soma and the spines into a single watertight and manifold mesh
+        with a signed distance grid, instead of the boolean operators.
+
+        The arbors are added to the grid directly from the skeleton as tapered tubes, and the soma
+        and the spines as closed meshes, which are deleted once the union is extracted. The arbors
+        are always welded to the soma. Every primitive is labeled with the index of its material,
+        the soma, the arbor or the spine one, and the faces of the union get the material of the
+        primitive that makes them.
+        """
+
+        nmv.logger.header('Reconstructing the voxel union')
+
+        # The distance grid at the resolution of the voxel size
+        grid = nmv.mesh.ops.SparseDistanceGrid(voxel_size=self.options.mesh.voxel_size)
+
+        # The materials of the union, the label of a primitive is the index of its material
+        materials = list()
+
+        def get_material_label(material):
+            if material not in materials:
+                materials.append(material)
+            return materials.index(material)
+
+        # The arbors
+        arbors = list()
+        if self.morphology.has_axons() and not self.options.morphology.ignore_axons:
+            arbors.extend([(arbor, self.options.morphology.axon_branch_order,
+                            self.axons_materials[0]) for arbor in self.morphology.axons])
+        if self.morphology.has_apical_dendrites() and \
+                not self.options.morphology.ignore_apical_dendrites:
+            arbors.extend([(arbor, self.options.morphology.apical_dendrite_branch_order,
+                            self.apical_dendrites_materials[0])
+                           for arbor in self.morphology.apical_dendrites])
+        if self.morphology.has_basal_dendrites() and \
+                not self.options.morphology.ignore_basal_dendrites:
+            arbors.extend([(arbor, self.options.morphology.basal_dendrites_branch_order,
+                            self.basal_dendrites_materials[0])
+                           for arbor in self.morphology.basal_dendrites])
+        for arbor, max_branching_order, material in arbors:
+            nmv.logger.detail(arbor.label)
+            self.add_arbor_to_distance_grid(grid, arbor, max_branching_order,
+                                            get_material_label(material))
+
+        # The soma, with its material, and the spines, with theirs if they have any
+        mesh_objects = list()
+        if self.soma_mesh is not None:
+            mesh_objects.append([self.soma_mesh, self.soma_materials[0]])
+        spines_objects = nmv.builders.add_spines_to_surface(self)
+        if spines_objects is not None:
+            for spine_object in spines_objects:
+                spine_materials = spine_object.data.materials
+                mesh_objects.append([spine_object, spine_materials[0] if len(spine_materials) > 0
+                                     else self.soma_materials[0]])
+        for mesh_object, material in mesh_objects:
+            grid.add_mesh_object(mesh_object, get_material_label(material))
+
+        # Extract the surface of the union
+        vertices, faces, labels = grid.extract_surface()
+        nmv.scene.ops.delete_list_objects([mesh_object for mesh_object, _ in mesh_objects])
+        self.soma_mesh = None
+        if vertices is None:
+            nmv.logger.log('ERROR: The voxel union is empty')
+            return
+
+        # A single mesh object of the neuron
+        neuron_mesh = nmv.mesh.ops.create_mesh_object_from_surface(
+            vertices, faces, name='%s_mesh' % self.morphology.label)
+
+        # Assign the materials to the faces
+        neuron_mesh.data.materials.clear()
+        for material in materials:
+            neuron_mesh.data.materials.append(material)
+        neuron_mesh.data.polygons.foreach_set('material_index', labels.astype(numpy.int32))
+        neuron_mesh.data.update()
+
     ################################################################################################
     # @reconstruct_mesh
     ################################################################################################
@@ -364,60 +493,104 @@ class UnionBuilder:
         """Reconstructs the mesh.
         """
 
+        return nmv.utilities.run_stages(self.reconstruct_mesh_in_stages())
+
+    ################################################################################################
+    # @reconstruct_mesh_in_stages
+    ################################################################################################
+    def reconstruct_mesh_in_stages(self):
+        """Reconstructs the mesh stage by stage, see reconstruct_mesh(). Yields the progress and
+        the name of every stage before running it.
+
+        :return:
+            The result of reconstruct_mesh(), once the generator is exhausted.
+        """
+
         nmv.logger.header('Building Mesh: UnionBuilder')
 
+        # Record the memory and the datablocks around every profiled stage
+        nmv.utilities.start_memory_profile(label='UnionBuilder')
+
         # NOTE: Before drawing the skeleton, create the materials once and for all to improve the
         # performance since this is way better than creating a new material per section or segment
         nmv.builders.create_skeleton_materials(builder=self)
 
         # Verify and repair the morphology, if required
+        yield 0.0, 'Updating the morphology skeleton'
         result, stats = nmv.utilities.profile_function(self.update_morphology_skeleton)
         self.profiling_statistics += stats
 
         # Apply skeleton - based operation, if required, to slightly modify the skeleton
+        yield 0.05, 'Modifying the morphology skeleton'
         result, stats = nmv.utilities.profile_function(
             nmv.builders.modify_morphology_skeleton, self)
         self.profiling_statistics += stats
 
         # Resample the sections of the morphology skeleton
+        yield 0.1, 'Resampling the sections'
         nmv.builders.morphology.resample_skeleton_sections(builder=self)
 
         # Build the soma, with the default parameters
+        yield 0.15, 'Building the soma'
         result, stats = nmv.utilities.profile_function(nmv.builders.reconstruct_soma_mesh, self)
         self.profiling_statistics += stats
 
-        # Build the arbors
-        result, stats = nmv.utilities.profile_function(self.build_arbors)
-        self.profiling_statistics += stats
+        # Merge the arbors, the soma and the spines in a distance grid
+        if self.options.mesh.union_mode == nmv.enums.Meshing.UnionMode.VOXEL:
+            yield 0.2, 'Merging the arbors, the soma and the spines in a distance grid'
+            result, stats = nmv.utilities.profile_function(self.build_voxel_union)
+            self.profiling_statistics += stats
 
-        # Connect to the soma
-        result, stats = nmv.utilities.profile_function(nmv.builders.connect_arbors_to_soma, self)
-        self.profiling_statistics += stats
+            # Tessellation
+            yield 0.7, 'Decimating the mesh'
+            result, stats = nmv.utilities.profile_function(nmv.builders.decimate_neuron_mesh, self)
+            self.profiling_statistics += stats
 
-        # Tessellation
-        result, stats = nmv.utilities.profile_function(nmv.builders.decimate_neuron_mesh, self)
-        self.profiling_statistics += stats
+        # Or with the boolean operators
+        else:
 
-        # Add the spines
-        result, stats = nmv.utilities.profile_function(nmv.builders.add_spines_to_surface, self)
-        self.profiling_statistics += stats
+            # Build the arbors
+            yield 0.2, 'Building the arbors'
+            result, stats = nmv.utilities.profile_function(self.build_arbors)
+            self.profiling_statistics += stats
+
+            # Connect to the soma
+            yield 0.5, 'Connecting the arbors to the soma'
+            result, stats = nmv.utilities.profile_function(
+                nmv.builders.connect_arbors_to_soma, self)
+            self.profiling_statistics += stats
+
+            # Tessellation
+            yield 0.6, 'Decimating the mesh'
+            result, stats = nmv.utilities.profile_function(nmv.builders.decimate_neuron_mesh, self)
+            self.profiling_statistics += stats
+
+            # Add the spines
+            yield 0.7, 'Adding the spines'
+            result, stats = nmv.utilities.profile_function(
+                nmv.builders.add_spines_to_surface, self)
+            self.profiling_statistics += stats
 
         # Surface roughness
+        yield 0.8, 'Adding the surface roughness'
         result, stats = nmv.utilities.profile_function(
             nmv.builders.add_surface_noise_to_arbor, self)
         self.profiling_statistics += stats
 
         # Join all the objects into a single object
+        yield 0.85, 'Joining the mesh objects'
         result, stats = nmv.utilities.profile_function(
             nmv.builders.join_mesh_object_into_single_object, self)
         self.profiling_statistics += stats
 
         # Transform to the global coordinates, if required
+        yield 0.9, 'Transforming to the global coordinates'
         result, stats = nmv.utilities.profile_function(
             nmv.builders.transform_to_global_coordinates, self)
         self.profiling_statistics += stats
 
         # Collect the stats. of the mesh
+        yield 0.95, 'Collecting the mesh statistics'
         result, stats = nmv.utilities.profile_function(nmv.builders.collect_mesh_stats, self)
         self.profiling_statistics += stats
 
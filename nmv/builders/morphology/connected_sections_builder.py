@@ -48,8 +48,8 @@ class ConnectedSectionsBuilder:
             A given morphology.
         """
 
-        # Morphology
-        self.morphology = copy.deepcopy(morphology)
+        # Morphology, a copy-on-write view that shares the samples that are not modified
+        self.morphology = morphology.create_copy_on_write_view()
 
         # System options
         self.options = copy.deepcopy(options)
@@ -622,6 +622,19 @@ class ConnectedSectionsBuilder:
             A list of all the drawn morphology objects including the soma and arbors.
         """
 
+        return nmv.utilities.run_stages(self.draw_morphology_skeleton_in_stages())
+
+    ################################################################################################
+    # @draw_morphology_skeleton_in_stages
+    ################################################################################################
+    def draw_morphology_skeleton_in_stages(self):
+        """Draws the morphology skeleton stage by stage, see draw_morphology_skeleton(). Yields
+        the progress and the name of every stage before running it.
+
+        :return:
+            The result of draw_morphology_skeleton(), once the generator is exhausted.
+        """
+
         nmv.logger.header('Building Skeleton: ConnectedSectionsBuilder')
 
         # Create a static bevel object that you can use to scale the samples along the arbors
@@ -648,9 +661,11 @@ class ConnectedSectionsBuilder:
             morphology=self.morphology, arbor_style=self.options.morphology.arbor_style)
 
         # Resample the sections of the morphology skeleton
+        yield 0.1, 'Resampling the sections'
         nmv.builders.morphology.resample_skeleton_sections(builder=self)
 
         # Create each arbor as a separate component
+        yield 0.2, 'Drawing the arbors'
         self.create_each_arbor_as_separate_component(bevel_object=bevel_object)
 
         # TODO: Add an option to handle this.
@@ -658,9 +673,11 @@ class ConnectedSectionsBuilder:
         # self.create_all_arbors_as_single_component(bevel_object=bevel_object)
 
         # Draw the soma
+        yield 0.8, 'Drawing the soma'
         nmv.builders.morphology.draw_soma(builder=self)
 
         # Transforming to global coordinates
+        yield 0.9, 'Transforming to the global coordinates'
         nmv.builders.morphology.transform_to_global_coordinates(builder=self)
 
         # Return the list of the drawn morphology objects
@@ -56,8 +56,8 @@ class DendrogramBuilder:
             A given morphology.
         """
 
-        # Morphology
-        self.morphology = copy.deepcopy(morphology)
+        # Morphology, a copy-on-write view that shares the samples that are not modified
+        self.morphology = morphology.create_copy_on_write_view()
 
         # System options
         self.options = copy.deepcopy(options)
@@ -174,12 +174,26 @@ class DendrogramBuilder:
             A list of all the drawn morphology objects including the soma and arbors.
         """
 
+        return nmv.utilities.run_stages(self.draw_morphology_skeleton_in_stages())
+
+    ################################################################################################
+    # @draw_morphology_skeleton_in_stages
+    ################################################################################################
+    def draw_morphology_skeleton_in_stages(self):
+        """Draws the morphology skeleton stage by stage, see draw_morphology_skeleton(). Yields
+        the progress and the name of every stage before running it.
+
+        :return:
+            The result of draw_morphology_skeleton(), once the generator is exhausted.
+        """
+
         nmv.logger.header('Building Dendrogram')
 
         # Create the skeleton materials
         self.create_single_skeleton_materials_list()
 
         # Resample the sections of the morphology skeleton
+        yield 0.1, 'Resampling the sections'
         nmv.builders.morphology.resample_skeleton_sections(builder=self)
 
         # Get the maximum radius to make it easy to compute the deltas
@@ -187,6 +201,7 @@ class DendrogramBuilder:
             morphology=self.morphology).morphology_result
 
         # Compute the dendrogram of the morphology
+        yield 0.2, 'Computing the dendrogram'
         if self.options.morphology.dendrogram_type == nmv.enums.Dendrogram.Type.DETAILED:
             nmv.skeleton.compute_morphology_dendrogram(
                 morphology=self.morphology, delta=maximum_radius * 8)
@@ -235,6 +250,7 @@ class DendrogramBuilder:
             radius=1.0, vertices=self.options.morphology.bevel_object_sides, name='bevel')
 
         # Draw the poly-lines as a single object
+        yield 0.6, 'Drawing the dendrogram'
         morphology_object = nmv.geometry.draw_poly_lines_in_single_object(
             poly_lines=skeleton_poly_lines, object_name=self.morphology.label,
             edges=self.options.morphology.edges, bevel_object=bevel_object,
@@ -32,6 +32,7 @@ import nmv.scene
 import nmv.bmeshi
 import nmv.shading
 import nmv.rendering
+import nmv.utilities
 
 
 ####################################################################################################
@@ -54,8 +55,8 @@ class DisconnectedSectionsBuilder:
             A given morphology.
         """
 
-        # Morphology
-        self.morphology = copy.deepcopy(morphology)
+        # Morphology, a copy-on-write view that shares the samples that are not modified
+        self.morphology = morphology.create_copy_on_write_view()
 
         # System options
         self.options = copy.deepcopy(options)
@@ -494,6 +495,19 @@ class DisconnectedSectionsBuilder:
             A list of all the drawn morphology objects including the soma and arbors.
         """
 
+        return nmv.utilities.run_stages(self.draw_morphology_skeleton_in_stages())
+
+    ################################################################################################
+    # @draw_morphology_skeleton_in_stages
+    ################################################################################################
+    def draw_morphology_skeleton_in_stages(self):
+        """Draws the morphology skeleton stage by stage, see draw_morphology_skeleton(). Yields
+        the progress and the name of every stage before running it.
+
+        :return:
+            The result of draw_morphology_skeleton(), once the generator is exhausted.
+        """
+
         nmv.logger.header('Building skeleton using DisconnectedSectionsBuilder')
 
         nmv.logger.info('Updating radii')
@@ -512,9 +526,11 @@ class DisconnectedSectionsBuilder:
         self.create_single_skeleton_materials_list()
 
         # Resample the sections of the morphology skeleton
+        yield 0.1, 'Resampling the sections'
         nmv.builders.morphology.resample_skeleton_sections(builder=self)
 
         # Draw each arbor as a single object
+        yield 0.2, 'Drawing the arbors'
         self.draw_each_arbor_as_single_object(bevel_object=bevel_object)
 
         # For the articulated sections, draw the spheres
@@ -523,6 +539,7 @@ class DisconnectedSectionsBuilder:
             self.draw_articulations()
 
         # Draw the soma
+        yield 0.8, 'Drawing the soma'
         if self.force_meta_ball:
 
             # In case of reloading morphology
@@ -531,6 +548,7 @@ class DisconnectedSectionsBuilder:
             nmv.builders.morphology.draw_soma(builder=self)
 
         # Transforming to global coordinates
+        yield 0.9, 'Transforming to the global coordinates'
         nmv.builders.morphology.transform_to_global_coordinates(builder=self)
 
         # Return the list of the drawn morphology objects
@@ -32,6 +32,7 @@ import nmv.scene
 import nmv.bmeshi
 import nmv.shading
 import nmv.analysis
+import nmv.utilities
 
 
 ####################################################################################################
@@ -54,8 +55,8 @@ class ProgressiveBuilder:
             A given morphology.
         """
 
-        # Morphology
-        self.morphology = copy.deepcopy(morphology)
+        # Morphology, a copy-on-write view that shares the samples that are not modified
+        self.morphology = morphology.create_copy_on_write_view()
 
         # System options
         self.options = copy.deepcopy(options)
@@ -381,6 +382,19 @@ class ProgressiveBuilder:
             A list of all the drawn morphology objects including the soma and arbors.
         """
 
+        return nmv.utilities.run_stages(self.draw_morphology_skeleton_in_stages())
+
+    ################################################################################################
+    # @draw_morphology_skeleton_in_stages
+    ################################################################################################
+    def draw_morphology_skeleton_in_stages(self):
+        """Draws the morphology skeleton stage by stage, see draw_morphology_skeleton(). Yields
+        the progress and the name of every stage before running it.
+
+        :return:
+            The result of draw_morphology_skeleton(), once the generator is exhausted.
+        """
+
         nmv.logger.header('Building Skeleton: ProgressiveBuilder')
 
         # Create a static bevel object that you can use to scale the samples along the arbors
@@ -399,9 +413,11 @@ class ProgressiveBuilder:
         nmv.skeleton.update_arbors_radii(self.morphology, self.options.morphology)
 
         # Resample the sections of the morphology skeleton
+        yield 0.1, 'Resampling the sections'
         nmv.builders.morphology.resample_skeleton_sections(builder=self)
 
         # The maximum branching order of the morphology
+        yield 0.2, 'Drawing the arbors'
         morphology_maximum_branching_order = \
             nmv.analysis.kernel_maximum_branching_order(self.morphology).morphology_result
 
@@ -441,9 +457,11 @@ class ProgressiveBuilder:
             self.draw_articulations()
 
         # Draw the soma
+        yield 0.8, 'Drawing the soma'
         nmv.builders.morphology.draw_soma(builder=self)
 
         # Transforming to global coordinates
+        yield 0.9, 'Transforming to the global coordinates'
         nmv.builders.morphology.transform_to_global_coordinates(builder=self)
 
         # Return the list of the drawn morphology objects
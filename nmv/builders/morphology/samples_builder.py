@@ -52,8 +52,8 @@ class SamplesBuilder:
             A given morphology.
         """
 
-        # Morphology
-        self.morphology = copy.deepcopy(morphology)
+        # Morphology, a copy-on-write view that shares the samples that are not modified
+        self.morphology = morphology.create_copy_on_write_view()
 
         # System options
         self.options = copy.deepcopy(options)
@@ -297,6 +297,19 @@ class SamplesBuilder:
             A list of all the drawn morphology objects including the soma and arbors.
         """
 
+        return nmv.utilities.run_stages(self.draw_morphology_skeleton_in_stages())
+
+    ################################################################################################
+    # @draw_morphology_skeleton_in_stages
+    ################################################################################################
+    def draw_morphology_skeleton_in_stages(self):
+        """Draws the morphology skeleton stage by stage, see draw_morphology_skeleton(). Yields
+        the progress and the name of every stage before running it.
+
+        :return:
+            The result of draw_morphology_skeleton(), once the generator is exhausted.
+        """
+
         nmv.logger.header('Building Skeleton: SamplesBuilder')
 
         # Create the skeleton materials
@@ -306,9 +319,11 @@ class SamplesBuilder:
         nmv.skeleton.update_arbors_radii(self.morphology, self.options.morphology)
 
         # Resample the sections of the morphology skeleton
+        yield 0.1, 'Resampling the sections'
         nmv.builders.morphology.resample_skeleton_sections(builder=self)
 
         # Apical dendrite
+        yield 0.2, 'Drawing the apical dendrites'
         nmv.logger.info('Constructing spheres')
         if not self.options.morphology.ignore_apical_dendrites:
             if self.morphology.has_apical_dendrites():
@@ -327,6 +342,7 @@ class SamplesBuilder:
                                                 prefix=arbor.label)
 
         # Axon
+        yield 0.4, 'Drawing the axons'
         if not self.options.morphology.ignore_axons:
             if self.morphology.has_axons():
                 for arbor in self.morphology.axons:
@@ -343,6 +359,7 @@ class SamplesBuilder:
                                                 prefix=arbor.label)
 
         # Basal dendrites
+        yield 0.6, 'Drawing the basal dendrites'
         if not self.options.morphology.ignore_basal_dendrites:
             if self.morphology.has_basal_dendrites():
                 for arbor in self.morphology.basal_dendrites:
@@ -359,9 +376,11 @@ class SamplesBuilder:
                                                 materials_list=self.basal_dendrites_materials,
                                                 prefix=arbor.label)
         # Draw the soma
+        yield 0.8, 'Drawing the soma'
         nmv.builders.morphology.draw_soma(builder=self)
 
         # Transforming to global coordinates
+        yield 0.9, 'Transforming to the global coordinates'
         nmv.builders.morphology.transform_to_global_coordinates(builder=self)
 
         # Return the list of the drawn morphology objects
@@ -15,12 +15,10 @@
 # If not, see <http://www.gnu.org/licenses/>.
 ####################################################################################################
 
-# System imports
-import random
-
 # Blender imports
 from mathutils import Vector
 
+import nmv.builders
 import nmv.consts
 import nmv.shading
 import nmv.scene
@@ -54,32 +52,32 @@ class NucleusBuilder:
         # Loaded options from NeuroMorphoVis
         self.options = options
 
-        # A list of all the loaded nuclei
-        self.nuclei_meshes = None
+        # A list of all the nuclei templates, shared from the template library
+        self.nuclei_templates = None
+
+        # The material of the nucleus
+        self.nucleus_material = None
+
+        # The random stream of the builder, seeded from the run seed if given
+        self.random = nmv.utilities.RandomContext(options.mesh.random_seed).get_random('nucleus')
 
     ################################################################################################
     # @load_nuclei_meshes
     ################################################################################################
     def load_nuclei_meshes(self):
-        """Loads all the nuclei meshes from the nuclei directory
+        """Gets all the nuclei templates from the template library, where they are loaded only once
+        per session, and creates the material of the nucleus.
         """
 
-        # Load all the template spines and ignore the verbose messages of loading
-        nmv.utilities.disable_std_output()
-        self.nuclei_meshes = nmv.file.load_nuclei(nmv.consts.Paths.NUCLEI_MESHES_LQ_DIRECTORY)
-        nmv.utilities.enable_std_output()
+        # Get the template nuclei
+        self.nuclei_templates = nmv.builders.get_template_library().get_templates(
+            nmv.consts.Paths.NUCLEI_MESHES_LQ_DIRECTORY)
 
         # Create the material
-        material = nmv.shading.create_material(
+        self.nucleus_material = nmv.shading.create_material(
             name='%nuclei_material', color=self.options.mesh.nucleus_color,
             material_type=self.options.shading.mesh_material)
 
-        # Apply the shader
-        for nucleus_object in self.nuclei_meshes:
-
-            # Apply the shader to each spine mesh
-            nmv.shading.set_material_to_object(nucleus_object, material)
-
     ################################################################################################
     # @add_nucleus_inside_soma
     ################################################################################################
@@ -97,27 +95,25 @@ class NucleusBuilder:
         nmv.logger.info('Integrating nucleus')
 
         # Select a random nucleus from the nuclei list
-        nucleus_template = random.choice(self.nuclei_meshes)
+        nucleus_template = self.random.choice(self.nuclei_templates)
 
         # Get a copy of the template and update it
-        nucleus_object = nmv.scene.ops.duplicate_object(nucleus_template, index)
+        nucleus_object = nucleus_template.create_instance(
+            '%s_nucleus' % self.options.morphology.label)
 
-        # Rename the nucleus
-        nucleus_object.name = '%s_nucleus' % self.options.morphology.label
+        # Apply the shader
+        nmv.shading.set_material_to_object(nucleus_object, self.nucleus_material)
 
         # Scale the nucleus
-        nucleus_scale = random.uniform(0.5, 0.75) * self.morphology.soma.mean_radius
+        nucleus_scale = self.random.uniform(0.5, 0.75) * self.morphology.soma.mean_radius
         nmv.scene.ops.scale_object_uniformly(nucleus_object, nucleus_scale)
 
         # Translate the spine to soma place in the soma
-        nucleus_position = self.morphology.soma.centroid + Vector((random.uniform(-1.0, 1.0),
-                                                                   random.uniform(-1.0, 1.0),
-                                                                   random.uniform(-1.0, 1.0)))
+        nucleus_position = self.morphology.soma.centroid + Vector((self.random.uniform(-1.0, 1.0),
+                                                                   self.random.uniform(-1.0, 1.0),
+                                                                   self.random.uniform(-1.0, 1.0)))
         nmv.scene.ops.set_object_location(nucleus_object, nucleus_position)
 
-        # Delete the template spines
-        nmv.scene.ops.delete_list_objects(self.nuclei_meshes)
-
         # Return the spines objects list
         return nucleus_object
 
@@ -16,7 +16,6 @@
 ####################################################################################################
 
 # System imports
-import random
 import copy
 
 # Blender imports
@@ -27,6 +26,7 @@ import nmv.bmeshi
 import nmv.consts
 import nmv.enums
 import nmv.mesh
+import nmv.geometry
 import nmv.physics
 import nmv.scene
 import nmv.shading
@@ -204,12 +204,11 @@ class SomaHybridBuilder:
         # Decimation
         nmv.mesh.decimate_mesh_object(mesh_object=self.meta_mesh, decimation_ratio=0.5)
 
-        # Adding perturbations
-        for i in range(len(self.meta_mesh.data.vertices)):
-            vertex = self.meta_mesh.data.vertices[i]
-            vertex.select = True
-            vertex.co = vertex.co + (vertex.normal * random.uniform(-delta / 2.0, delta / 2.0))
-            vertex.select = False
+        # Adding perturbations to all the vertices at once
+        nmv.mesh.add_coherent_noise_to_mesh(
+            mesh_object=self.meta_mesh, amplitude=delta / 2.0,
+            seed=nmv.utilities.RandomContext(self.options.mesh.random_seed).get_stream_seed(
+                'soma_noise', default=nmv.consts.Meshing.SURFACE_NOISE_SEED))
 
         # Smoothing
         nmv.mesh.smooth_object(mesh_object=self.meta_mesh, level=2)
@@ -378,18 +377,13 @@ class SomaHybridBuilder:
         soft_body_soma = soft_body_soma_builder.reconstruct_soma_mesh(
             apply_shader=False, add_noise_to_surface=False)
 
-        # Run the particles simulation re-mesher
-        particle_remeshes = nmv.physics.ParticleRemesher()
-        stepper = particle_remeshes.run(mesh_object=soft_body_soma,
-                                        context=bpy.context, interactive=True)
-
-        # Iterate
-        for i in range(1000000):
-            finished = next(stepper)
-
-            # If the finished state was over, go ahead and break
-            if finished:
-                break
+        # Run the particles simulation re-mesher within the time budget of the soma
+        particle_remeshes = nmv.physics.ParticleRemesher(
+            random_seed=self.options.mesh.random_seed)
+        remeshing_statistics = particle_remeshes.run_batch(
+            mesh_object=soft_body_soma, context=bpy.context,
+            time_budget=self.options.soma.remeshing_time_budget)
+        nmv.logger.info(remeshing_statistics.get_report())
 
         # Remove the faces that are located around the initial segment
         valid_arbors = soft_body_soma_builder.remove_faces_within_arbor_initial_segment(
@@ -403,25 +397,20 @@ class SomaHybridBuilder:
             meta_element.radius = arbor.samples[0].radius * self.magic_scale_factor * 1.0
             meta_element.co = arbor.samples[0].point
 
-        # Build the soma profile from the soft-body mesh
-        for i, face in enumerate(soft_body_soma.data.polygons):
-
-            # Add a new meta element
-            meta_element = self.meta_skeleton.elements.new()
-
-            # Compute the largest radius in the triangle, but since we re-mesh the soma, we will
-            # get almost equi-sides faces
-            radius = nmv.mesh.get_largest_radius_in_face(
-                mesh_object=soft_body_soma, face_index=face.index)
-
-            # Compute the radius of the meta-element by trial-and-error
-            meta_element.radius = radius * 2 * self.magic_scale_factor
+        # Compute the largest radius in all the triangles at once, but since we re-mesh the soma,
+        # we will get almost equi-sides faces
+        centers, normals, radii = nmv.mesh.get_largest_radii_of_faces(mesh_object=soft_body_soma)
 
-            if meta_element.radius < self.smallest_radius:
-                self.smallest_radius = meta_element.radius
+        # Compute the radii of the meta-elements by trial-and-error
+        meta_radii = radii * 2 * self.magic_scale_factor
+        if len(meta_radii) > 0:
+            self.smallest_radius = min(self.smallest_radius, float(meta_radii.min()))
 
-            # Update its coordinates
-            meta_element.co = face.center - (face.normal * radius * self.soma_scaling_factor)
+        # Build the soma profile from the soft-body mesh in bulk
+        nmv.geometry.add_meta_elements_in_bulk(
+            meta_skeleton=self.meta_skeleton,
+            locations=centers - normals * (radii * self.soma_scaling_factor)[:, None],
+            radii=meta_radii)
 
         # Delete the mesh
         nmv.scene.delete_object_in_scene(scene_object=soft_body_soma)
@@ -447,25 +436,50 @@ class SomaHybridBuilder:
             A reference to the reconstructed mesh of the soma.
         """
 
+        return nmv.utilities.run_stages(self.reconstruct_soma_mesh_in_stages(
+            apply_shader=apply_shader, add_noise_to_surface=add_noise_to_surface))
+
+    ################################################################################################
+    # @reconstruct_soma_mesh_in_stages
+    ################################################################################################
+    def reconstruct_soma_mesh_in_stages(self,
+                                        apply_shader=True,
+                                        add_noise_to_surface=False):
+        """Reconstructs the mesh of the soma stage by stage, see reconstruct_soma_mesh(). Yields
+        the progress and the name of every stage before running it.
+
+        :param apply_shader:
+            Apply the given soma shader in the configuration.
+        :param add_noise_to_surface:
+            Adds noise to the surface of the soma.
+        :return:
+            A reference to the reconstructed mesh of the soma, once the generator is exhausted.
+        """
+
         # Header
         nmv.logger.header('Soma reconstruction with MetaBalls')
 
         # Initialize the MetaObject before emanating towards the branches
+        yield 0.0, 'Initializing the meta object'
         self.initialize_meta_object(name=nmv.consts.Skeleton.SOMA_PREFIX)
 
         # Emanate the basic sphere towards the branches
+        yield 0.1, 'Emanating the soma towards the branches'
         valid_arbors = self.build_soma_from_soft_body_mesh()
 
         # Update the meta object and convert it to a mesh
+        yield 0.5, 'Finalizing the meta object'
         self.finalize_meta_object(name=nmv.consts.Skeleton.SOMA_PREFIX)
 
         # Remove the internal partition
+        yield 0.7, 'Smoothing the soma'
         nmv.mesh.remove_small_partitions(mesh_object=self.meta_mesh)
 
         # Smooth the mesh surface, the level (13) was obtained by trial and error
         nmv.mesh.smooth_object_vertices(mesh_object=self.meta_mesh, level=15)
 
         # Assign the material to the reconstructed mesh
+        yield 0.9, 'Shading the soma'
         if apply_shader:
             self.assign_material_to_mesh()
 
@@ -16,7 +16,6 @@
 ####################################################################################################
 
 # System imports
-import random
 import copy
 
 # Blender imports
@@ -152,21 +151,16 @@ class SomaMetaBuilder:
         # Set the mesh to be the active one
         nmv.scene.set_active_object(self.meta_mesh)
 
-        # Decimate the mesh to remove any bumpy artifacts based on the meta resolution
-        if 0.0 < self.meta_skeleton.resolution < 0.1:
-            iterations = 4
-        elif 0.1 < self.meta_skeleton.resolution < 0.2:
-            iterations = 3
-        elif 0.2 < self.meta_skeleton.resolution < 0.3:
-            iterations = 2
-        elif 0.3 < self.meta_skeleton.resolution < 0.5:
-            iterations = 1
-        else:
-            iterations = 0
-
-        # Apply the decimation operation
-        for i in range(iterations):
-            nmv.mesh.decimate_mesh_object(mesh_object=self.meta_mesh, decimation_ratio=0.25)
+        # Decimate the fine meta resolutions in a single pass to remove any bumpy artifacts, while
+        # keeping the geometric error bounded and the arbor connections untouched
+        if 0.0 < self.meta_skeleton.resolution < 0.5:
+            statistics = nmv.mesh.decimate_mesh_object_to_target(
+                mesh_object=self.meta_mesh,
+                max_error=self.morphology.soma.mean_radius *
+                          nmv.consts.MetaBall.SOMA_DECIMATION_RELATIVE_ERROR,
+                protected_extents=nmv.skeleton.ops.get_soma_to_root_sections_connection_extent(
+                    self.morphology))
+            nmv.logger.detail(statistics.get_report())
 
     ################################################################################################
     # @assign_material_to_mesh
@@ -212,12 +206,11 @@ class SomaMetaBuilder:
         # Decimation
         nmv.mesh.decimate_mesh_object(mesh_object=self.meta_mesh, decimation_ratio=0.5)
 
-        # Adding perturbations
-        for i in range(len(self.meta_mesh.data.vertices)):
-            vertex = self.meta_mesh.data.vertices[i]
-            vertex.select = True
-            vertex.co = vertex.co + (vertex.normal * random.uniform(-delta / 2.0, delta / 2.0))
-            vertex.select = False
+        # Adding perturbations to all the vertices at once
+        nmv.mesh.add_coherent_noise_to_mesh(
+            mesh_object=self.meta_mesh, amplitude=delta / 2.0,
+            seed=nmv.utilities.RandomContext(self.options.mesh.random_seed).get_stream_seed(
+                'soma_noise', default=nmv.consts.Meshing.SURFACE_NOISE_SEED))
 
         # Smoothing
         nmv.mesh.smooth_object(mesh_object=self.meta_mesh, level=2)
@@ -388,19 +381,43 @@ class SomaMetaBuilder:
             A reference to the reconstructed mesh of the soma.
         """
 
+        return nmv.utilities.run_stages(self.reconstruct_soma_mesh_in_stages(
+            apply_shader=apply_shader, add_noise_to_surface=add_noise_to_surface))
+
+    ################################################################################################
+    # @reconstruct_soma_mesh_in_stages
+    ################################################################################################
+    def reconstruct_soma_mesh_in_stages(self,
+                                        apply_shader=True,
+                                        add_noise_to_surface=False):
+        """Reconstructs the mesh of the soma stage by stage, see reconstruct_soma_mesh(). Yields
+        the progress and the name of every stage before running it.
+
+        :param apply_shader:
+            Apply the given soma shader in the configuration.
+        :param add_noise_to_surface:
+            Adds noise to the surface of the soma.
+        :return:
+            A reference to the reconstructed mesh of the soma, once the generator is exhausted.
+        """
+
         # Header
         nmv.logger.header('Soma reconstruction with MetaBalls')
 
         # Initialize the MetaObject before emanating towards the branches
+        yield 0.0, 'Initializing the meta object'
         self.initialize_meta_object(name=nmv.consts.Skeleton.SOMA_PREFIX)
 
         # Emanate the basic sphere towards the branches
+        yield 0.1, 'Emanating the soma towards the branches'
         self.emanate_towards_the_branches()
 
         # Update the meta object and convert it to a mesh
+        yield 0.5, 'Finalizing the meta object'
         self.finalize_meta_object(name=nmv.consts.Skeleton.SOMA_PREFIX)
 
         # Assign the material to the reconstructed mesh
+        yield 0.9, 'Shading the soma'
         if apply_shader:
             self.assign_material_to_mesh()
 
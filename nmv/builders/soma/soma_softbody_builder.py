@@ -16,9 +16,8 @@
 ####################################################################################################
 
 # System imports
-import random
 import math
-import copy
+import numpy
 
 # Blender imports
 import bpy
@@ -59,8 +58,8 @@ class SomaSoftBodyBuilder:
             System options.
         """
 
-        # Morphology
-        self.morphology = copy.deepcopy(morphology)
+        # Morphology, a copy-on-write view that shares the samples that are not modified
+        self.morphology = morphology.create_copy_on_write_view()
 
         # All the options of the project (an instance of NeuroMorphoVisOptions)
         self.options = options
@@ -99,15 +98,11 @@ class SomaSoftBodyBuilder:
         connection_extents = nmv.skeleton.ops.get_soma_to_root_sections_connection_extent(
             self.morphology)
 
-        for i in range(len(soma_mesh.data.vertices)):
-            vertex = soma_mesh.data.vertices[i]
-
-            if nmv.skeleton.ops.is_point_located_within_extents(vertex.co, connection_extents):
-                continue
-
-            vertex.select = True
-            vertex.co = vertex.co + (vertex.normal * random.uniform(-delta / 2.0, delta / 2.0))
-            vertex.select = False
+        # Displace all the vertices outside the connection extents at once
+        nmv.mesh.add_coherent_noise_to_mesh(
+            mesh_object=soma_mesh, amplitude=delta / 2.0, excluded_extents=connection_extents,
+            seed=nmv.utilities.RandomContext(self.options.mesh.random_seed).get_stream_seed(
+                'soma_noise', default=nmv.consts.Meshing.SURFACE_NOISE_SEED))
 
     ################################################################################################
     # @get_extrusion_scale
@@ -337,9 +332,8 @@ class SomaSoftBodyBuilder:
         # Create a hook list to be able to delete all the hooks after finishing the simulation
         self.hooks_list = list()
 
-        for i, face_centroid in enumerate(faces_centers):
-            self.attach_hook_to_extrusion_face_on_profile_point(
-                soma_sphere_mesh, valid_profile_points[i], i)
+        # Attach the hooks to the profile points
+        self.attach_hooks_in_bulk(soma_sphere_mesh, list(), valid_profile_points)
 
         # Set the time-line to zero
         bpy.context.scene.frame_set(0)
@@ -563,6 +557,120 @@ class SomaSoftBodyBuilder:
         # Make a subdivision for extra processing, if the topology is not required to be preserved
         nmv.bmeshi.ops.subdivide_faces(soma_bmesh_sphere, faces_indices, cuts=2)
 
+    ################################################################################################
+    # @subdivide_at_extrusion_points
+    ################################################################################################
+    def subdivide_at_extrusion_points(self,
+                                      soma_bmesh_sphere,
+                                      arbors):
+        """Makes the initial subdivision of the soma sphere at the extrusion points of all the
+        given arbors at once. The faces of all the extrusion regions are found with a single query
+        and subdivided with a single operation.
+
+        :param soma_bmesh_sphere:
+            The initial sphere that represents the soma.
+        :param arbors:
+            A list of arbors.
+        """
+
+        # Compute the connection point and the extrusion radius of every arbor
+        connection_points = list()
+        extrusion_radii = list()
+        for arbor in arbors:
+
+            # The connection point of the arbor on the soma sphere
+            connection_direction = \
+                (arbor.samples[0].point - self.morphology.soma.centroid).normalized()
+            connection_points.append(
+                self.morphology.soma.centroid + connection_direction * self.initial_soma_radius)
+
+            # The extrusion radius that will be applied on the soma sphere
+            distance_to_soma = (arbor.samples[0].point - self.morphology.soma.centroid).length
+            extrusion_radii.append(
+                arbor.samples[0].radius * self.initial_soma_radius / distance_to_soma)
+
+        # Get the faces that intersect any of the extrusion spheres
+        faces_indices = nmv.bmeshi.ops.get_indices_of_faces_intersecting_spheres(
+            soma_bmesh_sphere, connection_points, extrusion_radii)
+
+        # Subdivide all the faces at once
+        if len(faces_indices) > 0:
+            nmv.bmeshi.ops.subdivide_faces(soma_bmesh_sphere, faces_indices, cuts=2)
+
+    ################################################################################################
+    # @attach_hooks_in_bulk
+    ################################################################################################
+    def attach_hooks_in_bulk(self,
+                             soma_sphere_object,
+                             roots_and_faces_centroids,
+                             profile_points):
+        """Attaches all the hooks of the arbors and the profile points to the soma sphere at once.
+
+        The extrusion faces are found with a single nearest-face query, their vertices are added
+        to the vertex group in a single call and the hooks and their keyframes are created in bulk.
+
+        :param soma_sphere_object:
+            The soma sphere object, linked to the scene.
+        :param roots_and_faces_centroids:
+            A list of [arbor, extrusion face centroid] pairs.
+        :param profile_points:
+            A list of valid profile points.
+        :return:
+            A list of the indices of the extrusion faces of the arbors.
+        """
+
+        # Query the nearest faces to the extrusion face centroids and the profile points at once
+        query_points = [item[1] for item in roots_and_faces_centroids] + list(profile_points)
+        faces_indices, faces_centers, faces_vertices_indices = \
+            nmv.mesh.ops.get_nearest_faces_to_points(soma_sphere_object, query_points)
+
+        # Nothing to attach
+        if len(faces_indices) == 0:
+            return list()
+
+        # Add all the vertices to the existing vertex group at once
+        self.vertex_group.add(
+            sorted(set(index for indices in faces_vertices_indices for index in indices)),
+            1.0, 'ADD')
+
+        # The hooks are stretched from the center of the face to the arbor initial segment point
+        # or to the profile point
+        start_points = faces_centers + faces_centers / numpy.maximum(
+            numpy.linalg.norm(faces_centers, axis=1), 1e-10)[:, None] * 0.01
+        end_points = numpy.array([item[0].samples[0].point[:]
+                                  for item in roots_and_faces_centroids] +
+                                 [point[:] for point in profile_points], dtype=numpy.float64)
+
+        # Start with a little bit of offset for bridging the arbors with the soma directly
+        number_arbors = len(roots_and_faces_centroids)
+        if self.options.mesh.soma_connection == nmv.enums.Meshing.SomaConnection.CONNECTED:
+            arbors_end_points = end_points[:number_arbors]
+            end_points[:number_arbors] = arbors_end_points - arbors_end_points / numpy.maximum(
+                numpy.linalg.norm(arbors_end_points, axis=1), 1e-10)[:, None] * \
+                nmv.consts.Skeleton.SOMA_EXTRUSION_DELTA
+
+        # Create all the hooks
+        names = ['hook_%d' % item[0].index for item in roots_and_faces_centroids] + \
+                ['hook_%d' % i for i in range(len(profile_points))]
+        hooks = nmv.physics.hook.ops.add_hooks_to_vertices_in_bulk(
+            soma_sphere_object, faces_vertices_indices, names)
+        self.hooks_list.extend(hooks)
+
+        # Locate all the hooks at the keyframes 1 and 50
+        nmv.physics.hook.ops.set_hooks_keyframes_in_bulk(
+            hooks, 'location', [1, 50], numpy.stack((start_points, end_points), axis=1))
+
+        # The hooks of the arbors are scaled between 50 and 60
+        if number_arbors > 0:
+            scales = numpy.ones((number_arbors, 3, 3))
+            scales[:, 2, :] = numpy.array([self.get_branch_extrusion_scale(item[0])
+                                           for item in roots_and_faces_centroids])[:, None]
+            nmv.physics.hook.ops.set_hooks_keyframes_in_bulk(
+                hooks[:number_arbors], 'scale', [1, 50, 60], scales)
+
+        # Return the indices of the extrusion faces of the arbors
+        return faces_indices[:number_arbors].tolist()
+
     ################################################################################################
     # @build_soma_soft_body
     ################################################################################################
@@ -596,9 +704,8 @@ class SomaSoftBodyBuilder:
             radius=self.initial_soma_radius, location=self.morphology.soma.centroid,
             subdivisions=self.options.soma.subdivision_level)
 
-        # subdivide the extrusion faces around the valid arbors
-        for arbor in self.valid_arbors:
-            self.subdivide_at_extrusion_point(soma_bmesh_sphere, arbor)
+        # Subdivide the extrusion faces around the valid arbors
+        self.subdivide_at_extrusion_points(soma_bmesh_sphere, self.valid_arbors)
 
         # Keep a list of all the extrusion face centroids, for later
         roots_and_faces_centroids = []
@@ -761,48 +868,9 @@ class SomaSoftBodyBuilder:
         # Create a hooks list to be able to delete all the hooks after finishing the simulation
         self.hooks_list = list()
 
-        # Create a list to keep track on the indices of the vertices of the extruded faces
-        extrusion_faces_vertices_indices = list()
-
-        # Create a list to keep track on the indices of the extruded faces
-        faces_indices = list()
-
-        # Attach the hooks to the faces that correspond to the branches
-        for root_and_face_center in roots_and_faces_centroids:
-
-            # Get the arbor
-            arbor = root_and_face_center[0]
-
-            # Get the center of the face
-            face_centroid = root_and_face_center[1]
-
-            # Get the indices of the faces
-            face_index = nmv.mesh.ops.get_index_of_nearest_face_to_point(
-                soma_sphere_object, face_centroid)
-
-            # Get a reference to the face
-            face = soma_sphere_object.data.polygons[face_index]
-
-            # Get a list of the indices of the vertices of the face
-            vertices_indices = face.vertices[:]
-
-            # Append to the list
-            extrusion_faces_vertices_indices.extend(vertices_indices)
-
-            # Get the extrusion scale
-            extrusion_scale = self.get_branch_extrusion_scale(arbor)
-
-            # Attach hook to an extrusion face
-            face_index = self.attach_hook_to_extrusion_face(
-                soma_sphere_object, arbor, face_centroid, extrusion_scale)
-
-            # Append the face index to the list
-            faces_indices.append(face_index)
-
-        for i, profile_point in enumerate(valid_profile_points):
-            # Attach hook to the profile point
-            self.attach_hook_to_extrusion_face_on_profile_point(
-                soma_sphere_object, profile_point, i)
+        # Attach the hooks to the faces that correspond to the branches and the profile points
+        self.attach_hooks_in_bulk(
+            soma_sphere_object, roots_and_faces_centroids, valid_profile_points)
 
         # Set the time-line to zero
         bpy.context.scene.frame_set(0)
@@ -863,6 +931,30 @@ class SomaSoftBodyBuilder:
         # Return the reconstructed soma object
         return soma_mesh
 
+    ################################################################################################
+    # @simulate_soft_body_in_stages
+    ################################################################################################
+    def simulate_soft_body_in_stages(self):
+        """Runs the soft body simulation of the soma, a frame per stage. Yields the progress of the
+        simulation before every frame.
+        """
+
+        # Update the frame based on the soft body simulation
+        for frame_index in range(0, self.options.soma.simulation_steps):
+            yield float(frame_index) / self.options.soma.simulation_steps, 'Soft body simulation'
+
+            # Set the frame index
+            bpy.context.scene.frame_set(frame_index)
+
+            # Update the progress shell
+            nmv.utilities.show_progress(
+                '* Simulation ', frame_index, self.options.soma.simulation_steps)
+
+        # Report process done
+        nmv.utilities.show_progress(
+            '* Simulation ', self.options.soma.simulation_steps, self.options.soma.simulation_steps,
+            done=True)
+
     ################################################################################################
     # @reconstruct_soma_mesh
     ################################################################################################
@@ -881,25 +973,35 @@ class SomaSoftBodyBuilder:
             A reference to the reconstructed mesh of the soma.
         """
 
-        # Build the soft body of the soma
-        soma_soft_body = self.build_soma_soft_body(apply_shader=apply_shader)
+        return nmv.utilities.run_stages(self.reconstruct_soma_mesh_in_stages(
+            apply_shader=apply_shader, add_noise_to_surface=add_noise_to_surface))
 
-        # Update the frame based on the soft body simulation
-        for frame_index in range(0, self.options.soma.simulation_steps):
+    ################################################################################################
+    # @reconstruct_soma_mesh_in_stages
+    ################################################################################################
+    def reconstruct_soma_mesh_in_stages(self,
+                                        apply_shader=True,
+                                        add_noise_to_surface=True):
+        """Reconstructs the mesh of the soma stage by stage, see reconstruct_soma_mesh(). Yields
+        the progress and the name of every stage before running it.
 
-            # Set the frame index
-            bpy.context.scene.frame_set(frame_index)
+        :param apply_shader:
+            Apply the given soma shader in the configuration.
+        :param add_noise_to_surface:
+            Adds noise to the surface of the soma.
+        :return:
+            A reference to the reconstructed mesh of the soma, once the generator is exhausted.
+        """
 
-            # Update the progress shell
-            nmv.utilities.show_progress(
-                '* Simulation ', frame_index, self.options.soma.simulation_steps)
+        # Build the soft body of the soma
+        yield 0.0, 'Building the soft body of the soma'
+        soma_soft_body = self.build_soma_soft_body(apply_shader=apply_shader)
 
-        # Report process done
-        nmv.utilities.show_progress(
-            '* Simulation ', self.options.soma.simulation_steps, self.options.soma.simulation_steps,
-            done=True)
+        # Run the simulation
+        yield from nmv.utilities.scale_stages(self.simulate_soft_body_in_stages(), 0.1, 0.9)
 
         # Build the soma mesh from the soft body object after deformation
+        yield 0.9, 'Building the soma mesh from the soft body'
         reconstructed_soma_mesh = self.build_soma_mesh_from_soft_body_object(soma_soft_body)
 
         # Add noise to the soma surface to make it more realistic
@@ -16,14 +16,12 @@
 # MA 02110-1301 USA.
 ####################################################################################################
 
-# System imports
-import random
-
 # Blender imports
 import bpy
 from mathutils import Vector
 
 # Internal imports
+import nmv.builders
 import nmv.consts
 import nmv.mesh
 import nmv.shading
@@ -60,38 +58,41 @@ class CircuitSpineBuilder:
         # Loaded options from NeuroMorphoVis
         self.options = options
 
-        # A list containing all the spines meshes
-        self.spine_meshes = None
+        # A list containing all the spines templates, shared from the template library
+        self.spine_templates = None
+
+        # Protrusion template
+        self.protrusion_template = None
+
+        # The material of the spines and the protrusions
+        self.spine_material = None
 
-        # Protrusion mesh
-        self.protrusion_mesh = None
+        # The random stream of the builder, seeded from the run seed if given
+        self.random = nmv.utilities.RandomContext(
+            options.mesh.random_seed).get_random('circuit_spines')
 
     ################################################################################################
     # @load_spine_meshes
     ################################################################################################
     def load_spine_meshes(self):
-        """Loads all the spine meshes from the spines directory
+        """Gets all the spine templates from the template library, where they are loaded only once
+        per session, and creates the material of the spines.
         """
 
-        # Load all the template spines and ignore the verbose messages of loading
-        nmv.utilities.disable_std_output()
-        self.spine_meshes = nmv.file.load_spines(nmv.consts.Paths.SPINES_MESHES_LQ_DIRECTORY)
-        nmv.utilities.enable_std_output()
+        # Get the template spines
+        template_library = nmv.builders.get_template_library()
+        self.spine_templates = template_library.get_templates(
+            nmv.consts.Paths.SPINES_MESHES_LQ_DIRECTORY)
 
-        self.protrusion_mesh = \
-            nmv.file.import_obj_file(nmv.consts.Paths.SPINES_MESHES_LQ_DIRECTORY, 'tip.obj')
+        # Get the protrusion template
+        self.protrusion_template = template_library.get_template(
+            nmv.consts.Paths.SPINES_MESHES_LQ_DIRECTORY, 'tip')
 
         # Create the material
-        material = nmv.shading.create_material(
+        self.spine_material = nmv.shading.create_material(
             name='%spine_material', color=self.options.shading.mesh_spines_color,
             material_type=self.options.shading.mesh_material)
 
-        # Apply the shader
-        for spine_object in self.spine_meshes:
-            nmv.shading.set_material_to_object(spine_object, material)
-
-        nmv.shading.set_material_to_object(self.protrusion_mesh, material)
-
     ################################################################################################
     # @emanate_protrusion
     ################################################################################################
@@ -109,9 +110,11 @@ class CircuitSpineBuilder:
         """
 
         # Get a protrusion object
-        protrusion_object = nmv.scene.ops.duplicate_object(self.protrusion_mesh,
-                                                           'protrusion_%d' % index,
-                                                           link_to_scene=False)
+        protrusion_object = self.protrusion_template.create_instance(
+            'protrusion_%d' % index, link_to_scene=False)
+
+        # Apply the shader
+        nmv.shading.set_material_to_object(protrusion_object, self.spine_material)
 
         # Scale the object based on the radius of the branch
         nmv.scene.ops.scale_object_uniformly(protrusion_object, spine.post_synaptic_radius)
@@ -143,10 +146,13 @@ class CircuitSpineBuilder:
         """
 
         # Select a random spine from the spines list
-        spine_template = random.choice(self.spine_meshes)
+        spine_template = self.random.choice(self.spine_templates)
 
         # Get a copy of the template and update it
-        spine_object = nmv.scene.ops.duplicate_object(spine_template, index, link_to_scene=False)
+        spine_object = spine_template.create_instance(index, link_to_scene=False)
+
+        # Apply the shader
+        nmv.shading.set_material_to_object(spine_object, self.spine_material)
 
         # Compute the spine extent
         # spine_extent = (spine.post_synaptic_position - spine.pre_synaptic_position).length
@@ -302,8 +308,5 @@ class CircuitSpineBuilder:
         building_timer.end()
         nmv.logger.info('Spines: [%f] seconds' % building_timer.duration())
 
-        # Delete the template spines
-        nmv.scene.ops.delete_list_objects(self.spine_meshes)
-
         # Return the spines objects list
         return spines_mesh
@@ -16,13 +16,11 @@
 # MA 02110-1301 USA.
 ####################################################################################################
 
-# System imports
-import random
-
 # Blender imports
 import bpy
 from mathutils import Vector
 
+import nmv.builders
 import nmv.consts
 import nmv.shading
 import nmv.skeleton
@@ -57,8 +55,15 @@ class RandomSpineBuilder:
         # Loaded options from NeuroMorphoVis
         self.options = options
 
-        # A list containing all the spines meshes
-        self.spine_meshes = None
+        # A list containing all the spines templates, shared from the template library
+        self.spine_templates = None
+
+        # The material of the spines
+        self.spine_material = None
+
+        # The random stream of the builder, seeded from the run seed if given
+        self.random = nmv.utilities.RandomContext(
+            options.mesh.random_seed).get_random('random_spines')
 
     ################################################################################################
     # @load_spine_meshes
@@ -83,13 +88,14 @@ class RandomSpineBuilder:
 
 
         # Select a random spine from the spines list
-        spine_template = random.choice(self.spine_meshes)
+        spine_template = self.random.choice(self.spine_templates)
 
         # Get a copy of the template and update it
-        spine_object = nmv.scene.ops.duplicate_object(spine_template, index)
+        spine_object = spine_template.create_instance(
+            '%s_spine_%d' % (self.options.morphology.label, index))
 
-        # Rename the spine
-        spine_object.name = '%s_spine_%d' % (self.options.morphology.label, index)
+        # Apply the shader
+        nmv.shading.set_material_to_object(spine_object, self.spine_material)
 
         # Scale the spine
         spine_scale = spine.size
@@ -110,26 +116,19 @@ class RandomSpineBuilder:
     # @load_spine_meshes
     ################################################################################################
     def load_spine_meshes(self):
-        """Loads all the spine meshes from the spines directory
-
-        :return:
+        """Gets all the spine templates from the template library, where they are loaded only once
+        per session, and creates the material of the spines.
         """
-        # Load all the template spines and ignore the verbose messages of loading
-        nmv.utilities.disable_std_output()
-        self.spine_meshes = nmv.file.load_spines(nmv.consts.Paths.SPINES_MESHES_LQ_DIRECTORY)
-        nmv.utilities.enable_std_output()
+
+        # Get the template spines
+        self.spine_templates = nmv.builders.get_template_library().get_templates(
+            nmv.consts.Paths.SPINES_MESHES_LQ_DIRECTORY)
 
         # Create the material
-        material = nmv.shading.create_material(
+        self.spine_material = nmv.shading.create_material(
             name='%spine_material', color=self.options.shading.mesh_spines_color,
             material_type=self.options.shading.mesh_material)
 
-        # Apply the shader
-        for spine_object in self.spine_meshes:
-
-            # Apply the shader to each spine mesh
-            nmv.shading.set_material_to_object(spine_object, material)
-
     ################################################################################################
     # @emanate_spine
     ################################################################################################
@@ -147,16 +146,17 @@ class RandomSpineBuilder:
         """
 
         # Select a random spine from the spines list
-        spine_template = random.choice(self.spine_meshes)
+        spine_template = self.random.choice(self.spine_templates)
 
         # Get a copy of the template and update it
-        spine_object = nmv.scene.ops.duplicate_object(spine_template, index)
+        spine_object = spine_template.create_instance(
+            '%s_spine_%d' % (self.options.morphology.label, index))
 
-        # Rename the spine
-        spine_object.name = '%s_spine_%d' % (self.options.morphology.label, index)
+        # Apply the shader
+        nmv.shading.set_material_to_object(spine_object, self.spine_material)
 
         # Scale the spine
-        spine_scale = spine.size * random.uniform(1.25, 1.5)
+        spine_scale = spine.size * self.random.uniform(1.25, 1.5)
         nmv.scene.ops.scale_object_uniformly(spine_object, spine_scale)
 
         # Translate the spine to the post synaptic position
@@ -165,7 +165,7 @@ class RandomSpineBuilder:
         # Rotate the spine towards the pre-synaptic point
         nmv.scene.ops.rotate_object_towards_target(
             spine_object, Vector((0, 0, -1)),
-            spine.pre_synaptic_position * (1 if random.random() < 0.5 else -1))
+            spine.pre_synaptic_position * (1 if self.random.random() < 0.5 else -1))
 
         # Adjust the shading
         nmv.shading.adjust_material_uv(spine_object, 5)
@@ -195,7 +195,8 @@ class RandomSpineBuilder:
               self.options.morphology.apical_dendrite_branch_order,
               nmv.skeleton.ops.get_random_spines_on_section,
               self.options.mesh.number_spines_per_micron,
-              spines_list])
+              spines_list,
+              self.random])
 
         # Keep a list of all the spines objects
         spines_objects = []
@@ -228,8 +229,5 @@ class RandomSpineBuilder:
         building_timer.end()
         nmv.logger.info('Spines: [%f] seconds' % building_timer.duration())
 
-        # Delete the template spines
-        nmv.scene.ops.delete_list_objects(self.spine_meshes)
-
         # Return the spines objects list
         return spines_objects
@@ -17,7 +17,6 @@
 ####################################################################################################
 
 # System imports
-import random
 import copy
 
 # Blender imports
@@ -67,6 +66,10 @@ class RandomSpineBuilderFromMorphology:
         # A list of all the templates that we can use to build the morphology
         self.spine_template_structures = list()
 
+        # The random stream of the builder, seeded from the run seed if given
+        self.random = nmv.utilities.RandomContext(
+            options.mesh.random_seed).get_random('morphology_spines')
+
         # Construct a bevel object that will be used to build the spines
         self.bevel_object = nmv.mesh.create_bezier_circle(radius=1.0,
                                                           vertices=8,
@@ -127,7 +130,8 @@ class RandomSpineBuilderFromMorphology:
               number_spines_per_micron,
               max_branching_order,
               spine_morphologies,
-              True])
+              True,
+              self.random])
 
         # Return a list of spine morphologies (samples and radii) that can be used to draw
         # the spine in the scene at the respective locations
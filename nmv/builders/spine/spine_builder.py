@@ -26,6 +26,7 @@ from mathutils import Matrix
 
 # Internal imports
 import nmv
+import nmv.builders
 import nmv.consts
 import nmv.file
 import nmv.mesh
@@ -93,18 +94,21 @@ def load_spines(spines_directory):
 def emanate_a_spine(spines_list,
                     post_synaptic_position,
                     pre_synaptic_position,
-                    identifier):
+                    identifier,
+                    random_generator=random):
     """Emanate a spine at the specified position and towards the direction given by the pre and post
     synaptic positions.
 
     :param spines_list:
-        A list of all the loaded spines
+        A list of the spine templates from the template library.
     :param post_synaptic_position:
         The post-synaptic position of the spine.
     :param pre_synaptic_position:
         The pre-synaptic position of the spine.
     :param identifier :
         The spine identifier.
+    :param random_generator:
+        The random generator used to scale the spine, by default the global random module.
     :return:
         A reference to the spine object.
     """
@@ -113,12 +117,13 @@ def emanate_a_spine(spines_list,
     spine_template = spines_list[0] # random.choice(spines_list)
 
     # Get a copy of the template and update it
-    spine_object = nmv.scene.ops.duplicate_object(spine_template, identifier, link_to_scene=False)
+    spine_object = spine_template.create_instance(identifier, link_to_scene=False)
 
     # Scale the spine
     nmv.scene.ops.scale_object_uniformly(
         spine_object,
-        random.uniform(nmv.consts.Spines.MIN_SCALE_FACTOR, nmv.consts.Spines.MAX_SCALE_FACTOR))
+        random_generator.uniform(nmv.consts.Spines.MIN_SCALE_FACTOR,
+                                 nmv.consts.Spines.MAX_SCALE_FACTOR))
 
     # Translate the spine to the post synaptic position
     nmv.scene.ops.set_object_location(spine_object, post_synaptic_position)
@@ -137,7 +142,8 @@ def emanate_a_spine(spines_list,
 def build_circuit_spines(morphology,
                          blue_config,
                          gid,
-                         material=None):
+                         material=None,
+                         random_seed=None):
     """Builds all the spines on a spiny neuron using a BBP circuit.
 
     :param morphology:
@@ -148,6 +154,8 @@ def build_circuit_spines(morphology,
         Neuron gid.
     :param material:
         Spine material.
+    :param random_seed:
+        The seed of the run, None for a non-deterministic run.
     :return:
         A list of all the reconstructed spines along the neuron.
     """
@@ -203,12 +211,16 @@ def build_circuit_spines(morphology,
     transformation_matrix[3][2] = 0.0
     transformation_matrix[3][3] = 1.0
 
-    # Load all the template spines and ignore the verbose messages of loading
-    templates_spines_list = load_spines(nmv.consts.Paths.SPINES_MESHES_LQ_DIRECTORY)
+    # Get the template spines, they are loaded only once per session
+    templates_spines_list = nmv.builders.get_template_library().get_templates(
+        nmv.consts.Paths.SPINES_MESHES_LQ_DIRECTORY)
 
     # Invert the transformation matrix
     transformation_matrix = transformation_matrix.inverted()
 
+    # The random stream of the spines, seeded from the run seed if given
+    random_generator = nmv.utilities.RandomContext(random_seed).get_random('circuit_spines')
+
     # Create a timer to report the performance
     building_timer = nmv.utilities.timer.Timer()
 
@@ -235,7 +247,8 @@ def build_circuit_spines(morphology,
         pre_position = transformation_matrix @ pre_position
 
         # Emanate a spine
-        spine_object = emanate_a_spine(templates_spines_list, post_position, pre_position, i)
+        spine_object = emanate_a_spine(
+            templates_spines_list, post_position, pre_position, i, random_generator)
 
         # Apply the material to the spine object
         if material is not None:
@@ -258,9 +271,6 @@ def build_circuit_spines(morphology,
     building_timer.end()
     nmv.logger.info('Spines: [%f] seconds' % building_timer.duration())
 
-    # Delete the template spines
-    nmv.scene.ops.delete_list_objects(templates_spines_list)
-
     # Return the spines objects list
     return spines_objects
 
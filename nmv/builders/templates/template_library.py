@@ -0,0 +1,464 @@
+####################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+# System imports
+import os
+import numpy
+
+# Blender imports
+import bpy
+
+# Internal imports
+import nmv.file
+import nmv.scene
+import nmv.utilities
+
+
+####################################################################################################
+# @MeshTemplate
+####################################################################################################
+class MeshTemplate:
+    """A template mesh, i.e. a spine or a nucleus, that is stored as flat arrays and a hidden mesh
+    datablock that is not linked to any scene.
+
+    The arrays are the reference data of the template. The datablock is only a cache to create the
+    instances quickly, and it is re-created from the arrays if it was removed, for example when the
+    scene is cleared between two neurons.
+    """
+
+    ################################################################################################
+    # @__init__
+    ################################################################################################
+    def __init__(self,
+                 name,
+                 vertices,
+                 loops_vertices,
+                 loops_totals,
+                 polygons_smooth=None,
+                 polygons_materials=None,
+                 uv_layers=None,
+                 materials_names=None):
+        """Constructor
+
+        :param name:
+            The name of the template, i.e. the name of its file without the extension.
+        :param vertices:
+            An array of shape (N, 3) with the vertices of the template.
+        :param loops_vertices:
+            A flat array with the vertex indices of all the faces of the template.
+        :param loops_totals:
+            An array with the number of vertices of each face.
+        :param polygons_smooth:
+            An array with the smooth shading flag of each face, flat shading by default.
+        :param polygons_materials:
+            An array with the material index of each face, the first material by default.
+        :param uv_layers:
+            A dictionary of the UV layers of the template, each is an array of shape (L, 2) with
+            the UV coordinates of the loops.
+        :param materials_names:
+            A list of the names of the materials of the slots of the template.
+        """
+
+        # The name of the template
+        self.name = name
+
+        # The geometry of the template
+        self.vertices = numpy.asarray(vertices, dtype=numpy.float32).reshape((-1, 3))
+        self.loops_vertices = numpy.asarray(loops_vertices, dtype=numpy.int32)
+        self.loops_totals = numpy.asarray(loops_totals, dtype=numpy.int32)
+
+        # The shading and the materials of the faces
+        self.polygons_smooth = numpy.zeros(len(self.loops_totals), dtype=bool) \
+            if polygons_smooth is None else numpy.asarray(polygons_smooth, dtype=bool)
+        self.polygons_materials = numpy.zeros(len(self.loops_totals), dtype=numpy.int32) \
+            if polygons_materials is None else numpy.asarray(polygons_materials, dtype=numpy.int32)
+
+        # The UV layers, keyed by their names
+        self.uv_layers = dict() if uv_layers is None else \
+            {layer_name: numpy.asarray(uvs, dtype=numpy.float32).reshape((-1, 2))
+             for layer_name, uvs in uv_layers.items()}
+
+        # The material slots, by name, since the materials can be removed with the scene
+        self.materials_names = list() if materials_names is None else list(materials_names)
+
+        # The hidden mesh datablock, created on demand
+        self.mesh = None
+
+    ################################################################################################
+    # @from_mesh_object
+    ################################################################################################
+    @staticmethod
+    def from_mesh_object(mesh_object,
+                         name):
+        """Creates a template from the data of a given mesh object.
+
+        :param mesh_object:
+            A given mesh object.
+        :param name:
+            The name of the template.
+        :return:
+            A new MeshTemplate.
+        """
+
+        # Mesh data
+        mesh = mesh_object.data
+
+        # Vertices
+        vertices = numpy.zeros(len(mesh.vertices) * 3, dtype=numpy.float32)
+        mesh.vertices.foreach_get('co', vertices)
+
+        # Faces, as loops
+        loops_vertices = numpy.zeros(len(mesh.loops), dtype=numpy.int32)
+        loops_totals = numpy.zeros(len(mesh.polygons), dtype=numpy.int32)
+        mesh.loops.foreach_get('vertex_index', loops_vertices)
+        mesh.polygons.foreach_get('loop_total', loops_totals)
+
+        # Shading and materials of the faces
+        polygons_smooth = numpy.zeros(len(mesh.polygons), dtype=bool)
+        polygons_materials = numpy.zeros(len(mesh.polygons), dtype=numpy.int32)
+        mesh.polygons.foreach_get('use_smooth', polygons_smooth)
+        mesh.polygons.foreach_get('material_index', polygons_materials)
+
+        # UV layers
+        uv_layers = dict()
+        for uv_layer in mesh.uv_layers:
+            uvs = numpy.zeros(len(mesh.loops) * 2, dtype=numpy.float32)
+            uv_layer.data.foreach_get('uv', uvs)
+            uv_layers[uv_layer.name] = uvs
+
+        # Material slots
+        materials_names = [material.name if material is not None else None
+                           for material in mesh.materials]
+
+        # Construct the template
+        return MeshTemplate(name, vertices, loops_vertices, loops_totals,
+                            polygons_smooth=polygons_smooth, polygons_materials=polygons_materials,
+                            uv_layers=uv_layers, materials_names=materials_names)
+
+    ################################################################################################
+    # @get_size_in_bytes
+    ################################################################################################
+    def get_size_in_bytes(self):
+        """Returns the size of the arrays of the template in bytes.
+
+        :return:
+            The size of the template in bytes.
+        """
+
+        return self.vertices.nbytes + self.loops_vertices.nbytes + self.loops_totals.nbytes + \
+            self.polygons_smooth.nbytes + self.polygons_materials.nbytes + \
+            sum(uvs.nbytes for uvs in self.uv_layers.values())
+
+    ################################################################################################
+    # @is_mesh_valid
+    ################################################################################################
+    def is_mesh_valid(self):
+        """Checks if the hidden mesh datablock still exists.
+
+        :return:
+            True if the datablock exists, otherwise False.
+        """
+
+        # Not created yet
+        if self.mesh is None:
+            return False
+
+        # Accessing a removed datablock raises a ReferenceError
+        try:
+            return self.mesh.name in bpy.data.meshes
+        except ReferenceError:
+            return False
+
+    ################################################################################################
+    # @get_mesh
+    ################################################################################################
+    def get_mesh(self):
+        """Returns the hidden mesh datablock of the template, and creates it from the arrays if it
+        does not exist.
+
+        :return:
+            A reference to the mesh datablock.
+        """
+
+        # Already created
+        if self.is_mesh_valid():
+            return self.mesh
+
+        # Create a new datablock
+        mesh = bpy.data.meshes.new('%s_template' % self.name)
+
+        # Vertices
+        mesh.vertices.add(len(self.vertices))
+        mesh.vertices.foreach_set('co', self.vertices.ravel())
+
+        # Faces
+        mesh.loops.add(len(self.loops_vertices))
+        mesh.loops.foreach_set('vertex_index', self.loops_vertices)
+        mesh.polygons.add(len(self.loops_totals))
+        mesh.polygons.foreach_set(
+            'loop_start', (numpy.cumsum(self.loops_totals) - self.loops_totals).astype(numpy.int32))
+        mesh.polygons.foreach_set('loop_total', self.loops_totals)
+
+        # Shading and materials of the faces
+        mesh.polygons.foreach_set('use_smooth', self.polygons_smooth)
+        mesh.polygons.foreach_set('material_index', self.polygons_materials)
+
+        # UV layers
+        for layer_name, uvs in self.uv_layers.items():
+            uv_layer = mesh.uv_layers.new(name=layer_name)
+            uv_layer.data.foreach_set('uv', uvs.ravel())
+
+        # Material slots, an empty slot keeps the indices of the faces if a material is removed
+        for material_name in self.materials_names:
+            mesh.materials.append(bpy.data.materials.get(material_name)
+                                  if material_name is not None else None)
+
+        # Update the mesh and compute the edges
+        mesh.update(calc_edges=True)
+        mesh.validate()
+
+        # Keep the datablock, even if it has no users
+        mesh.use_fake_user = True
+
+        # Update the reference
+        self.mesh = mesh
+
+        # Return a reference to the datablock
+        return self.mesh
+
+    ################################################################################################
+    # @create_instance
+    ################################################################################################
+    def create_instance(self,
+                        name,
+                        link_to_scene=True):
+        """Creates a new mesh object with an independent copy of the template.
+
+        :param name:
+            The name of the new object.
+        :param link_to_scene:
+            Link the new object to the scene.
+        :return:
+            A reference to the new object.
+        """
+
+        # Copy the data of the template
+        mesh = self.get_mesh().copy()
+        mesh.use_fake_user = False
+
+        # Create the object
+        instance_object = bpy.data.objects.new(str(name), mesh)
+
+        # Link it to the scene
+        if link_to_scene:
+            nmv.scene.ops.link_object_to_scene(instance_object)
+
+        # Return a reference to the object
+        return instance_object
+
+    ################################################################################################
+    # @release
+    ################################################################################################
+    def release(self):
+        """Removes the hidden mesh datablock of the template if it exists.
+        """
+
+        # Remove the datablock
+        if self.is_mesh_valid():
+            bpy.data.meshes.remove(self.mesh, do_unlink=True)
+
+        # Reset the reference
+        self.mesh = None
+
+
+####################################################################################################
+# @TemplateLibrary
+####################################################################################################
+class TemplateLibrary:
+    """A process-wide library of the template meshes, i.e. the spines and the nuclei.
+
+    Every directory of templates is imported only once per session. The builders create their
+    instances from the library, therefore the templates are not imported again for every neuron in
+    multi-neuron and batch runs.
+    """
+
+    ################################################################################################
+    # @__init__
+    ################################################################################################
+    def __init__(self):
+        """Constructor
+        """
+
+        # The templates, keyed by the path of their directory and their file extension
+        self.templates = dict()
+
+    ################################################################################################
+    # @import_templates
+    ################################################################################################
+    @staticmethod
+    def import_templates(directory,
+                         file_extension):
+        """Imports all the templates in a given directory into arrays, and removes the imported
+        objects from the scene.
+
+        :param directory:
+            A given directory of templates.
+        :param file_extension:
+            The extension of the template files.
+        :return:
+            A list of MeshTemplate objects, sorted by the names of the files.
+        """
+
+        # List all the template files in the directory
+        template_files = nmv.file.ops.get_files_in_directory(
+            directory, file_extension=file_extension)
+
+        # Import the templates and ignore the verbose messages of loading
+        templates = list()
+        imported_objects = list()
+        nmv.utilities.disable_std_output()
+        for template_file in template_files:
+
+            # Import the file
+            imported_object = nmv.file.import_obj_file(directory, template_file)
+            imported_objects.append(imported_object)
+
+            # Get the arrays of the template
+            templates.append(MeshTemplate.from_mesh_object(
+                imported_object, os.path.splitext(template_file)[0]))
+        nmv.utilities.enable_std_output()
+
+        # The imported objects are not needed any further
+        nmv.scene.ops.delete_list_objects(imported_objects)
+
+        # Return the templates
+        return templates
+
+    ################################################################################################
+    # @get_templates
+    ################################################################################################
+    def get_templates(self,
+                      directory,
+                      file_extension='.obj'):
+        """Returns all the templates in a given directory, and imports them if they are not loaded.
+
+        :param directory:
+            A given directory of templates.
+        :param file_extension:
+            The extension of the template files.
+        :return:
+            A list of MeshTemplate objects, sorted by the names of the files.
+        """
+
+        # The key of the directory in the library
+        key = (os.path.abspath(directory), file_extension)
+
+        # Import the templates once
+        if key not in self.templates:
+            self.templates[key] = self.import_templates(directory, file_extension)
+
+            # Report the memory of the library
+            nmv.logger.info('Templates: [%d] from [%s], library [%d] templates, [%.3f] MB' %
+                            (len(self.templates[key]), directory, self.get_number_templates(),
+                             self.get_size_in_bytes() / (1024.0 * 1024.0)))
+
+        # Return the templates
+        return self.templates[key]
+
+    ################################################################################################
+    # @get_template
+    ################################################################################################
+    def get_template(self,
+                     directory,
+                     template_name,
+                     file_extension='.obj'):
+        """Returns a specific template by its name from a given directory.
+
+        :param directory:
+            A given directory of templates.
+        :param template_name:
+            The name of the template, i.e. the name of its file without the extension.
+        :param file_extension:
+            The extension of the template files.
+        :return:
+            A reference to the MeshTemplate, or None if it does not exist.
+        """
+
+        # Search the templates of the directory
+        for template in self.get_templates(directory, file_extension):
+            if template.name == template_name:
+                return template
+
+        # Not found
+        return None
+
+    ################################################################################################
+    # @get_number_templates
+    ################################################################################################
+    def get_number_templates(self):
+        """Returns the number of templates in the library.
+
+        :return:
+            The number of templates in the library.
+        """
+
+        return sum(len(templates) for templates in self.templates.values())
+
+    ################################################################################################
+    # @get_size_in_bytes
+    ################################################################################################
+    def get_size_in_bytes(self):
+        """Returns the size of the arrays of all the templates in the library in bytes.
+
+        :return:
+            The size of the library in bytes.
+        """
+
+        return sum(template.get_size_in_bytes()
+                   for templates in self.templates.values() for template in templates)
+
+    ################################################################################################
+    # @clear
+    ################################################################################################
+    def clear(self):
+        """Removes all the templates from the library and their datablocks from Blender.
+        """
+
+        # Release the datablocks
+        for templates in self.templates.values():
+            for template in templates:
+                template.release()
+
+        # Reset the library
+        self.templates = dict()
+
+
+# The library of the session
+TEMPLATE_LIBRARY = TemplateLibrary()
+
+
+####################################################################################################
+# @get_template_library
+####################################################################################################
+def get_template_library():
+    """Returns the template library of the session.
+
+    :return:
+        A reference to the TemplateLibrary of the session.
+    """
+
+    return TEMPLATE_LIBRARY
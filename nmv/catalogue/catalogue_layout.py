@@ -0,0 +1,215 @@
+###################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+# System imports
+import os
+
+# Internal imports
+import nmv.consts
+
+
+####################################################################################################
+# @get_items_in_group
+####################################################################################################
+def get_items_in_group(labels,
+                       group_sub_string):
+    """Finds the labels that belong to a group, i.e. that contain the sub-string of the group,
+    for example a layer 'L5' or an m-type 'L5_TPC'.
+
+    :param labels:
+        A list of labels.
+    :param group_sub_string:
+        The sub-string of the group.
+    :return:
+        A list of the labels of the group.
+    """
+
+    return [label for label in labels if group_sub_string in label]
+
+
+####################################################################################################
+# @collect_catalogue_items
+####################################################################################################
+def collect_catalogue_items(input_directory,
+                            groups=None):
+    """Collects the morphology and the mesh files of a directory and its sub-directories, and
+    assigns every file to a group.
+
+    If a list of groups is given, a file belongs to the first group whose sub-string is contained
+    in its path relative to the input directory, and the files that do not belong to any group
+    are collected in an extra group that is laid out at the end. Otherwise, the files are grouped
+    by the name of their directory, for example one directory per m-type.
+
+    :param input_directory:
+        The input directory.
+    :param groups:
+        An optional list of the sub-strings of the groups, in the order of the layout.
+    :return:
+        A list of the items, every item is a dictionary, and the list of the groups in the order
+        of the layout.
+    """
+
+    extensions = nmv.consts.Catalogue.MORPHOLOGY_EXTENSIONS + nmv.consts.Catalogue.MESH_EXTENSIONS
+
+    # Collect the files
+    items = list()
+    for directory, _, files in os.walk(input_directory):
+        for file_name in sorted(files):
+            label, extension = os.path.splitext(file_name)
+            if extension.lower() not in extensions:
+                continue
+            file_path = os.path.join(directory, file_name)
+            items.append({'file': file_path,
+                          'label': label,
+                          'key': os.path.splitext(os.path.relpath(file_path, input_directory))[0],
+                          'is_mesh': extension.lower() in nmv.consts.Catalogue.MESH_EXTENSIONS,
+                          'size': os.path.getsize(file_path),
+                          'group': os.path.basename(os.path.normpath(directory))})
+
+    # Group by directory
+    if groups is None or len(groups) == 0:
+        return items, sorted(set(item['group'] for item in items))
+
+    # Group by the sub-strings of the groups, that are matched against the relative paths of the
+    # files, so the directories can also be grouped, and a file belongs to the first match
+    keys = [item['key'] for item in items]
+    key_groups = dict()
+    for group in groups:
+        for key in get_items_in_group(keys, group):
+            key_groups.setdefault(key, group)
+
+    # The files that do not match any group
+    ungrouped = False
+    for item in items:
+        item['group'] = key_groups.get(item['key'], '')
+        if item['group'] == '':
+            ungrouped = True
+
+    # The ungrouped files go to the end
+    return items, list(groups) + ([''] if ungrouped else list())
+
+
+####################################################################################################
+# @shard_catalogue_items
+####################################################################################################
+def shard_catalogue_items(items,
+                          number_workers):
+    """Distributes the items over the workers, with a balanced cost.
+
+    The cost of an item is estimated from the size of its file, and the items are assigned from
+    the largest to the smallest to the least loaded worker, so a few large neurons do not end up
+    on the same worker.
+
+    :param items:
+        A list of the items.
+    :param number_workers:
+        The number of the workers.
+    """
+
+    loads = [0] * number_workers
+    for index in sorted(range(len(items)), key=lambda i: -items[i]['size']):
+        worker = loads.index(min(loads))
+        items[index]['worker'] = worker
+        loads[worker] += items[index]['size']
+
+
+####################################################################################################
+# @get_cell_size
+####################################################################################################
+def get_cell_size(bounds,
+                  scale_factor):
+    """Gets the size of the image of a cell, rendered to scale from the FRONT view.
+
+    :param bounds:
+        The dimensions of the bounding box of the cell in microns.
+    :param scale_factor:
+        The resolution scale factor.
+    :return:
+        The width and the height of the image in pixels, as computed by the to-scale camera.
+    """
+
+    return int(scale_factor * bounds[0]) * 2, int(scale_factor * bounds[1]) * 2
+
+
+####################################################################################################
+# @compute_catalogue_layout
+####################################################################################################
+def compute_catalogue_layout(items,
+                             groups,
+                             scale_factor=nmv.consts.Catalogue.DEFAULT_SCALE_FACTOR,
+                             columns=nmv.consts.Catalogue.DEFAULT_COLUMNS,
+                             spacing=nmv.consts.Catalogue.DEFAULT_SPACING,
+                             group_spacing=nmv.consts.Catalogue.DEFAULT_GROUP_SPACING):
+    """Lays out the cells on a grid from their bounding boxes.
+
+    Every group starts on a new row, the cells of a group are placed from left to right in rows of
+    @columns cells, and every cell is centered vertically in its row. The positions are computed in
+    the pixels of the catalogue image, where the origin is the top-left corner. The items without
+    bounds, i.e. that failed to load, are skipped.
+
+    :param items:
+        A list of the items, with their 'bounds' in microns.
+    :param groups:
+        The list of the groups in the order of the layout.
+    :param scale_factor:
+        The resolution scale factor of the cells.
+    :param columns:
+        The number of the cells in a row.
+    :param spacing:
+        The spacing between the cells in microns.
+    :param group_spacing:
+        The spacing between the groups in microns.
+    :return:
+        The width and the height of the catalogue image in pixels. The position and the size of
+        every cell are set in its item as 'x', 'y', 'width' and 'height'.
+    """
+
+    # The spacing in pixels, like the cells
+    spacing_pixels = int(scale_factor * spacing) * 2
+    group_spacing_pixels = int(scale_factor * group_spacing) * 2
+
+    width = 0
+    y = 0
+    for group in groups:
+        group_items = [item for item in items
+                       if item['group'] == group and item.get('bounds') is not None]
+        if len(group_items) == 0:
+            continue
+        group_items.sort(key=lambda item: item['label'])
+
+        # The gap between the groups
+        if y > 0:
+            y += group_spacing_pixels - spacing_pixels
+
+        for first in range(0, len(group_items), columns):
+            row = group_items[first:first + columns]
+            for item in row:
+                item['width'], item['height'] = get_cell_size(item['bounds'], scale_factor)
+            row_height = max(item['height'] for item in row)
+
+            # Place the row
+            x = 0
+            for item in row:
+                item['x'] = x
+                item['y'] = y + (row_height - item['height']) // 2
+                x += item['width'] + spacing_pixels
+            width = max(width, x - spacing_pixels)
+            y += row_height + spacing_pixels
+
+    # Remove the trailing spacing
+    height = max(0, y - spacing_pixels)
+    return width, height
@@ -0,0 +1,454 @@
+###################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+# System imports
+import json
+import os
+import shutil
+import subprocess
+import time
+import numpy
+
+# Internal imports
+import nmv.bbox
+import nmv.builders
+import nmv.consts
+import nmv.enums
+import nmv.file
+import nmv.options
+import nmv.rendering
+import nmv.scene
+from .catalogue_layout import *
+
+
+####################################################################################################
+# @get_catalogue_rendering_script
+####################################################################################################
+def get_catalogue_rendering_script():
+    """Gets the path to the CLI script that is executed by the catalogue workers.
+
+    :return:
+        The path to the script.
+    """
+
+    return os.path.realpath('%s/../interface/cli/catalogue_rendering.py' %
+                            os.path.dirname(os.path.realpath(__file__)))
+
+
+####################################################################################################
+# @create_catalogue_manifest
+####################################################################################################
+def create_catalogue_manifest(input_directory,
+                              output_directory,
+                              catalogue_name='catalogue',
+                              groups=None,
+                              number_workers=nmv.consts.Catalogue.DEFAULT_WORKERS,
+                              scale_factor=nmv.consts.Catalogue.DEFAULT_SCALE_FACTOR,
+                              columns=nmv.consts.Catalogue.DEFAULT_COLUMNS,
+                              spacing=nmv.consts.Catalogue.DEFAULT_SPACING,
+                              group_spacing=nmv.consts.Catalogue.DEFAULT_GROUP_SPACING):
+    """Creates the manifest of a catalogue of all the morphologies and meshes in a directory.
+
+    :param input_directory:
+        The directory of the morphologies and the meshes, possibly in sub-directories.
+    :param output_directory:
+        The directory where the catalogue will be created.
+    :param catalogue_name:
+        The name of the catalogue image.
+    :param groups:
+        An optional list of the sub-strings of the groups, e.g. layers or m-types, otherwise the
+        files are grouped by their directories.
+    :param number_workers:
+        The number of the workers that render the cells.
+    :param scale_factor:
+        The resolution scale factor of the cells.
+    :param columns:
+        The number of the cells in a row of a group.
+    :param spacing:
+        The spacing between the cells in microns.
+    :param group_spacing:
+        The spacing between the groups in microns.
+    :return:
+        The path to the manifest.
+    """
+
+    # Collect the items and shard them
+    items, groups = collect_catalogue_items(input_directory, groups)
+    if len(items) == 0:
+        raise RuntimeError('The directory [%s] does NOT contain any morphologies or meshes' %
+                           input_directory)
+    shard_catalogue_items(items, number_workers)
+
+    # Every cell is rendered to its own files
+    cells_directory = '%s/%s' % (output_directory, nmv.consts.Catalogue.CELLS_DIRECTORY)
+    if not nmv.file.ops.path_exists(cells_directory):
+        nmv.file.ops.clean_and_create_directory(cells_directory)
+    for i, item in enumerate(items):
+        item['cell'] = '%s/cell_%06d' % (cells_directory, i)
+
+    # Write the manifest
+    manifest = {'image_file': '%s/%s.tiff' % (output_directory, catalogue_name),
+                'index_file': '%s/%s%s' % (output_directory, catalogue_name,
+                                           nmv.consts.Catalogue.INDEX_SUFFIX),
+                'scale_factor': scale_factor,
+                'columns': columns,
+                'spacing': spacing,
+                'group_spacing': group_spacing,
+                'groups': groups,
+                'items': items}
+    manifest_file = '%s/%s' % (output_directory, nmv.consts.Catalogue.MANIFEST_FILE)
+    with open(manifest_file, 'w') as file_handle:
+        json.dump(manifest, file_handle, indent=1)
+
+    nmv.logger.log('Catalogue of [%d] items in [%d] groups' % (len(items), len(groups)))
+
+    # Return the path to the manifest
+    return manifest_file
+
+
+####################################################################################################
+# @read_catalogue_morphology
+####################################################################################################
+def read_catalogue_morphology(options):
+    """Reads the morphology of a catalogue item, on a prefetching thread. The meshes are imported
+    later in the main thread, since they are read by Blender.
+
+    :param options:
+        The options of the item.
+    :return:
+        The loading flag and the morphology, or None for a mesh.
+    """
+
+    if os.path.splitext(options.morphology.morphology_file_path)[1].lower() in \
+            nmv.consts.Catalogue.MESH_EXTENSIONS:
+        return True, None
+    return nmv.file.read_morphology_from_file(options=options)
+
+
+####################################################################################################
+# @load_catalogue_item
+####################################################################################################
+def load_catalogue_item(item,
+                        options,
+                        morphology):
+    """Loads a morphology or a mesh into an empty scene.
+
+    The morphologies are reconstructed with the default options of the morphology toolbox.
+
+    :param item:
+        The catalogue item.
+    :param options:
+        The options of the item.
+    :param morphology:
+        The morphology of the item, already read, or None for a mesh.
+    :return:
+        True if the item is loaded, otherwise False.
+    """
+
+    # Clear the scene
+    nmv.scene.ops.clear_scene()
+
+    # Meshes
+    if item['is_mesh']:
+        if item['file'].lower().endswith('.blend'):
+            objects = nmv.file.import_object_from_blend_file(
+                os.path.dirname(item['file']), os.path.basename(item['file']))
+        else:
+            objects = nmv.file.import_mesh(item['file'])
+        return objects is not None
+
+    # Morphologies
+    builder = nmv.builders.DisconnectedSectionsBuilder(morphology=morphology, options=options)
+    builder.draw_morphology_skeleton()
+    return True
+
+
+####################################################################################################
+# @render_catalogue_cells
+####################################################################################################
+def render_catalogue_cells(manifest_file,
+                           worker_index=0):
+    """Renders the cells of a worker. This function is executed in a worker process.
+
+    Every item is loaded alone in the scene and rendered to scale from the FRONT view with the
+    scale factor of the catalogue, so the relative sizes of the neurons are kept. The pixels of a
+    cell are saved as an array whose first row is the top of the image, and its bounding box is
+    saved next to it for the layout. The cells that exist already are skipped, so a failed
+    catalogue can be resumed. The next morphologies are read on background threads while the
+    current one is rendered.
+
+    :param manifest_file:
+        The path to the manifest of the catalogue.
+    :param worker_index:
+        The index of this worker.
+    """
+
+    with open(manifest_file, 'r') as file_handle:
+        manifest = json.load(file_handle)
+
+    start_time = time.time()
+
+    # The items of this worker, except the rendered ones
+    worker_items = [item for item in manifest['items']
+                    if item['worker'] == worker_index and not
+                    os.path.exists('%s.json' % item['cell'])]
+
+    # The next morphologies are read while the current one is rendered
+    options = nmv.options.NeuroMorphoVisOptions()
+    prefetcher = nmv.file.MorphologyPrefetcher(
+        [nmv.file.create_options_for_morphology_file(options, item['file'])
+         for item in worker_items],
+        prefetch_count=nmv.consts.Catalogue.PREFETCH_COUNT,
+        number_threads=nmv.consts.Catalogue.PREFETCH_COUNT,
+        reader=read_catalogue_morphology)
+
+    for i, (item, (item_options, loading_flag, morphology)) in enumerate(
+            zip(worker_items, prefetcher)):
+
+        # Track the datablocks of this item to free them before the next one
+        datablock_tracker = nmv.scene.ops.DatablockTracker(label=item['cell'])
+
+        # Load the item and compute its bounds
+        bounds = None
+        if loading_flag and load_catalogue_item(item, item_options, morphology):
+            bounding_box = nmv.bbox.compute_scene_bounding_box_for_curves_and_meshes()
+            bounds = [bounding_box.bounds[0], bounding_box.bounds[1], bounding_box.bounds[2]]
+
+            # Render the cell
+            nmv.rendering.render_to_scale(
+                bounding_box=bounding_box,
+                camera_view=nmv.enums.Camera.View.FRONT,
+                image_scale_factor=manifest['scale_factor'],
+                image_name=item['cell'])
+
+            # Save the pixels of the cell and delete the image
+            pixels = nmv.rendering.load_image_pixels('%s.png' % item['cell'])
+            pixels = numpy.clip(pixels * 255.0 + 0.5, 0, 255).astype(numpy.uint8)
+            numpy.save('%s.npy' % item['cell'], pixels)
+            os.remove('%s.png' % item['cell'])
+        else:
+            nmv.logger.log('WARNING: Cannot load [%s], it is skipped' % item['file'])
+
+        # Keep the memory of the worker flat over its items
+        datablock_tracker.free()
+
+        # The bounds of the cell, written last, marks the cell as done
+        with open('%s.json' % item['cell'], 'w') as file_handle:
+            json.dump({'bounds': bounds}, file_handle)
+
+        nmv.logger.log('Worker [%d]: cell [%d/%d] rendered' % (worker_index, i + 1,
+                                                               len(worker_items)))
+
+    nmv.logger.statistics('Worker [%d]: [%d] cells rendered in [%f] seconds' %
+                          (worker_index, len(worker_items), time.time() - start_time))
+
+
+####################################################################################################
+# @composite_catalogue
+####################################################################################################
+def composite_catalogue(manifest_file):
+    """Lays out the rendered cells and composites them into a tiled TIFF image.
+
+    The image is composited in bands of one row of tiles, so the memory is bounded by a band
+    regardless of the number of the cells. The position of every cell in the image is written to
+    an index next to it.
+
+    :param manifest_file:
+        The path to the manifest of the catalogue.
+    :return:
+        The path to the catalogue image.
+    """
+
+    with open(manifest_file, 'r') as file_handle:
+        manifest = json.load(file_handle)
+    items = manifest['items']
+
+    # The bounds of the rendered cells
+    for item in items:
+        bounds_file = '%s.json' % item['cell']
+        if not os.path.exists(bounds_file):
+            raise RuntimeError('The cell of [%s] is not rendered' % item['file'])
+        with open(bounds_file, 'r') as file_handle:
+            item['bounds'] = json.load(file_handle)['bounds']
+
+    # Lay out the cells
+    width, height = compute_catalogue_layout(
+        items, manifest['groups'], scale_factor=manifest['scale_factor'],
+        columns=manifest['columns'], spacing=manifest['spacing'],
+        group_spacing=manifest['group_spacing'])
+    placed_items = [item for item in items if item.get('bounds') is not None]
+    if len(placed_items) == 0:
+        raise RuntimeError('None of the items of the catalogue is rendered')
+
+    # Composite the image band by band
+    start_time = time.time()
+    tile_size = nmv.consts.Catalogue.TILE_SIZE
+    writer = nmv.file.TiledTiffWriter(manifest['image_file'], width, height, tile_size)
+    band_width = writer.tiles_x * tile_size
+    for band_y in range(0, height, tile_size):
+        band = numpy.zeros((tile_size, band_width, 4), dtype=numpy.uint8)
+        for item in placed_items:
+
+            # The rows of the cell in this band
+            first_row = max(band_y, item['y'])
+            last_row = min(band_y + tile_size, item['y'] + item['height'])
+            if first_row >= last_row:
+                continue
+
+            # The cells do not overlap, so they are copied
+            pixels = numpy.load('%s.npy' % item['cell'], mmap_mode='r')
+            rows = pixels[first_row - item['y']:last_row - item['y'], :item['width']]
+            band[first_row - band_y:first_row - band_y + rows.shape[0],
+                 item['x']:item['x'] + rows.shape[1]] = rows
+
+        # Write the tiles of the band
+        for band_x in range(0, band_width, tile_size):
+            writer.write_tile(band[:, band_x:band_x + tile_size])
+    writer.close()
+
+    # The index of the cells
+    index = [{key: item[key] for key in ['label', 'group', 'file', 'x', 'y', 'width', 'height',
+                                         'bounds']} for item in placed_items]
+    with open(manifest['index_file'], 'w') as file_handle:
+        json.dump(index, file_handle, indent=1)
+
+    nmv.logger.statistics('Catalogue [%s] of [%d x %d] pixels composited in [%f] seconds' %
+                          (manifest['image_file'], width, height, time.time() - start_time))
+
+    # Return the path to the image
+    return manifest['image_file']
+
+
+####################################################################################################
+# @get_catalogue_worker_command
+####################################################################################################
+def get_catalogue_worker_command(blender_executable,
+                                 manifest_file,
+                                 worker_index=None):
+    """Gets the shell command of a catalogue worker, or of the compositing.
+
+    :param blender_executable:
+        The path to the Blender executable.
+    :param manifest_file:
+        The path to the manifest of the catalogue.
+    :param worker_index:
+        The index of the worker, or None for the compositing.
+    :return:
+        The command as a list of arguments.
+    """
+
+    command = [blender_executable, '-b', '--verbose', '0',
+               '--python', get_catalogue_rendering_script(), '--', '--manifest', manifest_file]
+    if worker_index is None:
+        return command + ['--composite']
+    return command + ['--worker', str(worker_index)]
+
+
+####################################################################################################
+# @run_catalogue_locally
+####################################################################################################
+def run_catalogue_locally(manifest_file,
+                          blender_executable='blender',
+                          number_workers=nmv.consts.Catalogue.DEFAULT_WORKERS):
+    """Renders the cells of a catalogue in parallel worker processes on the local node, then
+    composites the catalogue in this process.
+
+    :param manifest_file:
+        The path to the manifest of the catalogue.
+    :param blender_executable:
+        The path to the Blender executable.
+    :param number_workers:
+        The number of the worker processes, as in the manifest.
+    :return:
+        The path to the catalogue image.
+    """
+
+    start_time = time.time()
+
+    # Launch the workers and wait for them
+    workers = [subprocess.Popen(get_catalogue_worker_command(
+        blender_executable, manifest_file, worker_index))
+        for worker_index in range(number_workers)]
+    failures = len([worker for worker in workers if worker.wait() != 0])
+    if failures > 0:
+        raise RuntimeError('[%d] catalogue workers failed, re-run to resume' % failures)
+
+    nmv.logger.statistics('Cells rendered by [%d] workers in [%f] seconds' %
+                          (number_workers, time.time() - start_time))
+
+    # Composite the catalogue
+    return composite_catalogue(manifest_file)
+
+
+####################################################################################################
+# @create_catalogue_slurm_jobs
+####################################################################################################
+def create_catalogue_slurm_jobs(manifest_file,
+                                blender_executable='blender',
+                                number_workers=nmv.consts.Catalogue.DEFAULT_WORKERS):
+    """Creates a SLURM job for every catalogue worker and a compositing job that depends on all of
+    them, and a script that submits them.
+
+    :param manifest_file:
+        The path to the manifest of the catalogue.
+    :param blender_executable:
+        The path to the Blender executable.
+    :param number_workers:
+        The number of the worker jobs, as in the manifest.
+    :return:
+        The path to the submission script.
+    """
+
+    jobs_directory = os.path.dirname(manifest_file)
+    logs_directory = '%s/logs' % jobs_directory
+    if not nmv.file.ops.path_exists(logs_directory):
+        nmv.file.ops.clean_and_create_directory(logs_directory)
+
+    # The worker jobs
+    lines = ['#!/bin/bash', 'JOBS=""']
+    for worker_index in range(number_workers):
+        worker_script = '%s/catalogue_worker_%04d.sh' % (jobs_directory, worker_index)
+        with open(worker_script, 'w') as file_handle:
+            file_handle.write(nmv.rendering.create_batch_job_string(
+                'nmv_catalogue_%04d' % worker_index, logs_directory,
+                [get_catalogue_worker_command(blender_executable, manifest_file, worker_index)]))
+        lines.append('JOBS="$JOBS:$(sbatch --parsable %s)"' % worker_script)
+
+    # The compositing job, after all the workers succeed
+    composite_script = '%s/catalogue_composite.sh' % jobs_directory
+    with open(composite_script, 'w') as file_handle:
+        file_handle.write(nmv.rendering.create_batch_job_string(
+            'nmv_catalogue_composite', logs_directory,
+            [get_catalogue_worker_command(blender_executable, manifest_file)], cpus_per_task=1))
+    lines.append('sbatch --dependency=afterok$JOBS %s' % composite_script)
+
+    # The submission script
+    submit_script = '%s/catalogue_submit.sh' % jobs_directory
+    with open(submit_script, 'w') as file_handle:
+        file_handle.write('\n'.join(lines) + '\n')
+    os.chmod(submit_script, 0o755)
+
+    # Submit
+    if shutil.which('sbatch') is not None:
+        subprocess.call(['bash', submit_script])
+        nmv.logger.log('[%d] catalogue jobs submitted, the catalogue will be written to [%s]' %
+                       (number_workers, jobs_directory))
+    else:
+        nmv.logger.log('Submit the catalogue jobs with [%s]' % submit_script)
+
+    # Return the path to the submission script
+    return submit_script
@@ -31,4 +31,8 @@ from .simulation_consts import *
 from .soft_body_consts import *
 from .spines_consts import *
 from .suffix_consts import *
-from .meta_ball_consts import *
\ No newline at end of file
+from .meta_ball_consts import *
+from .render_profile_consts import *
+from .catalogue_consts import *
+from .memory_consts import *
+from .validation_consts import *
\ No newline at end of file
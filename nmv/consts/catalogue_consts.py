@@ -0,0 +1,67 @@
+###################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+
+####################################################################################################
+# @Catalogue
+####################################################################################################
+class Catalogue:
+    """Catalogue constants
+    """
+
+    ################################################################################################
+    # @__init__
+    ################################################################################################
+    def __init__(self):
+        pass
+
+    # The default resolution scale factor of the cells, the same for all the cells to keep the
+    # relative sizes of the neurons
+    DEFAULT_SCALE_FACTOR = 2.0
+
+    # The default number of the cells in a row of a group
+    DEFAULT_COLUMNS = 10
+
+    # The default spacing between the cells in microns
+    DEFAULT_SPACING = 50.0
+
+    # The default spacing between the groups in microns
+    DEFAULT_GROUP_SPACING = 300.0
+
+    # The default number of the worker processes
+    DEFAULT_WORKERS = 4
+
+    # The number of the morphologies that a worker reads ahead of the rendered one
+    PREFETCH_COUNT = 2
+
+    # The size of the tiles of the catalogue image, that bounds the memory of the compositing
+    TILE_SIZE = 512
+
+    # The extensions of the morphology files
+    MORPHOLOGY_EXTENSIONS = ['.h5', '.swc']
+
+    # The extensions of the mesh files
+    MESH_EXTENSIONS = ['.obj', '.ply', '.stl', '.blend']
+
+    # The name of the manifest of the catalogue
+    MANIFEST_FILE = 'catalogue.json'
+
+    # The directory where the cells are rendered
+    CELLS_DIRECTORY = 'cells'
+
+    # The suffix of the index that lists the positions of the cells in the catalogue image
+    INDEX_SUFFIX = '_index.json'
@@ -55,3 +55,76 @@ class Image:
 
     # Default samples per pixels
     DEFAULT_SPP = 8
+
+
+####################################################################################################
+# @TiledRendering
+####################################################################################################
+class TiledRendering:
+    """Tiled rendering constants
+    """
+
+    ################################################################################################
+    # @__init__
+    ################################################################################################
+    def __init__(self):
+        pass
+
+    # The default size of the tiles in pixels, a multiple of 16 for the tiled TIFF
+    DEFAULT_TILE_SIZE = 2048
+
+    # The default number of the worker processes
+    DEFAULT_WORKERS = 4
+
+    # The suffix of the directory where the scene, the manifest and the tiles are stored
+    TILES_DIRECTORY_SUFFIX = '_tiles'
+
+    # The name of the manifest of the tiled rendering job
+    MANIFEST_FILE = 'manifest.json'
+
+    # The name of the scene file loaded by the workers
+    SCENE_FILE = 'scene.blend'
+
+    # SLURM partition of the workers
+    SLURM_PARTITION = 'prod'
+
+    # SLURM session time of a worker
+    SLURM_SESSION_TIME = '4:00:00'
+
+    # SLURM memory of a worker in MBytes
+    SLURM_MEMORY_MB = 16000
+
+    # SLURM CPUs of a worker
+    SLURM_CPUS_PER_TASK = 8
+
+
+####################################################################################################
+# @QualityAssurance
+####################################################################################################
+class QualityAssurance:
+    """Quality assurance rendering constants
+    """
+
+    ################################################################################################
+    # @__init__
+    ################################################################################################
+    def __init__(self):
+        pass
+
+    # The default resolution of a quality assurance image
+    DEFAULT_RESOLUTION = 256
+
+    # The anti-aliasing of the Workbench, FXAA is almost free
+    WORKBENCH_AA = 'FXAA'
+
+    # The number of the columns of a contact sheet
+    CONTACT_SHEET_COLUMNS = 16
+
+    # The number of the rows of a contact sheet, the next images go to another page
+    CONTACT_SHEET_ROWS = 16
+
+    # The prefix of the names of the contact sheets
+    CONTACT_SHEET_PREFIX = 'contact_sheet'
+
+    # The background color of the contact sheets
+    CONTACT_SHEET_BACKGROUND = (1.0, 1.0, 1.0)
@@ -0,0 +1,53 @@
+###################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+
+####################################################################################################
+# @Memory
+####################################################################################################
+class Memory:
+    """Memory accounting constants
+    """
+
+    ################################################################################################
+    # @__init__
+    ################################################################################################
+    def __init__(self):
+        pass
+
+    # The extension of the memory reports that are written next to the .stats files
+    REPORT_EXTENSION = 'memory'
+
+    # The collections of Blender datablocks that are counted around every stage
+    DATABLOCKS = ['objects', 'meshes', 'curves', 'materials', 'images']
+
+    # The suggested SLURM memory is the predicted peak memory multiplied by this margin
+    SLURM_MEMORY_MARGIN = 1.25
+
+    # The suggested SLURM memory is rounded up to a multiple of this value in MB
+    SLURM_MEMORY_GRANULARITY_MB = 500
+
+    # The minimum SLURM memory that can be suggested in MB
+    SLURM_MINIMUM_MEMORY_MB = 1000
+
+    # The collections of Blender datablocks that are freed between the items of a batch, in the
+    # order of their removal, the users first
+    TRACKED_DATABLOCKS = ['objects', 'meshes', 'curves', 'metaballs', 'lights', 'lamps', 'cameras',
+                          'materials', 'node_groups', 'textures', 'images']
+
+    # The types of the images that are owned by Blender and never freed
+    PERSISTENT_IMAGE_TYPES = ['RENDER_RESULT', 'COMPOSITING']
@@ -41,6 +41,25 @@ class Meshing:
     # The number of spines per micron to be added to the neuron
     NUMBER_SPINES_PER_MICRON = 10
 
+    # The default seed of the surface noise
+    SURFACE_NOISE_SEED = 0
+
+    # The default number of the worker processes of the union, a single worker unions in process
+    UNION_WORKERS = 1
+
+    # The minimum number of the meshes of a union that are distributed over worker processes,
+    # below it the cost of launching the workers exceeds the gain
+    PARALLEL_UNION_MINIMUM_MESHES = 32
+
+    # The default size of the voxels of the voxel union in microns
+    VOXEL_UNION_VOXEL_SIZE = 0.2
+
+    # The width of the narrow band of the distance grid of the voxel union in voxels
+    VOXEL_UNION_BAND_VOXELS = 2
+
+    # The number of the voxels along each side of a block of the distance grid
+    VOXEL_UNION_BLOCK_SIZE = 32
+
     # PLY extension
     PLY_EXTENSION = '.ply'
 
@@ -34,3 +34,9 @@ class MetaBall:
 
     # Resolution
     META_DEFAULT_RESOLUTION = 0.99
+
+    # Maximum geometric error of the soma decimation, relative to the mean radius of the soma
+    SOMA_DECIMATION_RELATIVE_ERROR = 0.02
+
+    # Number of subdivisions applied to every edge of the endfeet triangles, as powers of two
+    ASTROCYTE_ENDFEET_SUBDIVISION_LEVELS = 4
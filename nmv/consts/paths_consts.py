@@ -38,6 +38,9 @@ class Paths:
     # The folder where the images will be generated
     IMAGES_FOLDER = 'images'
 
+    # The folder where the quality assurance images and contact sheets will be generated
+    QA_FOLDER = 'qa'
+
     # The folder where the output morphologies will be generated
     MORPHOLOGIES_FOLDER = 'morphologies'
 
@@ -0,0 +1,95 @@
+###################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+
+####################################################################################################
+# @RenderProfile
+####################################################################################################
+class RenderProfile:
+    """The parameters of the rendering quality profiles.
+    The samples are the maximum samples per pixel, the adaptive sampling stops sampling a pixel
+    once its noise drops below the threshold, after the minimum samples.
+    """
+
+    ################################################################################################
+    # @__init__
+    ################################################################################################
+    def __init__(self):
+        pass
+
+    # Draft: maximum samples per pixel
+    DRAFT_SAMPLES = 8
+
+    # Draft: adaptive sampling noise threshold
+    DRAFT_ADAPTIVE_THRESHOLD = 0.1
+
+    # Draft: minimum samples per pixel before the adaptive sampling stops
+    DRAFT_ADAPTIVE_MIN_SAMPLES = 4
+
+    # Draft: denoise the image
+    DRAFT_DENOISING = True
+
+    # Draft: Workbench anti-aliasing samples
+    DRAFT_WORKBENCH_AA = 'FXAA'
+
+    # Draft: EEVEE samples
+    DRAFT_EEVEE_SAMPLES = 4
+
+    # Preview: maximum samples per pixel
+    PREVIEW_SAMPLES = 64
+
+    # Preview: adaptive sampling noise threshold
+    PREVIEW_ADAPTIVE_THRESHOLD = 0.05
+
+    # Preview: minimum samples per pixel before the adaptive sampling stops
+    PREVIEW_ADAPTIVE_MIN_SAMPLES = 8
+
+    # Preview: denoise the image
+    PREVIEW_DENOISING = True
+
+    # Preview: Workbench anti-aliasing samples
+    PREVIEW_WORKBENCH_AA = '8'
+
+    # Preview: EEVEE samples
+    PREVIEW_EEVEE_SAMPLES = 16
+
+    # Final: maximum samples per pixel
+    FINAL_SAMPLES = 512
+
+    # Final: adaptive sampling noise threshold
+    FINAL_ADAPTIVE_THRESHOLD = 0.01
+
+    # Final: minimum samples per pixel before the adaptive sampling stops
+    FINAL_ADAPTIVE_MIN_SAMPLES = 64
+
+    # Final: denoise the image
+    FINAL_DENOISING = True
+
+    # Final: Workbench anti-aliasing samples
+    FINAL_WORKBENCH_AA = '32'
+
+    # Final: EEVEE samples
+    FINAL_EEVEE_SAMPLES = 64
+
+    # The size of the render tiles in pixels
+    TILE_SIZE = 64
+
+    # The number of rendering threads, zero to detect the number of cores automatically
+    THREADS = 0
+
+    # Estimate the noise of every rendered image, it reads the image back from the disk
+    ESTIMATE_NOISE = False
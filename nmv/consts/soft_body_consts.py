@@ -52,3 +52,6 @@ class SoftBody:
 
     # Initial soma radius scale factor
     SOMA_SCALE_FACTOR = 0.5
+
+    # Default wall-clock budget of the particle remeshing of the soma in seconds, zero is unlimited
+    REMESHING_TIME_BUDGET_DEFAULT = 0.0
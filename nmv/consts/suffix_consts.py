@@ -59,6 +59,12 @@ class Suffix:
     # Suffix appended to the name of a top image of the morphology
     MORPHOLOGY_TOP = '_morphology_top'
 
+    # Suffix appended to the name of an image of the morphology at a custom camera angle
+    MORPHOLOGY_ANGLE = '_morphology_angle'
+
+    # Suffix appended to the name of a quality assurance image of the morphology
+    MORPHOLOGY_QA = '_morphology_qa'
+
     # Suffix appended to the name of a directory where a 360 of the morphology will be rendered
     MORPHOLOGY_360 = '_morphology_360'
 
@@ -74,6 +80,12 @@ class Suffix:
     # Suffix appended to the name of a top image of a reconstructed mesh
     MESH_TOP = '_mesh_top'
 
+    # Suffix appended to the name of an image of a reconstructed mesh at a custom camera angle
+    MESH_ANGLE = '_mesh_angle'
+
+    # Suffix appended to the name of a quality assurance image of a reconstructed mesh
+    MESH_QA = '_mesh_qa'
+
     # Suffix appended to the name of a directory where a 360 of the mesh will be rendered
     MESH_360 = '_mesh_360'
 
@@ -0,0 +1,110 @@
+###################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+####################################################################################################
+# @Validation
+####################################################################################################
+class Validation:
+    """Validation constants
+    """
+
+    ################################################################################################
+    # @__init__
+    ################################################################################################
+    def __init__(self):
+        pass
+
+    # Severities, a morphology with an ERROR does not pass the validation
+    ERROR = 'error'
+    WARNING = 'warning'
+    INFO = 'info'
+
+    # A section without samples
+    NO_SAMPLES = 'no-samples'
+
+    # A section with a single sample
+    SINGLE_SAMPLE = 'single-sample'
+
+    # A section with only two samples
+    TWO_SAMPLES = 'two-samples'
+
+    # A sample with non-finite coordinates
+    INVALID_POINT = 'invalid-point'
+
+    # A sample with a zero, negative or non-finite radius
+    INVALID_RADIUS = 'invalid-radius'
+
+    # A section shorter than the sum of the diameters of its first and last samples
+    SHORT_SECTION = 'short-section'
+
+    # A segment shorter than the radius of its first sample
+    SHORT_SEGMENT = 'short-segment'
+
+    # Two successive samples closer than the duplicates threshold
+    DUPLICATED_SAMPLES = 'duplicated-samples'
+
+    # A section with a single child
+    SINGLE_CHILD = 'single-child'
+
+    # A section with more than two children
+    MULTIPLE_CHILDREN = 'multiple-children'
+
+    # A section whose first sample is thicker than the last sample of its parent
+    RADIUS_AT_BRANCHING = 'radius-at-branching'
+
+    # The severities of the rules
+    SEVERITIES = {NO_SAMPLES: ERROR,
+                  SINGLE_SAMPLE: ERROR,
+                  TWO_SAMPLES: INFO,
+                  INVALID_POINT: ERROR,
+                  INVALID_RADIUS: ERROR,
+                  SHORT_SECTION: WARNING,
+                  SHORT_SEGMENT: INFO,
+                  DUPLICATED_SAMPLES: WARNING,
+                  SINGLE_CHILD: WARNING,
+                  MULTIPLE_CHILDREN: WARNING,
+                  RADIUS_AT_BRANCHING: WARNING}
+
+    # The rules that can be repaired, in the order of the repairs, the structural one is last
+    REPAIRABLE_RULES = [DUPLICATED_SAMPLES, RADIUS_AT_BRANCHING, SHORT_SECTION, SINGLE_CHILD]
+
+    # The distance below which two successive samples are duplicates, in microns
+    DUPLICATED_SAMPLES_THRESHOLD = 1.0
+
+    # The default number of the worker processes
+    DEFAULT_WORKERS = 4
+
+    # The number of the morphologies that a worker reads ahead of the validated one
+    PREFETCH_COUNT = 2
+
+    # The extensions of the morphology files
+    MORPHOLOGY_EXTENSIONS = ['.h5', '.swc']
+
+    # The name of the manifest of the validation
+    MANIFEST_FILE = 'validation.json'
+
+    # The name of the report of the validation
+    REPORT_FILE = 'validation_report.json'
+
+    # The name of the list of the morphologies that passed the validation
+    PASSED_FILE = 'passed_morphologies.txt'
+
+    # The directory where the repaired morphologies are written
+    REPAIRED_DIRECTORY = 'repaired'
+
+    # The directory where the reports of the morphologies are written by the workers
+    REPORTS_DIRECTORY = 'reports'
@@ -284,6 +284,43 @@ class Meshing:
         def __init__(self):
             pass
 
+    ################################################################################################
+    # @UnionMode
+    ################################################################################################
+    class UnionMode:
+        """How the union meshing technique merges the arbors, the soma and the spines
+        """
+
+        # Boolean union operators between the meshes
+        BOOLEAN = 'UNION_MODE_BOOLEAN'
+
+        # A signed distance grid, contoured into a single watertight and manifold mesh
+        VOXEL = 'UNION_MODE_VOXEL'
+
+        ############################################################################################
+        # @__init__
+        ############################################################################################
+        def __init__(self):
+            pass
+
+        ############################################################################################
+        # @get_enum
+        ############################################################################################
+        @staticmethod
+        def get_enum(argument):
+
+            # Voxel union
+            if argument == 'voxel':
+                return Meshing.UnionMode.VOXEL
+
+            # Boolean union
+            elif argument == 'boolean':
+                return Meshing.UnionMode.BOOLEAN
+
+            # By default use the boolean operators
+            else:
+                return Meshing.UnionMode.BOOLEAN
+
     ################################################################################################
     # @Spines
     ################################################################################################
@@ -109,3 +109,47 @@ class Rendering:
             # By default render at the specified resolution
             else:
                 return Rendering.Resolution.FIXED
+
+    ################################################################################################
+    # @Profile
+    ################################################################################################
+    class Profile:
+        """Rendering quality profiles, that control the cost of every rendered image
+        """
+
+        # A quick look, few samples and denoising
+        DRAFT = 'RENDER_PROFILE_DRAFT'
+
+        # A preview of good quality
+        PREVIEW = 'RENDER_PROFILE_PREVIEW'
+
+        # Final images for publications
+        FINAL = 'RENDER_PROFILE_FINAL'
+
+        ############################################################################################
+        # @__init__
+        ############################################################################################
+        def __init__(self):
+            pass
+
+        ############################################################################################
+        # @get_enum
+        ############################################################################################
+        @staticmethod
+        def get_enum(argument):
+
+            # Draft
+            if argument == 'draft':
+                return Rendering.Profile.DRAFT
+
+            # Preview
+            elif argument == 'preview':
+                return Rendering.Profile.PREVIEW
+
+            # Final
+            elif argument == 'final':
+                return Rendering.Profile.FINAL
+
+            # By default use the preview profile
+            else:
+                return Rendering.Profile.PREVIEW
@@ -105,8 +105,8 @@ def get_files_in_directory(directory,
             if i_file.endswith(file_extension):
                 files.append(i_file)
 
-    # Return the list
-    return files
+    # Return the list, sorted to be independent of the listing order of the file system
+    return sorted(files)
 
 
 ####################################################################################################
@@ -179,6 +179,10 @@ def create_output_tree(output_directory):
     images_directory = '%s/%s' % (output_directory, Paths.IMAGES_FOLDER)
     create_directory(images_directory)
 
+    # Quality assurance directory
+    qa_directory = '%s/%s' % (output_directory, Paths.QA_FOLDER)
+    create_directory(qa_directory)
+
     # Sequences directory
     sequences_directory = '%s/%s' % (output_directory, Paths.SEQUENCES_FOLDER)
     create_directory(sequences_directory)
@@ -15,6 +15,9 @@
 # If not, see <http://www.gnu.org/licenses/>.
 ####################################################################################################
 
+# System imports
+import numpy
+
 # Blender imports
 from mathutils import Vector
 
@@ -37,13 +40,17 @@ class H5Reader:
     ################################################################################################
     def __init__(self,
                  h5_file,
-                 center_morphology=True):
+                 center_morphology=True,
+                 lazy=False):
         """Constructor
 
         :param h5_file:
             A given .H5 morphology file.
         :param center_morphology:
             Center the morphology at the origin, by default True.
+        :param lazy:
+            If True, the samples of the sections are only created when the sections are visited,
+            by default False.
         """
 
         # Set the path to the given h5 file
@@ -70,6 +77,9 @@ class H5Reader:
         # Centering the morphology at the origin
         self.center_morphology = center_morphology
 
+        # Create the samples of the sections on demand
+        self.lazy = lazy
+
     ################################################################################################
     # @build_tree
     ################################################################################################
@@ -308,7 +318,8 @@ class H5Reader:
             A linear list of sections of the entire morphology.
         """
 
-        # Parse the sections and add them to a linear list [index, parent, type, samples]
+        # Parse the sections and add them to a linear list
+        # [index, parent, type, samples, samples descriptor]
         sections_list = list()
 
         for i_section in range(1, len(self.structure_list)):
@@ -343,37 +354,21 @@ class H5Reader:
             # Get the section parent index
             section_parent_index = int(self.structure_list[i_section][2])
 
-            # Get the positions and radii of each sample along the section
-            samples = list()
-
-            # Sample index
-            sample_index = 0
-
-            # Reconstruct the samples
-            for i_sample in range(section_first_point_index, section_last_point_index):
-
-                # Position
-                x = self.points_list[i_sample][nmv.consts.Skeleton.H5_SAMPLE_X_COORDINATES_IDX]
-                y = self.points_list[i_sample][nmv.consts.Skeleton.H5_SAMPLE_Y_COORDINATES_IDX]
-                z = self.points_list[i_sample][nmv.consts.Skeleton.H5_SAMPLE_Z_COORDINATES_IDX]
-                point = Vector((x, y, z))
-
-                # Radius
-                # NOTE: What is reported in our .H5 files is the diameter unlike the .SWC files
-                radius = self.points_list[i_sample][nmv.consts.Skeleton.H5_SAMPLE_RADIUS_IDX] / 2.0
-
-                # Build a NeuroMorphoVis sample
-                nmv_sample = nmv.skeleton.Sample(point=point, radius=radius, index=sample_index,
-                                                 morphology_id=sample_index, type=section_type)
-
-                # Add the sample to the list
-                samples.append(nmv_sample)
-
-                # Next sample
-                sample_index += 1
+            # Describe the samples to create them on demand, or create them right away
+            if self.lazy:
+                samples = None
+                samples_descriptor = create_h5_samples_descriptor(
+                    self.points_list, section_first_point_index, section_last_point_index,
+                    section_type)
+            else:
+                samples = create_h5_section_samples(
+                    self.points_list, section_first_point_index, section_last_point_index,
+                    section_type)
+                samples_descriptor = None
 
             # Build a section list until all the sections are parsed
-            section = [section_index, section_parent_index, section_type, samples]
+            section = [section_index, section_parent_index, section_type, samples,
+                       samples_descriptor]
 
             # Add this section to the parsed sections list
             sections_list.append(section)
@@ -437,13 +432,15 @@ class H5Reader:
             # Section type
             section_type = i_section[2]
 
-            # Section samples
+            # Section samples, or their descriptor if the morphology is loaded lazily
             section_samples = i_section[3]
+            section_samples_descriptor = i_section[4]
 
             # Construct a skeleton section
             nmv_section = nmv.skeleton.Section(
                 index=section_id, parent_index=section_parent_id, children_ids=section_children_ids,
-                samples=section_samples, type=section_type)
+                samples=section_samples, type=section_type,
+                samples_descriptor=section_samples_descriptor)
 
             # Axon
             if section_type == nmv.consts.Skeleton.H5_AXON_SECTION_TYPE:
@@ -535,3 +532,102 @@ class H5Reader:
 
         # Return a reference to the reconstructed morphology skeleton
         return nmv_morphology
+
+
+####################################################################################################
+# @create_h5_section_samples
+####################################################################################################
+def create_h5_section_samples(points_list,
+                              first_point_index,
+                              last_point_index,
+                              section_type):
+    """Creates the samples of a section from the points of an .H5 morphology.
+
+    :param points_list:
+        The points of the morphology file.
+    :param first_point_index:
+        The index of the first point of the section.
+    :param last_point_index:
+        The index of the point after the last one of the section.
+    :param section_type:
+        The type of the section.
+    :return:
+        A list of samples.
+    """
+
+    # Get the positions and radii of each sample along the section
+    samples = list()
+
+    # Sample index
+    sample_index = 0
+
+    # Reconstruct the samples
+    for i_sample in range(first_point_index, last_point_index):
+
+        # Position
+        x = points_list[i_sample][nmv.consts.Skeleton.H5_SAMPLE_X_COORDINATES_IDX]
+        y = points_list[i_sample][nmv.consts.Skeleton.H5_SAMPLE_Y_COORDINATES_IDX]
+        z = points_list[i_sample][nmv.consts.Skeleton.H5_SAMPLE_Z_COORDINATES_IDX]
+        point = Vector((x, y, z))
+
+        # Radius
+        # NOTE: What is reported in our .H5 files is the diameter unlike the .SWC files
+        radius = points_list[i_sample][nmv.consts.Skeleton.H5_SAMPLE_RADIUS_IDX] / 2.0
+
+        # Build a NeuroMorphoVis sample
+        nmv_sample = nmv.skeleton.Sample(point=point, radius=radius, index=sample_index,
+                                         morphology_id=sample_index, type=section_type)
+
+        # Add the sample to the list
+        samples.append(nmv_sample)
+
+        # Next sample
+        sample_index += 1
+
+    # Return the samples
+    return samples
+
+
+####################################################################################################
+# @create_h5_samples_descriptor
+####################################################################################################
+def create_h5_samples_descriptor(points_list,
+                                 first_point_index,
+                                 last_point_index,
+                                 section_type):
+    """Creates a descriptor of the samples of a section over the points of an .H5 morphology.
+
+    :param points_list:
+        The points of the morphology file.
+    :param first_point_index:
+        The index of the first point of the section.
+    :param last_point_index:
+        The index of the point after the last one of the section.
+    :param section_type:
+        The type of the section.
+    :return:
+        A SamplesDescriptor.
+    """
+
+    # The samples are created from the shared points when the section is visited
+    def loader():
+        return create_h5_section_samples(
+            points_list, first_point_index, last_point_index, section_type)
+
+    # The bounding box of the points of the section
+    number_samples = max(last_point_index - first_point_index, 0)
+    p_min = [1e10, 1e10, 1e10]
+    p_max = [-1e10, -1e10, -1e10]
+    if number_samples > 0:
+        axes = [nmv.consts.Skeleton.H5_SAMPLE_X_COORDINATES_IDX,
+                nmv.consts.Skeleton.H5_SAMPLE_Y_COORDINATES_IDX,
+                nmv.consts.Skeleton.H5_SAMPLE_Z_COORDINATES_IDX]
+        points = numpy.asarray(points_list[first_point_index:last_point_index])[:, axes]
+        p_min = [float(value) for value in points.min(axis=0)]
+        p_max = [float(value) for value in points.max(axis=0)]
+
+    # The samples are indexed along the section
+    return nmv.skeleton.SamplesDescriptor(
+        loader=loader, number_samples=number_samples, first_sample_index=0,
+        last_sample_index=number_samples - 1, first_sample_parent_index=-1,
+        p_min=p_min, p_max=p_max)
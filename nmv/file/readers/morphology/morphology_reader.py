@@ -25,12 +25,14 @@ import nmv.file
 ####################################################################################################
 # @read_h5_morphology
 ####################################################################################################
-def read_h5_morphology(h5_file):
+def read_h5_morphology(h5_file,
+                       lazy=False):
     """Verifies if the given path is valid or not and then loads a .h5 morphology file.
 
     If the path is not valid, this function returns None.
 
     :param h5_file: Path to the H5 morphology file.
+    :param lazy: Create the samples of the sections only when the sections are visited.
     :return: A morphology object or None if the path is not valid.
     """
 
@@ -38,7 +40,7 @@ def read_h5_morphology(h5_file):
     if os.path.isfile(h5_file):
 
         # Load the .h5 morphology
-        reader = nmv.file.readers.H5Reader(h5_file=h5_file)
+        reader = nmv.file.readers.H5Reader(h5_file=h5_file, lazy=lazy)
         morphology_object = reader.read_file()
 
         # Return a reference to this morphology object
@@ -54,13 +56,16 @@ def read_h5_morphology(h5_file):
 ####################################################################################################
 # @read_swc_morphology
 ####################################################################################################
-def read_swc_morphology(swc_file):
+def read_swc_morphology(swc_file,
+                        lazy=False):
     """Verifies if the given path is valid or not and then loads a .swc morphology file.
 
     If the path is not valid, this function returns None.
 
     :param swc_file:
         Path to the SWC morphology file.
+    :param lazy:
+        Create the samples of the sections only when the sections are visited, by default False.
     :return:
         Morphology object and True (if the morphology is loaded) or False (if the something is
         wrong).
@@ -70,7 +75,7 @@ def read_swc_morphology(swc_file):
     if os.path.isfile(swc_file):
 
         # Load the .h5 morphology
-        reader = nmv.file.readers.SWCReader(swc_file=swc_file)
+        reader = nmv.file.readers.SWCReader(swc_file=swc_file, lazy=lazy)
         morphology_object = reader.read_file()
 
         # Return a reference to this morphology object
@@ -106,12 +111,14 @@ def read_morphology_from_file(options):
     if '.h5' in morphology_extension:
 
         # Load the .h5 file
-        morphology_object = read_h5_morphology(morphology_file_path)
+        morphology_object = read_h5_morphology(
+            morphology_file_path, lazy=options.morphology.lazy_loading)
 
     elif '.swc' in morphology_extension:
 
         # Load the .swc file
-        morphology_object = read_swc_morphology(morphology_file_path)
+        morphology_object = read_swc_morphology(
+            morphology_file_path, lazy=options.morphology.lazy_loading)
 
     else:
 
@@ -182,13 +189,11 @@ def load_from_circuit(options):
     wrong)
     """
 
-    morphology_object = None
-
-    morphology_object = nmv.file.BBPReader.load_morphology_from_circuit(
+    loading_flag, morphology_object = nmv.file.BBPReader.load_morphology_from_circuit(
         blue_config=options.morphology.blue_config, gid=options.morphology.gid)
 
     # If the morphology object is None, return False
-    if morphology_object is None:
+    if not loading_flag or morphology_object is None:
         return False, None
 
     # The morphology file was loaded successfully
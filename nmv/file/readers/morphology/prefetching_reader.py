@@ -0,0 +1,213 @@
+####################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+# System imports
+import collections
+import concurrent.futures
+import copy
+import os
+import time
+
+# Internal imports
+import nmv.file
+from .morphology_reader import *
+
+
+####################################################################################################
+# @read_morphology
+####################################################################################################
+def read_morphology(options):
+    """Loads the morphology given in the options, either from a file or from a circuit.
+
+    :param options:
+        A reference to the system options.
+    :return:
+        Morphology object and True (if the morphology is loaded) or False (if the something is
+        wrong).
+    """
+
+    # A GID in a circuit
+    if options.morphology.gid is not None:
+        return load_from_circuit(options)
+
+    # A file
+    return read_morphology_from_file(options)
+
+
+####################################################################################################
+# @create_options_for_morphology_file
+####################################################################################################
+def create_options_for_morphology_file(options,
+                                       morphology_file_path):
+    """Creates the options of a single morphology file of a batch from the options of the batch.
+
+    The morphology options are copied, and the other options are shared with the batch.
+
+    :param options:
+        The options of the batch.
+    :param morphology_file_path:
+        The path to the morphology file.
+    :return:
+        The options of the morphology.
+    """
+
+    morphology_options = copy.copy(options)
+    morphology_options.morphology = copy.copy(options.morphology)
+    morphology_options.morphology.gid = None
+    morphology_options.morphology.morphology_file_path = morphology_file_path
+    morphology_options.morphology.label = nmv.file.ops.get_file_name_from_path(
+        morphology_file_path)
+    return morphology_options
+
+
+####################################################################################################
+# @create_options_for_morphology_directory
+####################################################################################################
+def create_options_for_morphology_directory(options,
+                                            morphology_directory):
+    """Creates the options of all the morphology files (.H5 or .SWC) in a directory.
+
+    :param options:
+        The options of the batch.
+    :param morphology_directory:
+        The directory of the morphologies.
+    :return:
+        A list of the options of the morphologies, sorted by the names of the files.
+    """
+
+    morphology_files = nmv.file.ops.get_files_in_directory(morphology_directory, '.h5')
+    morphology_files.extend(nmv.file.ops.get_files_in_directory(morphology_directory, '.swc'))
+    return [create_options_for_morphology_file(
+        options, os.path.join(morphology_directory, morphology_file))
+        for morphology_file in sorted(morphology_files)]
+
+
+####################################################################################################
+# @MorphologyPrefetcher
+####################################################################################################
+class MorphologyPrefetcher:
+    """Reads the morphologies of a batch on background threads ahead of their processing.
+
+    While the current morphology is built, meshed or rendered, the next ones are read and parsed
+    on a pool of threads, so the latency of the file system, in particular a network one, is
+    hidden. At most @prefetch_count morphologies are read ahead of the consumer, which bounds the
+    memory of the pipeline. The morphologies are returned in the order of the batch.
+
+    Threads are used rather than processes, because the parsed morphologies reference Blender
+    math types that cannot be sent between processes, and because the reading of the files
+    releases the interpreter lock. The readers must not access the Blender data.
+    """
+
+    ################################################################################################
+    # @__init__
+    ################################################################################################
+    def __init__(self,
+                 options_list,
+                 prefetch_count=2,
+                 number_threads=2,
+                 reader=read_morphology):
+        """Constructor
+
+        :param options_list:
+            A list of the options of the morphologies, one per morphology.
+        :param prefetch_count:
+            The maximum number of the morphologies that are read ahead of the consumer.
+        :param number_threads:
+            The number of the reading threads.
+        :param reader:
+            The function that reads a morphology from its options and returns a loading flag and
+            the morphology.
+        """
+
+        # Batch
+        self.options_list = options_list
+
+        # Parameters
+        self.prefetch_count = max(1, prefetch_count)
+        self.number_threads = max(1, number_threads)
+        self.reader = reader
+
+        # The time the consumer has waited for the readers, i.e. the latency that is not hidden
+        self.waiting_time = 0.0
+
+    ################################################################################################
+    # @read
+    ################################################################################################
+    def read(self,
+             options):
+        """Reads a morphology and reports the errors instead of raising them in the consumer.
+
+        :param options:
+            The options of the morphology.
+        :return:
+            The loading flag and the morphology.
+        """
+
+        try:
+            return self.reader(options)
+        except Exception as e:
+            nmv.logger.log('ERROR: Cannot read the morphology [%s], %s' %
+                           (options.morphology.label, str(e)))
+            return False, None
+
+    ################################################################################################
+    # @__iter__
+    ################################################################################################
+    def __iter__(self):
+        """Iterates over the morphologies of the batch.
+
+        :return:
+            A generator of (options, loading flag, morphology) for every morphology of the batch.
+        """
+
+        self.waiting_time = 0.0
+        start_time = time.time()
+        options_iterator = iter(self.options_list)
+        pending = collections.deque()
+        executor = concurrent.futures.ThreadPoolExecutor(max_workers=self.number_threads)
+        try:
+
+            # Read ahead
+            for options in options_iterator:
+                pending.append([options, executor.submit(self.read, options)])
+                if len(pending) == self.prefetch_count:
+                    break
+
+            while len(pending) > 0:
+                options, future = pending.popleft()
+
+                # Wait for the next morphology
+                waiting_start = time.time()
+                loading_flag, morphology = future.result()
+                self.waiting_time += time.time() - waiting_start
+
+                # Keep the readers busy while this one is processed
+                for next_options in options_iterator:
+                    pending.append([next_options, executor.submit(self.read, next_options)])
+                    break
+
+                yield options, loading_flag, morphology
+
+        finally:
+
+            # Drop the prefetched morphologies if the consumer stops early
+            for _, future in pending:
+                future.cancel()
+            executor.shutdown(wait=True)
+
+        nmv.logger.statistics('Batch read in [%f] seconds, the reading stalled [%f] seconds' %
+                              (time.time() - start_time, self.waiting_time))
@@ -36,16 +36,23 @@ class SWCReader:
     # @__init__
     ################################################################################################
     def __init__(self,
-                 swc_file):
+                 swc_file,
+                 lazy=False):
         """Constructor
 
         :param swc_file:
             A given .SWC morphology file.
+        :param lazy:
+            If True, the samples of the sections are only created when the sections are visited,
+            by default False.
         """
 
         # Set the path to the given h5 file
         self.morphology_file = swc_file
 
+        # Create the samples of the sections on demand
+        self.lazy = lazy
+
         # The samples list parsed from the morphology file
         self.parsed_samples_list = list()
 
@@ -380,6 +387,61 @@ class SWCReader:
         # Return a reference to the reconstructed object
         return nmv_sample
 
+    ################################################################################################
+    # @get_nmv_samples_from_samples_list
+    ################################################################################################
+    def get_nmv_samples_from_samples_list(self,
+                                          samples_indices):
+        """Gets a list of NeuroMorphoVis samples from the original list of samples that was parsed
+        from the SWC morphology file.
+
+        :param samples_indices:
+            The indices of the samples.
+        :return:
+            A list of NeuroMorphoVis sample objects.
+        """
+
+        return [self.get_nmv_sample_from_samples_list(i) for i in samples_indices]
+
+    ################################################################################################
+    # @get_samples_descriptor
+    ################################################################################################
+    def get_samples_descriptor(self,
+                               samples_indices):
+        """Creates a descriptor of the samples of a section over the original list of samples
+        that was parsed from the SWC morphology file.
+
+        :param samples_indices:
+            The indices of the samples of the section.
+        :return:
+            A SamplesDescriptor.
+        """
+
+        # The samples are created from the parsed list when the section is visited
+        reader = self
+
+        def loader():
+            return reader.get_nmv_samples_from_samples_list(samples_indices)
+
+        # The bounding box of the samples of the section
+        p_min = [1e10, 1e10, 1e10]
+        p_max = [-1e10, -1e10, -1e10]
+        for sample_index in samples_indices:
+            sample_data = self.samples_list[sample_index]
+            for i in range(3):
+                p_min[i] = min(p_min[i], sample_data[2 + i])
+                p_max[i] = max(p_max[i], sample_data[2 + i])
+
+        # The terminal samples, identified by their indices in the file
+        first_sample_data = self.samples_list[samples_indices[0]]
+        last_sample_data = self.samples_list[samples_indices[-1]]
+
+        # Return the descriptor
+        return nmv.skeleton.SamplesDescriptor(
+            loader=loader, number_samples=len(samples_indices),
+            first_sample_index=first_sample_data[0], last_sample_index=last_sample_data[0],
+            first_sample_parent_index=first_sample_data[6], p_min=p_min, p_max=p_max)
+
     ################################################################################################
     # @get_samples_list_by_type
     ################################################################################################
@@ -522,8 +584,8 @@ class SWCReader:
         # For each section
         for arbor_section in arbor_sections_samples_indices_list:
 
-            # Construct the samples list
-            samples_list = list()
+            # Construct the list of the indices of the samples
+            samples_indices = list()
 
             # A flag to indicate whether this section is root or not
             is_root_section = False
@@ -543,15 +605,18 @@ class SWCReader:
                     is_root_section = True
                     continue
 
-                # Get the a nmv sample based on its index
-                nmv_sample = self.get_nmv_sample_from_samples_list(arbor_sample_index)
+                # Add the index of the sample
+                samples_indices.append(arbor_sample_index)
 
-                # Add a new NMV sample
-                samples_list.append(nmv_sample)
-
-            # Construct an nmv section that ONLY contains the samples list, and UPDATE its other
-            # members later when all the other sections are reconstructed
-            nmv_section = nmv.skeleton.Section(samples=samples_list)
+            # Construct an nmv section that ONLY contains the samples list, or their descriptor
+            # if the morphology is loaded lazily, and UPDATE its other members later when all the
+            # other sections are reconstructed
+            if self.lazy:
+                nmv_section = nmv.skeleton.Section(
+                    samples_descriptor=self.get_samples_descriptor(samples_indices))
+            else:
+                nmv_section = nmv.skeleton.Section(
+                    samples=self.get_nmv_samples_from_samples_list(samples_indices))
 
             # If this is a root sample, indicate that this section is a root
             if is_root_section:
@@ -18,4 +18,4 @@
 from .morphology import *
 from .mesh import *
 from .strings import *
-
+from .image import *
@@ -0,0 +1,246 @@
+####################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+# System imports
+import struct
+import zlib
+import numpy
+
+
+# TIFF field types
+TIFF_SHORT = 3
+TIFF_LONG = 4
+TIFF_LONG8 = 16
+
+# The size of a classic TIFF file is limited by its 32-bit offsets, use a margin for the headers
+CLASSIC_TIFF_LIMIT = 2 ** 32 - 2 ** 26
+
+
+####################################################################################################
+# @TiledTiffWriter
+####################################################################################################
+class TiledTiffWriter:
+    """Writes an RGBA image to a tiled TIFF file, one tile at a time.
+
+    The tiles are streamed to the file in row-major order and only the offsets of the tiles are
+    kept in memory, so the memory footprint is bounded by a single tile regardless of the size of
+    the image. The images that can exceed 4 GB are written as BigTIFF. The tiles are compressed
+    with deflate.
+    """
+
+    ################################################################################################
+    # @__init__
+    ################################################################################################
+    def __init__(self,
+                 file_path,
+                 width,
+                 height,
+                 tile_size,
+                 use_float=False):
+        """Constructor
+
+        :param file_path:
+            The path to the output .TIFF file.
+        :param width:
+            The width of the image in pixels.
+        :param height:
+            The height of the image in pixels.
+        :param tile_size:
+            The size of the square tiles in pixels, a multiple of 16.
+        :param use_float:
+            If True, the samples are 32-bit floats, otherwise 8-bit unsigned integers.
+        """
+
+        if tile_size % 16 != 0:
+            raise ValueError('The size of the TIFF tiles must be a multiple of 16')
+
+        # Image parameters
+        self.width = width
+        self.height = height
+        self.tile_size = tile_size
+        self.use_float = use_float
+        self.dtype = numpy.dtype('<f4') if use_float else numpy.dtype('u1')
+
+        # The grid of the tiles
+        self.tiles_x = (width + tile_size - 1) // tile_size
+        self.tiles_y = (height + tile_size - 1) // tile_size
+
+        # Use BigTIFF if the image may not fit in a classic TIFF, deflate may slightly expand
+        raw_size = self.tiles_x * self.tiles_y * tile_size * tile_size * 4 * self.dtype.itemsize
+        self.big_tiff = raw_size * 1.01 > CLASSIC_TIFF_LIMIT
+
+        # The offsets and the sizes of the written tiles
+        self.tile_offsets = list()
+        self.tile_byte_counts = list()
+
+        # Open the file and write a header, the offset of the directory is patched on closing
+        self.file = open(file_path, 'wb')
+        if self.big_tiff:
+            self.file.write(b'II' + struct.pack('<HHHQ', 43, 8, 0, 0))
+        else:
+            self.file.write(b'II' + struct.pack('<HI', 42, 0))
+
+    ################################################################################################
+    # @get_number_tiles
+    ################################################################################################
+    def get_number_tiles(self):
+        """Gets the number of the tiles of the image.
+
+        :return:
+            The number of the tiles.
+        """
+
+        return self.tiles_x * self.tiles_y
+
+    ################################################################################################
+    # @write_tile
+    ################################################################################################
+    def write_tile(self,
+                   tile):
+        """Writes the next tile of the image, in row-major order.
+
+        :param tile:
+            An array of shape (rows, columns, 4) whose first row is the top of the tile. The edge
+            tiles may be smaller than the tile size, they are padded with transparent pixels.
+        """
+
+        if len(self.tile_offsets) == self.get_number_tiles():
+            raise ValueError('All the tiles of the image are already written')
+
+        # Pad the tile to the full tile size
+        data = numpy.zeros((self.tile_size, self.tile_size, 4), dtype=self.dtype)
+        rows = min(tile.shape[0], self.tile_size)
+        columns = min(tile.shape[1], self.tile_size)
+        data[:rows, :columns, :] = tile[:rows, :columns, :4]
+
+        # Compress and write the tile
+        compressed = zlib.compress(data.tobytes(), 6)
+        self.tile_offsets.append(self.file.tell())
+        self.tile_byte_counts.append(len(compressed))
+        self.file.write(compressed)
+
+    ################################################################################################
+    # @get_entry
+    ################################################################################################
+    def get_entry(self,
+                  tag,
+                  field_type,
+                  values):
+        """Creates an entry of the image file directory. The values that do not fit in the entry
+        are stored after the directory and the entry points to them.
+
+        :param tag:
+            The TIFF tag.
+        :param field_type:
+            The type of the values, SHORT, LONG or LONG8.
+        :param values:
+            A list of values.
+        :return:
+            The bytes of the entry, and None for inline values or the format of the offset and the
+            bytes of the external values, where the offset must be appended to the entry.
+        """
+
+        # Pack the values
+        value_format = {TIFF_SHORT: 'H', TIFF_LONG: 'I', TIFF_LONG8: 'Q'}[field_type]
+        data = struct.pack('<%d%s' % (len(values), value_format), *values)
+
+        # The size of the value field of the entry
+        inline_size = 8 if self.big_tiff else 4
+        count_format = '<HHQ' if self.big_tiff else '<HHI'
+        offset_format = '<Q' if self.big_tiff else '<I'
+
+        # Inline values
+        if len(data) <= inline_size:
+            return struct.pack(count_format, tag, field_type, len(values)) + \
+                data.ljust(inline_size, b'\0'), None
+
+        # External values, the offset is patched once the directory is placed
+        return struct.pack(count_format, tag, field_type, len(values)), [offset_format, data]
+
+    ################################################################################################
+    # @close
+    ################################################################################################
+    def close(self):
+        """Writes the image file directory and closes the file.
+        """
+
+        if len(self.tile_offsets) != self.get_number_tiles():
+            self.file.close()
+            raise ValueError('The image has [%d] tiles, but only [%d] are written' %
+                             (self.get_number_tiles(), len(self.tile_offsets)))
+
+        # Word-aligned directory
+        if self.file.tell() % 2 != 0:
+            self.file.write(b'\0')
+        directory_offset = self.file.tell()
+
+        # The offsets use 64-bit values in BigTIFF
+        offset_type = TIFF_LONG8 if self.big_tiff else TIFF_LONG
+        bits_per_sample = 32 if self.use_float else 8
+        sample_format = 3 if self.use_float else 1
+
+        # The entries, sorted by tag
+        entries = [[256, TIFF_LONG, [self.width]],
+                   [257, TIFF_LONG, [self.height]],
+                   [258, TIFF_SHORT, [bits_per_sample] * 4],
+                   [259, TIFF_SHORT, [8]],
+                   [262, TIFF_SHORT, [2]],
+                   [277, TIFF_SHORT, [4]],
+                   [284, TIFF_SHORT, [1]],
+                   [322, TIFF_LONG, [self.tile_size]],
+                   [323, TIFF_LONG, [self.tile_size]],
+                   [324, offset_type, self.tile_offsets],
+                   [325, offset_type, self.tile_byte_counts],
+                   [338, TIFF_SHORT, [2]],
+                   [339, TIFF_SHORT, [sample_format] * 4]]
+
+        # The layout of the directory
+        if self.big_tiff:
+            count_bytes = struct.pack('<Q', len(entries))
+            entry_size, next_size = 20, 8
+        else:
+            count_bytes = struct.pack('<H', len(entries))
+            entry_size, next_size = 12, 4
+        external_offset = directory_offset + len(count_bytes) + entry_size * len(entries) + \
+            next_size
+
+        # Build the entries and place their external values after the directory
+        directory = count_bytes
+        external = b''
+        for tag, field_type, values in entries:
+            entry, external_value = self.get_entry(tag, field_type, values)
+            if external_value is not None:
+                offset_format, data = external_value
+                entry += struct.pack(offset_format, external_offset + len(external))
+                external += data
+                if len(external) % 2 != 0:
+                    external += b'\0'
+            directory += entry
+
+        # No next directory
+        directory += b'\0' * next_size
+
+        # Write the directory and patch its offset in the header
+        self.file.write(directory)
+        self.file.write(external)
+        if self.big_tiff:
+            self.file.seek(8)
+            self.file.write(struct.pack('<Q', directory_offset))
+        else:
+            self.file.seek(4)
+            self.file.write(struct.pack('<I', directory_offset))
+        self.file.close()
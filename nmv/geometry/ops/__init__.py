@@ -17,6 +17,7 @@
 ####################################################################################################
 
 from .intersection import *
+from .meta_ball_ops import *
 from .line_ops import *
 from .sphere_ops import *
 from .poly_line_ops import *
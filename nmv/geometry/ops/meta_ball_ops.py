@@ -0,0 +1,62 @@
+####################################################################################################
+#  Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This library is free software; you can redistribute it and/or modify it under the terms of the
+# GNU Lesser General Public License version 3.0 as published by the Free Software Foundation.
+#
+# This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+# without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+# See the GNU Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License along with this library;
+# if not, write to the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+# MA 02110-1301 USA.
+####################################################################################################
+
+# System imports
+import numpy
+
+
+####################################################################################################
+# @add_meta_elements_in_bulk
+####################################################################################################
+def add_meta_elements_in_bulk(meta_skeleton,
+                              locations,
+                              radii):
+    """Adds a set of meta elements to a meta skeleton and sets their locations and radii with
+    a single foreach_set call instead of setting every element separately.
+
+    :param meta_skeleton:
+        A given meta skeleton (bpy.data.metaballs) to add the elements to.
+    :param locations:
+        A numpy array of shape (N, 3) with the locations of the new elements.
+    :param radii:
+        A numpy array of shape (N,) with the radii of the new elements.
+    """
+
+    locations = numpy.asarray(locations, dtype=numpy.float32).reshape((-1, 3))
+    radii = numpy.asarray(radii, dtype=numpy.float32).reshape((-1,))
+
+    # Nothing to add
+    number_new_elements = len(radii)
+    if number_new_elements == 0:
+        return
+
+    # Get the data of the existing elements, since foreach_set updates the whole collection
+    elements = meta_skeleton.elements
+    number_existing_elements = len(elements)
+    existing_locations = numpy.zeros(number_existing_elements * 3, dtype=numpy.float32)
+    existing_radii = numpy.zeros(number_existing_elements, dtype=numpy.float32)
+    elements.foreach_get('co', existing_locations)
+    elements.foreach_get('radius', existing_radii)
+
+    # Allocate the new elements, Blender does not provide a bulk allocation for meta elements
+    for _ in range(number_new_elements):
+        elements.new()
+
+    # Set the locations and radii of all the elements at once
+    elements.foreach_set('co', numpy.concatenate((existing_locations, locations.ravel())))
+    elements.foreach_set('radius', numpy.concatenate((existing_radii, radii)))
@@ -47,6 +47,9 @@ class Args:
     # A directory containing a group of morphology files
     MORPHOLOGY_DIRECTORY = '--morphology-directory'
 
+    # Create the samples of the sections of the morphology on demand
+    LAZY_MORPHOLOGY = '--lazy-morphology'
+
     # A single GID
     GID = '--gid'
 
@@ -77,6 +80,9 @@ class Args:
     # Soma subdivision level
     SOMA_SUBDIVISION_LEVEL = '--soma-subdivision-level'
 
+    # Soma remeshing time budget
+    SOMA_REMESHING_TIME_BUDGET = '--soma-remeshing-time-budget'
+
     ################################################################################################
     # Morphology arguments
     ################################################################################################
@@ -198,6 +204,18 @@ class Args:
     # Connect the soma to the arbors
     CONNECT_SOMA_ARBORS = '--connect-soma-arbors'
 
+    # Seed of the stochastic builders
+    RANDOM_SEED = '--random-seed'
+
+    # Worker processes of the union meshing
+    UNION_WORKERS = '--union-workers'
+
+    # Union mode of the union meshing (boolean or voxel)
+    UNION_MODE = '--union-mode'
+
+    # Voxel size of the voxel union
+    VOXEL_SIZE = '--voxel-size'
+
     ################################################################################################
     # Geometry export arguments
     ################################################################################################
@@ -274,6 +292,9 @@ class Args:
     # The view or the direction of the camera
     CAMERA_VIEW = '--camera-view'
 
+    # Custom camera angles around the Y-axis, rendered in the same session as the views
+    CAMERA_ANGLES = '--camera-angles'
+
     # The size of a close up view in microns
     CLOSE_UP_DIMENSIONS = '--close-up-dimensions'
 
@@ -286,8 +307,35 @@ class Args:
     # Image file format or extensions
     IMAGE_FILE_FORMAT = '--image-file-format'
 
+    # Rendering profile
+    RENDER_PROFILE = '--render-profile'
+
+    # The number of rendering threads
+    RENDER_THREADS = '--render-threads'
+
+    # Estimate the noise of every rendered image
+    ESTIMATE_RENDER_NOISE = '--estimate-render-noise'
+
+    # The size of the tiles of the tiled to-scale rendering, zero to render a single image
+    RENDER_TILE_SIZE = '--render-tile-size'
+
+    # The number of the workers of the tiled rendering
+    RENDER_TILE_WORKERS = '--render-tile-workers'
+
+    # Stitch the tiles into a 32-bit float image
+    RENDER_TILE_HDR = '--render-tile-hdr'
+
+    # Render a quick quality assurance image of every neuron and a contact sheet of the batch
+    QA_RENDER = '--qa-render'
+
+    # The resolution of the quality assurance images
+    QA_RESOLUTION = '--qa-resolution'
+
     ################################################################################################
     # Execution arguments
     ################################################################################################
     # Execution node
     EXECUTION_NODE = '--execution-node'
+
+    # The number of the morphologies that are read ahead in a batch processed in a single job
+    PREFETCH_MORPHOLOGIES = '--prefetch-morphologies'
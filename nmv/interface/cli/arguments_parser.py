@@ -85,6 +85,15 @@ def parse_command_line_arguments():
         action='store', default=None,
         help=arg_help)
 
+    # Lazy loading
+    arg_help = 'Create the samples of the sections of the morphology only when they are ' \
+               'visited, to reduce the memory and the loading time of large morphologies ' \
+               'that are partially reconstructed.'
+    input_args.add_argument(
+        Args.LAZY_MORPHOLOGY,
+        action='store_true', default=False,
+        help=arg_help)
+
     # Cell GID, requires a circuit configuration
     arg_help = 'Cell GID (requires BBP circuit).'
     input_args.add_argument(
@@ -149,6 +158,14 @@ def parse_command_line_arguments():
         Args.SOMA_SUBDIVISION_LEVEL,
         action='store', type=int, default=5,
         help=arg_help)
+
+    # Soma remeshing time budget
+    arg_help = 'Wall-clock budget of the particle remeshing of the soma in seconds. \n' \
+               'Default 0, unlimited.'
+    soma_args.add_argument(
+        Args.SOMA_REMESHING_TIME_BUDGET,
+        action='store', type=float, default=0.0,
+        help=arg_help)
     
     ################################################################################################
     # Morphology arguments
@@ -494,6 +511,42 @@ def parse_command_line_arguments():
         action='store_true', default=False,
         help=arg_help)
 
+    # Seed of the stochastic builders
+    arg_help = 'Seed of the spines, nucleus, soma remeshing and surface noise builders. \n' \
+               'Identical inputs with the same seed give identical meshes. \n' \
+               'Default None, non-deterministic.'
+    meshing_args.add_argument(
+        Args.RANDOM_SEED,
+        action='store', type=int, default=None,
+        help=arg_help)
+
+    # Worker processes of the union meshing
+    arg_help = 'Number of the worker processes that union the meshes of the arbors in \n' \
+               'parallel in the union meshing algorithm. \n' \
+               'Default 1, the union runs in process.'
+    meshing_args.add_argument(
+        Args.UNION_WORKERS,
+        action='store', type=int, default=1,
+        help=arg_help)
+
+    # Union mode of the union meshing
+    arg_options = ['(boolean)', 'voxel']
+    arg_help = 'How the union meshing algorithm merges the arbors, the soma and the spines. \n' \
+               'The voxel mode creates a single watertight and manifold mesh. \n' \
+               'Options: %s' % arg_options
+    meshing_args.add_argument(
+        Args.UNION_MODE,
+        action='store', default='boolean',
+        help=arg_help)
+
+    # Voxel size of the voxel union
+    arg_help = 'The size of the voxels of the voxel union in microns. \n' \
+               'Default 0.2.'
+    meshing_args.add_argument(
+        Args.VOXEL_SIZE,
+        action='store', type=float, default=0.2,
+        help=arg_help)
+
     ################################################################################################
     # Geometry export arguments
     ################################################################################################
@@ -672,6 +725,16 @@ def parse_command_line_arguments():
         action='store', default='front',
         help=arg_help)
 
+    # Custom camera angles
+    arg_help = 'A comma-separated list of camera angles around the Y-axis in degrees, where 0 is ' \
+               'the front view, for example 45,135. \n' \
+               'The angles are rendered in the same session of the camera views. \n' \
+               'Default None.'
+    rendering_args.add_argument(
+        Args.CAMERA_ANGLES,
+        action='store', default=None,
+        help=arg_help)
+
     # Close up dimensions (the view around the soma in microns)
     arg_help = 'Close up dimensions (the view around the soma in microns). \n' \
                'Valid only when the --rendering-view = close-up. \n' \
@@ -707,6 +770,74 @@ def parse_command_line_arguments():
         action='store', default='png',
         help=arg_help)
 
+    # Rendering profile
+    arg_options = ['draft', '(preview)', 'final']
+    arg_help = 'The rendering profile, that controls the samples, the adaptive sampling and the ' \
+               'denoising of every image. \n' \
+               'Options: %s' % arg_options
+    rendering_args.add_argument(
+        Args.RENDER_PROFILE,
+        action='store', default='preview',
+        help=arg_help)
+
+    # Rendering threads
+    arg_help = 'The number of rendering threads, zero to use all the cores. \n' \
+               'Default 0.'
+    rendering_args.add_argument(
+        Args.RENDER_THREADS,
+        action='store', type=int, default=0,
+        help=arg_help)
+
+    # Rendering noise
+    arg_help = 'Estimate and log the noise level of every rendered image, to compare the ' \
+               'profiles. It reads every image back from the disk.'
+    rendering_args.add_argument(
+        Args.ESTIMATE_RENDER_NOISE,
+        action='store_true', default=False,
+        help=arg_help)
+
+    # Tile size
+    arg_help = 'Render the to-scale images in tiles of this size in pixels, that are rendered ' \
+               'by parallel workers, locally or on the cluster, and stitched into a tiled ' \
+               '.TIFF image. Use it for images that do not fit in a single render. \n' \
+               'Default 0, i.e. a single image.'
+    rendering_args.add_argument(
+        Args.RENDER_TILE_SIZE,
+        action='store', type=int, default=0,
+        help=arg_help)
+
+    # Tile workers
+    arg_help = 'The number of the workers of the tiled rendering. \n' \
+               'Default 4.'
+    rendering_args.add_argument(
+        Args.RENDER_TILE_WORKERS,
+        action='store', type=int, default=4,
+        help=arg_help)
+
+    # HDR tiles
+    arg_help = 'Stitch the tiles into a 32-bit float .TIFF image instead of an 8-bit one.'
+    rendering_args.add_argument(
+        Args.RENDER_TILE_HDR,
+        action='store_true', default=False,
+        help=arg_help)
+
+    # QA render
+    arg_help = 'Render a quick quality assurance image of every neuron with the Workbench, ' \
+               'using flat per-arbor colors at a low resolution, and assemble the images of the ' \
+               'batch into contact sheets. The flat shader is used for all the renders.'
+    rendering_args.add_argument(
+        Args.QA_RENDER,
+        action='store_true', default=False,
+        help=arg_help)
+
+    # QA resolution
+    arg_help = 'The resolution of the quality assurance images. \n' \
+               'Default 256.'
+    rendering_args.add_argument(
+        Args.QA_RESOLUTION,
+        action='store', type=int, default=256,
+        help=arg_help)
+
     ################################################################################################
     # Execution arguments
     ################################################################################################
@@ -721,6 +852,16 @@ def parse_command_line_arguments():
         action='store', default='local',
         help=arg_help)
 
+    # Prefetching
+    arg_help = 'Process all the morphologies of a directory in a single job per task, where ' \
+               'this number of morphologies are read on background threads ahead of the one ' \
+               'that is processed, to hide the latency of the file system. \n' \
+               'Default 0, i.e. a job per morphology.'
+    execution_args.add_argument(
+        Args.PREFETCH_MORPHOLOGIES,
+        action='store', type=int, default=0,
+        help=arg_help)
+
     # Parse the arguments, and return a list of them
     return parser.parse_args()
 
@@ -750,8 +891,8 @@ def get_arguments_string_as_list(arguments):
         # Get the argument value
         arg_value = getattr(arguments, arg)
 
-        # Ignore the unset flags
-        if arg_value is False:
+        # Ignore the unset flags and the unset values, they fall back to their defaults
+        if arg_value is False or arg_value is None:
             continue
 
         elif arg_value is True:
@@ -902,7 +1043,8 @@ def create_shell_commands(arguments,
        arguments.render_neuron_morphology_progressive or    \
        arguments.export_morphology_swc or                   \
        arguments.export_morphology_segments or              \
-       arguments.export_morphology_blend:
+       arguments.export_morphology_blend or                 \
+       arguments.qa_render:
 
         # Add this command to the list
         shell_commands.append('%s -b --verbose 0 --python %s -- %s' %
@@ -0,0 +1,134 @@
+####################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+# System imports
+import argparse
+import sys
+import os
+
+# Blender imports
+import bpy
+
+# Append the internal modules into the system paths to avoid Blender importing conflicts
+import_paths = ['neuromorphovis']
+for import_path in import_paths:
+    sys.path.append(('%s/../../..' % (os.path.dirname(os.path.realpath(__file__)))))
+
+# Internal imports
+import nmv.catalogue
+import nmv.consts
+
+
+####################################################################################################
+# @parse_catalogue_arguments
+####################################################################################################
+def parse_catalogue_arguments(arguments):
+    """Parses the arguments of the catalogue.
+
+    :param arguments:
+        The list of the arguments given after '--'.
+    :return:
+        The parsed arguments.
+    """
+
+    parser = argparse.ArgumentParser(description='Renders a catalogue of morphologies or meshes')
+
+    # Catalogue
+    parser.add_argument('--input-directory', action='store', dest='input_directory',
+                        help='The directory of the morphologies or the meshes, the files are '
+                             'grouped by their sub-directories unless --groups is given')
+    parser.add_argument('--output-directory', action='store', dest='output_directory',
+                        help='The directory where the catalogue will be created')
+    parser.add_argument('--catalogue-name', action='store', dest='catalogue_name',
+                        default='catalogue', help='The name of the catalogue image')
+    parser.add_argument('--groups', action='store', dest='groups', default=None,
+                        help='A comma-separated list of the sub-strings of the groups in the '
+                             'order of the layout, e.g. L1,L2,L3,L4,L5,L6')
+    parser.add_argument('--scale-factor', action='store', dest='scale_factor', type=float,
+                        default=nmv.consts.Catalogue.DEFAULT_SCALE_FACTOR,
+                        help='The resolution scale factor of the cells')
+    parser.add_argument('--columns', action='store', dest='columns', type=int,
+                        default=nmv.consts.Catalogue.DEFAULT_COLUMNS,
+                        help='The number of the cells in a row of a group')
+    parser.add_argument('--spacing', action='store', dest='spacing', type=float,
+                        default=nmv.consts.Catalogue.DEFAULT_SPACING,
+                        help='The spacing between the cells in microns')
+    parser.add_argument('--group-spacing', action='store', dest='group_spacing', type=float,
+                        default=nmv.consts.Catalogue.DEFAULT_GROUP_SPACING,
+                        help='The spacing between the groups in microns')
+    parser.add_argument('--workers', action='store', dest='workers', type=int,
+                        default=nmv.consts.Catalogue.DEFAULT_WORKERS,
+                        help='The number of the workers that render the cells')
+    parser.add_argument('--execution-node', action='store', dest='execution_node',
+                        default='local', help='Run the workers locally or on the cluster')
+
+    # Workers
+    parser.add_argument('--manifest', action='store', dest='manifest', default=None,
+                        help='The manifest of the catalogue, for a worker or the compositing')
+    parser.add_argument('--worker', action='store', dest='worker', type=int, default=None,
+                        help='The index of the worker')
+    parser.add_argument('--composite', action='store_true', dest='composite', default=False,
+                        help='Composite the rendered cells into the catalogue')
+    return parser.parse_args(arguments)
+
+
+####################################################################################################
+# @ Run the main function if invoked from the command line.
+####################################################################################################
+if __name__ == "__main__":
+
+    # Ignore blender extra arguments required to launch blender given to the command line interface
+    args = sys.argv
+    arguments = parse_catalogue_arguments(args[args.index("--") + 1:])
+
+    # A worker
+    if arguments.manifest is not None and arguments.worker is not None:
+        nmv.catalogue.render_catalogue_cells(arguments.manifest, arguments.worker)
+
+    # The compositing
+    elif arguments.manifest is not None and arguments.composite:
+        nmv.catalogue.composite_catalogue(arguments.manifest)
+
+    # A new catalogue
+    else:
+
+        # Verify the directories
+        if arguments.input_directory is None or arguments.output_directory is None:
+            nmv.logger.log('ERROR: Please set the input and the output directories')
+            exit(0)
+
+        # Create the manifest
+        manifest_file = nmv.catalogue.create_catalogue_manifest(
+            input_directory=arguments.input_directory,
+            output_directory=arguments.output_directory,
+            catalogue_name=arguments.catalogue_name,
+            groups=arguments.groups.split(',') if arguments.groups is not None else None,
+            number_workers=arguments.workers,
+            scale_factor=arguments.scale_factor,
+            columns=arguments.columns,
+            spacing=arguments.spacing,
+            group_spacing=arguments.group_spacing)
+
+        # Run the workers with the same Blender
+        if arguments.execution_node == 'cluster':
+            nmv.catalogue.create_catalogue_slurm_jobs(
+                manifest_file, bpy.app.binary_path, arguments.workers)
+        else:
+            nmv.catalogue.run_catalogue_locally(
+                manifest_file, bpy.app.binary_path, arguments.workers)
+
+    nmv.logger.log('NMV Done')
@@ -0,0 +1,62 @@
+####################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+# System imports
+import argparse
+import sys
+import os
+
+# Append the internal modules into the system paths to avoid Blender importing conflicts
+import_paths = ['neuromorphovis']
+for import_path in import_paths:
+    sys.path.append(('%s/../../..' % (os.path.dirname(os.path.realpath(__file__)))))
+
+# Internal imports
+import nmv.mesh
+
+
+####################################################################################################
+# @parse_mesh_union_arguments
+####################################################################################################
+def parse_mesh_union_arguments(arguments):
+    """Parses the arguments of a union worker.
+
+    :param arguments:
+        The list of the arguments given after '--'.
+    :return:
+        The parsed arguments.
+    """
+
+    parser = argparse.ArgumentParser(description='Unions the meshes of a .blend file')
+    parser.add_argument('--input', action='store', dest='input', required=True,
+                        help='The .blend file of the meshes')
+    parser.add_argument('--output', action='store', dest='output', required=True,
+                        help='The .blend file where the union is written')
+    return parser.parse_args(arguments)
+
+
+####################################################################################################
+# @ Run the main function if invoked from the command line.
+####################################################################################################
+if __name__ == "__main__":
+
+    # Ignore blender extra arguments required to launch blender given to the command line interface
+    args = sys.argv
+    arguments = parse_mesh_union_arguments(args[args.index("--") + 1:])
+
+    # Union the meshes
+    nmv.mesh.ops.union_mesh_objects_in_blend_file(arguments.input, arguments.output)
@@ -0,0 +1,133 @@
+####################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+# System imports
+import argparse
+import sys
+import os
+
+# Blender imports
+import bpy
+
+# Append the internal modules into the system paths to avoid Blender importing conflicts
+import_paths = ['neuromorphovis']
+for import_path in import_paths:
+    sys.path.append(('%s/../../..' % (os.path.dirname(os.path.realpath(__file__)))))
+
+# Internal imports
+import nmv.consts
+import nmv.validation
+
+
+####################################################################################################
+# @parse_validation_arguments
+####################################################################################################
+def parse_validation_arguments(arguments):
+    """Parses the arguments of the validation.
+
+    :param arguments:
+        The list of the arguments given after '--'.
+    :return:
+        The parsed arguments.
+    """
+
+    parser = argparse.ArgumentParser(description='Validates, and repairs, a directory of '
+                                                 'morphologies before meshing them')
+
+    # Validation
+    parser.add_argument('--input-directory', action='store', dest='input_directory',
+                        help='The directory of the morphologies, including its sub-directories')
+    parser.add_argument('--output-directory', action='store', dest='output_directory',
+                        help='The directory where the reports and the repaired morphologies '
+                             'will be written')
+    parser.add_argument('--repairs', action='store', dest='repairs', default=None,
+                        help='A comma-separated list of the rules to repair, or all, from: %s' %
+                             ','.join(nmv.consts.Validation.REPAIRABLE_RULES))
+    parser.add_argument('--duplicates-threshold', action='store', dest='duplicates_threshold',
+                        type=float, default=nmv.consts.Validation.DUPLICATED_SAMPLES_THRESHOLD,
+                        help='The distance below which two successive samples are duplicates')
+    parser.add_argument('--workers', action='store', dest='workers', type=int,
+                        default=nmv.consts.Validation.DEFAULT_WORKERS,
+                        help='The number of the workers that validate the morphologies')
+
+    # Workers
+    parser.add_argument('--manifest', action='store', dest='manifest', default=None,
+                        help='The manifest of the validation, for a worker')
+    parser.add_argument('--worker', action='store', dest='worker', type=int, default=None,
+                        help='The index of the worker')
+    return parser.parse_args(arguments)
+
+
+####################################################################################################
+# @get_repairs
+####################################################################################################
+def get_repairs(repairs_argument):
+    """Gets the list of the rules to repair from the argument.
+
+    :param repairs_argument:
+        A comma-separated list of the rules, 'all' or None.
+    :return:
+        A list of the rules.
+    """
+
+    if repairs_argument is None:
+        return list()
+    if repairs_argument == 'all':
+        return list(nmv.consts.Validation.REPAIRABLE_RULES)
+
+    repairs = [rule.strip() for rule in repairs_argument.split(',')]
+    for rule in repairs:
+        if rule not in nmv.consts.Validation.REPAIRABLE_RULES:
+            nmv.logger.log('ERROR: The rule [%s] cannot be repaired' % rule)
+            exit(0)
+    return repairs
+
+
+####################################################################################################
+# @ Run the main function if invoked from the command line.
+####################################################################################################
+if __name__ == "__main__":
+
+    # Ignore blender extra arguments required to launch blender given to the command line interface
+    args = sys.argv
+    arguments = parse_validation_arguments(args[args.index("--") + 1:])
+
+    # A worker
+    if arguments.manifest is not None and arguments.worker is not None:
+        nmv.validation.validate_morphologies(arguments.manifest, arguments.worker)
+
+    # A new validation
+    else:
+
+        # Verify the directories
+        if arguments.input_directory is None or arguments.output_directory is None:
+            nmv.logger.log('ERROR: Please set the input and the output directories')
+            exit(0)
+
+        # Create the manifest
+        manifest_file = nmv.validation.create_validation_manifest(
+            input_directory=arguments.input_directory,
+            output_directory=arguments.output_directory,
+            number_workers=arguments.workers,
+            repairs=get_repairs(arguments.repairs),
+            duplicates_threshold=arguments.duplicates_threshold)
+
+        # Run the workers with the same Blender
+        nmv.validation.run_validation_locally(
+            manifest_file, bpy.app.binary_path, arguments.workers)
+
+    nmv.logger.log('NMV Done')
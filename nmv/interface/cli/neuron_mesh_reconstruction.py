@@ -186,6 +186,19 @@ def render_neuron_mesh_to_static_frame(cli_morphology,
         bounding_box = nmv.skeleton.compute_full_morphology_bounding_box(
             morphology=cli_morphology)
 
+    # Render at a specific resolution or to scale
+    image_scale_factor = None
+    if cli_options.rendering.resolution_basis != nmv.enums.Rendering.Resolution.FIXED:
+        image_scale_factor = cli_options.rendering.resolution_scale_factor
+
+    # Render all the views and the custom angles in a single session
+    renderer = nmv.rendering.MultiViewRenderer(
+        bounding_box=bounding_box,
+        image_directory=cli_options.io.images_directory,
+        image_format=cli_options.rendering.image_format,
+        image_resolution=cli_options.rendering.full_view_resolution,
+        image_scale_factor=image_scale_factor)
+
     # If rendering all views
     if cli_options.rendering.camera_view == nmv.enums.Camera.View.ALL_VIEWS:
         views = [nmv.enums.Camera.View.FRONT,
@@ -195,32 +208,23 @@ def render_neuron_mesh_to_static_frame(cli_morphology,
         views = [cli_options.rendering.camera_view]
 
     # Get the image suffix
-    suffixes = nmv.interface.get_morphology_image_suffixes_from_view(
+    suffixes = nmv.interface.get_mesh_image_suffixes_from_view(
         cli_options.rendering.camera_view)
 
     for view, suffix in zip(views, suffixes):
 
-        # Render at a specific resolution
-        if cli_options.rendering.resolution_basis == nmv.enums.Rendering.Resolution.FIXED:
-
-            # Render the image
-            nmv.rendering.render(
-                bounding_box=bounding_box,
-                camera_view=cli_options.rendering.camera_view,
-                image_resolution=cli_options.rendering.full_view_resolution,
-                image_name='%s%s' % (cli_options.morphology.label, suffix),
-                image_directory=cli_options.io.images_directory)
-
-        # Render at a specific scale factor
+        # Images that are too large for a single render are rendered in tiles by workers
+        if image_scale_factor is not None and cli_options.rendering.render_tile_size > 0:
+            nmv.rendering.render_to_scale_tiled_with_options(
+                bounding_box, view, '%s%s' % (cli_options.morphology.label, suffix), cli_options)
         else:
+            renderer.add_view(view, '%s%s' % (cli_options.morphology.label, suffix))
+
+    for angle in cli_options.rendering.camera_angles:
+        renderer.add_angle(angle, '%s%s_%g' % (
+            cli_options.morphology.label, nmv.consts.Suffix.MESH_ANGLE, angle))
 
-            # Render the image
-            nmv.rendering.render_to_scale(
-                bounding_box=bounding_box,
-                camera_view=cli_options.rendering.camera_view,
-                image_scale_factor=cli_options.rendering.resolution_scale_factor,
-                image_name='MESH_%s_%s' % (cli_options.morphology.label, suffix),
-                image_directory=cli_options.io.images_directory)
+    renderer.render()
 
 
 ####################################################################################################
@@ -313,6 +317,46 @@ def render_neuron_mesh_360(cli_options,
                     image_name=image_name)
 
 
+####################################################################################################
+# @process_neuron_mesh
+####################################################################################################
+def process_neuron_mesh(cli_morphology,
+                        cli_options):
+    """Reconstructs, exports and renders the mesh of a neuron as requested in the options.
+
+    :param cli_morphology:
+        The morphology loaded from the command line interface (CLI).
+    :param cli_options:
+        System options parsed from the command line interface (CLI).
+    """
+
+    # Neuron mesh reconstruction
+    reconstruct_neuron_mesh(cli_morphology=cli_morphology, cli_options=cli_options)
+
+    # Saving the mesh
+    if cli_options.mesh.export_ply or cli_options.mesh.export_obj or \
+       cli_options.mesh.export_stl or cli_options.mesh.export_blend:
+
+        # Export the neuron mesh
+        export_neuron_mesh(cli_morphology=cli_morphology, cli_options=cli_options)
+
+    # Render a quick quality assurance image of the mesh
+    if cli_options.rendering.qa_render:
+        nmv.rendering.render_qa_image(
+            bounding_box=nmv.bbox.compute_scene_bounding_box_for_meshes(),
+            image_name='%s%s' % (cli_options.morphology.label, nmv.consts.Suffix.MESH_QA),
+            image_directory=cli_options.io.qa_directory,
+            resolution=cli_options.rendering.qa_resolution)
+
+    # Render the mesh
+    if cli_options.rendering.render_mesh_static_frame:
+        render_neuron_mesh_to_static_frame(cli_options=cli_options, cli_morphology=cli_morphology)
+
+    # Render 360 of the mesh
+    if cli_options.rendering.render_mesh_360:
+        render_neuron_mesh_360(cli_options=cli_options, cli_morphology=cli_morphology)
+
+
 ####################################################################################################
 # @ Run the main function if invoked from the command line.
 ####################################################################################################
@@ -338,6 +382,11 @@ if __name__ == "__main__":
     # Convert the CLI arguments to system options
     cli_options.consume_arguments(arguments=arguments)
 
+    # Select the rendering profile of all the rendered images
+    nmv.rendering.set_render_profile(cli_options.rendering.render_profile,
+                                     cli_options.rendering.render_threads,
+                                     cli_options.rendering.estimate_render_noise)
+
     # Read the morphology
     cli_morphology = None
 
@@ -365,27 +414,38 @@ if __name__ == "__main__":
                            str(cli_options.morphology.morphology_file_path))
             exit(0)
 
-    else:
-        nmv.logger.log('ERROR: Invalid input option')
-        exit(0)
+    # A directory, processed in this job while the next morphologies are read ahead
+    elif arguments.input == 'directory':
 
-    # Soma mesh reconstruction and visualization
-    neuron_mesh = reconstruct_neuron_mesh(cli_morphology=cli_morphology, cli_options=cli_options)
+        for options, loading_flag, cli_morphology in nmv.file.MorphologyPrefetcher(
+                nmv.file.create_options_for_morphology_directory(
+                    cli_options, cli_options.io.morphology_directory),
+                prefetch_count=cli_options.io.prefetch_morphologies,
+                number_threads=cli_options.io.prefetch_morphologies):
 
-    # Saving the mesh
-    if cli_options.mesh.export_ply or cli_options.mesh.export_obj or \
-       cli_options.mesh.export_stl or cli_options.mesh.export_blend:
+            if not loading_flag:
+                nmv.logger.log('ERROR: Cannot load the morphology file [%s]' %
+                               str(options.morphology.morphology_file_path))
+                continue
 
-        # Export the neuron mesh
-        export_neuron_mesh(cli_morphology=cli_morphology, cli_options=cli_options)
+            # Track the datablocks of this neuron to free them before the next one
+            datablock_tracker = nmv.scene.ops.DatablockTracker(label=cli_morphology.label)
 
-    # Render the mesh
-    if cli_options.rendering.render_mesh_static_frame:
-        render_neuron_mesh_to_static_frame(cli_options=cli_options, cli_morphology=cli_morphology)
+            # Process the neuron mesh
+            process_neuron_mesh(cli_morphology=cli_morphology, cli_options=options)
 
-    # Render 360 of the mesh
-    if cli_options.rendering.render_mesh_360:
-        render_neuron_mesh_360(cli_options=cli_options, cli_morphology=cli_morphology)
+            # Keep the memory of the process flat over the batch
+            datablock_tracker.free()
+
+        nmv.logger.log('NMV Done')
+        exit(0)
+
+    else:
+        nmv.logger.log('ERROR: Invalid input option')
+        exit(0)
+
+    # Process the neuron mesh
+    process_neuron_mesh(cli_morphology=cli_morphology, cli_options=cli_options)
 
     # Rendering the mesh
     nmv.logger.log('NMV Done')
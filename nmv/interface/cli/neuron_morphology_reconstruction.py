@@ -101,6 +101,15 @@ def reconstruct_neuron_morphology(cli_morphology,
             None, cli_options.io.morphologies_directory, cli_morphology.label,
             blend=cli_options.morphology.export_blend)
 
+    # Render a quick quality assurance image of the morphology skeleton
+    if cli_options.rendering.qa_render:
+        nmv.rendering.render_qa_image(
+            bounding_box=nmv.skeleton.compute_full_morphology_bounding_box(
+                morphology=cli_morphology),
+            image_name='%s%s' % (cli_morphology.label, nmv.consts.Suffix.MORPHOLOGY_QA),
+            image_directory=cli_options.io.qa_directory,
+            resolution=cli_options.rendering.qa_resolution)
+
     # Render a static image of the reconstructed morphology skeleton
     if cli_options.rendering.render_morphology_static_frame:
 
@@ -124,6 +133,19 @@ def reconstruct_neuron_morphology(cli_morphology,
             bounding_box = nmv.skeleton.compute_full_morphology_bounding_box(
                 morphology=cli_morphology)
 
+        # Render at a specific resolution or to scale
+        image_scale_factor = None
+        if cli_options.rendering.resolution_basis != nmv.enums.Rendering.Resolution.FIXED:
+            image_scale_factor = cli_options.rendering.resolution_scale_factor
+
+        # Render all the views and the custom angles in a single session
+        renderer = nmv.rendering.MultiViewRenderer(
+            bounding_box=bounding_box,
+            image_directory=cli_options.io.images_directory,
+            image_format=cli_options.rendering.image_format,
+            image_resolution=cli_options.rendering.full_view_resolution,
+            image_scale_factor=image_scale_factor)
+
         # If rendering all views
         if cli_options.rendering.camera_view == nmv.enums.Camera.View.ALL_VIEWS:
             views = [nmv.enums.Camera.View.FRONT,
@@ -138,29 +160,18 @@ def reconstruct_neuron_morphology(cli_morphology,
 
         for view, suffix in zip(views, suffixes):
 
-            # Render at a specific resolution
-            if cli_options.rendering.resolution_basis == nmv.enums.Rendering.Resolution.FIXED:
-
-                # Render the image
-                nmv.rendering.render(
-                    bounding_box=bounding_box,
-                    camera_view=view,
-                    image_resolution=cli_options.rendering.full_view_resolution,
-                    image_name='%s%s' % (cli_morphology.label, suffix),
-                    image_format=cli_options.rendering.image_format,
-                    image_directory=cli_options.io.images_directory)
-
-            # Render at a specific scale factor
+            # Images that are too large for a single render are rendered in tiles by workers
+            if image_scale_factor is not None and cli_options.rendering.render_tile_size > 0:
+                nmv.rendering.render_to_scale_tiled_with_options(
+                    bounding_box, view, '%s%s' % (cli_morphology.label, suffix), cli_options)
             else:
+                renderer.add_view(view, '%s%s' % (cli_morphology.label, suffix))
+
+        for angle in cli_options.rendering.camera_angles:
+            renderer.add_angle(angle, '%s%s_%g' % (
+                cli_morphology.label, nmv.consts.Suffix.MORPHOLOGY_ANGLE, angle))
 
-                # Render the image
-                nmv.rendering.render_to_scale(
-                    bounding_box=bounding_box,
-                    camera_view=view,
-                    image_scale_factor=cli_options.rendering.resolution_scale_factor,
-                    image_name='%s%s' % (cli_morphology.label, suffix),
-                    image_format=cli_options.morphology.image_format,
-                    image_directory=cli_options.io.images_directory)
+        renderer.render()
 
     # Render a 360 sequence of the reconstructed morphology skeleton
     if cli_options.rendering.render_mesh_360:
@@ -283,6 +294,11 @@ if __name__ == "__main__":
     # Convert the CLI arguments to system options
     input_options.consume_arguments(arguments=arguments)
 
+    # Select the rendering profile of all the rendered images
+    nmv.rendering.set_render_profile(input_options.rendering.render_profile,
+                                     input_options.rendering.render_threads,
+                                     input_options.rendering.estimate_render_noise)
+
     # Read the morphology
     input_morphology = None
 
@@ -310,6 +326,32 @@ if __name__ == "__main__":
                            str(input_options.morphology.morphology_file_path))
             exit(0)
 
+    # A directory, processed in this job while the next morphologies are read ahead
+    elif arguments.input == 'directory':
+
+        for options, loading_flag, input_morphology in nmv.file.MorphologyPrefetcher(
+                nmv.file.create_options_for_morphology_directory(
+                    input_options, input_options.io.morphology_directory),
+                prefetch_count=input_options.io.prefetch_morphologies,
+                number_threads=input_options.io.prefetch_morphologies):
+
+            if not loading_flag:
+                nmv.logger.log('ERROR: Cannot load the morphology file [%s]' %
+                               str(options.morphology.morphology_file_path))
+                continue
+
+            # Track the datablocks of this neuron to free them before the next one
+            datablock_tracker = nmv.scene.ops.DatablockTracker(label=input_morphology.label)
+
+            # Neuron morphology reconstruction and visualization
+            reconstruct_neuron_morphology(cli_morphology=input_morphology, cli_options=options)
+
+            # Keep the memory of the process flat over the batch
+            datablock_tracker.free()
+
+        nmv.logger.log('NMV Done')
+        exit(0)
+
     else:
         nmv.logger.log('ERROR: Invalid input option')
         exit(0)
@@ -0,0 +1,68 @@
+####################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+# System imports
+import argparse
+import sys
+import os
+
+# Append the internal modules into the system paths to avoid Blender importing conflicts
+import_paths = ['neuromorphovis']
+for import_path in import_paths:
+    sys.path.append(('%s/../../..' % (os.path.dirname(os.path.realpath(__file__)))))
+
+# Internal imports
+import nmv.consts
+import nmv.rendering
+
+
+####################################################################################################
+# @parse_contact_sheet_arguments
+####################################################################################################
+def parse_contact_sheet_arguments(arguments):
+    """Parses the arguments of the contact sheet assembly.
+
+    :param arguments:
+        The list of the arguments given after '--'.
+    :return:
+        The parsed arguments.
+    """
+
+    parser = argparse.ArgumentParser(description='Assembles the QA images into contact sheets')
+    parser.add_argument('--qa-directory', action='store', dest='qa_directory', required=True,
+                        help='The directory of the quality assurance images')
+    parser.add_argument('--qa-resolution', action='store', dest='qa_resolution', type=int,
+                        default=nmv.consts.QualityAssurance.DEFAULT_RESOLUTION,
+                        help='The resolution of the quality assurance images')
+    return parser.parse_args(arguments)
+
+
+####################################################################################################
+# @ Run the main function if invoked from the command line.
+####################################################################################################
+if __name__ == "__main__":
+
+    # Ignore blender extra arguments required to launch blender given to the command line interface
+    args = sys.argv
+    arguments = parse_contact_sheet_arguments(args[args.index("--") + 1:])
+
+    # A contact sheet for the morphologies and another one for the meshes, if any
+    for suffix in [nmv.consts.Suffix.MORPHOLOGY_QA, nmv.consts.Suffix.MESH_QA]:
+        nmv.rendering.create_qa_contact_sheets(arguments.qa_directory, suffix,
+                                               resolution=arguments.qa_resolution)
+
+    nmv.logger.log('NMV Done')
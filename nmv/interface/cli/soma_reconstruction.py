@@ -197,6 +197,11 @@ if __name__ == "__main__":
     # Convert the CLI arguments to system options
     cli_options.consume_arguments(arguments=arguments)
 
+    # Select the rendering profile of all the rendered images
+    nmv.rendering.set_render_profile(cli_options.rendering.render_profile,
+                                     cli_options.rendering.render_threads,
+                                     cli_options.rendering.estimate_render_noise)
+
     # Read the morphology
     cli_morphology = None
 
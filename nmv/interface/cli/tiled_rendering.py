@@ -0,0 +1,73 @@
+####################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+# System imports
+import argparse
+import sys
+import os
+
+# Append the internal modules into the system paths to avoid Blender importing conflicts
+import_paths = ['neuromorphovis']
+for import_path in import_paths:
+    sys.path.append(('%s/../../..' % (os.path.dirname(os.path.realpath(__file__)))))
+
+# Internal imports
+import nmv.rendering
+
+
+####################################################################################################
+# @parse_tiled_rendering_arguments
+####################################################################################################
+def parse_tiled_rendering_arguments(arguments):
+    """Parses the arguments of a tile worker.
+
+    :param arguments:
+        The list of the arguments given after '--'.
+    :return:
+        The parsed arguments.
+    """
+
+    parser = argparse.ArgumentParser(description='Renders the tiles of a tiled rendering job')
+    parser.add_argument('--manifest', action='store', dest='manifest', required=True,
+                        help='The manifest of the tiled rendering job')
+    parser.add_argument('--worker', action='store', dest='worker', type=int, default=0,
+                        help='The index of this worker')
+    parser.add_argument('--workers', action='store', dest='workers', type=int, default=1,
+                        help='The total number of the workers')
+    parser.add_argument('--stitch', action='store_true', dest='stitch', default=False,
+                        help='Stitch the rendered tiles into the image')
+    return parser.parse_args(arguments)
+
+
+####################################################################################################
+# @ Run the main function if invoked from the command line.
+####################################################################################################
+if __name__ == "__main__":
+
+    # Ignore blender extra arguments required to launch blender given to the command line interface
+    args = sys.argv
+    arguments = parse_tiled_rendering_arguments(args[args.index("--") + 1:])
+
+    # Stitch the image after all the workers are done
+    if arguments.stitch:
+        nmv.rendering.stitch_tiles(arguments.manifest)
+
+    # Or render the tiles of this worker, the scene of the job is already loaded
+    else:
+        nmv.rendering.render_tiles(arguments.manifest, arguments.worker, arguments.workers)
+
+    nmv.logger.log('NMV Done')
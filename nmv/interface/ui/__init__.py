@@ -16,6 +16,7 @@
 ####################################################################################################
 
 from .common import *
+from .background_reconstruction import *
 from .data import *
 from .about import *
 from .edit import *
@@ -0,0 +1,330 @@
+####################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+# System imports
+import copy
+import time
+
+# Internal imports
+import nmv.interface
+import nmv.scene
+import nmv.utilities
+
+
+
+####################################################################################################
+# @BackgroundReconstruction
+####################################################################################################
+class BackgroundReconstruction:
+    """A mixin for the modal reconstruction operators.
+
+    The morphology is read in a background thread while the UI stays responsive. Once it is read,
+    it is committed and reconstructed on the main thread, which is the only thread that touches
+    the Blender data, a stage of the builder per timer step. The progress is streamed into a
+    progress property of the scene and the progress indicator of the window, and ESC or right
+    click cancels the operation between two steps.
+
+    The operator that uses this mixin defines progress_property, the name of the progress property
+    of the scene, and implements reconstruct_in_stages(context).
+
+    A single reconstruction runs at a time, the new invocations are rejected while it runs.
+    """
+
+    # Set while a reconstruction is running, shared by all the operators of the mixin
+    running = False
+
+    # The name of the progress property of the scene, a percentage
+    progress_property = None
+
+    # The share of the loading in the progress bar, the rest is the reconstruction
+    loading_share = 0.5
+
+    # Timer
+    event_timer = None
+
+    # The background task
+    task = None
+
+    # The stages of the reconstruction, once the morphology is loaded
+    stages = None
+
+    # Start time
+    start_time = 0
+
+    # The last logged progress message, only the changes of the message are logged
+    progress_message = None
+
+    ################################################################################################
+    # @reconstruct_in_stages
+    ################################################################################################
+    def reconstruct_in_stages(self,
+                              context):
+        """Reconstructs the loaded morphology stage by stage, on the main thread. Implemented by
+        the operator as a generator that yields the progress of the reconstruction, a fraction in
+        [0, 1], and the name of every stage before running it.
+
+        :param context:
+            Blender context.
+        """
+
+        raise NotImplementedError
+
+    ################################################################################################
+    # @update_progress
+    ################################################################################################
+    def update_progress(self,
+                        context,
+                        progress,
+                        message=None):
+        """Updates the progress property of the scene and the progress indicator of the window,
+        redraws the panels and logs the message when it changes.
+
+        :param context:
+            Blender context.
+        :param progress:
+            The progress as a fraction in [0, 1].
+        :param message:
+            An optional message that describes the current step.
+        """
+
+        # Update the property and the indicator
+        setattr(context.scene, self.progress_property, int(100.0 * progress))
+        context.window_manager.progress_update(int(100.0 * progress))
+
+        # Redraw the 3D views, where the panels are
+        if context.screen is not None:
+            for area in context.screen.areas:
+                if area.type == 'VIEW_3D':
+                    area.tag_redraw()
+
+        # Log the message when it changes
+        if message and message != self.progress_message:
+            nmv.logger.info(message)
+            self.progress_message = message
+
+    ################################################################################################
+    # @start_reconstruction
+    ################################################################################################
+    def start_reconstruction(self,
+                             context):
+        """Starts the stages of the reconstruction of the loaded morphology, the first stage runs
+        at the next timer step.
+
+        :param context:
+            Blender context.
+        """
+
+        self.stages = self.reconstruct_in_stages(context)
+        self.update_progress(context, self.loading_share)
+
+    ################################################################################################
+    # @execute
+    ################################################################################################
+    def execute(self,
+                context):
+        """Validates the input and starts reading the morphology in the background.
+
+        :param context:
+            Blender context.
+        :return:
+            'RUNNING_MODAL', or 'CANCELLED' if the input is invalid or a reconstruction is running.
+        """
+
+        # Reject the invocation while another reconstruction is running
+        if BackgroundReconstruction.running:
+            self.report({'WARNING'}, 'A reconstruction is already running')
+            return {'CANCELLED'}
+
+        # Clear the scene
+        nmv.scene.ops.clear_scene()
+
+        # Validate the input
+        loading_request = nmv.interface.ui.prepare_morphology_loading(self, context.scene)
+        if loading_request is None:
+            self.report({'ERROR'}, 'Please select a valid morphology file')
+            return {'CANCELLED'}
+
+        # Running until the reconstruction is finished, cancelled or failed
+        BackgroundReconstruction.running = True
+        self.start_time = time.time()
+        self.progress_message = None
+        self.task = None
+        self.stages = None
+        context.window_manager.progress_begin(0, 100)
+        self.update_progress(context, 0.0)
+
+        # The morphology is loaded, reconstruct it directly
+        if loading_request == 'ALREADY_LOADED':
+            self.start_reconstruction(context)
+
+        # Read the morphology in the background, with a copy of the options
+        else:
+            self.task = nmv.utilities.BackgroundTask(
+                nmv.interface.ui.read_morphology_in_background,
+                copy.deepcopy(nmv.interface.ui_options.morphology), context.scene.NMV_InputSource)
+            self.task.start()
+
+        # Use the event timer to run the steps and update the UI
+        wm = context.window_manager
+        self.event_timer = wm.event_timer_add(time_step=0.1, window=context.window)
+        wm.modal_handler_add(self)
+
+        # Modal
+        return {'RUNNING_MODAL'}
+
+    ################################################################################################
+    # @modal
+    ################################################################################################
+    def modal(self,
+              context,
+              event):
+        """Polls the loading task, then runs a stage of the reconstruction per timer step.
+
+        :param context:
+            Blender context.
+        :param event:
+            A given event for the panel.
+        """
+
+        # Cancelling event
+        if event.type in {'RIGHTMOUSE', 'ESC'}:
+            return self.cancel_reconstruction(context)
+
+        # Only the timer events
+        if event.type != 'TIMER':
+            return {'PASS_THROUGH'}
+
+        # Loading
+        if self.stages is None:
+            return self.poll_loading(context)
+
+        # Run the next stage, the error of a stage stops the reconstruction
+        try:
+            progress, message = next(self.stages)
+        except StopIteration:
+            return self.complete(context)
+        except Exception as e:
+            self.update_progress(context, 0.0)
+            self.finish(context)
+            self.report({'ERROR'}, 'Reconstruction failed: %s' % str(e))
+            return {'CANCELLED'}
+
+        # Stream the progress of the reconstruction
+        self.update_progress(
+            context, self.loading_share + (1.0 - self.loading_share) * progress, message)
+        return {'PASS_THROUGH'}
+
+    ################################################################################################
+    # @poll_loading
+    ################################################################################################
+    def poll_loading(self,
+                     context):
+        """Streams the progress of the loading task, and starts the reconstruction once the
+        morphology is loaded.
+
+        :param context:
+            Blender context.
+        :return:
+            'PASS_THROUGH', or 'CANCELLED' if the morphology cannot be loaded.
+        """
+
+        # Stream the progress
+        progress, message = self.task.get_progress()
+        self.update_progress(context, progress * self.loading_share, message)
+
+        # Still loading
+        if not self.task.is_done():
+            return {'PASS_THROUGH'}
+
+        # Failure
+        if self.task.error is not None or self.task.result is None:
+            self.update_progress(context, 0.0)
+            self.finish(context)
+            self.report({'ERROR'}, 'Invalid Morphology File')
+            return {'CANCELLED'}
+
+        # Commit the morphology and reconstruct it on the main thread
+        nmv.interface.ui.commit_loaded_morphology(context.scene, self.task.result)
+        self.start_reconstruction(context)
+        return {'PASS_THROUGH'}
+
+    ################################################################################################
+    # @cancel_reconstruction
+    ################################################################################################
+    def cancel_reconstruction(self,
+                              context):
+        """Cancels the operation. The readers have no cancellation points, so a cancelled read
+        runs to completion in its thread and its result is discarded. A cancelled reconstruction
+        stops between two stages and the partial reconstruction is removed from the scene.
+
+        :param context:
+            Blender context.
+        :return:
+            'CANCELLED'
+        """
+
+        # Stop the loading or the reconstruction
+        if self.stages is None:
+            self.task.cancel()
+        else:
+            self.stages.close()
+            nmv.scene.ops.clear_scene()
+
+        self.update_progress(context, 0.0)
+        self.finish(context)
+        self.report({'WARNING'}, 'Reconstruction cancelled')
+        return {'CANCELLED'}
+
+    ################################################################################################
+    # @complete
+    ################################################################################################
+    def complete(self,
+                 context):
+        """Finishes the operation once all the stages of the reconstruction are done, and reports
+        the timing.
+
+        :param context:
+            Blender context.
+        :return:
+            'FINISHED'
+        """
+
+        self.update_progress(context, 1.0)
+        self.finish(context)
+
+        # Report the time
+        nmv.logger.statistics('Loading and reconstruction in [%f] seconds' %
+                              (time.time() - self.start_time))
+        return {'FINISHED'}
+
+    ################################################################################################
+    # @finish
+    ################################################################################################
+    def finish(self,
+               context):
+        """Removes the event timer of the operator, ends the progress indicator and clears the
+        running flag, once the reconstruction is finished, cancelled or failed.
+
+        :param context:
+            Blender context.
+        """
+
+        if self.event_timer is not None:
+            context.window_manager.event_timer_remove(self.event_timer)
+            self.event_timer = None
+        context.window_manager.progress_end()
+        BackgroundReconstruction.running = False
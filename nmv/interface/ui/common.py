@@ -89,149 +89,166 @@ def load_morphology(panel_object,
 
     :param context_scene:
         Current scene in the rendering context.
+    :return:
+        'NEW_MORPHOLOGY_LOADED' if a morphology is loaded, 'ALREADY_LOADED' if it is loaded
+        before, or None if the input or the morphology is invalid.
     """
 
-    global current_morphology_label
-    global current_morphology_path
+    # Validate the input and update the options
+    loading_request = prepare_morphology_loading(panel_object, context_scene)
+    if loading_request != 'LOAD':
+        return loading_request
 
     # Read the data from a given morphology file either in .h5 or .swc formats
-    if bpy.context.scene.NMV_InputSource == nmv.enums.Input.H5_SWC_FILE:
-
-        #try:
-        if True:
-            # Pass options from UI to system
-            nmv.interface.ui_options.morphology.morphology_file_path = context_scene.NMV_MorphologyFile
+    if context_scene.NMV_InputSource == nmv.enums.Input.H5_SWC_FILE:
+        loading_flag, morphology_object = nmv.file.readers.read_morphology_from_file(
+            options=nmv.interface.ui_options)
 
-            # Ensure that a file has been selected
-            if 'Select File' in context_scene.NMV_MorphologyFile:
-                return None
-
-            # If no morphologies are loaded
-            if current_morphology_path is None:
+    # Read the data from a specific gid in a given circuit
+    else:
+        loading_flag, morphology_object = nmv.file.readers.BBPReader.load_morphology_from_circuit(
+            blue_config=nmv.interface.ui_options.morphology.blue_config,
+            gid=nmv.interface.ui_options.morphology.gid)
 
-                # Update the morphology label
-                nmv.interface.ui_options.morphology.label = nmv.file.ops.get_file_name_from_path(
-                    context_scene.NMV_MorphologyFile)
+    # Otherwise, report an ERROR
+    if not loading_flag:
 
-                # Load the morphology file
-                # Load the morphology from the file
-                loading_flag, morphology_object = nmv.file.readers.read_morphology_from_file(
-                    options=nmv.interface.ui_options)
+        # Report the issue
+        if context_scene.NMV_InputSource == nmv.enums.Input.H5_SWC_FILE:
+            panel_object.report({'ERROR'}, 'Invalid Morphology File')
+        else:
+            panel_object.report({'ERROR'}, 'Cannot Load Morphology from Circuit')
 
-                # Verify the loading operation
-                if loading_flag:
+        # None
+        return None
 
-                    # Update the morphology
-                    nmv.interface.ui_morphology = morphology_object
+    # Update the morphology and its path or label
+    commit_loaded_morphology(context_scene, morphology_object)
 
-                    # Update the current morphology path
-                    current_morphology_path = context_scene.NMV_MorphologyFile
+    # New morphology loaded
+    return 'NEW_MORPHOLOGY_LOADED'
 
-                    # New morphology loaded
-                    return 'NEW_MORPHOLOGY_LOADED'
 
-                # Otherwise, report an ERROR
-                else:
+####################################################################################################
+# @prepare_morphology_loading
+####################################################################################################
+def prepare_morphology_loading(panel_object,
+                               context_scene):
+    """Validates the input of the morphology and updates the options, without reading the file.
+    This is the part of load_morphology that must run on the main thread, before the morphology
+    is read, either synchronously by load_morphology or in the background with
+    read_morphology_in_background.
 
-                    # Report the issue
-                    panel_object.report({'ERROR'}, 'Invalid Morphology File')
+    :param panel_object:
+        An object of a UI panel.
+    :param context_scene:
+        Current scene in the rendering context.
+    :return:
+        'ALREADY_LOADED' if the morphology is loaded, 'LOAD' if it must be read, or None if the
+        input is invalid.
+    """
 
-                    # None
-                    return None
+    # A file
+    if context_scene.NMV_InputSource == nmv.enums.Input.H5_SWC_FILE:
 
-            # If there is file that is loaded
-            else:
+        # Ensure that a file has been selected
+        if 'Select File' in context_scene.NMV_MorphologyFile:
+            return None
 
-                # If the same path, then return
-                if current_morphology_path == \
-                   nmv.interface.ui_options.morphology.morphology_file_path:
-                    return 'ALREADY_LOADED'
+        # Pass options from UI to system
+        nmv.interface.ui_options.morphology.morphology_file_path = context_scene.NMV_MorphologyFile
 
-                # Load the new morphology file
-                else:
+        # The same file
+        if current_morphology_path == context_scene.NMV_MorphologyFile:
+            return 'ALREADY_LOADED'
 
-                    # Update the morphology label
-                    nmv.interface.ui_options.morphology.label = \
-                        nmv.file.ops.get_file_name_from_path(context_scene.NMV_MorphologyFile)
+        # Update the morphology label
+        nmv.interface.ui_options.morphology.label = nmv.file.ops.get_file_name_from_path(
+            context_scene.NMV_MorphologyFile)
 
-                    # Load the morphology file
-                    # Load the morphology from the file
-                    loading_flag, morphology_object = nmv.file.readers.read_morphology_from_file(
-                        options=nmv.interface.ui_options)
+    # A specific gid in a given circuit
+    elif context_scene.NMV_InputSource == nmv.enums.Input.CIRCUIT_GID:
 
-                    # Verify the loading operation
-                    if loading_flag:
+        # Pass options from UI to system
+        nmv.interface.ui_options.morphology.blue_config = context_scene.NMV_CircuitFile
+        nmv.interface.ui_options.morphology.gid = context_scene.NMV_Gid
+        nmv.interface.ui_options.morphology.label = 'neuron_' + str(context_scene.NMV_Gid)
 
-                        # Update the morphology
-                        nmv.interface.ui_morphology = morphology_object
+        # The same neuron
+        if current_morphology_label == nmv.interface.ui_options.morphology.label:
+            return 'ALREADY_LOADED'
 
-                        # Update the current morphology path
-                        current_morphology_path = context_scene.NMV_MorphologyFile
+    else:
 
-                        # New morphology loaded
-                        return 'NEW_MORPHOLOGY_LOADED'
+        # Report an invalid input source
+        panel_object.report({'ERROR'}, 'Invalid Input Source')
+        return None
 
-                    # Otherwise, report an ERROR
-                    else:
+    # The morphology must be read
+    return 'LOAD'
 
-                        # Report the issue
-                        panel_object.report({'ERROR'}, 'Invalid Morphology File')
 
-                        # None
-                        return None
+####################################################################################################
+# @read_morphology_in_background
+####################################################################################################
+def read_morphology_in_background(task,
+                                  morphology_options,
+                                  input_source):
+    """Reads the morphology in a background task. This function does not access any Blender data.
+
+    :param task:
+        The BackgroundTask that runs this function.
+    :param morphology_options:
+        A copy of the morphology options, updated by prepare_morphology_loading.
+    :param input_source:
+        The input source, a file or a circuit.
+    :return:
+        The morphology object, or None if it cannot be loaded.
+    """
 
-        # Invalid morphology file
-        #except ValueError:
-        else:
-            # Report the issue
-            panel_object.report({'ERROR'}, 'CANNOT load. Invalid Morphology File')
+    # Reading
+    task.set_progress(0.0, 'Reading [%s]' % morphology_options.label)
 
-            # None
-            return None
+    # Read the data from a given morphology file either in .h5 or .swc formats
+    if input_source == nmv.enums.Input.H5_SWC_FILE:
+        loading_flag, morphology_object = nmv.file.readers.read_morphology_from_file_naively(
+            morphology_options.morphology_file_path)
 
     # Read the data from a specific gid in a given circuit
-    elif bpy.context.scene.NMV_InputSource == nmv.enums.Input.CIRCUIT_GID:
-
-        # Pass options from UI to system
-        nmv.interface.ui_options.morphology.blue_config = context_scene.NMV_CircuitFile
-        nmv.interface.ui_options.morphology.gid = context_scene.NMV_Gid
-
-        # Update the morphology label
-        nmv.interface.ui_options.morphology.label = 'neuron_' + str(context_scene.NMV_Gid)
-
-        # Check if the morphology is loaded before or not
-        if current_morphology_label is None:
-            current_morphology_label = nmv.interface.ui_options.morphology.label
-        else:
-            if current_morphology_label == nmv.interface.ui_options.morphology.label:
-                return 'ALREADY_LOADED'
-
-        # Load the morphology from the circuit
+    else:
         loading_flag, morphology_object = nmv.file.readers.BBPReader.load_morphology_from_circuit(
-                blue_config=nmv.interface.ui_options.morphology.blue_config,
-                gid=nmv.interface.ui_options.morphology.gid)
+            blue_config=morphology_options.blue_config, gid=morphology_options.gid)
 
-        # Verify the loading operation
-        if loading_flag:
+    # Done
+    task.set_progress(1.0, 'Loaded [%s]' % morphology_options.label)
+    return morphology_object if loading_flag else None
 
-            # Update the morphology
-            nmv.interface.ui_morphology = morphology_object
 
-        # Otherwise, report an ERROR
-        else:
-            panel_object.report({'ERROR'}, 'Cannot Load Morphology from Circuit')
+####################################################################################################
+# @commit_loaded_morphology
+####################################################################################################
+def commit_loaded_morphology(context_scene,
+                             morphology_object):
+    """Updates the loaded morphology of the interface on the main thread, after it is read in the
+    background.
 
-            # None
-            return None
+    :param context_scene:
+        Current scene in the rendering context.
+    :param morphology_object:
+        The loaded morphology object.
+    """
 
-    else:
-        # Report an invalid input source
-        panel_object.report({'ERROR'}, 'Invalid Input Source')
+    global current_morphology_label
+    global current_morphology_path
 
-        # None
-        return None
+    # Update the morphology
+    nmv.interface.ui_morphology = morphology_object
 
-    return 'NEW_MORPHOLOGY_LOADED'
+    # Update the current morphology path or label
+    if context_scene.NMV_InputSource == nmv.enums.Input.H5_SWC_FILE:
+        current_morphology_path = context_scene.NMV_MorphologyFile
+    else:
+        current_morphology_label = nmv.interface.ui_options.morphology.label
 
 
 ####################################################################################################
@@ -312,6 +329,98 @@ def validate_output_directory(panel_object,
     return True
 
 
+####################################################################################################
+# @compute_morphology_rendering_bounding_box
+####################################################################################################
+def compute_morphology_rendering_bounding_box(context_scene):
+    """Computes the bounding box of the selected rendering view of the morphology.
+
+    :param context_scene:
+        A reference to the Blender scene.
+    :return:
+        The bounding box of the close up, mid shot or wide shot view.
+    """
+
+    # Compute the bounding box for a close up view
+    if context_scene.NMV_MorphologyRenderingView == nmv.enums.Rendering.View.CLOSE_UP:
+
+        # Compute the bounding box for a close up view
+        return nmv.bbox.compute_unified_extent_bounding_box(
+            extent=context_scene.NMV_MorphologyCloseUpDimensions)
+
+    # Compute the bounding box for a mid shot view
+    elif context_scene.NMV_MorphologyRenderingView == nmv.enums.Rendering.View.MID_SHOT:
+
+        # Compute the bounding box for the available curves and meshes
+        return nmv.bbox.compute_scene_bounding_box_for_curves_and_meshes()
+
+    # Compute the bounding box for the wide shot view that correspond to the whole morphology
+    else:
+
+        # Compute the full morphology bounding box
+        return nmv.skeleton.compute_full_morphology_bounding_box(
+            morphology=nmv.interface.ui_morphology)
+
+
+####################################################################################################
+# @create_morphology_views_renderer
+####################################################################################################
+def create_morphology_views_renderer(context_scene,
+                                     views,
+                                     image_format=nmv.enums.Image.Extension.PNG):
+    """Creates a renderer of the given views of the morphology reconstructed in the scene.
+
+    A dendrogram is a two-dimensional projection, so it is rendered once from the FRONT view with a
+    bounding box that is stretched around its curves, whatever views are requested.
+
+    :param context_scene:
+        A reference to the Blender scene.
+    :param views:
+        A list of camera views, i.e. FRONT, SIDE and TOP.
+    :param image_format:
+        Image extension or file format, by default .PNG.
+    :return:
+        A MultiViewRenderer with the views of the morphology.
+    """
+
+    label = nmv.interface.ui_options.morphology.label
+
+    # If this is a dendrogram rendering, handle it in a very specific way
+    if nmv.interface.ui_options.morphology.reconstruction_method == \
+            nmv.enums.Skeleton.Method.DENDROGRAM:
+
+        # Compute the bounding box of the dendrogram and stretch it
+        bounding_box = nmv.bbox.compute_scene_bounding_box_for_curves()
+        delta = bounding_box.get_largest_dimension() * 0.05
+        bounding_box.extend_bbox(delta_x=1.5 * delta, delta_y=delta)
+
+        # A single image at a specific resolution
+        renderer = nmv.rendering.MultiViewRenderer(
+            bounding_box=bounding_box,
+            image_directory=nmv.interface.ui_options.io.images_directory,
+            image_format=image_format,
+            image_resolution=context_scene.NMV_MorphologyFrameResolution)
+        renderer.add_view(nmv.enums.Camera.View.FRONT, '%s_dendrogram' % label)
+        return renderer
+
+    # Render at a specific resolution or to scale
+    image_scale_factor = None
+    if context_scene.NMV_RenderingType != nmv.enums.Rendering.Resolution.FIXED:
+        image_scale_factor = context_scene.NMV_MorphologyFrameScaleFactor
+
+    # A single session for all the views
+    renderer = nmv.rendering.MultiViewRenderer(
+        bounding_box=compute_morphology_rendering_bounding_box(context_scene),
+        image_directory=nmv.interface.ui_options.io.images_directory,
+        image_format=image_format,
+        image_resolution=context_scene.NMV_MorphologyFrameResolution,
+        image_scale_factor=image_scale_factor)
+    for view in views:
+        suffix = nmv.interface.get_morphology_image_suffixes_from_view(view)[0]
+        renderer.add_view(view, '%s%s' % (label, suffix))
+    return renderer
+
+
 ####################################################################################################
 # @render_morphology_image
 ####################################################################################################
@@ -331,10 +440,31 @@ def render_morphology_image(panel_object,
         Image extension or file format, by default .PNG.
     """
 
-    nmv.logger.header('Rendering Image')
+    render_morphology_views(panel_object=panel_object, context_scene=context_scene,
+                            views=[view], image_format=image_format)
 
-    # Start
-    start_time = time.time()
+
+####################################################################################################
+# @render_morphology_views
+####################################################################################################
+def render_morphology_views(panel_object,
+                            context_scene,
+                            views,
+                            image_format=nmv.enums.Image.Extension.PNG):
+    """Renders multiple views of the morphology reconstructed in the scene in a single session,
+    where the bounding box is computed once and the camera and the scene are shared by the views.
+
+    :param panel_object:
+        UI Panel.
+    :param context_scene:
+        A reference to the Blender scene.
+    :param views:
+        A list of camera views, i.e. FRONT, SIDE and TOP.
+    :param image_format:
+        Image extension or file format, by default .PNG.
+    """
+
+    nmv.logger.header('Rendering Image')
 
     # Validate the output directory
     if not nmv.interface.ui.validate_output_directory(
@@ -351,87 +481,8 @@ def render_morphology_image(panel_object,
     # Update the image file format
     bpy.context.scene.render.image_settings.file_format = image_format
 
-    # If this is a dendrogram rendering, handle it in a very specific way.
-    if nmv.interface.ui_options.morphology.reconstruction_method == \
-            nmv.enums.Skeleton.Method.DENDROGRAM:
-
-        # Compute the bounding box of the dendrogram and stretch it
-        bounding_box = nmv.bbox.compute_scene_bounding_box_for_curves()
-        delta = bounding_box.get_largest_dimension() * 0.05
-        bounding_box.extend_bbox(delta_x=1.5 * delta, delta_y=delta)
-
-        # Render the image
-        nmv.rendering.render(
-            bounding_box=bounding_box,
-            camera_view=nmv.enums.Camera.View.FRONT,
-            image_resolution=context_scene.NMV_MorphologyFrameResolution,
-            image_name='%s_dendrogram' % nmv.interface.ui_options.morphology.label,
-            image_format=image_format,
-            image_directory=nmv.interface.ui_options.io.images_directory,
-            keep_camera_in_scene=False)
-
-    # All other cases are okay
-    else:
-
-        # Compute the bounding box for a close up view
-        if context_scene.NMV_MorphologyRenderingView == \
-                nmv.enums.Rendering.View.CLOSE_UP:
-
-            # Compute the bounding box for a close up view
-            bounding_box = nmv.bbox.compute_unified_extent_bounding_box(
-                extent=context_scene.NMV_MorphologyCloseUpDimensions)
-
-        # Compute the bounding box for a mid shot view
-        elif context_scene.NMV_MorphologyRenderingView == \
-                nmv.enums.Rendering.View.MID_SHOT:
-
-            # Compute the bounding box for the available curves and meshes
-            bounding_box = nmv.bbox.compute_scene_bounding_box_for_curves_and_meshes()
-
-        # Compute the bounding box for the wide shot view that correspond to the whole morphology
-        else:
-
-            # Compute the full morphology bounding box
-            bounding_box = nmv.skeleton.compute_full_morphology_bounding_box(
-                morphology=nmv.interface.ui_morphology)
-
-        # Get the image suffix
-        if view == nmv.enums.Camera.View.FRONT:
-            suffix = nmv.consts.Suffix.MORPHOLOGY_FRONT
-        elif view == nmv.enums.Camera.View.SIDE:
-            suffix = nmv.consts.Suffix.MORPHOLOGY_SIDE
-        elif view == nmv.enums.Camera.View.TOP:
-            suffix = nmv.consts.Suffix.MORPHOLOGY_TOP
-        else:
-            suffix = nmv.consts.Suffix.MORPHOLOGY_FRONT
-
-        # Render at a specific resolution
-        if context_scene.NMV_RenderingType == nmv.enums.Rendering.Resolution.FIXED:
-
-            # Render the image
-            nmv.rendering.render(
-                bounding_box=bounding_box,
-                camera_view=view,
-                image_resolution=context_scene.NMV_MorphologyFrameResolution,
-                image_name='%s%s' % (nmv.interface.ui_options.morphology.label, suffix),
-                image_format=image_format,
-                image_directory=nmv.interface.ui_options.io.images_directory,
-                keep_camera_in_scene=False)
-
-        # Render at a specific scale factor
-        else:
-
-            # Render the image
-            nmv.rendering.render_to_scale(
-                bounding_box=bounding_box,
-                camera_view=view,
-                image_scale_factor=context_scene.NMV_MorphologyFrameScaleFactor,
-                image_name='%s%s' % (nmv.interface.ui_options.morphology.label, suffix),
-                image_format=image_format,
-                image_directory=nmv.interface.ui_options.io.images_directory,
-                keep_camera_in_scene=False)
-
-    nmv.logger.statistics('Image rendered in [%f] seconds' % (time.time() - start_time))
+    # Render the views
+    create_morphology_views_renderer(context_scene, views, image_format).render()
 
     # Report the process termination in the UI
     panel_object.report({'INFO'}, 'Rendering Done')
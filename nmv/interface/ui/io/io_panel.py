@@ -25,6 +25,7 @@ import bpy
 # Internal imports
 import nmv.enums
 import nmv.interface
+import nmv.rendering
 import nmv.scene
 import nmv.utilities
 import nmv.consts
@@ -156,6 +157,26 @@ class IOPanel(bpy.types.Panel):
             analysis_path_row.enabled = False
             stats_path_row.enabled = False
 
+        # Rendering options
+        rendering_options_row = layout.row()
+        rendering_options_row.label(text='Rendering Options:', icon='RENDER_STILL')
+
+        # Rendering profile
+        render_profile_row = layout.row()
+        render_profile_row.prop(scene, 'NMV_RenderProfile')
+
+        # Rendering threads
+        render_threads_row = layout.row()
+        render_threads_row.prop(scene, 'NMV_RenderThreads')
+
+        # Pass the rendering profile from UI to system
+        nmv.interface.ui_options.rendering.render_profile = scene.NMV_RenderProfile
+        nmv.interface.ui_options.rendering.render_threads = scene.NMV_RenderThreads
+        render_profile = nmv.rendering.get_render_profile()
+        if render_profile.profile != scene.NMV_RenderProfile or \
+                render_profile.threads != scene.NMV_RenderThreads:
+            nmv.rendering.set_render_profile(scene.NMV_RenderProfile, scene.NMV_RenderThreads)
+
         # Pass options from UI to system
         if 'Select Directory' in scene.NMV_OutputDirectory:
             nmv.interface.ui_options.io.output_directory = None
@@ -122,3 +122,25 @@ bpy.types.Scene.NMV_StatisticsPath = bpy.props.StringProperty(
     name="Statistics",
     description="Relative path where the statistics files will be generated",
     default="statistics", maxlen=1000)
+
+# Rendering profile
+bpy.types.Scene.NMV_RenderProfile = bpy.props.EnumProperty(
+    items=[(nmv.enums.Rendering.Profile.DRAFT,
+            'Draft',
+            'Few samples with denoising, for a quick look'),
+           (nmv.enums.Rendering.Profile.PREVIEW,
+            'Preview',
+            'Adaptive sampling with denoising, for previews of good quality'),
+           (nmv.enums.Rendering.Profile.FINAL,
+            'Final',
+            'Many samples with a low noise threshold, for publications')],
+    name='Render Profile',
+    description='The quality of the rendered images, that controls the samples, the adaptive '
+                'sampling and the denoising of every image',
+    default=nmv.enums.Rendering.Profile.PREVIEW)
+
+# Rendering threads
+bpy.types.Scene.NMV_RenderThreads = bpy.props.IntProperty(
+    name='Render Threads',
+    description='The number of rendering threads, zero to use all the cores',
+    default=0, min=0, max=1024)
@@ -123,6 +123,82 @@ class MeshPanel(bpy.types.Panel):
         nmv.interface.enable_or_disable_layout(self.layout)
 
 
+####################################################################################################
+# @reconstruct_neuron_mesh
+####################################################################################################
+def reconstruct_neuron_mesh(context):
+    """Reconstructs the mesh of the loaded morphology with the selected meshing technique.
+
+    :param context:
+        Blender context.
+    :return:
+        True if the mesh is reconstructed, or False if the meshing technique is invalid.
+    """
+
+    return nmv.utilities.run_stages(reconstruct_neuron_mesh_in_stages(context))
+
+
+####################################################################################################
+# @reconstruct_neuron_mesh_in_stages
+####################################################################################################
+def reconstruct_neuron_mesh_in_stages(context):
+    """Reconstructs the mesh of the loaded morphology stage by stage, see
+    reconstruct_neuron_mesh(). Yields the progress and the name of every stage of the builder
+    before running it.
+
+    :param context:
+        Blender context.
+    :return:
+        True if the mesh is reconstructed, or False if the meshing technique is invalid, once the
+        generator is exhausted.
+    """
+
+    # Meshing technique
+    meshing_technique = nmv.interface.ui_options.mesh.meshing_technique
+
+    # Start reconstruction
+    start_time = time.time()
+
+    # Piece-wise watertight meshing
+    if meshing_technique == nmv.enums.Meshing.Technique.PIECEWISE_WATERTIGHT:
+        mesh_builder = nmv.builders.PiecewiseBuilder(
+            morphology=nmv.interface.ui_morphology, options=nmv.interface.ui_options)
+        nmv.interface.ui_reconstructed_mesh = yield from mesh_builder.reconstruct_mesh_in_stages()
+
+    # Union
+    elif meshing_technique == nmv.enums.Meshing.Technique.UNION:
+        mesh_builder = nmv.builders.UnionBuilder(
+            morphology=nmv.interface.ui_morphology, options=nmv.interface.ui_options)
+        nmv.interface.ui_reconstructed_mesh = yield from mesh_builder.reconstruct_mesh_in_stages()
+
+    # Skinning
+    elif meshing_technique == nmv.enums.Meshing.Technique.SKINNING:
+        mesh_builder = nmv.builders.SkinningBuilder(
+            morphology=nmv.interface.ui_morphology, options=nmv.interface.ui_options)
+        nmv.interface.ui_reconstructed_mesh = yield from mesh_builder.reconstruct_mesh_in_stages()
+
+    # Meta Balls
+    elif meshing_technique == nmv.enums.Meshing.Technique.META_OBJECTS:
+        mesh_builder = nmv.builders.MetaBuilder(
+            morphology=nmv.interface.ui_morphology, options=nmv.interface.ui_options)
+        nmv.interface.ui_reconstructed_mesh = yield from mesh_builder.reconstruct_mesh_in_stages()
+
+    else:
+
+        # Invalid method
+        return False
+
+    # Mesh reconstructed
+    reconstruction_time = time.time()
+    global is_mesh_reconstructed
+    is_mesh_reconstructed = True
+    context.scene.NMV_MeshReconstructionTime = reconstruction_time - start_time
+    nmv.logger.statistics('Mesh reconstructed in [%f] seconds' %
+                          context.scene.NMV_MeshReconstructionTime)
+
+    return True
+
+
 ####################################################################################################
 # @ReconstructNeuronMesh
 ####################################################################################################
@@ -148,6 +224,11 @@ class ReconstructNeuronMesh(bpy.types.Operator):
 
         import time
 
+        # Do not clear the scene under a running background reconstruction
+        if nmv.interface.ui.BackgroundReconstruction.running:
+            self.report({'WARNING'}, 'A reconstruction is already running')
+            return {'CANCELLED'}
+
         # Clear the scene
         nmv.scene.ops.clear_scene()
 
@@ -159,51 +240,40 @@ class ReconstructNeuronMesh(bpy.types.Operator):
             self.report({'ERROR'}, 'Please select a morphology file')
             return {'FINISHED'}
 
-        # Meshing technique
-        meshing_technique = nmv.interface.ui_options.mesh.meshing_technique
+        # Reconstruct the mesh
+        if not reconstruct_neuron_mesh(context):
+            self.report({'ERROR'}, 'Invalid Meshing Technique')
 
-        # Start reconstruction
-        start_time = time.time()
+        return {'FINISHED'}
 
-        # Piece-wise watertight meshing
-        if meshing_technique == nmv.enums.Meshing.Technique.PIECEWISE_WATERTIGHT:
-            mesh_builder = nmv.builders.PiecewiseBuilder(
-                morphology=nmv.interface.ui_morphology, options=nmv.interface.ui_options)
-            nmv.interface.ui_reconstructed_mesh = mesh_builder.reconstruct_mesh()
-
-        # Union
-        elif meshing_technique == nmv.enums.Meshing.Technique.UNION:
-            mesh_builder = nmv.builders.UnionBuilder(
-                morphology=nmv.interface.ui_morphology, options=nmv.interface.ui_options)
-            nmv.interface.ui_reconstructed_mesh = mesh_builder.reconstruct_mesh()
-
-        # Skinning
-        elif meshing_technique == nmv.enums.Meshing.Technique.SKINNING:
-            mesh_builder = nmv.builders.SkinningBuilder(
-                morphology=nmv.interface.ui_morphology, options=nmv.interface.ui_options)
-            nmv.interface.ui_reconstructed_mesh = mesh_builder.reconstruct_mesh()
-
-        # Meta Balls
-        elif meshing_technique == nmv.enums.Meshing.Technique.META_OBJECTS:
-            mesh_builder = nmv.builders.MetaBuilder(
-                morphology=nmv.interface.ui_morphology, options=nmv.interface.ui_options)
-            nmv.interface.ui_reconstructed_mesh = mesh_builder.reconstruct_mesh()
 
-        else:
+####################################################################################################
+# @ReconstructNeuronMeshInBackground
+####################################################################################################
+class ReconstructNeuronMeshInBackground(nmv.interface.ui.BackgroundReconstruction,
+                                        bpy.types.Operator):
+    """Reconstructs the mesh of the neuron without blocking the UI"""
 
-            # Invalid method
-            self.report({'ERROR'}, 'Invalid Meshing Technique')
-            return {'FINISHED'}
+    # Operator parameters
+    bl_idname = "nmv.reconstruct_neuron_mesh_background"
+    bl_label = "Reconstruct in Background"
 
-        # Mesh reconstructed
-        reconstruction_time = time.time()
-        global is_mesh_reconstructed
-        is_mesh_reconstructed = True
-        context.scene.NMV_MeshReconstructionTime = reconstruction_time - start_time
-        nmv.logger.statistics('Mesh reconstructed in [%f] seconds' %
-                              context.scene.NMV_MeshReconstructionTime)
+    # Progress property
+    progress_property = 'NMV_MeshReconstructionProgress'
 
-        return {'FINISHED'}
+    ################################################################################################
+    # @reconstruct_in_stages
+    ################################################################################################
+    def reconstruct_in_stages(self,
+                              context):
+        """Reconstructs the mesh of the loaded morphology stage by stage.
+
+        :param context:
+            Blender context.
+        """
+
+        if not (yield from reconstruct_neuron_mesh_in_stages(context)):
+            self.report({'ERROR'}, 'Invalid Meshing Technique')
 
 
 ####################################################################################################
@@ -618,6 +688,7 @@ def register_panel():
     # Buttons
     bpy.utils.register_class(MeshReconstructionDocumentation)
     bpy.utils.register_class(ReconstructNeuronMesh)
+    bpy.utils.register_class(ReconstructNeuronMeshInBackground)
     bpy.utils.register_class(RenderMeshFront)
     bpy.utils.register_class(RenderMeshSide)
     bpy.utils.register_class(RenderMeshTop)
@@ -637,6 +708,7 @@ def unregister_panel():
     # Buttons
     bpy.utils.unregister_class(MeshReconstructionDocumentation)
     bpy.utils.unregister_class(ReconstructNeuronMesh)
+    bpy.utils.unregister_class(ReconstructNeuronMeshInBackground)
     bpy.utils.unregister_class(RenderMeshFront)
     bpy.utils.unregister_class(RenderMeshSide)
     bpy.utils.unregister_class(RenderMeshTop)
@@ -643,6 +643,14 @@ def draw_mesh_reconstruction_button(panel,
     mesh_reconstruction_row = layout.row()
     mesh_reconstruction_row.operator('nmv.reconstruct_neuron_mesh', icon='MESH_DATA')
 
+    # Background mesh reconstruction, cancelled with ESC
+    background_reconstruction_row = layout.row()
+    background_reconstruction_row.operator('nmv.reconstruct_neuron_mesh_background',
+                                           icon='SORTTIME')
+    background_reconstruction_progress_row = layout.row()
+    background_reconstruction_progress_row.prop(scene, 'NMV_MeshReconstructionProgress')
+    background_reconstruction_progress_row.enabled = False
+
 
 ####################################################################################################
 # @draw_mesh_export_options
@@ -329,6 +329,11 @@ bpy.types.Scene.NMV_NeuronMeshRenderingProgress = bpy.props.IntProperty(
     name="Rendering Progress",
     default=0, min=0, max=100, subtype='PERCENTAGE')
 
+# Mesh background reconstruction progress
+bpy.types.Scene.NMV_MeshReconstructionProgress = bpy.props.IntProperty(
+    name="Reconstruction Progress",
+    default=0, min=0, max=100, subtype='PERCENTAGE')
+
 # Individual components export flag
 bpy.types.Scene.NMV_ExportIndividuals = bpy.props.BoolProperty(
     name='Export Components',
@@ -104,6 +104,15 @@ class MorphologyPanel(bpy.types.Panel):
                                                    icon='RNA_ADD')
         reconstruct_morphology_button_row.enabled = True
 
+        # Background reconstruction button, cancelled with ESC
+        background_reconstruction_row = layout.row()
+        background_reconstruction_row.operator('nmv.reconstruct_morphology_background',
+                                               icon='SORTTIME')
+        background_reconstruction_progress_row = layout.row()
+        background_reconstruction_progress_row.prop(
+            current_scene, 'NMV_MorphologyReconstructionProgress')
+        background_reconstruction_progress_row.enabled = False
+
         global is_morphology_reconstructed
         if is_morphology_reconstructed:
             morphology_stats_row = layout.row()
@@ -132,6 +141,83 @@ class MorphologyPanel(bpy.types.Panel):
         nmv.interface.enable_or_disable_layout(layout)
 
 
+####################################################################################################
+# @reconstruct_morphology_skeleton
+####################################################################################################
+def reconstruct_morphology_skeleton(context):
+    """Reconstructs the loaded morphology skeleton with the selected builder.
+
+    :param context:
+        Blender context.
+    """
+
+    nmv.utilities.run_stages(reconstruct_morphology_skeleton_in_stages(context))
+
+
+####################################################################################################
+# @reconstruct_morphology_skeleton_in_stages
+####################################################################################################
+def reconstruct_morphology_skeleton_in_stages(context):
+    """Reconstructs the loaded morphology skeleton stage by stage, see
+    reconstruct_morphology_skeleton(). Yields the progress and the name of every stage of the
+    builder before running it.
+
+    :param context:
+        Blender context.
+    """
+
+    # Start reconstruction
+    start_time = time.time()
+
+    global morphology_builder
+
+    # Create a skeleton builder object to build the morphology skeleton
+    method = nmv.interface.ui_options.morphology.reconstruction_method
+    if method == nmv.enums.Skeleton.Method.DISCONNECTED_SEGMENTS:
+        morphology_builder = nmv.builders.DisconnectedSegmentsBuilder(
+            morphology=nmv.interface.ui_morphology, options=nmv.interface.ui_options)
+
+    # Draw the morphology as a set of disconnected tubes, where each SECTION is a tube
+    elif method == nmv.enums.Skeleton.Method.DISCONNECTED_SECTIONS or \
+            method == nmv.enums.Skeleton.Method.ARTICULATED_SECTIONS:
+        morphology_builder = nmv.builders.DisconnectedSectionsBuilder(
+            morphology=nmv.interface.ui_morphology, options=nmv.interface.ui_options)
+
+    # Draw the morphology as a set of spheres, where each SPHERE represents a sample
+    elif method == nmv.enums.Skeleton.Method.SAMPLES:
+        morphology_builder = nmv.builders.SamplesBuilder(
+            morphology=nmv.interface.ui_morphology, options=nmv.interface.ui_options)
+
+    elif method == nmv.enums.Skeleton.Method.CONNECTED_SECTIONS:
+        morphology_builder = nmv.builders.ConnectedSectionsBuilder(
+            morphology=nmv.interface.ui_morphology, options=nmv.interface.ui_options)
+
+    elif method == nmv.enums.Skeleton.Method.PROGRESSIVE:
+        morphology_builder = nmv.builders.ProgressiveBuilder(
+            morphology=nmv.interface.ui_morphology, options=nmv.interface.ui_options)
+
+    elif method == nmv.enums.Skeleton.Method.DENDROGRAM:
+        morphology_builder = nmv.builders.DendrogramBuilder(
+            morphology=nmv.interface.ui_morphology, options=nmv.interface.ui_options)
+
+    # Default: DisconnectedSectionsBuilder
+    else:
+        morphology_builder = nmv.builders.DisconnectedSectionsBuilder(
+            morphology=nmv.interface.ui_morphology, options=nmv.interface.ui_options)
+
+    # Draw the morphology skeleton and return a list of all the reconstructed objects
+    nmv.interface.ui_reconstructed_skeleton = \
+        yield from morphology_builder.draw_morphology_skeleton_in_stages()
+
+    # Morphology reconstructed
+    reconstruction_time = time.time()
+    global is_morphology_reconstructed
+    is_morphology_reconstructed = True
+    context.scene.NMV_MorphologyReconstructionTime = reconstruction_time - start_time
+    nmv.logger.statistics('Morphology reconstructed in [%f] seconds' %
+                          context.scene.NMV_MorphologyReconstructionTime)
+
+
 ####################################################################################################
 # ReconstructMorphologyOperator
 ####################################################################################################
@@ -155,6 +241,11 @@ class ReconstructMorphologyOperator(bpy.types.Operator):
             'FINISHED'
         """
 
+        # Do not clear the scene under a running background reconstruction
+        if nmv.interface.ui.BackgroundReconstruction.running:
+            self.report({'WARNING'}, 'A reconstruction is already running')
+            return {'CANCELLED'}
+
         # Clear the scene
         nmv.scene.ops.clear_scene()
 
@@ -166,58 +257,40 @@ class ReconstructMorphologyOperator(bpy.types.Operator):
             self.report({'ERROR'}, 'Please select a valid morphology file')
             return {'FINISHED'}
 
-        # Start reconstruction
-        start_time = time.time()
+        # Reconstruct the morphology
+        reconstruct_morphology_skeleton(context)
 
-        global morphology_builder
-
-        # Create a skeleton builder object to build the morphology skeleton
-        method = nmv.interface.ui_options.morphology.reconstruction_method
-        if method == nmv.enums.Skeleton.Method.DISCONNECTED_SEGMENTS:
-            morphology_builder = nmv.builders.DisconnectedSegmentsBuilder(
-                morphology=nmv.interface.ui_morphology, options=nmv.interface.ui_options)
-
-        # Draw the morphology as a set of disconnected tubes, where each SECTION is a tube
-        elif method == nmv.enums.Skeleton.Method.DISCONNECTED_SECTIONS or \
-                method == nmv.enums.Skeleton.Method.ARTICULATED_SECTIONS:
-            morphology_builder = nmv.builders.DisconnectedSectionsBuilder(
-                morphology=nmv.interface.ui_morphology, options=nmv.interface.ui_options)
-
-        # Draw the morphology as a set of spheres, where each SPHERE represents a sample
-        elif method == nmv.enums.Skeleton.Method.SAMPLES:
-            morphology_builder = nmv.builders.SamplesBuilder(
-                morphology=nmv.interface.ui_morphology, options=nmv.interface.ui_options)
+        # Confirm operation done
+        return {'FINISHED'}
 
-        elif method == nmv.enums.Skeleton.Method.CONNECTED_SECTIONS:
-            morphology_builder = nmv.builders.ConnectedSectionsBuilder(
-                morphology=nmv.interface.ui_morphology, options=nmv.interface.ui_options)
 
-        elif method == nmv.enums.Skeleton.Method.PROGRESSIVE:
-            morphology_builder = nmv.builders.ProgressiveBuilder(
-                morphology=nmv.interface.ui_morphology, options=nmv.interface.ui_options)
+####################################################################################################
+# @ReconstructMorphologyInBackground
+####################################################################################################
+class ReconstructMorphologyInBackground(nmv.interface.ui.BackgroundReconstruction,
+                                        bpy.types.Operator):
+    """Morphology reconstruction, where the morphology is loaded and reconstructed without blocking
+    the UI"""
 
-        elif method == nmv.enums.Skeleton.Method.DENDROGRAM:
-            morphology_builder = nmv.builders.DendrogramBuilder(
-                morphology=nmv.interface.ui_morphology, options=nmv.interface.ui_options)
+    # Operator parameters
+    bl_idname = "nmv.reconstruct_morphology_background"
+    bl_label = 'Reconstruct in Background'
 
-        # Default: DisconnectedSectionsBuilder
-        else:
-            morphology_builder = nmv.builders.DisconnectedSectionsBuilder(
-                morphology=nmv.interface.ui_morphology, options=nmv.interface.ui_options)
+    # Progress property
+    progress_property = 'NMV_MorphologyReconstructionProgress'
 
-        # Draw the morphology skeleton and return a list of all the reconstructed objects
-        nmv.interface.ui_reconstructed_skeleton = morphology_builder.draw_morphology_skeleton()
+    ################################################################################################
+    # @reconstruct_in_stages
+    ################################################################################################
+    def reconstruct_in_stages(self,
+                              context):
+        """Reconstructs the loaded morphology stage by stage.
 
-        # Morphology reconstructed
-        reconstruction_time = time.time()
-        global is_morphology_reconstructed
-        is_morphology_reconstructed = True
-        context.scene.NMV_MorphologyReconstructionTime = reconstruction_time - start_time
-        nmv.logger.statistics('Morphology reconstructed in [%f] seconds' %
-                              context.scene.NMV_MorphologyReconstructionTime)
+        :param context:
+            Blender context.
+        """
 
-        # Confirm operation done
-        return {'FINISHED'}
+        yield from reconstruct_morphology_skeleton_in_stages(context)
 
 
 ####################################################################################################
@@ -347,6 +420,51 @@ class RenderMorphologyTop(bpy.types.Operator):
         return {'FINISHED'}
 
 
+####################################################################################################
+# @RenderMorphologyAllViews
+####################################################################################################
+class RenderMorphologyAllViews(bpy.types.Operator):
+    """Render the front, side and top views of the reconstructed morphology in a single session"""
+
+    # Operator parameters
+    bl_idname = "nmv.render_morphology_all_views"
+    bl_label = "All"
+
+    ################################################################################################
+    # @execute
+    ################################################################################################
+    def execute(self, context):
+        """Execute the operator.
+
+        :param context:
+            Rendering context.
+        :return:
+            'FINISHED'.
+        """
+
+        # Timer
+        start_time = time.time()
+
+        # Render the images
+        nmv.interface.ui.render_morphology_views(
+            self, context_scene=context.scene,
+            views=[nmv.enums.Camera.View.FRONT,
+                   nmv.enums.Camera.View.SIDE,
+                   nmv.enums.Camera.View.TOP],
+            image_format=nmv.interface.ui_options.morphology.image_format)
+
+        # Stats.
+        rendering_time = time.time()
+        global is_morphology_rendered
+        is_morphology_rendered = True
+        context.scene.NMV_MorphologyRenderingTime = rendering_time - start_time
+        nmv.logger.statistics('Morphology rendered in [%f] seconds' %
+                              context.scene.NMV_MorphologyRenderingTime)
+
+        # Confirm operation done
+        return {'FINISHED'}
+
+
 ####################################################################################################
 # @RenderMorphology360
 ####################################################################################################
@@ -882,9 +1000,11 @@ def register_panel():
     # Buttons
     bpy.utils.register_class(MorphologyReconstructionDocumentation)
     bpy.utils.register_class(ReconstructMorphologyOperator)
+    bpy.utils.register_class(ReconstructMorphologyInBackground)
     bpy.utils.register_class(RenderMorphologyFront)
     bpy.utils.register_class(RenderMorphologySide)
     bpy.utils.register_class(RenderMorphologyTop)
+    bpy.utils.register_class(RenderMorphologyAllViews)
     bpy.utils.register_class(RenderMorphology360)
     bpy.utils.register_class(RenderMorphologyProgressive)
     bpy.utils.register_class(SaveMorphologyBLEND)
@@ -904,7 +1024,9 @@ def unregister_panel():
     # Buttons
     bpy.utils.unregister_class(MorphologyReconstructionDocumentation)
     bpy.utils.unregister_class(ReconstructMorphologyOperator)
+    bpy.utils.unregister_class(ReconstructMorphologyInBackground)
     bpy.utils.unregister_class(RenderMorphologyTop)
+    bpy.utils.unregister_class(RenderMorphologyAllViews)
     bpy.utils.unregister_class(RenderMorphologySide)
     bpy.utils.unregister_class(RenderMorphologyFront)
     bpy.utils.unregister_class(RenderMorphology360)
@@ -538,6 +538,7 @@ def set_rendering_options(layout,
     render_view_buttons_row.operator('nmv.render_morphology_front', icon='AXIS_FRONT')
     render_view_buttons_row.operator('nmv.render_morphology_side', icon='AXIS_SIDE')
     render_view_buttons_row.operator('nmv.render_morphology_top', icon='AXIS_TOP')
+    render_view_buttons_row.operator('nmv.render_morphology_all_views', icon='SCENE')
     render_view_buttons_row.enabled = True
 
     # Render animations buttons
@@ -398,6 +398,11 @@ bpy.types.Scene.NMV_MorphologyRenderingProgress = bpy.props.IntProperty(
     name='Rendering Progress',
     default=0, min=0, max=100, subtype='PERCENTAGE')
 
+# Morphology background reconstruction progress
+bpy.types.Scene.NMV_MorphologyReconstructionProgress = bpy.props.IntProperty(
+    name='Reconstruction Progress',
+    default=0, min=0, max=100, subtype='PERCENTAGE')
+
 # Reconstruction time
 bpy.types.Scene.NMV_MorphologyReconstructionTime = bpy.props.FloatProperty(
     name='Reconstruction (Sec)',
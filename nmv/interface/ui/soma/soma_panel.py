@@ -146,6 +146,13 @@ class SomaPanel(bpy.types.Panel):
         soma_reconstruction_buttons_row = layout.row(align=True)
         soma_reconstruction_buttons_row.operator('nmv.reconstruct_soma', icon='FORCE_LENNARDJONES')
 
+        # Background reconstruction button, cancelled with ESC
+        background_reconstruction_row = layout.row()
+        background_reconstruction_row.operator('nmv.reconstruct_soma_background', icon='SORTTIME')
+        background_reconstruction_progress_row = layout.row()
+        background_reconstruction_progress_row.prop(scene, 'NMV_SomaReconstructionProgress')
+        background_reconstruction_progress_row.enabled = False
+
         # Progress
         if scene.NMV_SomaReconstructionMethod == \
                 nmv.enums.Soma.Representation.SOFT_BODY:
@@ -259,6 +266,82 @@ class SomaPanel(bpy.types.Panel):
         nmv.interface.enable_or_disable_layout(layout)
 
 
+####################################################################################################
+# @reconstruct_soma_in_stages
+####################################################################################################
+def reconstruct_soma_in_stages(context):
+    """Reconstructs the soma of the loaded morphology stage by stage with the selected method. The
+    soft body simulation runs a frame per stage. Yields the progress and the name of every stage
+    before running it.
+
+    :param context:
+        Blender context.
+    """
+
+    # Get a reference to the scene
+    scene = context.scene
+
+    # Reconstruction time
+    start_time = time.time()
+
+    # MetaBall reconstruction
+    if scene.NMV_SomaReconstructionMethod == nmv.enums.Soma.Representation.META_BALLS:
+        soma_builder = nmv.builders.SomaMetaBuilder(
+            nmv.interface.ui_morphology, nmv.interface.ui_options)
+        nmv.interface.ui_soma_mesh = yield from soma_builder.reconstruct_soma_mesh_in_stages()
+
+    # Hybrid reconstruction
+    elif scene.NMV_SomaReconstructionMethod == nmv.enums.Soma.Representation.HYBRID:
+        soma_builder = nmv.builders.SomaHybridBuilder(
+            nmv.interface.ui_morphology, nmv.interface.ui_options)
+        nmv.interface.ui_soma_mesh = yield from soma_builder.reconstruct_soma_mesh_in_stages()
+
+    # Softbody reconstruction
+    else:
+        soma_builder = nmv.builders.SomaSoftBodyBuilder(
+            nmv.interface.ui_morphology, nmv.interface.ui_options)
+
+        # Build the basic profile of the soma from the soft body operation
+        yield 0.0, 'Building the soft body of the soma'
+        if scene.NMV_SomaProfile == nmv.enums.Soma.Profile.PROFILE_POINTS_ONLY:
+            soma_sphere_object = soma_builder.build_soma_based_on_profile_points_only()
+        elif scene.NMV_SomaProfile == nmv.enums.Soma.Profile.COMBINED:
+            soma_sphere_object = soma_builder.build_soma_soft_body(use_profile_points=True)
+        else:
+            soma_sphere_object = soma_builder.build_soma_soft_body()
+
+        # Run the simulation, a frame per stage
+        yield from nmv.utilities.scale_stages(
+            soma_builder.simulate_soft_body_in_stages(), 0.1, 0.9)
+
+        # Build the mesh from the soft body object
+        yield 0.9, 'Building the soma mesh from the soft body'
+        soma_sphere_object = soma_builder.build_soma_mesh_from_soft_body_object(
+            soma_sphere_object)
+        nmv.interface.ui_soma_mesh = soma_sphere_object
+
+        if scene.NMV_SomaProfile == nmv.enums.Soma.Profile.PROFILE_POINTS_ONLY:
+
+            # Decimate the mesh using 25%
+            nmv.logger.info('Decimation')
+            nmv.mesh.ops.decimate_mesh_object(soma_sphere_object, decimation_ratio=0.25)
+
+            # Smooth the mesh again to look nice
+            nmv.logger.info('Smoothing')
+            nmv.mesh.ops.smooth_object(soma_sphere_object, level=2)
+
+    # Get the reconstruction time to update the UI
+    scene.NMV_SomaReconstructionTime = time.time() - start_time
+    nmv.logger.info_done('Soma reconstructed in [%f] seconds' % scene.NMV_SomaReconstructionTime)
+
+    # Set the reconstruction flag to on
+    global is_soma_reconstructed
+    is_soma_reconstructed = True
+
+    # View all the objects in the scene
+    nmv.scene.ops.view_all_scene()
+
+
 ####################################################################################################
 # @ReconstructSoma
 ####################################################################################################
@@ -356,6 +439,11 @@ class ReconstructSomaOperator(bpy.types.Operator):
         # Get a reference to the scene
         scene = context.scene
 
+        # Do not clear the scene under a running background reconstruction
+        if nmv.interface.ui.BackgroundReconstruction.running:
+            self.report({'WARNING'}, 'A reconstruction is already running')
+            return {'CANCELLED'}
+
         # Clear the scene
         nmv.scene.ops.clear_scene()
 
@@ -500,6 +588,35 @@ class ReconstructSomaOperator(bpy.types.Operator):
         self.report({'INFO'}, 'Soma Reconstruction Done')
 
 
+####################################################################################################
+# @ReconstructSomaInBackground
+####################################################################################################
+class ReconstructSomaInBackground(nmv.interface.ui.BackgroundReconstruction,
+                                  bpy.types.Operator):
+    """Soma reconstruction, where the morphology is loaded and the soma is reconstructed without
+    blocking the UI"""
+
+    # Operator parameters
+    bl_idname = "nmv.reconstruct_soma_background"
+    bl_label = 'Reconstruct in Background'
+
+    # Progress property
+    progress_property = 'NMV_SomaReconstructionProgress'
+
+    ################################################################################################
+    # @reconstruct_in_stages
+    ################################################################################################
+    def reconstruct_in_stages(self,
+                              context):
+        """Reconstructs the soma of the loaded morphology stage by stage.
+
+        :param context:
+            Blender context.
+        """
+
+        yield from reconstruct_soma_in_stages(context)
+
+
 ####################################################################################################
 # @RenderSomaFront
 ####################################################################################################
@@ -1168,6 +1285,7 @@ def register_panel():
     # Buttons
     bpy.utils.register_class(SomaReconstructionDocumentation)
     bpy.utils.register_class(ReconstructSomaOperator)
+    bpy.utils.register_class(ReconstructSomaInBackground)
     bpy.utils.register_class(RenderSomaFront)
     bpy.utils.register_class(RenderSomaSide)
     bpy.utils.register_class(RenderSomaTop)
@@ -1192,6 +1310,7 @@ def unregister_panel():
     # Buttons
     bpy.utils.unregister_class(SomaReconstructionDocumentation)
     bpy.utils.unregister_class(ReconstructSomaOperator)
+    bpy.utils.unregister_class(ReconstructSomaInBackground)
     bpy.utils.unregister_class(RenderSomaFront)
     bpy.utils.unregister_class(RenderSomaSide)
     bpy.utils.unregister_class(RenderSomaTop)
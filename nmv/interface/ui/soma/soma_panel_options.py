@@ -133,6 +133,11 @@ bpy.types.Scene.NMV_SomaSimulationProgress = bpy.props.IntProperty(
     description='Reconstruction progress',
     default=0, min=0, max=100, subtype='PERCENTAGE')
 
+# Soma background reconstruction progress
+bpy.types.Scene.NMV_SomaReconstructionProgress = bpy.props.IntProperty(
+    name='Reconstruction Progress',
+    default=0, min=0, max=100, subtype='PERCENTAGE')
+
 # Image format
 bpy.types.Scene.NMV_SomaImageFormat = bpy.props.EnumProperty(
     items=nmv.enums.Image.Extension.IMAGE_EXTENSION_ITEMS,
@@ -15,7 +15,12 @@
 # If not, see <http://www.gnu.org/licenses/>.
 ####################################################################################################
 
+from .mesh_array_cleaning_ops import *
 from .mesh_cleaning_ops import *
+from .mesh_decimation_ops import *
 from .mesh_face_ops import *
+from .mesh_noise_ops import *
 from .mesh_object_ops import *
-from .mesh_vertex_ops import *
\ No newline at end of file
+from .mesh_vertex_ops import *
+from .mesh_union_ops import *
+from .mesh_voxel_union_ops import *
\ No newline at end of file
@@ -0,0 +1,790 @@
+####################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+# System imports
+import collections
+import itertools
+import numpy
+
+
+####################################################################################################
+# @MeshArrays
+####################################################################################################
+class MeshArrays:
+    """A polygonal mesh stored in flat arrays, as the vertices, the loops and the polygons of a
+    Blender mesh. It does not depend on Blender, so it can be cleaned in any process.
+    """
+
+    ################################################################################################
+    # @__init__
+    ################################################################################################
+    def __init__(self,
+                 vertices,
+                 loop_vertices,
+                 loop_starts,
+                 loop_totals,
+                 polygon_attributes=None,
+                 loop_attributes=None):
+        """Constructor
+
+        :param vertices:
+            An array of the vertices, a row each.
+        :param loop_vertices:
+            An array of the vertex indices of the loops of all the polygons.
+        :param loop_starts:
+            An array of the first loop of every polygon.
+        :param loop_totals:
+            An array of the number of the loops of every polygon.
+        :param polygon_attributes:
+            A dictionary of the arrays of the attributes of the polygons, like the smooth flags
+            or the material indices, with a row per polygon.
+        :param loop_attributes:
+            A dictionary of the arrays of the attributes of the loops, like the UV layers, with a
+            row per loop.
+        """
+
+        # The vertices
+        self.vertices = numpy.asarray(vertices, dtype=numpy.float64).reshape(-1, 3)
+
+        # The vertex indices of the loops
+        self.loop_vertices = numpy.asarray(loop_vertices, dtype=numpy.int64)
+
+        # The first loop of every polygon
+        self.loop_starts = numpy.asarray(loop_starts, dtype=numpy.int64)
+
+        # The number of the loops of every polygon
+        self.loop_totals = numpy.asarray(loop_totals, dtype=numpy.int64)
+
+        # The attributes of the polygons and the loops, they follow them through the cleaning
+        self.polygon_attributes = dict() if polygon_attributes is None else polygon_attributes
+        self.loop_attributes = dict() if loop_attributes is None else loop_attributes
+
+    ################################################################################################
+    # @from_polygons
+    ################################################################################################
+    @staticmethod
+    def from_polygons(vertices,
+                      polygons):
+        """Creates the arrays from a list of polygons.
+
+        :param vertices:
+            A list of the vertices.
+        :param polygons:
+            A list of the polygons, each is a list of vertex indices.
+        :return:
+            A MeshArrays object.
+        """
+
+        loop_totals = numpy.array([len(polygon) for polygon in polygons], dtype=numpy.int64)
+        loop_starts = numpy.cumsum(loop_totals) - loop_totals
+        loop_vertices = numpy.array(list(itertools.chain.from_iterable(polygons)),
+                                    dtype=numpy.int64)
+        return MeshArrays(vertices, loop_vertices, loop_starts, loop_totals)
+
+    ################################################################################################
+    # @get_polygons
+    ################################################################################################
+    def get_polygons(self):
+        """Gets the polygons as a list of lists of vertex indices.
+
+        :return:
+            A list of the polygons.
+        """
+
+        return [polygon.tolist() for polygon in
+                numpy.split(self.loop_vertices, self.loop_starts[1:])] \
+            if len(self.loop_starts) > 0 else list()
+
+    ################################################################################################
+    # @get_loop_polygons
+    ################################################################################################
+    def get_loop_polygons(self):
+        """Gets the polygon of every loop.
+
+        :return:
+            An array of the polygon index of every loop.
+        """
+
+        return numpy.repeat(numpy.arange(len(self.loop_totals)), self.loop_totals)
+
+    ################################################################################################
+    # @get_next_loops
+    ################################################################################################
+    def get_next_loops(self):
+        """Gets the next loop of every loop in its polygon, the last loop wraps to the first.
+
+        :return:
+            An array of the index of the next loop of every loop.
+        """
+
+        next_loops = numpy.arange(1, len(self.loop_vertices) + 1)
+        next_loops[self.loop_starts + self.loop_totals - 1] = self.loop_starts
+        return next_loops
+
+    ################################################################################################
+    # @get_edges
+    ################################################################################################
+    def get_edges(self):
+        """Gets the undirected edge of every loop, the edge from its vertex to the next one.
+
+        :return:
+            A tuple (edge of every loop, number of the loops of every edge, number of edges).
+        """
+
+        first = self.loop_vertices
+        second = self.loop_vertices[self.get_next_loops()]
+        keys = numpy.minimum(first, second) * len(self.vertices) + numpy.maximum(first, second)
+        unique_keys, loop_edges, edge_counts = numpy.unique(
+            keys, return_inverse=True, return_counts=True)
+        return loop_edges, edge_counts, len(unique_keys)
+
+    ################################################################################################
+    # @keep_polygons
+    ################################################################################################
+    def keep_polygons(self,
+                      mask):
+        """Keeps the polygons of a mask and removes the others.
+
+        :param mask:
+            A boolean array with a flag per polygon.
+        """
+
+        loop_mask = numpy.repeat(mask, self.loop_totals)
+        self.loop_vertices = self.loop_vertices[loop_mask]
+        self.loop_totals = self.loop_totals[mask]
+        for name in self.polygon_attributes:
+            self.polygon_attributes[name] = self.polygon_attributes[name][mask]
+        for name in self.loop_attributes:
+            self.loop_attributes[name] = self.loop_attributes[name][loop_mask]
+        self.loop_starts = numpy.cumsum(self.loop_totals) - self.loop_totals
+
+    ################################################################################################
+    # @keep_loops
+    ################################################################################################
+    def keep_loops(self,
+                   mask):
+        """Keeps the loops of a mask, the polygons with less than three loops are removed.
+
+        :param mask:
+            A boolean array with a flag per loop.
+        """
+
+        loop_totals = numpy.bincount(self.get_loop_polygons()[mask],
+                                     minlength=len(self.loop_totals))
+        self.loop_vertices = self.loop_vertices[mask]
+        self.loop_totals = loop_totals
+        for name in self.loop_attributes:
+            self.loop_attributes[name] = self.loop_attributes[name][mask]
+        self.loop_starts = numpy.cumsum(self.loop_totals) - self.loop_totals
+        self.keep_polygons(self.loop_totals >= 3)
+
+    ################################################################################################
+    # @reorder_loops
+    ################################################################################################
+    def reorder_loops(self,
+                      order):
+        """Reorders the loops, with their attributes, the polygons keep their loop ranges.
+
+        :param order:
+            An array of the old index of every new loop.
+        """
+
+        self.loop_vertices = self.loop_vertices[order]
+        for name in self.loop_attributes:
+            self.loop_attributes[name] = self.loop_attributes[name][order]
+
+    ################################################################################################
+    # @append_polygons
+    ################################################################################################
+    def append_polygons(self,
+                        polygons,
+                        source_polygons,
+                        source_loops):
+        """Appends new polygons, their attributes are copied from existing polygons and loops.
+
+        :param polygons:
+            A list of the new polygons, each is a list of vertex indices.
+        :param source_polygons:
+            An array of the existing polygon whose attributes are copied to every new polygon.
+        :param source_loops:
+            An array of the existing loop whose attributes are copied to every new loop.
+        """
+
+        totals = numpy.array([len(polygon) for polygon in polygons], dtype=numpy.int64)
+        self.loop_starts = numpy.concatenate(
+            [self.loop_starts, len(self.loop_vertices) + numpy.cumsum(totals) - totals])
+        self.loop_totals = numpy.concatenate([self.loop_totals, totals])
+        self.loop_vertices = numpy.concatenate(
+            [self.loop_vertices, numpy.array(list(itertools.chain.from_iterable(polygons)),
+                                             dtype=numpy.int64)])
+        for name, values in self.polygon_attributes.items():
+            self.polygon_attributes[name] = numpy.concatenate([values, values[source_polygons]])
+        for name, values in self.loop_attributes.items():
+            self.loop_attributes[name] = numpy.concatenate([values, values[source_loops]])
+
+    ################################################################################################
+    # @remove_unused_vertices
+    ################################################################################################
+    def remove_unused_vertices(self):
+        """Removes the vertices that are not used by any polygon, the loose vertices and edges.
+        """
+
+        used = numpy.zeros(len(self.vertices), dtype=bool)
+        used[self.loop_vertices] = True
+        new_indices = numpy.cumsum(used) - 1
+        self.vertices = self.vertices[used]
+        self.loop_vertices = new_indices[self.loop_vertices]
+
+
+####################################################################################################
+# @propagate_labels
+####################################################################################################
+def propagate_labels(number_elements,
+                     first,
+                     second):
+    """Labels the connected components of a graph, every element gets the smallest index in its
+    component.
+
+    :param number_elements:
+        The number of the elements.
+    :param first:
+        An array of the first elements of the connections.
+    :param second:
+        An array of the second elements of the connections.
+    :return:
+        An array of the label of every element.
+    """
+
+    labels = numpy.arange(number_elements)
+    while True:
+        new_labels = labels.copy()
+        numpy.minimum.at(new_labels, first, labels[second])
+        numpy.minimum.at(new_labels, second, labels[first])
+
+        # Jump to the labels of the labels until they settle
+        while True:
+            jumped_labels = new_labels[new_labels]
+            if numpy.array_equal(jumped_labels, new_labels):
+                break
+            new_labels = jumped_labels
+
+        if numpy.array_equal(new_labels, labels):
+            return labels
+        labels = new_labels
+
+
+####################################################################################################
+# @find_close_vertices
+####################################################################################################
+def find_close_vertices(vertices,
+                        threshold):
+    """Finds the pairs of the vertices closer than a threshold with a spatial hash, the vertices
+    are hashed into cells of the size of the threshold and only the neighbouring cells are compared.
+
+    :param vertices:
+        An array of the vertices, a row each.
+    :param threshold:
+        The distance threshold.
+    :return:
+        A tuple of two arrays of the first and the second vertices of the pairs.
+    """
+
+    # The cells of the vertices, shifted to leave an empty cell around them
+    cells = numpy.floor(vertices / threshold).astype(numpy.int64)
+    cells -= cells.min(axis=0) - 1
+    size = cells.max(axis=0) + 2
+    keys = (cells[:, 0] * size[1] + cells[:, 1]) * size[2] + cells[:, 2]
+
+    # The occupied cells, sorted, and their vertices
+    cell_keys, cell_indices, cell_counts = numpy.unique(
+        keys, return_inverse=True, return_counts=True)
+    order = numpy.argsort(cell_indices.ravel(), kind='stable')
+    cell_begins = numpy.cumsum(cell_counts) - cell_counts
+
+    first = list()
+    second = list()
+    for offset in itertools.product([-1, 0, 1], repeat=3):
+
+        # Every pair of neighbouring cells is visited once, from the lower cell
+        if offset < (0, 0, 0):
+            continue
+
+        # The occupied neighbouring cells of the occupied cells, the keys are sorted so the
+        # search is sequential
+        neighbour_keys = cell_keys + (offset[0] * size[1] + offset[1]) * size[2] + offset[2]
+        neighbour_cells = numpy.minimum(numpy.searchsorted(cell_keys, neighbour_keys),
+                                        len(cell_keys) - 1)
+        found = cell_keys[neighbour_cells] == neighbour_keys
+        cells_1 = numpy.nonzero(found)[0]
+        cells_2 = neighbour_cells[found]
+
+        # All the pairs of the vertices of the two cells
+        pair_counts = cell_counts[cells_1] * cell_counts[cells_2]
+        pairs = numpy.arange(pair_counts.sum()) - numpy.repeat(
+            numpy.cumsum(pair_counts) - pair_counts, pair_counts)
+        counts_2 = numpy.repeat(cell_counts[cells_2], pair_counts)
+        candidates = order[numpy.repeat(cell_begins[cells_1], pair_counts) + pairs // counts_2]
+        neighbours = order[numpy.repeat(cell_begins[cells_2], pair_counts) + pairs % counts_2]
+
+        # The close ones, the pairs within a cell once
+        close = numpy.linalg.norm(vertices[candidates] - vertices[neighbours], axis=1) <= threshold
+        if offset == (0, 0, 0):
+            close &= candidates < neighbours
+        first.append(candidates[close])
+        second.append(neighbours[close])
+
+    return numpy.concatenate(first), numpy.concatenate(second)
+
+
+####################################################################################################
+# @ArrayMeshCleaner
+####################################################################################################
+class ArrayMeshCleaner:
+    """Cleans a mesh with problems like duplicate vertices, degenerate and interior faces, loose
+    parts, non-manifold vertices and edges, holes and inconsistent normals, on the flat arrays of
+    the mesh.
+
+    It follows the steps of the MeshCleaner, but every step is a vectorized pass over the arrays
+    instead of an operator in the edit mode, and the mesh is read and written once.
+
+    NOTE: The MeshCleaner fills the non-manifold regions and deletes the new non-manifold vertices
+    until the mesh settles, while this cleaner splits every non-manifold vertex into a vertex per
+    fan of faces around it, which also separates the faces of the non-manifold edges.
+    """
+
+    ################################################################################################
+    # @__init__
+    ################################################################################################
+    def __init__(self,
+                 threshold=0.0001,
+                 sides=0,
+                 minimum_part_faces=0):
+        """Constructor
+
+        :param threshold:
+            Minimum distance between elements to merge.
+        :param sides:
+            Number of sides in hole required to fill (zero fills all holes).
+        :param minimum_part_faces:
+            The disconnected parts with less faces are removed, zero keeps all the parts.
+        """
+
+        # Merging threshold
+        self.threshold = threshold
+
+        # Number of sides in holes to be filled.
+        self.sides = sides
+
+        # The minimum number of the faces of a part
+        self.minimum_part_faces = minimum_part_faces
+
+        # Vertex count difference
+        self.vertex_count_difference = None
+
+        # Edge count difference
+        self.edge_count_difference = None
+
+        # Face count difference
+        self.face_count_difference = None
+
+    ################################################################################################
+    # @execute
+    ################################################################################################
+    def execute(self,
+                mesh):
+        """Cleans the mesh.
+
+        :param mesh:
+            A MeshArrays object, cleaned in place.
+        :return:
+            The cleaned mesh.
+        """
+
+        # The original counts
+        original_counts = self.count_mesh_elements(mesh)
+
+        # Weld the vertices
+        self.remove_doubles(mesh, self.threshold)
+
+        # Remove the degenerate, duplicate and interior faces
+        self.remove_degenerate(mesh, self.threshold)
+        self.remove_duplicate_faces(mesh)
+        self.delete_interior(mesh)
+
+        # Remove the small parts and the loose vertices
+        self.delete_loose(mesh, self.minimum_part_faces)
+
+        # Split the non-manifold vertices and edges
+        self.split_non_manifold_vertices(mesh)
+
+        # Make the normals consistent, then fill the holes along the consistent boundaries
+        self.make_normals_consistently_outwards(mesh)
+        self.fill_holes(mesh, self.sides)
+
+        # Compute data for stats.
+        counts = self.count_mesh_elements(mesh)
+        self.vertex_count_difference = counts[0] - original_counts[0]
+        self.edge_count_difference = counts[1] - original_counts[1]
+        self.face_count_difference = counts[2] - original_counts[2]
+
+        # Return the cleaned mesh
+        return mesh
+
+    ################################################################################################
+    # @count_mesh_elements
+    ################################################################################################
+    @staticmethod
+    def count_mesh_elements(mesh):
+        """Count number of elements in the mesh.
+
+        :param mesh:
+            A MeshArrays object.
+        :return:
+            A tuple of the numbers of the vertices, the edges and the faces.
+        """
+
+        number_edges = mesh.get_edges()[2] if len(mesh.loop_vertices) > 0 else 0
+        return len(mesh.vertices), number_edges, len(mesh.loop_totals)
+
+    ################################################################################################
+    # @remove_doubles
+    ################################################################################################
+    @staticmethod
+    def remove_doubles(mesh,
+                       threshold):
+        """Welds the vertices closer than the threshold, every cluster of close vertices is merged
+        into its first vertex.
+
+        :param mesh:
+            A MeshArrays object.
+        :param threshold:
+            The distance threshold.
+        """
+
+        if len(mesh.vertices) == 0 or threshold <= 0:
+            return
+
+        # Merge the clusters of close vertices
+        first, second = find_close_vertices(mesh.vertices, threshold)
+        labels = propagate_labels(len(mesh.vertices), first, second)
+        mesh.loop_vertices = labels[mesh.loop_vertices]
+
+        # The collapsed edges are removed from the polygons
+        mesh.keep_loops(mesh.loop_vertices != mesh.loop_vertices[mesh.get_next_loops()])
+        mesh.remove_unused_vertices()
+
+    ################################################################################################
+    # @remove_degenerate
+    ################################################################################################
+    @staticmethod
+    def remove_degenerate(mesh,
+                          threshold):
+        """Removes the faces that use a vertex twice and the faces with a zero area.
+
+        :param mesh:
+            A MeshArrays object.
+        :param threshold:
+            The distance threshold, the faces with an area below its square are removed.
+        """
+
+        if len(mesh.loop_totals) == 0:
+            return
+
+        loop_polygons = mesh.get_loop_polygons()
+
+        # The faces that use a vertex twice
+        order = numpy.lexsort((mesh.loop_vertices, loop_polygons))
+        repeated = (loop_polygons[order][1:] == loop_polygons[order][:-1]) & \
+                   (mesh.loop_vertices[order][1:] == mesh.loop_vertices[order][:-1])
+        valid = numpy.ones(len(mesh.loop_totals), dtype=bool)
+        valid[loop_polygons[order][1:][repeated]] = False
+
+        # The areas of the faces, as fans around their first vertices
+        first_points = mesh.vertices[mesh.loop_vertices[mesh.loop_starts]][loop_polygons]
+        points = mesh.vertices[mesh.loop_vertices]
+        next_points = points[mesh.get_next_loops()]
+        crosses = numpy.cross(points - first_points, next_points - first_points)
+        normals = numpy.zeros((len(mesh.loop_totals), 3))
+        numpy.add.at(normals, loop_polygons, crosses)
+        areas = 0.5 * numpy.linalg.norm(normals, axis=1)
+        valid &= areas > threshold * threshold
+
+        mesh.keep_polygons(valid)
+
+    ################################################################################################
+    # @remove_duplicate_faces
+    ################################################################################################
+    @staticmethod
+    def remove_duplicate_faces(mesh):
+        """Removes the faces that use the same vertices as a previous face.
+
+        :param mesh:
+            A MeshArrays object.
+        """
+
+        valid = numpy.ones(len(mesh.loop_totals), dtype=bool)
+        for total in numpy.unique(mesh.loop_totals):
+            polygons = numpy.nonzero(mesh.loop_totals == total)[0]
+            loops = mesh.loop_starts[polygons][:, None] + numpy.arange(total)
+            sorted_vertices = numpy.sort(mesh.loop_vertices[loops], axis=1)
+            _, first_polygons = numpy.unique(sorted_vertices, axis=0, return_index=True)
+            duplicates = numpy.ones(len(polygons), dtype=bool)
+            duplicates[first_polygons] = False
+            valid[polygons[duplicates]] = False
+        mesh.keep_polygons(valid)
+
+    ################################################################################################
+    # @delete_interior
+    ################################################################################################
+    @staticmethod
+    def delete_interior(mesh):
+        """Removes the interior faces, the faces whose edges are all shared by more than two faces.
+
+        :param mesh:
+            A MeshArrays object.
+        """
+
+        if len(mesh.loop_totals) == 0:
+            return
+
+        loop_edges, edge_counts, _ = mesh.get_edges()
+        interior = numpy.logical_and.reduceat(edge_counts[loop_edges] > 2, mesh.loop_starts)
+        mesh.keep_polygons(~interior)
+
+    ################################################################################################
+    # @delete_loose
+    ################################################################################################
+    @staticmethod
+    def delete_loose(mesh,
+                     minimum_part_faces):
+        """Removes the disconnected parts with less faces than a minimum, and the loose vertices.
+
+        :param mesh:
+            A MeshArrays object.
+        :param minimum_part_faces:
+            The minimum number of the faces of a part.
+        """
+
+        if minimum_part_faces > 0 and len(mesh.loop_totals) > 0:
+            parts = ArrayMeshCleaner.get_parts(mesh)
+            part_faces = numpy.bincount(parts)
+            mesh.keep_polygons(part_faces[parts] >= minimum_part_faces)
+        mesh.remove_unused_vertices()
+
+    ################################################################################################
+    # @get_parts
+    ################################################################################################
+    @staticmethod
+    def get_parts(mesh):
+        """Gets the connected part of every face, the faces are connected through their vertices.
+
+        :param mesh:
+            A MeshArrays object.
+        :return:
+            An array of the part label of every face.
+        """
+
+        first_vertices = mesh.loop_vertices[mesh.loop_starts][mesh.get_loop_polygons()]
+        labels = propagate_labels(len(mesh.vertices), first_vertices, mesh.loop_vertices)
+        return labels[mesh.loop_vertices[mesh.loop_starts]]
+
+    ################################################################################################
+    # @split_non_manifold_vertices
+    ################################################################################################
+    @staticmethod
+    def split_non_manifold_vertices(mesh):
+        """Splits every vertex into a vertex per fan of faces around it.
+
+        The corners of the faces, i.e. the loops, around a vertex are connected across the manifold
+        edges, the edges of two faces, and every connected group of corners is a fan. A vertex
+        with a single fan is kept, while a bowtie vertex, where two fans touch at a single point,
+        or a vertex of a non-manifold edge, an edge of more than two faces, gets a new vertex per
+        fan. The non-manifold edges become boundary edges of their faces.
+
+        :param mesh:
+            A MeshArrays object.
+        """
+
+        if len(mesh.loop_totals) == 0:
+            return
+
+        # The two loops of every manifold edge
+        loop_edges, edge_counts, _ = mesh.get_edges()
+        next_loops = mesh.get_next_loops()
+        manifold_loops = numpy.nonzero(edge_counts[loop_edges] == 2)[0]
+        manifold_loops = manifold_loops[numpy.argsort(loop_edges[manifold_loops], kind='stable')]
+        loops_1 = manifold_loops[0::2]
+        loops_2 = manifold_loops[1::2]
+
+        # A loop is the corner of its face at the first vertex of its edge, and the next loop is the
+        # corner at the second vertex. If the faces traverse the edge in opposite directions, the
+        # corner at the first vertex of one face meets the corner at the second vertex of the other
+        same_direction = mesh.loop_vertices[loops_1] == mesh.loop_vertices[loops_2]
+        first = numpy.concatenate([loops_1, next_loops[loops_1]])
+        second = numpy.concatenate([
+            numpy.where(same_direction, loops_2, next_loops[loops_2]),
+            numpy.where(same_direction, next_loops[loops_2], loops_2)])
+
+        # The fans, each is labeled by its smallest corner, and the fans of a vertex never merge
+        fans = propagate_labels(len(mesh.loop_vertices), first, second)
+
+        # A vertex per fan
+        unique_fans, loop_fans = numpy.unique(fans, return_inverse=True)
+        if len(unique_fans) == len(mesh.vertices):
+            return
+        mesh.vertices = mesh.vertices[mesh.loop_vertices[unique_fans]]
+        mesh.loop_vertices = loop_fans.ravel().astype(numpy.int64)
+
+    ################################################################################################
+    # @make_normals_consistently_outwards
+    ################################################################################################
+    @staticmethod
+    def make_normals_consistently_outwards(mesh):
+        """Orients the faces consistently with a breadth-first traversal across the manifold edges,
+        then flips every part with a negative volume to have all normals face outwards.
+
+        :param mesh:
+            A MeshArrays object.
+        """
+
+        number_faces = len(mesh.loop_totals)
+        if number_faces == 0:
+            return
+
+        # The faces of every manifold edge, and whether they traverse it in the same direction
+        loop_edges, edge_counts, _ = mesh.get_edges()
+        loop_polygons = mesh.get_loop_polygons()
+        manifold_loops = numpy.nonzero(edge_counts[loop_edges] == 2)[0]
+        manifold_loops = manifold_loops[numpy.argsort(loop_edges[manifold_loops], kind='stable')]
+        loops_1 = manifold_loops[0::2]
+        loops_2 = manifold_loops[1::2]
+        same_direction = mesh.loop_vertices[loops_1] == mesh.loop_vertices[loops_2]
+        faces_1 = loop_polygons[loops_1]
+        faces_2 = loop_polygons[loops_2]
+
+        # The adjacency of the faces, in Python lists that are faster to traverse than arrays
+        adjacent_faces = numpy.concatenate([faces_1, faces_2])
+        order = numpy.argsort(adjacent_faces, kind='stable')
+        pointers = numpy.searchsorted(
+            adjacent_faces[order], numpy.arange(number_faces + 1)).tolist()
+        neighbours = numpy.concatenate([faces_2, faces_1])[order].tolist()
+        same_directions = numpy.concatenate([same_direction, same_direction])[order].tolist()
+
+        # Traverse every part from its first face, a neighbour that traverses the shared edge in
+        # the same direction is flipped relative to its face
+        flipped = [False] * number_faces
+        parts = [-1] * number_faces
+        number_parts = 0
+        for seed in range(number_faces):
+            if parts[seed] >= 0:
+                continue
+            parts[seed] = number_parts
+            queue = collections.deque([seed])
+            while queue:
+                face = queue.popleft()
+                for i in range(pointers[face], pointers[face + 1]):
+                    neighbour = neighbours[i]
+                    if parts[neighbour] < 0:
+                        parts[neighbour] = number_parts
+                        flipped[neighbour] = flipped[face] ^ same_directions[i]
+                        queue.append(neighbour)
+            number_parts += 1
+        flipped = numpy.array(flipped, dtype=bool)
+        parts = numpy.array(parts, dtype=numpy.int64)
+
+        # The signed volume of every part after the flips
+        points = mesh.vertices[mesh.loop_vertices]
+        first_points = points[mesh.loop_starts][loop_polygons]
+        next_points = points[mesh.get_next_loops()]
+        volumes = numpy.einsum('ij,ij->i', first_points, numpy.cross(points, next_points))
+        volumes = numpy.where(flipped[loop_polygons], -volumes, volumes)
+        part_volumes = numpy.bincount(parts[loop_polygons], weights=volumes,
+                                      minlength=number_parts)
+        flipped ^= part_volumes[parts] < 0
+
+        # Reverse the loops of the flipped faces
+        loops = numpy.arange(len(mesh.loop_vertices))
+        starts = mesh.loop_starts[loop_polygons]
+        totals = mesh.loop_totals[loop_polygons]
+        reversed_loops = starts + totals - 1 - (loops - starts)
+        mesh.reorder_loops(numpy.where(flipped[loop_polygons], reversed_loops, loops))
+
+    ################################################################################################
+    # @fill_holes
+    ################################################################################################
+    @staticmethod
+    def fill_holes(mesh,
+                   sides):
+        """Fills the holes bounded by simple loops of boundary edges with a face each.
+
+        NOTE: The normals must be consistent, the boundary edges are then traversed in a single
+        direction and the new face traverses them backwards, with the orientation of its
+        neighbours. The boundaries through non-manifold vertices are not filled.
+
+        :param mesh:
+            A MeshArrays object.
+        :param sides:
+            Number of sides in hole required to fill (zero fills all holes).
+        """
+
+        if len(mesh.loop_totals) == 0:
+            return
+
+        # The boundary edges, traversed backwards
+        loop_edges, edge_counts, _ = mesh.get_edges()
+        boundary_loops = numpy.nonzero(edge_counts[loop_edges] == 1)[0]
+        if len(boundary_loops) == 0:
+            return
+        start_loops = mesh.get_next_loops()[boundary_loops]
+        starts = mesh.loop_vertices[start_loops].tolist()
+        ends = mesh.loop_vertices[boundary_loops].tolist()
+
+        # The boundary vertices with a single boundary edge leaving them, and their loops in the
+        # neighbouring faces, the new loops take their attributes
+        next_vertex = dict()
+        vertex_loop = dict()
+        ambiguous = set()
+        for start, end, start_loop in zip(starts, ends, start_loops.tolist()):
+            if start in next_vertex:
+                ambiguous.add(start)
+            next_vertex[start] = end
+            vertex_loop[start] = start_loop
+
+        # Walk along the holes
+        holes = list()
+        visited = set()
+        for start in next_vertex:
+            if start in visited:
+                continue
+            hole = list()
+            vertex = start
+            while vertex not in visited and vertex in next_vertex:
+                visited.add(vertex)
+                hole.append(vertex)
+                vertex = next_vertex[vertex]
+            if vertex == start and len(hole) >= 3 and not ambiguous.intersection(hole):
+                if sides == 0 or len(hole) <= sides:
+                    holes.append(hole)
+
+        # Add a face per hole, with the attributes of the neighbouring face of its first vertex
+        if len(holes) > 0:
+            source_loops = numpy.array(
+                [vertex_loop[vertex] for vertex in itertools.chain.from_iterable(holes)],
+                dtype=numpy.int64)
+            source_polygons = mesh.get_loop_polygons()[
+                numpy.array([vertex_loop[hole[0]] for hole in holes], dtype=numpy.int64)]
+            mesh.append_polygons(holes, source_polygons, source_loops)
@@ -16,11 +16,15 @@
 # MA 02110-1301 USA.
 ####################################################################################################
 
+# System imports
+import numpy
+
 # Blender imports
 import bpy
 import bmesh
 
 # Internal imports
+import nmv.mesh
 import nmv.scene
 import nmv.utilities
 
@@ -347,24 +351,125 @@ class MeshCleaner:
         nmv.utilities.enable_std_output()
 
 
+####################################################################################################
+# @read_mesh_arrays
+####################################################################################################
+def read_mesh_arrays(mesh_object):
+    """Reads the vertices and the polygons of a mesh object into flat arrays, with the smooth
+    flags and the material indices of the polygons and the UV layers of the loops.
+
+    :param mesh_object:
+        A given mesh object.
+    :return:
+        A MeshArrays object in the local coordinates of the mesh object.
+    """
+
+    mesh = mesh_object.data
+
+    vertices = numpy.zeros(len(mesh.vertices) * 3)
+    mesh.vertices.foreach_get('co', vertices)
+    loop_vertices = numpy.zeros(len(mesh.loops), dtype=numpy.int32)
+    mesh.loops.foreach_get('vertex_index', loop_vertices)
+    loop_starts = numpy.zeros(len(mesh.polygons), dtype=numpy.int32)
+    mesh.polygons.foreach_get('loop_start', loop_starts)
+    loop_totals = numpy.zeros(len(mesh.polygons), dtype=numpy.int32)
+    mesh.polygons.foreach_get('loop_total', loop_totals)
+    smooth = numpy.zeros(len(mesh.polygons), dtype=bool)
+    mesh.polygons.foreach_get('use_smooth', smooth)
+    material_indices = numpy.zeros(len(mesh.polygons), dtype=numpy.int32)
+    mesh.polygons.foreach_get('material_index', material_indices)
+    uv_layers = dict()
+    for uv_layer in mesh.uv_layers:
+        uvs = numpy.zeros(len(mesh.loops) * 2, dtype=numpy.float32)
+        uv_layer.data.foreach_get('uv', uvs)
+        uv_layers[uv_layer.name] = uvs.reshape(-1, 2)
+
+    # Blender keeps the loops of the polygons contiguous but not necessarily in order
+    order = numpy.argsort(loop_starts, kind='stable')
+    loop_totals = loop_totals[order]
+    new_loop_starts = numpy.cumsum(loop_totals) - loop_totals
+    loops = numpy.arange(len(loop_vertices)) + \
+        numpy.repeat(loop_starts[order] - new_loop_starts, loop_totals)
+    return nmv.mesh.ops.MeshArrays(
+        vertices, loop_vertices[loops], new_loop_starts, loop_totals,
+        polygon_attributes={'use_smooth': smooth[order], 'material_index': material_indices[order]},
+        loop_attributes={name: uvs[loops] for name, uvs in uv_layers.items()})
+
+
+####################################################################################################
+# @write_mesh_arrays
+####################################################################################################
+def write_mesh_arrays(mesh_object,
+                      mesh_arrays):
+    """Replaces the data of a mesh object by the flat arrays of a mesh, in a single write.
+
+    NOTE: The materials of the mesh are kept, and the smooth flags, the material indices and the
+    UV layers are restored from the attributes of the arrays when they have them.
+
+    :param mesh_object:
+        A given mesh object.
+    :param mesh_arrays:
+        A MeshArrays object in the local coordinates of the mesh object.
+    """
+
+    # Create the new mesh
+    original_mesh = mesh_object.data
+    mesh = bpy.data.meshes.new(original_mesh.name)
+    mesh.from_pydata(mesh_arrays.vertices.tolist(), [], mesh_arrays.get_polygons())
+    for material in original_mesh.materials:
+        mesh.materials.append(material)
+
+    # Restore the attributes of the polygons, from_pydata keeps their order and their loops order
+    for name in ['use_smooth', 'material_index']:
+        if name in mesh_arrays.polygon_attributes:
+            mesh.polygons.foreach_set(name, mesh_arrays.polygon_attributes[name].ravel())
+
+    # The attributes of the loops are the UV layers, as read by read_mesh_arrays
+    for name, uvs in mesh_arrays.loop_attributes.items():
+        uv_layer = mesh.uv_layers.new(name=name)
+        uv_layer.data.foreach_set('uv', uvs.astype(numpy.float32).ravel())
+    mesh.update()
+
+    # Replace the original mesh
+    mesh_object.data = mesh
+    if original_mesh.users == 0:
+        bpy.data.meshes.remove(original_mesh)
+
+
 ####################################################################################################
 # @clean_mesh_object
 ####################################################################################################
 def clean_mesh_object(mesh_object,
                       threshold=0.0001,
-                      sides=0):
+                      sides=0,
+                      use_operators=True):
     """Cleans a mesh object and make it two-manifold.
 
+    By default, the mesh is cleaned with the edit mode operators of the MeshCleaner. The callers
+    can clean it on its flat arrays with the ArrayMeshCleaner instead, without any operators or
+    edit mode, and write it back once. The array path splits the non-manifold vertices into a
+    vertex per fan of faces instead of filling them with the operators.
+
     :param mesh_object:
         A given mesh object to clean.
     :param threshold:
         Distance threshold between the vertices to be merged together.
     :param sides:
         Number of sides of holes to be filled.
+    :param use_operators:
+        Clean the mesh with the edit mode operators of the MeshCleaner, otherwise on its arrays.
     :return
         A tuple with number of vertices/edges/faces removed from the cleaning operation.
     """
 
+    # Clean the arrays of the mesh, and write them back
+    if not use_operators:
+        mesh_cleaner = nmv.mesh.ops.ArrayMeshCleaner(threshold=threshold, sides=sides)
+        write_mesh_arrays(mesh_object, mesh_cleaner.execute(read_mesh_arrays(mesh_object)))
+        return (mesh_cleaner.vertex_count_difference,
+                mesh_cleaner.edge_count_difference,
+                mesh_cleaner.face_count_difference)
+
     # Select the mesh object
     nmv.scene.select_object(scene_object=mesh_object)
 
@@ -0,0 +1,317 @@
+####################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+# System imports
+import numpy
+
+# Blender imports
+import bpy
+from mathutils.bvhtree import BVHTree
+
+# Internal imports
+import nmv.scene
+import nmv.utilities
+
+
+####################################################################################################
+# @DecimationStatistics
+####################################################################################################
+class DecimationStatistics:
+    """Statistics of a single-pass decimation.
+    """
+
+    ################################################################################################
+    # @__init__
+    ################################################################################################
+    def __init__(self):
+        """Constructor
+        """
+
+        # Number of faces before the decimation
+        self.initial_faces = 0
+
+        # Number of faces after the decimation
+        self.final_faces = 0
+
+        # The decimation ratio that was applied
+        self.ratio = 1.0
+
+        # Mean distance between the original surface samples and the decimated surface
+        self.mean_error = 0.0
+
+        # Maximum distance between the original surface samples and the decimated surface
+        self.max_error = 0.0
+
+        # Number of modifier evaluations that were needed to find the ratio
+        self.evaluations = 0
+
+    ################################################################################################
+    # @get_report
+    ################################################################################################
+    def get_report(self):
+        """Returns a formatted report of the statistics.
+
+        :return:
+            A report string.
+        """
+
+        return 'Decimation: Faces [%d -> %d], Ratio [%.4f], Mean Error [%.4f], ' \
+               'Max. Error [%.4f], Evaluations [%d]' % \
+               (self.initial_faces, self.final_faces, self.ratio, self.mean_error,
+                self.max_error, self.evaluations)
+
+
+####################################################################################################
+# @sample_mesh_vertices
+####################################################################################################
+def sample_mesh_vertices(mesh_object,
+                         number_samples=4096):
+    """Returns a regularly strided subset of the vertices of a mesh that is used to measure the
+    geometric error of the decimation.
+
+    :param mesh_object:
+        A given mesh object.
+    :param number_samples:
+        The maximum number of samples.
+    :return:
+        A numpy array of shape (N, 3).
+    """
+
+    number_vertices = len(mesh_object.data.vertices)
+    locations = numpy.zeros(number_vertices * 3, dtype=numpy.float32)
+    mesh_object.data.vertices.foreach_get('co', locations)
+    locations = locations.reshape((-1, 3))
+
+    # Regular stride to keep the samples deterministic
+    stride = max(1, number_vertices // max(1, number_samples))
+    return locations[::stride]
+
+
+####################################################################################################
+# @get_evaluated_mesh_bvh
+####################################################################################################
+def get_evaluated_mesh_bvh(mesh_object):
+    """Builds a BVH of a mesh object with its modifiers evaluated but not applied.
+
+    :param mesh_object:
+        A given mesh object.
+    :return:
+        A tuple (BVH, number of faces) of the evaluated mesh.
+    """
+
+    if nmv.utilities.is_blender_280():
+        depsgraph = bpy.context.evaluated_depsgraph_get()
+        depsgraph.update()
+        evaluated_object = mesh_object.evaluated_get(depsgraph)
+        evaluated_mesh = evaluated_object.to_mesh()
+        number_faces = len(evaluated_mesh.polygons)
+        evaluated_object.to_mesh_clear()
+        return BVHTree.FromObject(mesh_object, depsgraph), number_faces
+    else:
+        evaluated_mesh = mesh_object.to_mesh(bpy.context.scene, True, 'PREVIEW')
+        number_faces = len(evaluated_mesh.polygons)
+        bpy.data.meshes.remove(evaluated_mesh)
+        return BVHTree.FromObject(mesh_object, bpy.context.scene), number_faces
+
+
+####################################################################################################
+# @measure_surface_error
+####################################################################################################
+def measure_surface_error(bvh,
+                          samples):
+    """Measures the distance between a set of points and the surface represented by a BVH.
+
+    :param bvh:
+        The BVH of the surface.
+    :param samples:
+        A numpy array of points.
+    :return:
+        A tuple (mean, max) of the distances.
+    """
+
+    if len(samples) == 0:
+        return 0.0, 0.0
+
+    distances = numpy.zeros((len(samples),), dtype=numpy.float64)
+    for i, sample in enumerate(samples):
+        location, normal, index, distance = bvh.find_nearest(sample)
+        if location is not None:
+            distances[i] = distance
+
+    return float(distances.mean()), float(distances.max())
+
+
+####################################################################################################
+# @create_protection_vertex_group
+####################################################################################################
+def create_protection_vertex_group(mesh_object,
+                                   protected_extents,
+                                   name='nmv_decimation_protection'):
+    """Creates a vertex group of the vertices that are located inside the given extents, so that
+    the decimation does not touch them.
+
+    NOTE: The collapse cost of the decimate modifier is scaled by (2 - (w1 + w2)) for an edge
+    between the vertices with the weights w1 and w2, so the vertices with a full weight are the
+    cheapest to collapse. The group must be used with invert_vertex_group set, which gives the
+    protected vertices a zero weight and the others a full weight.
+
+    :param mesh_object:
+        A given mesh object.
+    :param protected_extents:
+        A list of extents [center, radius], for example the soma to arbor connections.
+    :param name:
+        The name of the vertex group.
+    :return:
+        A reference to the vertex group, or None if no vertex is protected.
+    """
+
+    # Get the vertices at once
+    number_vertices = len(mesh_object.data.vertices)
+    locations = numpy.zeros(number_vertices * 3, dtype=numpy.float32)
+    mesh_object.data.vertices.foreach_get('co', locations)
+    locations = locations.reshape((-1, 3))
+
+    # Vertices inside any of the extents
+    protected = numpy.zeros((number_vertices,), dtype=bool)
+    for extent_center, extent_radius in protected_extents:
+        center = numpy.array(extent_center, dtype=numpy.float32)
+        protected |= numpy.linalg.norm(locations - center, axis=1) < extent_radius
+
+    if not protected.any():
+        return None
+
+    # Create the group with a full weight for the protected vertices
+    vertex_group = mesh_object.vertex_groups.new(name=name)
+    vertex_group.add(numpy.flatnonzero(protected).tolist(), 1.0, 'REPLACE')
+    return vertex_group
+
+
+####################################################################################################
+# @decimate_mesh_object_to_target
+####################################################################################################
+def decimate_mesh_object_to_target(mesh_object,
+                                   target_faces=None,
+                                   max_error=None,
+                                   protected_extents=None,
+                                   minimum_ratio=0.005,
+                                   search_iterations=6,
+                                   error_samples=4096):
+    """Decimates a mesh object in a single modifier application, either to a target number of faces
+    or to the coarsest resolution whose geometric error does not exceed a given maximum.
+
+    The candidate ratios are evaluated on the modifier stack without being applied, and only the
+    selected one is applied to the mesh. If both the target number of faces and the maximum error
+    are given, the target is used unless its error exceeds the maximum, in which case the ratio is
+    increased until the error is within the bound.
+
+    :param mesh_object:
+        A given mesh object.
+    :param target_faces:
+        The target number of faces.
+    :param max_error:
+        The maximum allowed distance between the original and the decimated surfaces.
+    :param protected_extents:
+        A list of extents [center, radius] that must be preserved, for example the regions where
+        the arbors are connected to the soma.
+    :param minimum_ratio:
+        The smallest decimation ratio that is considered.
+    :param search_iterations:
+        Number of bisection steps used to find the ratio that satisfies the maximum error.
+    :param error_samples:
+        Number of surface samples that are used to measure the error.
+    :return:
+        A DecimationStatistics object with the achieved error.
+    """
+
+    statistics = DecimationStatistics()
+    statistics.initial_faces = len(mesh_object.data.polygons)
+    statistics.final_faces = statistics.initial_faces
+
+    # Nothing to decimate
+    if statistics.initial_faces == 0 or (target_faces is None and max_error is None):
+        return statistics
+
+    # Samples of the original surface
+    samples = sample_mesh_vertices(mesh_object, error_samples)
+
+    # Select the object and set it to be the active one
+    nmv.scene.ops.set_active_object(mesh_object)
+
+    # Add a single decimation modifier that is only applied at the end
+    modifier = mesh_object.modifiers.new(name='NMVDecimate', type='DECIMATE')
+
+    # Protect the given regions by scaling up the collapse cost of their vertices, the group is
+    # inverted since the modifier penalizes the collapse of the low weight vertices
+    vertex_group = None
+    if protected_extents:
+        vertex_group = create_protection_vertex_group(mesh_object, protected_extents)
+        if vertex_group is not None:
+            modifier.vertex_group = vertex_group.name
+            modifier.invert_vertex_group = True
+            modifier.vertex_group_factor = 1000.0
+
+    def evaluate(candidate_ratio):
+        modifier.ratio = candidate_ratio
+        bvh, faces = get_evaluated_mesh_bvh(mesh_object)
+        mean_error, max_error_value = measure_surface_error(bvh, samples)
+        statistics.evaluations += 1
+        return mean_error, max_error_value, faces
+
+    # Initial ratio from the target number of faces
+    if target_faces is not None:
+        ratio = min(1.0, max(minimum_ratio, float(target_faces) / statistics.initial_faces))
+    else:
+        ratio = minimum_ratio
+
+    # Search for the coarsest ratio that satisfies the error bound
+    if max_error is not None:
+        mean_error, error, _ = evaluate(ratio)
+        if error > max_error:
+            lower, upper = ratio, 1.0
+            for _ in range(search_iterations):
+                middle = 0.5 * (lower + upper)
+                mean_error, error, _ = evaluate(middle)
+                if error > max_error:
+                    lower = middle
+                else:
+                    upper = middle
+            ratio = upper
+
+    # Apply the selected ratio once
+    modifier.ratio = ratio
+    if ratio < 1.0:
+        if nmv.utilities.is_blender_290():
+            bpy.ops.object.modifier_apply(modifier=modifier.name)
+        else:
+            bpy.ops.object.modifier_apply(apply_as='DATA', modifier=modifier.name)
+    else:
+        mesh_object.modifiers.remove(modifier)
+
+    # Remove the temporary vertex group
+    if vertex_group is not None:
+        mesh_object.vertex_groups.remove(vertex_group)
+
+    # Measure the achieved error on the final mesh
+    statistics.ratio = ratio
+    statistics.final_faces = len(mesh_object.data.polygons)
+    statistics.mean_error, statistics.max_error = measure_surface_error(
+        BVHTree.FromPolygons(
+            [v.co for v in mesh_object.data.vertices],
+            [p.vertices for p in mesh_object.data.polygons]), samples)
+
+    # Return the statistics
+    return statistics
@@ -15,6 +15,9 @@
 # If not, see <http://www.gnu.org/licenses/>.
 ####################################################################################################
 
+# System imports
+import numpy
+
 # Blender imports
 import bpy
 from mathutils import Vector, Matrix
@@ -206,6 +209,68 @@ def get_largest_radius_in_face(mesh_object,
     return largest_radius
 
 
+####################################################################################################
+# @get_largest_radii_of_faces
+####################################################################################################
+def get_largest_radii_of_faces(mesh_object):
+    """Returns the centers, the normals and the largest radii of all the faces in the mesh.
+    This is the bulk version of get_largest_radius_in_face, where all the data are pulled from the
+    mesh with foreach_get and the radii are computed in a single array operation.
+
+    :param mesh_object:
+        A given mesh object.
+    :return:
+        A tuple of numpy arrays (centers, normals, radii) of shapes (F, 3), (F, 3) and (F,).
+    """
+
+    # Mesh data
+    mesh = mesh_object.data
+    number_faces = len(mesh.polygons)
+    number_loops = len(mesh.loops)
+
+    # Face centers and normals
+    centers = numpy.zeros(number_faces * 3, dtype=numpy.float32)
+    normals = numpy.zeros(number_faces * 3, dtype=numpy.float32)
+    mesh.polygons.foreach_get('center', centers)
+    mesh.polygons.foreach_get('normal', normals)
+    centers = centers.reshape((-1, 3)).astype(numpy.float64)
+    normals = normals.reshape((-1, 3)).astype(numpy.float64)
+
+    # Nothing else to do for empty meshes
+    if number_faces == 0:
+        return centers, normals, numpy.zeros((0,), dtype=numpy.float64)
+
+    # Vertex locations
+    locations = numpy.zeros(len(mesh.vertices) * 3, dtype=numpy.float32)
+    mesh.vertices.foreach_get('co', locations)
+    locations = locations.reshape((-1, 3)).astype(numpy.float64)
+
+    # The vertices of the faces, as loops
+    loop_vertices = numpy.zeros(number_loops, dtype=numpy.int32)
+    loop_starts = numpy.zeros(number_faces, dtype=numpy.int32)
+    loop_totals = numpy.zeros(number_faces, dtype=numpy.int32)
+    mesh.loops.foreach_get('vertex_index', loop_vertices)
+    mesh.polygons.foreach_get('loop_start', loop_starts)
+    mesh.polygons.foreach_get('loop_total', loop_totals)
+
+    # The loop indices of the corners of every face, grouped by face
+    loop_faces = numpy.repeat(numpy.arange(number_faces), loop_totals)
+    corner_offsets = numpy.arange(number_loops) - numpy.repeat(
+        numpy.cumsum(loop_totals) - loop_totals, loop_totals)
+    corner_loops = numpy.repeat(loop_starts, loop_totals) + corner_offsets
+
+    # The distance between every face corner and the center of its face
+    distances = numpy.linalg.norm(
+        locations[loop_vertices[corner_loops]] - centers[loop_faces], axis=1)
+
+    # The largest distance per face
+    radii = numpy.zeros(number_faces, dtype=numpy.float64)
+    numpy.maximum.at(radii, loop_faces, distances)
+
+    # Return the data
+    return centers, normals, radii
+
+
 ####################################################################################################
 # @extrude_face_to_face
 ####################################################################################################
@@ -371,6 +436,60 @@ def get_index_of_nearest_face_to_point(mesh_object,
     return nearest_face_index
 
 
+####################################################################################################
+# @get_nearest_faces_to_points
+####################################################################################################
+def get_nearest_faces_to_points(mesh_object,
+                                points):
+    """Gets the nearest face of an object to every point in a given list with a single query.
+    This is the bulk version of get_index_of_nearest_face_to_point.
+
+    :param mesh_object:
+        A given mesh object.
+    :param points:
+        A list of points in the three-dimensional space.
+    :return:
+        A tuple (faces_indices, faces_centers, faces_vertices_indices), where the first is an array
+        with the index of the nearest face to every point, the second is an array of shape (N, 3)
+        with the centers of these faces and the third is a list of lists of their vertex indices.
+    """
+
+    # Mesh data
+    mesh = mesh_object.data
+    number_faces = len(mesh.polygons)
+
+    # Nothing to query
+    if len(points) == 0 or number_faces == 0:
+        return numpy.zeros(0, dtype=numpy.int64), numpy.zeros((0, 3)), list()
+
+    # Face centers
+    centers = numpy.zeros(number_faces * 3, dtype=numpy.float32)
+    mesh.polygons.foreach_get('center', centers)
+    centers = centers.reshape((-1, 3)).astype(numpy.float64)
+
+    # The distances between all the points and all the face centers, (points, faces)
+    points = numpy.array([point[:] for point in points], dtype=numpy.float64)
+    distances = numpy.einsum('pfj,pfj->pf', centers[None, :, :] - points[:, None, :],
+                             centers[None, :, :] - points[:, None, :])
+
+    # The nearest face to every point
+    faces_indices = numpy.argmin(distances, axis=1)
+
+    # The vertices of the nearest faces
+    loop_vertices = numpy.zeros(len(mesh.loops), dtype=numpy.int32)
+    loop_starts = numpy.zeros(number_faces, dtype=numpy.int32)
+    loop_totals = numpy.zeros(number_faces, dtype=numpy.int32)
+    mesh.loops.foreach_get('vertex_index', loop_vertices)
+    mesh.polygons.foreach_get('loop_start', loop_starts)
+    mesh.polygons.foreach_get('loop_total', loop_totals)
+    faces_vertices_indices = [
+        loop_vertices[loop_starts[i]:loop_starts[i] + loop_totals[i]].tolist()
+        for i in faces_indices]
+
+    # Return the data
+    return faces_indices, centers[faces_indices], faces_vertices_indices
+
+
 ####################################################################################################
 # @get_index_of_nearest_face_to_point
 ####################################################################################################
@@ -0,0 +1,196 @@
+####################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+# System imports
+import numpy
+
+# Internal imports
+import nmv.consts
+
+
+####################################################################################################
+# @hash_lattice_points
+####################################################################################################
+def hash_lattice_points(x, y, z,
+                        seed=0):
+    """Hashes integer lattice coordinates into pseudo-random values in the range [-1, 1].
+    The hash is a pure function of the coordinates and the seed, so the noise is reproducible
+    across runs and machines.
+
+    :param x:
+        A numpy array of integer X coordinates.
+    :param y:
+        A numpy array of integer Y coordinates.
+    :param z:
+        A numpy array of integer Z coordinates.
+    :param seed:
+        The seed of the noise.
+    :return:
+        A numpy array of values in the range [-1, 1].
+    """
+
+    # Mix the coordinates with large primes in 64-bit unsigned arithmetic
+    with numpy.errstate(over='ignore'):
+        h = x.astype(numpy.uint64) * numpy.uint64(73856093)
+        h ^= y.astype(numpy.uint64) * numpy.uint64(19349663)
+        h ^= z.astype(numpy.uint64) * numpy.uint64(83492791)
+        h ^= numpy.uint64(seed & 0xFFFFFFFF) * numpy.uint64(2654435761)
+
+        # Avalanche the bits
+        h ^= h >> numpy.uint64(33)
+        h *= numpy.uint64(0xff51afd7ed558ccd)
+        h ^= h >> numpy.uint64(33)
+        h *= numpy.uint64(0xc4ceb9fe1a85ec53)
+        h ^= h >> numpy.uint64(33)
+
+    # Map the 24 lower bits to [-1, 1]
+    return (h & numpy.uint64(0xFFFFFF)).astype(numpy.float64) / float(0xFFFFFF) * 2.0 - 1.0
+
+
+####################################################################################################
+# @evaluate_coherent_noise
+####################################################################################################
+def evaluate_coherent_noise(points,
+                            noise_scale=1.0,
+                            octaves=1,
+                            seed=0):
+    """Evaluates a seeded coherent (value) noise function on a batch of points at once.
+
+    :param points:
+        A numpy array of shape (N, 3) of points.
+    :param noise_scale:
+        The size of the noise features in the units of the points.
+    :param octaves:
+        Number of octaves of the fractal sum, each octave has half the size and the amplitude of
+        the previous one.
+    :param seed:
+        The seed of the noise.
+    :return:
+        A numpy array of shape (N,) of noise values in the range [-1, 1].
+    """
+
+    points = numpy.asarray(points, dtype=numpy.float64).reshape((-1, 3))
+    noise = numpy.zeros((len(points),), dtype=numpy.float64)
+    total_amplitude = 0.0
+
+    frequency = 1.0 / max(noise_scale, 1e-6)
+    amplitude = 1.0
+    for octave in range(max(1, octaves)):
+
+        # The lattice cell of every point and the location inside the cell
+        p = points * frequency
+        cell = numpy.floor(p)
+        t = p - cell
+        cell = cell.astype(numpy.int64)
+
+        # Smooth-step weights
+        t = t * t * (3.0 - 2.0 * t)
+
+        # Interpolate the hashed values of the eight corners of the cell
+        octave_noise = numpy.zeros((len(points),), dtype=numpy.float64)
+        for dx in (0, 1):
+            wx = t[:, 0] if dx else 1.0 - t[:, 0]
+            for dy in (0, 1):
+                wy = t[:, 1] if dy else 1.0 - t[:, 1]
+                for dz in (0, 1):
+                    wz = t[:, 2] if dz else 1.0 - t[:, 2]
+                    octave_noise += wx * wy * wz * hash_lattice_points(
+                        cell[:, 0] + dx, cell[:, 1] + dy, cell[:, 2] + dz, seed + octave)
+
+        noise += amplitude * octave_noise
+        total_amplitude += amplitude
+        frequency *= 2.0
+        amplitude *= 0.5
+
+    # Normalize to [-1, 1]
+    return noise / total_amplitude
+
+
+####################################################################################################
+# @get_vertices_outside_extents
+####################################################################################################
+def get_vertices_outside_extents(locations,
+                                 extents):
+    """Returns a mask of the vertices that are not located inside any of the given extents.
+
+    :param locations:
+        A numpy array of shape (N, 3) of vertex locations.
+    :param extents:
+        A list of extents [center, radius].
+    :return:
+        A boolean numpy array of shape (N,).
+    """
+
+    mask = numpy.ones((len(locations),), dtype=bool)
+    for extent_center, extent_radius in extents:
+        center = numpy.array(extent_center, dtype=numpy.float64)
+        distances = numpy.linalg.norm(locations - center, axis=1)
+        mask &= distances >= extent_radius
+    return mask
+
+
+####################################################################################################
+# @add_coherent_noise_to_mesh
+####################################################################################################
+def add_coherent_noise_to_mesh(mesh_object,
+                               amplitude=0.5,
+                               noise_scale=1.0,
+                               octaves=2,
+                               seed=nmv.consts.Meshing.SURFACE_NOISE_SEED,
+                               excluded_extents=None):
+    """Displaces all the vertices of a mesh along their normals with a seeded coherent noise.
+    The vertices and normals are read with foreach_get and written back with foreach_set in a
+    single call.
+
+    :param mesh_object:
+        A given mesh object.
+    :param amplitude:
+        The maximum displacement of the vertices.
+    :param noise_scale:
+        The size of the noise features in the units of the mesh.
+    :param octaves:
+        Number of octaves of the noise.
+    :param seed:
+        The seed of the noise, the same seed gives the same surface for the same mesh.
+    :param excluded_extents:
+        An optional list of extents [center, radius], where the vertices are not displaced.
+    """
+
+    mesh = mesh_object.data
+    number_vertices = len(mesh.vertices)
+    if number_vertices == 0:
+        return
+
+    # Get the vertices and their normals at once
+    locations = numpy.zeros(number_vertices * 3, dtype=numpy.float32)
+    normals = numpy.zeros(number_vertices * 3, dtype=numpy.float32)
+    mesh.vertices.foreach_get('co', locations)
+    mesh.vertices.foreach_get('normal', normals)
+    locations = locations.reshape((-1, 3)).astype(numpy.float64)
+    normals = normals.reshape((-1, 3)).astype(numpy.float64)
+
+    # Evaluate the noise on all the vertices
+    displacement = amplitude * evaluate_coherent_noise(locations, noise_scale, octaves, seed)
+
+    # Keep the excluded regions unchanged
+    if excluded_extents:
+        displacement *= get_vertices_outside_extents(locations, excluded_extents)
+
+    # Displace and write back
+    locations += normals * displacement[:, numpy.newaxis]
+    mesh.vertices.foreach_set('co', locations.astype(numpy.float32).ravel())
+    mesh.update()
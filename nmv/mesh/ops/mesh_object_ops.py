@@ -19,6 +19,7 @@
 import bpy, bmesh
 
 # Internal imports
+import nmv.consts
 import nmv.scene
 import nmv.mesh
 import nmv.utilities
@@ -507,6 +508,29 @@ def union_mesh_objects(mesh_object_1,
     return mesh_object_1
 
 
+####################################################################################################
+# @clean_union_result
+####################################################################################################
+def clean_union_result(mesh_object):
+    """Removes the doubles of a mesh that results from a union operator and makes its normals
+    consistent.
+
+    NOTE: The mesh object is assumed to be the active object, as after @union_mesh_objects.
+
+    :param mesh_object:
+        The mesh object resulting from the union operator.
+    """
+
+    # Switch to edit mode to REMOVE THE DOUBLES
+    # TODO: Use the remove doubles function
+    nmv.scene.ops.set_active_object(mesh_object)
+    bpy.ops.object.editmode_toggle()
+    bpy.ops.mesh.select_all(action='SELECT')
+    bpy.ops.mesh.remove_doubles()
+    bpy.ops.mesh.normals_make_consistent(inside=False)
+    bpy.ops.object.editmode_toggle()
+
+
 ####################################################################################################
 # @union_mesh_objects_in_list
 ####################################################################################################
@@ -534,13 +558,8 @@ def union_mesh_objects_in_list(mesh_objects_list):
         # Union the ith mesh object
         mesh_object_1 = union_mesh_objects(mesh_object_1, mesh_objects_list[i])
 
-        # Switch to edit mode to REMOVE THE DOUBLES
-        # TODO: Use the remove doubles function
-        bpy.ops.object.editmode_toggle()
-        bpy.ops.mesh.select_all(action='SELECT')
-        bpy.ops.mesh.remove_doubles()
-        bpy.ops.mesh.normals_make_consistent(inside=False)
-        bpy.ops.object.editmode_toggle()
+        # Remove the doubles of the union
+        clean_union_result(mesh_object_1)
 
         # Delete the other mesh
         nmv.scene.ops.delete_list_objects([mesh_objects_list[i]])
@@ -555,6 +574,64 @@ def union_mesh_objects_in_list(mesh_objects_list):
     return mesh_object_1
 
 
+####################################################################################################
+# @union_mesh_objects_in_tree
+####################################################################################################
+def union_mesh_objects_in_tree(mesh_objects_list):
+    """Union a list of mesh objects into a single mesh, reducing them in a balanced binary tree.
+
+    Unlike @union_mesh_objects_in_list, where the accumulated mesh grows with every union and the
+    total cost is quadratic in the number of the meshes, every level of the tree unions pairs of
+    meshes of a similar size, and every mesh is involved in a logarithmic number of unions only.
+    The neighbouring meshes in the list are paired, so the list is better ordered spatially, e.g.
+    the poly-lines of an arbor in their depth-first order.
+
+    :param mesh_objects_list:
+        A list of mesh objects to be merged into a single mesh relying on the union operator.
+    :return:
+        The final mesh resulting from the union operator.
+    """
+
+    # Nothing to union
+    if len(mesh_objects_list) == 1:
+        return mesh_objects_list[0]
+
+    # The number of the unions, for the progress
+    number_unions = len(mesh_objects_list) - 1
+    union_index = 0
+
+    # Reduce the level until a single mesh remains
+    level = list(mesh_objects_list)
+    while len(level) > 1:
+
+        # The next level, an odd mesh is carried as is
+        next_level = list()
+        for i in range(0, len(level) - 1, 2):
+
+            # Show progress
+            union_index += 1
+            nmv.utilities.time_line.show_iteration_progress('Union', union_index, number_unions)
+
+            # Union the pair, and remove the doubles of the union
+            mesh_object = union_mesh_objects(level[i], level[i + 1])
+            clean_union_result(mesh_object)
+
+            # Delete the other mesh
+            nmv.scene.ops.delete_list_objects([level[i + 1]])
+            next_level.append(mesh_object)
+
+        if len(level) % 2 == 1:
+            next_level.append(level[-1])
+        level = next_level
+
+    # Report the progress
+    nmv.utilities.time_line.show_iteration_progress(
+        'Union', number_unions, number_unions, done=True)
+
+    # Return a reference to the final mesh
+    return level[0]
+
+
 ################################################################################
 # @intersect_mesh_objects
 ################################################################################
@@ -730,15 +807,29 @@ def add_surface_noise_to_mesh_using_displacement_modifier(mesh_object,
 ####################################################################################################
 def add_surface_noise_to_mesh(mesh_object,
                               noise_strength=1.0,
-                              subdivision_level=1):
+                              subdivision_level=1,
+                              seed=nmv.consts.Meshing.SURFACE_NOISE_SEED):
+    """Adds a realistic roughness to the surface of a given mesh.
+
+    :param mesh_object:
+        A given mesh object.
+    :param noise_strength:
+        The strength of the noise, equivalent to the strength of a displacement modifier.
+    :param subdivision_level:
+        The subdivision level of the surface before adding the noise.
+    :param seed:
+        The seed of the noise.
+    """
 
     # Subdivide the surface
     if subdivision_level > 0:
         subdivide_mesh(mesh_object=mesh_object, level=subdivision_level)
 
-    # Adding the noise
-    add_surface_noise_to_mesh_using_displacement_modifier(mesh_object=mesh_object,
-                                                          strength=noise_strength)
+    # Adding the noise, with the same range and feature size of the clouds displacement modifier
+    nmv.mesh.add_coherent_noise_to_mesh(mesh_object=mesh_object,
+                                        amplitude=noise_strength * 0.5,
+                                        noise_scale=1.5,
+                                        seed=seed)
 
     # Decimate
     decimate_mesh_object(mesh_object=mesh_object, decimation_ratio=0.2)
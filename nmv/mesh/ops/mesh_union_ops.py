@@ -0,0 +1,258 @@
+####################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+# System imports
+import os
+import shutil
+import subprocess
+import tempfile
+import time
+
+# Blender imports
+import bpy
+
+# Internal imports
+import nmv.consts
+import nmv.mesh
+import nmv.scene
+import nmv.utilities
+
+
+####################################################################################################
+# @get_mesh_union_script
+####################################################################################################
+def get_mesh_union_script():
+    """Gets the path to the CLI script that is executed by the union workers.
+
+    :return:
+        The path to the script.
+    """
+
+    return os.path.realpath('%s/../../interface/cli/mesh_union.py' %
+                            os.path.dirname(os.path.realpath(__file__)))
+
+
+####################################################################################################
+# @get_mesh_union_worker_command
+####################################################################################################
+def get_mesh_union_worker_command(blender_executable,
+                                  input_file,
+                                  output_file):
+    """Gets the shell command of a union worker.
+
+    :param blender_executable:
+        The path to the Blender executable.
+    :param input_file:
+        The .blend file of the meshes that will be unioned by the worker.
+    :param output_file:
+        The .blend file where the worker writes the union.
+    :return:
+        The command as a list of arguments.
+    """
+
+    return [blender_executable, '-b', '--verbose', '0', '--python', get_mesh_union_script(),
+            '--', '--input', input_file, '--output', output_file]
+
+
+####################################################################################################
+# @split_mesh_objects_into_chunks
+####################################################################################################
+def split_mesh_objects_into_chunks(mesh_objects_list,
+                                   number_chunks):
+    """Splits a list of mesh objects into contiguous chunks with similar numbers of vertices.
+
+    The chunks are contiguous to keep the neighbouring meshes in the same chunk, where they are
+    likely to overlap, e.g. the poly-lines of the same branches of an arbor.
+
+    :param mesh_objects_list:
+        A list of mesh objects.
+    :param number_chunks:
+        The number of the chunks.
+    :return:
+        A list of the chunks, each is a list of mesh objects.
+    """
+
+    # The share of the vertices of the first chunk
+    remaining_vertices = sum([len(mesh_object.data.vertices) for mesh_object in mesh_objects_list])
+    chunk_share = remaining_vertices / float(number_chunks)
+
+    chunks = [list()]
+    chunk_vertices = 0
+    for mesh_object in mesh_objects_list:
+
+        # Start a new chunk once the current one has its share, and share the remaining vertices
+        # among the remaining chunks
+        if chunk_vertices >= chunk_share and len(chunks) < number_chunks:
+            remaining_vertices -= chunk_vertices
+            chunk_share = remaining_vertices / float(number_chunks - len(chunks))
+            chunks.append(list())
+            chunk_vertices = 0
+
+        chunks[-1].append(mesh_object)
+        chunk_vertices += len(mesh_object.data.vertices)
+
+    # Return the chunks
+    return chunks
+
+
+####################################################################################################
+# @write_mesh_objects_to_blend_file
+####################################################################################################
+def write_mesh_objects_to_blend_file(mesh_objects_list,
+                                     file_path):
+    """Writes a list of mesh objects, with their data, to a .blend file.
+
+    :param mesh_objects_list:
+        A list of mesh objects.
+    :param file_path:
+        The path to the .blend file.
+    """
+
+    bpy.data.libraries.write(file_path, set(mesh_objects_list))
+
+
+####################################################################################################
+# @read_mesh_objects_from_blend_file
+####################################################################################################
+def read_mesh_objects_from_blend_file(file_path):
+    """Appends the mesh objects of a .blend file to the scene.
+
+    :param file_path:
+        The path to the .blend file.
+    :return:
+        A list of the appended mesh objects in the order of the file.
+    """
+
+    # Append the objects, they are listed in the order of their names
+    with bpy.data.libraries.load(file_path, link=False) as (data_src, data_dst):
+        data_dst.objects = sorted(data_src.objects)
+
+    # Link them to the scene
+    mesh_objects = list()
+    for mesh_object in data_dst.objects:
+        if mesh_object is not None:
+            nmv.scene.link_object_to_scene(mesh_object)
+            mesh_objects.append(mesh_object)
+    return mesh_objects
+
+
+####################################################################################################
+# @union_mesh_objects_in_blend_file
+####################################################################################################
+def union_mesh_objects_in_blend_file(input_file,
+                                     output_file):
+    """Unions the mesh objects of a .blend file in a balanced tree, and writes the resulting mesh
+    to another .blend file. This is the task of a union worker.
+
+    :param input_file:
+        The .blend file of the meshes.
+    :param output_file:
+        The .blend file where the union is written.
+    """
+
+    # Start from an empty scene
+    nmv.scene.clear_scene()
+
+    # Load the meshes and union them
+    mesh_objects = read_mesh_objects_from_blend_file(input_file)
+    mesh_object = nmv.mesh.ops.union_mesh_objects_in_tree(mesh_objects)
+
+    # The materials are assigned after the union in the main process
+    mesh_object.data.materials.clear()
+
+    # Write the union
+    write_mesh_objects_to_blend_file([mesh_object], output_file)
+
+
+####################################################################################################
+# @union_mesh_objects_in_parallel
+####################################################################################################
+def union_mesh_objects_in_parallel(mesh_objects_list,
+                                   number_workers=nmv.consts.Meshing.UNION_WORKERS,
+                                   blender_executable=None):
+    """Union a list of mesh objects into a single mesh, distributing the union over worker
+    processes.
+
+    The list is split into a contiguous chunk per worker. Each worker is a background Blender that
+    unions its chunk in a balanced tree, in parallel with the other workers, and only the final
+    merges of the unions of the chunks are done in this scene, in a balanced tree as well. A small
+    list, or a single worker, is unioned in a balanced tree in this process. The chunk of a failed
+    worker is unioned in this process.
+
+    NOTE: The materials of the meshes are not preserved, they must be assigned to the final mesh.
+
+    :param mesh_objects_list:
+        A list of mesh objects to be merged into a single mesh relying on the union operator.
+    :param number_workers:
+        The number of the worker processes.
+    :param blender_executable:
+        The path to the Blender executable of the workers, by default the running Blender.
+    :return:
+        The final mesh resulting from the union operator.
+    """
+
+    # Not worth launching the workers
+    if number_workers < 2 or \
+            len(mesh_objects_list) < nmv.consts.Meshing.PARALLEL_UNION_MINIMUM_MESHES:
+        return nmv.mesh.ops.union_mesh_objects_in_tree(mesh_objects_list)
+
+    # The workers are launched with the same Blender
+    if blender_executable is None:
+        blender_executable = bpy.app.binary_path
+
+    start_time = time.time()
+
+    # Write the chunk of every worker to a separate file, and remove it from the scene
+    chunks = split_mesh_objects_into_chunks(mesh_objects_list, number_workers)
+    union_directory = tempfile.mkdtemp(prefix='nmv_union_')
+    input_files = list()
+    output_files = list()
+    mesh_index = 0
+    for i, chunk in enumerate(chunks):
+
+        # Name the meshes after their indices to keep their order in the worker
+        for mesh_object in chunk:
+            mesh_object.name = 'union_%06d' % mesh_index
+            mesh_index += 1
+
+        input_files.append('%s/chunk_%d.blend' % (union_directory, i))
+        output_files.append('%s/union_%d.blend' % (union_directory, i))
+        write_mesh_objects_to_blend_file(chunk, input_files[-1])
+        nmv.scene.ops.delete_list_objects(chunk)
+
+    # Launch the workers and wait for them
+    workers = [subprocess.Popen(get_mesh_union_worker_command(
+        blender_executable, input_files[i], output_files[i])) for i in range(len(chunks))]
+    for worker in workers:
+        worker.wait()
+
+    # Collect the unions of the chunks, and union the chunks of the failed workers here
+    chunks_unions = list()
+    for i, worker in enumerate(workers):
+        if worker.returncode == 0 and os.path.isfile(output_files[i]):
+            chunks_unions.extend(read_mesh_objects_from_blend_file(output_files[i]))
+        else:
+            nmv.logger.warning('Union worker [%d] failed, unioning its chunk in process' % i)
+            chunks_unions.append(nmv.mesh.ops.union_mesh_objects_in_tree(
+                read_mesh_objects_from_blend_file(input_files[i])))
+    shutil.rmtree(union_directory, ignore_errors=True)
+
+    nmv.logger.statistics('[%d] meshes unioned by [%d] workers in [%f] seconds' %
+                          (len(mesh_objects_list), len(chunks), time.time() - start_time))
+
+    # The final merges in this scene
+    return nmv.mesh.ops.union_mesh_objects_in_tree(chunks_unions)
@@ -0,0 +1,582 @@
+####################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+# System imports
+import concurrent.futures
+import itertools
+import os
+import time
+import numpy
+
+# Blender imports
+import bpy
+import bmesh
+from mathutils import Vector
+from mathutils.bvhtree import BVHTree
+
+# Internal imports
+import nmv.consts
+import nmv.scene
+
+
+####################################################################################################
+# @create_marching_tetrahedra_tables
+####################################################################################################
+def create_marching_tetrahedra_tables():
+    """Creates the tetrahedra of a cell and the triangles of each case of a tetrahedron.
+
+    The cell is split into six tetrahedra around its main diagonal (Kuhn decomposition). Every cell
+    is split in the same way, so the tetrahedra of the neighbouring cells share their faces, and
+    the extracted surface is watertight and manifold, without the ambiguous cases of the marching
+    cubes.
+
+    :return:
+        A list of the tetrahedra, each is a tuple (corners, triangles). The corners are the four
+        offsets of the corners in the cell, every corner is one step along an axis from the
+        previous one. The triangles of a case, a bit mask of the inside corners, are lists of
+        three edges, each is a pair of corners, oriented towards the outside corners.
+    """
+
+    tetrahedra = list()
+
+    # The six tetrahedra, each walks from the corner (0, 0, 0) to (1, 1, 1) along the axes
+    for axes in itertools.permutations(range(3)):
+        corner = [0, 0, 0]
+        corners = [tuple(corner)]
+        for axis in axes:
+            corner[axis] = 1
+            corners.append(tuple(corner))
+        offsets = numpy.array(corners, dtype=numpy.float64)
+
+        # The triangles of each case
+        triangles = dict()
+        for case in range(1, 15):
+            inside = [i for i in range(4) if case & (1 << i)]
+            outside = [i for i in range(4) if not case & (1 << i)]
+
+            # A single corner is separated from the others by a triangle
+            if len(inside) != 2:
+                single = inside[0] if len(inside) == 1 else outside[0]
+                others = [i for i in range(4) if i != single]
+                case_triangles = [[(single, other) for other in others]]
+
+            # Two corners are separated from the others by a quad, split into two triangles
+            else:
+                a, b = inside
+                c, d = outside
+                case_triangles = [[(a, c), (a, d), (b, d)], [(a, c), (b, d), (b, c)]]
+
+            # Orient the triangles towards the outside corners. The orientation does not depend on
+            # where the vertices lie along the edges, so it is fixed with the middles of the edges,
+            # and is correct even for the degenerate triangles
+            direction = offsets[outside].mean(axis=0) - offsets[inside].mean(axis=0)
+            for i, triangle in enumerate(case_triangles):
+                middles = [(offsets[a] + offsets[b]) * 0.5 for a, b in triangle]
+                normal = numpy.cross(middles[1] - middles[0], middles[2] - middles[0])
+                if numpy.dot(normal, direction) < 0:
+                    case_triangles[i] = [triangle[0], triangle[2], triangle[1]]
+            triangles[case] = case_triangles
+
+        tetrahedra.append((corners, triangles))
+
+    # Return the tables
+    return tetrahedra
+
+
+# The tables of the marching tetrahedra
+TETRAHEDRA = create_marching_tetrahedra_tables()
+
+
+####################################################################################################
+# @SparseDistanceGrid
+####################################################################################################
+class SparseDistanceGrid:
+    """A sparse narrow-band signed distance grid of a union of tubes and closed meshes, from which a
+    single watertight surface is extracted.
+
+    The grid is split into blocks of voxels, and only the blocks within the band of a primitive are
+    computed. Every block is computed and contoured independently, in parallel, and only its
+    surface is kept. The distances are negative inside the primitives and positive outside, and
+    the union of the primitives is the minimum of their distances.
+    """
+
+    ################################################################################################
+    # @__init__
+    ################################################################################################
+    def __init__(self,
+                 voxel_size=nmv.consts.Meshing.VOXEL_UNION_VOXEL_SIZE,
+                 band_voxels=nmv.consts.Meshing.VOXEL_UNION_BAND_VOXELS,
+                 block_size=nmv.consts.Meshing.VOXEL_UNION_BLOCK_SIZE):
+        """Constructor
+
+        :param voxel_size:
+            The size of a voxel in microns, the resolution of the surface.
+        :param band_voxels:
+            The width of the narrow band in voxels, the distances are clamped beyond it.
+        :param block_size:
+            The number of the voxels along each side of a block.
+        """
+
+        # The size of a voxel in microns
+        self.voxel_size = voxel_size
+
+        # The width of the band in microns
+        self.band = band_voxels * voxel_size
+
+        # The number of the voxels along each side of a block
+        self.block_size = block_size
+
+        # The tubes, each row is [x0, y0, z0, x1, y1, z1, r0, r1]
+        self.tubes = list()
+
+        # The meshes, each is (BVH, p_min, p_max) in the world coordinates
+        self.meshes = list()
+
+        # The labels of the tubes and the meshes, e.g. the indices of their materials
+        self.tubes_labels = list()
+        self.meshes_labels = list()
+
+        # The origin of the grid
+        self.origin = None
+
+    ################################################################################################
+    # @add_tube
+    ################################################################################################
+    def add_tube(self,
+                 point_0,
+                 radius_0,
+                 point_1,
+                 radius_1,
+                 label=0):
+        """Adds a tapered tube between two points to the grid.
+
+        NOTE: The tubes thinner than a voxel would break in the grid, so they are thickened to the
+        size of the voxel.
+
+        :param point_0:
+            The first point of the tube.
+        :param radius_0:
+            The radius of the tube at the first point.
+        :param point_1:
+            The second point of the tube.
+        :param radius_1:
+            The radius of the tube at the second point.
+        :param label:
+            The label of the tube, given to the faces of the surface that it makes.
+        """
+
+        self.tubes.append([point_0[0], point_0[1], point_0[2], point_1[0], point_1[1], point_1[2],
+                           max(radius_0, self.voxel_size), max(radius_1, self.voxel_size)])
+        self.tubes_labels.append(label)
+
+    ################################################################################################
+    # @add_mesh_object
+    ################################################################################################
+    def add_mesh_object(self,
+                        mesh_object,
+                        label=0):
+        """Adds a closed mesh object, e.g. a soma or a spine, to the grid.
+
+        :param mesh_object:
+            A given mesh object.
+        :param label:
+            The label of the mesh, given to the faces of the surface that it makes.
+        """
+
+        # The BVH of the mesh in the world coordinates
+        bm = bmesh.new()
+        bm.from_mesh(mesh_object.data)
+        bm.transform(mesh_object.matrix_world)
+        vertices = numpy.array([vertex.co[:] for vertex in bm.verts])
+        bvh = BVHTree.FromBMesh(bm)
+        bm.free()
+
+        if len(vertices) > 0:
+            self.meshes.append((bvh, vertices.min(axis=0), vertices.max(axis=0)))
+            self.meshes_labels.append(label)
+
+    ################################################################################################
+    # @get_primitives_bounds
+    ################################################################################################
+    def get_primitives_bounds(self):
+        """Gets the bounding boxes of all the primitives, extended by the band.
+
+        :return:
+            Two arrays of the minimum and the maximum corners of the primitives, one row each,
+            the tubes first then the meshes.
+        """
+
+        p_min = list()
+        p_max = list()
+
+        # The tubes
+        if len(self.tubes) > 0:
+            tubes = numpy.array(self.tubes)
+            radii = numpy.maximum(tubes[:, 6], tubes[:, 7])[:, None] + self.band
+            p_min.append(numpy.minimum(tubes[:, 0:3], tubes[:, 3:6]) - radii)
+            p_max.append(numpy.maximum(tubes[:, 0:3], tubes[:, 3:6]) + radii)
+
+        # The meshes
+        if len(self.meshes) > 0:
+            p_min.append(numpy.array([mesh[1] for mesh in self.meshes]) - self.band)
+            p_max.append(numpy.array([mesh[2] for mesh in self.meshes]) + self.band)
+
+        return numpy.concatenate(p_min), numpy.concatenate(p_max)
+
+    ################################################################################################
+    # @get_primitives_index_bounds
+    ################################################################################################
+    def get_primitives_index_bounds(self,
+                                    p_min,
+                                    p_max):
+        """Gets the ranges of the grid points that are affected by the primitives.
+
+        :param p_min:
+            The minimum corners of the primitives.
+        :param p_max:
+            The maximum corners of the primitives.
+        :return:
+            Two integer arrays of the first and the last grid points of the primitives.
+        """
+
+        return numpy.floor((p_min - self.origin) / self.voxel_size).astype(numpy.int64), \
+            numpy.ceil((p_max - self.origin) / self.voxel_size).astype(numpy.int64)
+
+    ################################################################################################
+    # @compute_block
+    ################################################################################################
+    def compute_block(self,
+                      block,
+                      primitives,
+                      index_min,
+                      index_max):
+        """Computes the distances at the grid points of a block.
+
+        The block covers its voxels and the points on its far faces, which are shared with the
+        next blocks and computed identically by them.
+
+        :param block:
+            The index of the block along each axis.
+        :param primitives:
+            The indices of the primitives that affect the block.
+        :param index_min:
+            The first grid points of all the primitives.
+        :param index_max:
+            The last grid points of all the primitives.
+        :return:
+            The distances and the labels of the nearest primitives, two cubic arrays of
+            block_size + 1 points per side.
+        """
+
+        # The grid points of the block
+        first_point = numpy.array(block) * self.block_size
+        last_point = first_point + self.block_size
+        distances = numpy.full([self.block_size + 1] * 3, self.band, dtype=numpy.float32)
+        labels = numpy.zeros([self.block_size + 1] * 3, dtype=numpy.int32)
+        primitives_labels = self.tubes_labels + self.meshes_labels
+
+        for primitive in primitives:
+
+            # The grid points of the block that are affected by the primitive
+            point_min = numpy.maximum(index_min[primitive], first_point)
+            point_max = numpy.minimum(index_max[primitive], last_point)
+            if numpy.any(point_min > point_max):
+                continue
+
+            # Their positions
+            axes = [self.origin[i] + numpy.arange(point_min[i], point_max[i] + 1) * self.voxel_size
+                    for i in range(3)]
+            grid = numpy.meshgrid(*axes, indexing='ij')
+            points = numpy.stack([axis.ravel() for axis in grid], axis=1)
+
+            # The distances to the primitive
+            if primitive < len(self.tubes):
+                primitive_distances = self.compute_tube_distances(self.tubes[primitive], points)
+            else:
+                primitive_distances = self.compute_mesh_distances(
+                    self.meshes[primitive - len(self.tubes)][0], points)
+
+            # The union with the previous primitives
+            start = point_min - first_point
+            end = point_max - first_point + 1
+            region = distances[start[0]:end[0], start[1]:end[1], start[2]:end[2]]
+            primitive_distances = primitive_distances.reshape(region.shape)
+            nearer = primitive_distances < region
+            region[nearer] = primitive_distances[nearer]
+
+            # The label of the nearest primitive
+            labels[start[0]:end[0], start[1]:end[1], start[2]:end[2]][nearer] = \
+                primitives_labels[primitive]
+
+        # Clamp to the band, and keep the points off the surface to keep the surface manifold
+        numpy.clip(distances, -self.band, self.band, out=distances)
+        distances[distances == 0] = 1e-6 * self.voxel_size
+        return distances, labels
+
+    ################################################################################################
+    # @compute_tube_distances
+    ################################################################################################
+    @staticmethod
+    def compute_tube_distances(tube,
+                               points):
+        """Computes the signed distances of some points to a tapered tube.
+
+        :param tube:
+            The tube, [x0, y0, z0, x1, y1, z1, r0, r1].
+        :param points:
+            An array of the points, a row each.
+        :return:
+            An array of the distances.
+        """
+
+        point_0 = numpy.array(tube[0:3])
+        axis = numpy.array(tube[3:6]) - point_0
+        length = numpy.dot(axis, axis)
+
+        # The projection of the points on the axis of the tube
+        if length > 0:
+            t = numpy.clip(numpy.dot(points - point_0, axis) / length, 0.0, 1.0)
+        else:
+            t = numpy.zeros(len(points))
+        closest_points = point_0 + t[:, None] * axis
+
+        # The distance to the axis minus the interpolated radius
+        return numpy.linalg.norm(points - closest_points, axis=1) - \
+            (tube[6] + t * (tube[7] - tube[6]))
+
+    ################################################################################################
+    # @compute_mesh_distances
+    ################################################################################################
+    @staticmethod
+    def compute_mesh_distances(bvh,
+                               points):
+        """Computes the signed distances of some points to a closed mesh, the sign is given by the
+        normal of the nearest face.
+
+        :param bvh:
+            The BVH of the mesh.
+        :param points:
+            An array of the points, a row each.
+        :return:
+            An array of the distances.
+        """
+
+        distances = numpy.empty(len(points))
+        for i, point in enumerate(points):
+            point = Vector(point)
+            location, normal, index, distance = bvh.find_nearest(point)
+            if location is None:
+                distances[i] = numpy.inf
+            elif (point - location).dot(normal) < 0:
+                distances[i] = -distance
+            else:
+                distances[i] = distance
+        return distances
+
+    ################################################################################################
+    # @extract_block_surface
+    ################################################################################################
+    def extract_block_surface(self,
+                              block,
+                              distances,
+                              labels,
+                              grid_size):
+        """Extracts the surface of a block with the marching tetrahedra.
+
+        The vertices of the surface lie on the edges of the grid, and every vertex is identified by
+        its edge, so the vertices of the neighbouring blocks are merged.
+
+        :param block:
+            The index of the block along each axis.
+        :param distances:
+            The distances at the grid points of the block.
+        :param labels:
+            The labels of the nearest primitives at the grid points of the block.
+        :param grid_size:
+            The number of the grid points along each axis of the whole grid.
+        :return:
+            A tuple (edges, vertices, labels) of the triangles, or None if the block has no
+            surface. The edges are the identifiers of the vertices, an array of three per triangle,
+            the vertices are their positions, an array of three rows per triangle, and the label of
+            a triangle is that of the primitive nearest to the inner end of its first edge.
+        """
+
+        inside = distances < 0
+        if not inside.any() or inside.all():
+            return None
+
+        size = self.block_size
+        first_point = numpy.array(block) * size
+
+        # The grid points of the first corners of the cells of the block
+        cells = numpy.stack(numpy.meshgrid(
+            *[numpy.arange(size)] * 3, indexing='ij'), axis=-1).reshape(-1, 3) + first_point
+
+        edges = list()
+        vertices = list()
+        triangles_labels = list()
+        for corners, tetrahedron_triangles in TETRAHEDRA:
+
+            # The distances at the corners of the tetrahedra of all the cells
+            corner_distances = numpy.stack([distances[c[0]:c[0] + size, c[1]:c[1] + size,
+                                                      c[2]:c[2] + size].ravel()
+                                            for c in corners], axis=1)
+            corner_labels = numpy.stack([labels[c[0]:c[0] + size, c[1]:c[1] + size,
+                                                c[2]:c[2] + size].ravel()
+                                         for c in corners], axis=1)
+            cases = numpy.zeros(len(cells), dtype=numpy.int64)
+            for i in range(4):
+                cases |= (corner_distances[:, i] < 0).astype(numpy.int64) << i
+
+            for case, triangles in tetrahedron_triangles.items():
+                selection = numpy.nonzero(cases == case)[0]
+                if len(selection) == 0:
+                    continue
+
+                for triangle in triangles:
+                    triangle_edges = list()
+                    triangle_vertices = list()
+                    for a, b in triangle:
+
+                        # The edge goes from its lower corner along a direction of the cell
+                        lower, upper = (a, b) if sum(corners[a]) < sum(corners[b]) else (b, a)
+                        step = numpy.array(corners[upper]) - numpy.array(corners[lower])
+                        lower_points = cells[selection] + numpy.array(corners[lower])
+                        linear_index = (lower_points[:, 0] * grid_size[1] +
+                                        lower_points[:, 1]) * grid_size[2] + lower_points[:, 2]
+                        triangle_edges.append(
+                            linear_index * 7 + step[0] + 2 * step[1] + 4 * step[2] - 1)
+
+                        # The vertex where the distance vanishes along the edge
+                        distance_a = corner_distances[selection, a]
+                        distance_b = corner_distances[selection, b]
+                        t = distance_a / (distance_a - distance_b)
+                        offset = numpy.array(corners[a]) + \
+                            t[:, None] * (numpy.array(corners[b]) - numpy.array(corners[a]))
+                        triangle_vertices.append(
+                            self.origin + (cells[selection] + offset) * self.voxel_size)
+
+                    edges.append(numpy.stack(triangle_edges, axis=1))
+                    vertices.append(numpy.stack(triangle_vertices, axis=1))
+
+                    # The label of the inner end of the first edge
+                    a, b = triangle[0]
+                    triangles_labels.append(numpy.where(
+                        corner_distances[selection, a] < 0,
+                        corner_labels[selection, a], corner_labels[selection, b]))
+
+        # Return the triangles of the block
+        return numpy.concatenate(edges), numpy.concatenate(vertices), \
+            numpy.concatenate(triangles_labels)
+
+    ################################################################################################
+    # @extract_surface
+    ################################################################################################
+    def extract_surface(self,
+                        number_threads=None):
+        """Computes the active blocks of the grid in parallel and extracts the surface of the union
+        of the primitives.
+
+        :param number_threads:
+            The number of the threads that compute the blocks, by default the number of the cores.
+        :return:
+            A tuple (vertices, faces, labels) of arrays of the surface, where the labels are those
+            of the primitives that make the faces, or (None, None, None) if it is empty.
+        """
+
+        if len(self.tubes) == 0 and len(self.meshes) == 0:
+            return None, None, None
+
+        start_time = time.time()
+
+        # The grid starts a voxel before the primitives
+        p_min, p_max = self.get_primitives_bounds()
+        self.origin = p_min.min(axis=0) - self.voxel_size
+        index_min, index_max = self.get_primitives_index_bounds(p_min, p_max)
+
+        # The blocks that are affected by each primitive, including the blocks that share their
+        # first points with the last points of the primitive
+        size = self.block_size
+        block_min = -((size - index_min) // size)
+        block_max = index_max // size
+        blocks = dict()
+        for primitive in range(len(index_min)):
+            for block in itertools.product(*[range(block_min[primitive][i],
+                                                   block_max[primitive][i] + 1)
+                                             for i in range(3)]):
+                blocks.setdefault(block, list()).append(primitive)
+
+        # The number of the grid points along each axis, the points of all the blocks
+        grid_size = (numpy.max(list(blocks.keys()), axis=0) + 1) * size + 1
+
+        # Compute and contour the blocks in parallel, the numpy kernels release the GIL
+        def process_block(block):
+            distances, labels = self.compute_block(block, blocks[block], index_min, index_max)
+            return self.extract_block_surface(block, distances, labels, grid_size)
+
+        if number_threads is None:
+            number_threads = os.cpu_count()
+        with concurrent.futures.ThreadPoolExecutor(max_workers=number_threads) as executor:
+            surfaces = [surface for surface in executor.map(process_block, list(blocks.keys()))
+                        if surface is not None]
+
+        nmv.logger.statistics('[%d] blocks of the distance grid computed in [%f] seconds' %
+                              (len(blocks), time.time() - start_time))
+
+        if len(surfaces) == 0:
+            return None, None, None
+
+        # Merge the vertices that are shared by the triangles and the blocks
+        edges = numpy.concatenate([surface[0] for surface in surfaces]).ravel()
+        positions = numpy.concatenate([surface[1] for surface in surfaces]).reshape(-1, 3)
+        _, first_indices, faces = numpy.unique(
+            edges, return_index=True, return_inverse=True)
+
+        # Return the surface
+        return positions[first_indices], faces.reshape(-1, 3), \
+            numpy.concatenate([surface[2] for surface in surfaces])
+
+
+####################################################################################################
+# @create_mesh_object_from_surface
+####################################################################################################
+def create_mesh_object_from_surface(vertices,
+                                    faces,
+                                    name='Mesh'):
+    """Creates a mesh object from the arrays of a surface.
+
+    :param vertices:
+        An array of the vertices, a row each.
+    :param faces:
+        An array of the triangles, three vertex indices each.
+    :param name:
+        The name of the mesh object.
+    :return:
+        A reference to the created mesh object.
+    """
+
+    # Create the mesh and fill it
+    mesh = bpy.data.meshes.new(name)
+    mesh.from_pydata(vertices.tolist(), [], faces.tolist())
+    mesh.update()
+
+    # Create the object and link it to the scene
+    mesh_object = bpy.data.objects.new(name, mesh)
+    nmv.scene.link_object_to_scene(mesh_object)
+
+    # Return a reference to the mesh object
+    return mesh_object
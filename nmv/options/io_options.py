@@ -36,6 +36,9 @@ class IOOptions:
         # Images directory, where the images will be rendered
         self.images_directory = None
 
+        # Quality assurance directory, where the QA images and the contact sheets will be rendered
+        self.qa_directory = None
+
         # Sequences directory, where the movies will be rendered
         self.sequences_directory = None
 
@@ -51,4 +54,10 @@ class IOOptions:
         # Statistics directory, where the stats. will be saved
         self.statistics_directory = None
 
+        # The directory of the morphologies of a batch that is processed in a single job
+        self.morphology_directory = None
+
+        # The number of the morphologies that are read ahead in a batch, zero to disable
+        self.prefetch_morphologies = 0
+
 
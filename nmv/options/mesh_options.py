@@ -68,6 +68,15 @@ class MeshOptions:
         # The shape of the skeleton that is used in the union meshing algorithm
         self.skeleton_shape = nmv.enums.Meshing.UnionMeshing.QUAD_SKELETON
 
+        # The number of the worker processes of the union meshing algorithm
+        self.union_workers = nmv.consts.Meshing.UNION_WORKERS
+
+        # The union meshing algorithm uses boolean operators or a voxel grid
+        self.union_mode = nmv.enums.Meshing.UnionMode.BOOLEAN
+
+        # The size of the voxels of the voxel union in microns
+        self.voxel_size = nmv.consts.Meshing.VOXEL_UNION_VOXEL_SIZE
+
         # SPINES OPTIONS ###########################################################################
         # The source where the spines will be loaded from, by default ignore the spines
         self.spines = nmv.enums.Meshing.Spines.Source.IGNORE
@@ -78,6 +87,10 @@ class MeshOptions:
         # Number of random spines per micron
         self.number_spines_per_micron = nmv.consts.Meshing.NUMBER_SPINES_PER_MICRON
 
+        # RANDOMNESS ###############################################################################
+        # The seed of the random streams of the stochastic builders, None for non-deterministic runs
+        self.random_seed = None
+
         # NUCLEI OPTIONS ###########################################################################
         # Nucleus, ignore by default
         self.nucleus = nmv.enums.Meshing.Nucleus.IGNORE
@@ -66,6 +66,9 @@ class MorphologyOptions:
         # The arbors connectivity to the soma
         self.arbors_to_soma_connection = nmv.enums.Skeleton.Roots.ALL_CONNECTED
 
+        # Create the samples of the sections only when the sections are visited by the builders
+        self.lazy_loading = False
+
         # Enable/Disable axon reconstruction
         self.ignore_axons = False
 
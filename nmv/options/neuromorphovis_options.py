@@ -80,6 +80,9 @@ class NeuroMorphoVisOptions:
         # Images directory
         self.io.images_directory = '%s/%s' % (arguments.output_directory, nmv.consts.Paths.IMAGES_FOLDER)
 
+        # Quality assurance directory
+        self.io.qa_directory = '%s/%s' % (arguments.output_directory, nmv.consts.Paths.QA_FOLDER)
+
         # Sequences directory
         self.io.sequences_directory = '%s/%s' % (arguments.output_directory, nmv.consts.Paths.SEQUENCES_FOLDER)
 
@@ -95,6 +98,11 @@ class NeuroMorphoVisOptions:
         # Statistics directory
         self.io.statistics_directory = '%s/%s' % (arguments.output_directory, nmv.consts.Paths.STATS_FOLDER)
 
+        # A batch of morphologies processed in a single job
+        if arguments.input == 'directory':
+            self.io.morphology_directory = arguments.morphology_directory
+        self.io.prefetch_morphologies = arguments.prefetch_morphologies
+
         ############################################################################################
         # Morphology options
         ############################################################################################
@@ -135,6 +143,9 @@ class NeuroMorphoVisOptions:
         self.morphology.soma_representation = \
             nmv.enums.Soma.Representation.get_enum(arguments.soma_representation)
 
+        # Create the samples of the sections on demand
+        self.morphology.lazy_loading = arguments.lazy_morphology
+
         # Ignore axon
         self.morphology.ignore_axons = arguments.ignore_axons
 
@@ -206,6 +217,9 @@ class NeuroMorphoVisOptions:
         # Subdivision level of the sphere
         self.soma.subdivision_level = arguments.soma_subdivision_level
 
+        # Time budget of the particle remeshing of the soma
+        self.soma.remeshing_time_budget = arguments.soma_remeshing_time_budget
+
         # Soma color
         self.soma.soma_color = nmv.utilities.parse_color_from_argument(arguments.soma_color)
 
@@ -288,6 +302,16 @@ class NeuroMorphoVisOptions:
         self.mesh.soma_connection = nmv.enums.Meshing.SomaConnection.CONNECTED if \
             arguments.connect_soma_arbors else nmv.enums.Meshing.SomaConnection.DISCONNECTED
 
+        # The seed of the stochastic builders
+        self.mesh.random_seed = arguments.random_seed
+
+        # The number of the worker processes of the union meshing
+        self.mesh.union_workers = arguments.union_workers
+
+        # The union mode and the voxel size of the union meshing
+        self.mesh.union_mode = nmv.enums.Meshing.UnionMode.get_enum(arguments.union_mode)
+        self.mesh.voxel_size = arguments.voxel_size
+
         ############################################################################################
         # Shading options
         ############################################################################################
@@ -350,6 +374,11 @@ class NeuroMorphoVisOptions:
         # Camera view [FRONT, SIDE or TOP]
         self.rendering.camera_view = nmv.enums.Camera.View.get_enum(arguments.camera_view)
 
+        # Custom camera angles
+        if arguments.camera_angles is not None:
+            self.rendering.camera_angles = \
+                [float(angle) for angle in arguments.camera_angles.split(',')]
+
         # Rendering view
         self.rendering.rendering_view = nmv.enums.Rendering.View.get_enum(
             arguments.rendering_view)
@@ -375,4 +404,29 @@ class NeuroMorphoVisOptions:
 
         # The file format of the image
         self.rendering.image_format = nmv.enums.Image.Extension.get_enum(
-            arguments.image_file_format)
\ No newline at end of file
+            arguments.image_file_format)
+
+        # Rendering profile
+        self.rendering.render_profile = nmv.enums.Rendering.Profile.get_enum(
+            arguments.render_profile)
+
+        # Rendering threads
+        self.rendering.render_threads = arguments.render_threads
+
+        # Rendering noise
+        self.rendering.estimate_render_noise = arguments.estimate_render_noise
+
+
+        # Tiled rendering
+        self.rendering.render_tile_size = arguments.render_tile_size
+        self.rendering.render_tile_workers = arguments.render_tile_workers
+        self.rendering.render_tile_hdr = arguments.render_tile_hdr
+        self.rendering.blender_executable = arguments.blender
+        self.rendering.render_tiles_on_cluster = arguments.execution_node == 'cluster'
+
+        # Quality assurance images, with flat per-arbor colors that are cheap to render
+        self.rendering.qa_render = arguments.qa_render
+        self.rendering.qa_resolution = arguments.qa_resolution
+        if arguments.qa_render:
+            self.shading.morphology_material = nmv.enums.Shader.FLAT
+            self.shading.mesh_material = nmv.enums.Shader.FLAT
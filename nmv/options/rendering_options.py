@@ -61,6 +61,9 @@ class RenderingOptions:
         # Camera view
         self.camera_view = nmv.enums.Camera.View.FRONT
 
+        # Custom camera angles around the Y-axis in degrees
+        self.camera_angles = list()
+
         # Rendering view
         self.rendering_view = nmv.enums.Rendering.View.MID_SHOT
 
@@ -82,4 +85,34 @@ class RenderingOptions:
         # Image extension
         self.image_format = nmv.enums.Image.Extension.PNG
 
+        # Rendering profile, that controls the quality and the cost of every image
+        self.render_profile = nmv.enums.Rendering.Profile.PREVIEW
+
+        # The number of rendering threads, zero to use all the cores
+        self.render_threads = nmv.consts.RenderProfile.THREADS
+
+        # Estimate the noise of every rendered image
+        self.estimate_render_noise = nmv.consts.RenderProfile.ESTIMATE_NOISE
+
+        # The size of the tiles of the tiled to-scale rendering, zero to render a single image
+        self.render_tile_size = 0
+
+        # The number of the workers of the tiled rendering
+        self.render_tile_workers = nmv.consts.TiledRendering.DEFAULT_WORKERS
+
+        # Stitch the tiles into a 32-bit float image
+        self.render_tile_hdr = False
+
+        # The Blender executable of the workers
+        self.blender_executable = 'blender'
+
+        # Run the workers on the cluster
+        self.render_tiles_on_cluster = False
+
+        # Render a quick quality assurance image of every neuron
+        self.qa_render = False
+
+        # The resolution of the quality assurance images
+        self.qa_resolution = nmv.consts.QualityAssurance.DEFAULT_RESOLUTION
+
 
@@ -56,6 +56,9 @@ class SomaOptions:
         # Simulation steps
         self.simulation_steps = nmv.consts.SoftBody.SIMULATION_STEPS_DEFAULT
 
+        # Wall-clock budget of the particle remeshing of the soma in seconds, zero is unlimited
+        self.remeshing_time_budget = nmv.consts.SoftBody.REMESHING_TIME_BUDGET_DEFAULT
+
         # MESH EXPORT OPTIONS ######################################################################
         # Export soma mesh in .ply format
         self.export_ply = False
@@ -15,8 +15,12 @@
 # If not, see <http://www.gnu.org/licenses/>.
 ####################################################################################################
 
+# System imports
+import numpy
+
 # Blender imports
 import bpy
+from mathutils import Vector, Matrix
 
 # Internal imports
 import nmv.scene
@@ -140,3 +144,126 @@ def scale_hook_at_keyframe(hook,
 
     # Insert the keyframe at this scale
     hook.keyframe_insert(data_path="scale")
+
+
+####################################################################################################
+# @add_hooks_to_vertices_in_bulk
+####################################################################################################
+def add_hooks_to_vertices_in_bulk(mesh_object,
+                                  vertices_indices_list,
+                                  names):
+    """Creates a hook for every list of vertices in a given list of lists.
+
+    The hooks are created with the data API, without switching to the edit mode or running the
+    hook operator per hook. The empties are located at the median of their vertices, the same as
+    bpy.ops.object.hook_add_newob. The mesh object is assumed to have an identity transformation.
+
+    NOTE: HookModifier.vertex_indices_set is only available in Blender 2.90 and later, for the
+    older versions the hooks are created one by one with add_hook_to_vertices.
+
+    :param mesh_object:
+        An input mesh where the hooks will be added to.
+    :param vertices_indices_list:
+        A list of lists of the indices of the vertices where every hook will be attached to.
+    :param names:
+        A list of the names of the hooks.
+    :return:
+        A list of references to the created hooks.
+    """
+
+    # Fall back to the operator if the modifier cannot assign the vertices directly
+    if not hasattr(bpy.types.HookModifier, 'vertex_indices_set'):
+        return [add_hook_to_vertices(mesh_object, vertices_indices, name=name)
+                for vertices_indices, name in zip(vertices_indices_list, names)]
+
+    # Get the coordinates of all the vertices at once
+    coordinates = numpy.zeros(len(mesh_object.data.vertices) * 3, dtype=numpy.float32)
+    mesh_object.data.vertices.foreach_get('co', coordinates)
+    coordinates = coordinates.reshape((-1, 3))
+
+    # A list of all the created hooks
+    hooks = list()
+
+    for vertices_indices, name in zip(vertices_indices_list, names):
+
+        # The center of the vertices
+        center = Vector(coordinates[list(vertices_indices)].mean(axis=0).tolist())
+
+        # Create an empty object that represents the hook and link it to the scene
+        hook = bpy.data.objects.new(name, None)
+        hook.location = center
+        nmv.scene.link_object_to_scene(hook)
+
+        # Add the hook modifier and bind it to the vertices, the inverse matrix cancels the initial
+        # location of the hook such that the mesh is not deformed before the hook is moved
+        modifier = mesh_object.modifiers.new(name=name, type='HOOK')
+        modifier.object = hook
+        modifier.center = center
+        modifier.matrix_inverse = Matrix.Translation(center).inverted()
+        modifier.vertex_indices_set(list(vertices_indices))
+
+        # Add the hook to the list
+        hooks.append(hook)
+
+    # Return a list of references to the hooks
+    return hooks
+
+
+####################################################################################################
+# @set_hooks_keyframes_in_bulk
+####################################################################################################
+def set_hooks_keyframes_in_bulk(hooks,
+                                data_path,
+                                keyframes,
+                                values):
+    """Inserts the keyframes of a given property of a list of hooks by filling their animation
+    curves directly, instead of switching the frame of the scene for every keyframe.
+
+    :param hooks:
+        A list of hooks.
+    :param data_path:
+        The animated property, for example 'location' or 'scale'.
+    :param keyframes:
+        A list of K keyframes.
+    :param values:
+        An array of shape (H, K, 3) with the values of the property of every hook at every
+        keyframe.
+    """
+
+    # Frames
+    keyframes = numpy.array(keyframes, dtype=numpy.float32)
+    values = numpy.asarray(values, dtype=numpy.float32).reshape((len(hooks), len(keyframes), 3))
+
+    for hook, hook_values in zip(hooks, values):
+
+        # Make sure that the hook has an action
+        if hook.animation_data is None:
+            hook.animation_data_create()
+        if hook.animation_data.action is None:
+            hook.animation_data.action = bpy.data.actions.new(name='%s_action' % hook.name)
+        action = hook.animation_data.action
+
+        # Fill the curve of every component
+        for axis in range(3):
+
+            # Get the curve, or create it
+            fcurve = action.fcurves.find(data_path, index=axis)
+            if fcurve is None:
+                fcurve = action.fcurves.new(data_path, index=axis)
+
+            # The existing keyframes, foreach_set overwrites all the points of the curve
+            existing_points = numpy.zeros(len(fcurve.keyframe_points) * 2, dtype=numpy.float32)
+            fcurve.keyframe_points.foreach_get('co', existing_points)
+
+            # Interleaved (frame, value) pairs
+            points = numpy.zeros(len(keyframes) * 2, dtype=numpy.float32)
+            points[0::2] = keyframes
+            points[1::2] = hook_values[:, axis]
+
+            # Add all the keyframes at once, then sort them and update their handles
+            fcurve.keyframe_points.add(len(keyframes))
+            fcurve.keyframe_points.foreach_set('co', numpy.concatenate((existing_points, points)))
+            fcurve.update()
+
+        # The static value of the property is the one at the first keyframe
+        setattr(hook, data_path, Vector(hook_values[0].tolist()))
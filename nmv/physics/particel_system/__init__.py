@@ -16,6 +16,7 @@
 ####################################################################################################
 
 from .drawing import *
+from .field_engine import *
 from .field import *
 from .particle import *
 from .surface_particle_system import *
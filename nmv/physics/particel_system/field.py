@@ -28,7 +28,6 @@ import bmesh
 from mathutils import Vector
 from mathutils.geometry import barycentric_transform
 from mathutils.bvhtree import BVHTree
-from itertools import product
 
 # Internal imports
 import nmv.physics
@@ -48,16 +47,16 @@ class Field:
     ################################################################################################
     def __init__(self,
                  mesh_object,
-                 max_adjacent=20,
-                 enable_drawing=False):
+                 enable_drawing=False,
+                 random_state=None):
         """Constructor
 
         :param mesh_object:
             A given mesh object to calculate the field around.
-        :param max_adjacent:
-            Maximum number of adjacent vertices or edges per vertex.
         :param enable_drawing:
             Enable the drawing functions in the interactive mode.
+        :param random_state:
+            A numpy RandomState used for the random walks, by default the global numpy generator.
         """
 
         # World matrix
@@ -91,9 +90,6 @@ class Field:
         # Get the number of vertices of the bmesh 
         self.number_vertices = len(self.bm.verts)
 
-        # Max adjacent
-        self.max_adjacent = max_adjacent
-
         # A list of singularities
         self.singularities = list()
 
@@ -101,10 +97,8 @@ class Field:
         self.locations = numpy.array([vert.co for vert in self.bm.verts], dtype=numpy.float32)
 
         # A numpy array of the normals
-        self.normals = numpy.zeros((self.number_vertices, 3), dtype=numpy.float32)
-
-        # A numpy array for the adjacents
-        self.adjacent_counts = numpy.zeros((self.number_vertices,), dtype=numpy.float32)
+        self.normals = numpy.array([vert.normal for vert in self.bm.verts], dtype=numpy.float32)
+        self.normals = self.normals.reshape((self.number_vertices, 3))
 
         # A numpy array for the fields
         self.field = numpy.zeros((self.number_vertices, 3), dtype=numpy.float64)
@@ -112,14 +106,20 @@ class Field:
         # A numpy array for the scales
         self.scale = numpy.zeros((self.number_vertices,), dtype=numpy.float64)
 
-        # A numpy array for the curvatures
-        self.curvature = numpy.zeros((self.number_vertices,), dtype=numpy.float64)
-
         # A numpy array for the weights
         self.weights = numpy.ones((self.number_vertices,), dtype=numpy.float64)
 
-        # A numpy array for the connectivity
-        self.connectivity = numpy.zeros((self.number_vertices, max_adjacent), dtype=numpy.int64)
+        # The array-based engine that holds the CSR adjacency of the mesh, built once
+        self.engine = nmv.physics.FieldEngine(
+            number_vertices=self.number_vertices,
+            edges=[(edge.verts[0].index, edge.verts[1].index) for edge in self.bm.edges],
+            faces=[[vert.index for vert in face.verts] for face in self.bm.faces],
+            locations=self.locations,
+            normals=self.normals,
+            random_state=random_state)
+
+        # A numpy array for the curvatures, computed on all the vertices at once
+        self.curvature = self.engine.average_curvature()
 
         # Mask layer
         mask_layer = self.bm.verts.layers.paint_mask.verify()
@@ -130,35 +130,16 @@ class Field:
             # A reference to the vertex index
             i = vertex.index
 
-            #
+            # Initial direction of the field
             self.field[i] = nmv.physics.curvature_direction(vertex)
 
-            # Get the normal of the vertex
-            self.normals[i] = nmv.physics.vert_normal(vertex)
-
             # Get the scale of the field from the mask layer
             self.scale[i] = vertex[mask_layer]
 
-            # Get the average curvature of the vertex
-            self.curvature[i] = nmv.physics.average_curvature(vertex)
-
-            # Get the adjacent vertices
-            self.adjacent_counts[i] = min(len(vertex.link_edges), max_adjacent)
-
             # If this is a boundary vertex, set its weight to zero to avoid creating distorted mesh
             if vertex.is_boundary:
                 self.weights[vertex.index] = 0
 
-            # Update the connectivity matrix
-            for j, edge in enumerate(vertex.link_edges):
-
-                # Reached maximum adjacent edges
-                if j >= max_adjacent:
-                    continue
-
-                # Update the connectivity matrix
-                self.connectivity[i, j] = edge.other_vert(vertex).index
-
     ################################################################################################
     # @initialize_from_grease_pencil
     ################################################################################################
@@ -228,31 +209,15 @@ class Field:
     ################################################################################################
     def walk_edges(self,
                    depth=0):
-        """
+        """Walks (depth + 1) random edges from every vertex in the field mesh.
 
         :param depth:
+            Number of additional hops after the first one.
         :return:
+            A numpy array with the index of the vertex reached from every vertex.
         """
 
-
-        cols = numpy.arange(self.number_vertices)
-
-        ids = numpy.random.randint(0, self.max_adjacent,
-                                   (self.number_vertices,)) % self.adjacent_counts
-
-        ids = ids.astype(numpy.int_)
-
-        adjacent_edges = self.connectivity[cols, ids]
-
-        for _ in range(depth):
-            ids = numpy.random.randint(0, self.max_adjacent, (self.number_vertices,)) % \
-                  self.adjacent_counts[adjacent_edges]
-
-            ids = ids.astype(numpy.int_)
-
-            adjacent_edges = self.connectivity[adjacent_edges, ids]
-
-        return adjacent_edges
+        return self.engine.random_walk(depth)
 
     ################################################################################################
     # @smooth
@@ -260,59 +225,19 @@ class Field:
     def smooth(self,
                iterations=100,
                depth=3):
+        """Smooths the cross field using the cached multi-hop adjacency of the field engine.
 
-        def find_best_combinations(a, b):
-
-            w = self.weights[:, numpy.newaxis]
-            scores = []
-            vectors = []
-            for a, b in product(a, (b * w)):
-                m = (a * b).sum(axis=1)
-                scores.append(m)
-                vectors.append((a + b))
-            scores = numpy.stack(scores, axis=0)
-            vectors = numpy.stack(vectors, axis=0)
-            idx = scores.argmax(axis=0)
-            cols = numpy.arange(self.number_vertices)
-            rval = vectors[idx, cols]
-            nans = numpy.isnan(rval)
-            rval[nans] = 0
-            return rval * (1 / (w + 1))
-
-        if not self.hex_mode:
-            for i in range(iterations):
-
-                a = self.field
-                b = numpy.cross(self.field, self.normals)
-                adjacent_edges = self.walk_edges(depth)
-
-                c = self.field[adjacent_edges]
-                d = numpy.cross(c, self.normals[adjacent_edges])
-
-                best = find_best_combinations((a, b, -a, -b), (c, d))
-                best = best - self.normals * (best * self.normals).sum(axis=1)[:, numpy.newaxis]
-                self.field = best
-        else:
-            for i in range(iterations):
-                x = self.field
-                y = numpy.cross(self.field, self.normals)
-                a = x
-                b = x * 0.5 + y * 0.866025
-                c = x * -0.5 + y * 0.866025
-
-                adjacent_edges = self.walk_edges(depth)
-
-                x = self.field[adjacent_edges]
-                y = numpy.cross(x, self.normals[adjacent_edges])
-                d = x
-                e = x * 0.5 + y * 0.866025
-                f = x * -0.5 + y * 0.866025
-
-                best = find_best_combinations((a, b, c, -a, -b, -c), (d, e, f))
-                best = best - self.normals * (best * self.normals).sum(axis=1)[:, numpy.newaxis]
-                self.field = best
+        :param iterations:
+            Number of smoothing iterations.
+        :param depth:
+            Walking depth of the neighbours that are used in the smoothing.
+        """
 
-        self.field = nmv.physics.normalize_vectors_array(self.field)
+        self.field = self.engine.smooth(field=self.field,
+                                        weights=self.weights,
+                                        iterations=iterations,
+                                        depth=depth,
+                                        hex_mode=self.hex_mode)
 
     ################################################################################################
     # @autoscale
@@ -341,7 +266,7 @@ class Field:
                 ang += vert1_vec.angle_signed(vert2_vec)
             self.scale[vert.index] = ang
         for i in range(20):
-            self.scale += self.scale[self.walk_edges(0)]
+            self.scale += self.scale[self.engine.get_hop_table(0)].mean(axis=1)
             self.scale /= 2
         self.scale -= self.scale.min()
         self.scale /= self.scale.max()
@@ -391,7 +316,7 @@ class Field:
         else:
             for vert in self.bm.verts:
                 ang = 0
-                u = nmv.physics.random_tangent_vector(vert.normal)
+                u = nmv.physics.random_tangent_vector(vert.normal, self.engine.random_state)
                 v = u.cross(vert.normal)
                 last_vec = None
                 for loop in vert.link_loops:
@@ -442,6 +367,30 @@ class Field:
             return location, normal, dir, scale, curv
         else:
             return None, None, None, None
+
+    ################################################################################################
+    # @sample_points
+    ################################################################################################
+    def sample_points(self,
+                      points,
+                      reference_directions=None):
+        """Samples the field for a batch of points at once.
+
+        :param points:
+            A list of points.
+        :param reference_directions:
+            An optional list of reference directions, one per point.
+        :return:
+            A tuple of numpy arrays (valid, locations, normals, directions, scales, curvatures).
+        """
+
+        return self.engine.sample_points(bvh=self.bvh,
+                                         points=points,
+                                         field=self.field,
+                                         scale=self.scale,
+                                         curvature=self.curvature,
+                                         reference_directions=reference_directions,
+                                         hex_mode=self.hex_mode)
     '''
     ################################################################################################
     # @detect_singularities
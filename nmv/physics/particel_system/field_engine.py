@@ -0,0 +1,452 @@
+####################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+# System imports
+import numpy
+
+
+####################################################################################################
+# FieldEngine
+####################################################################################################
+class FieldEngine:
+    """Array-based back-end of the cross-field solver.
+
+    The engine stores the one-ring adjacency of the field mesh in a compressed sparse row (CSR)
+    layout that is built only once. The multi-hop neighbours that are used to propagate the field
+    are drawn from this layout in a single vectorized random walk and cached per depth, so the
+    smoothing iterations become plain array gathers instead of regenerating the walks every time.
+    The engine also samples the field for a whole batch of points at once.
+    """
+
+    ################################################################################################
+    # @__init__
+    ################################################################################################
+    def __init__(self,
+                 number_vertices,
+                 edges,
+                 faces,
+                 locations,
+                 normals,
+                 hop_samples=4,
+                 random_state=None):
+        """Constructor
+
+        :param number_vertices:
+            Number of vertices in the field mesh.
+        :param edges:
+            A numpy array of shape (E, 2) with the vertex indices of every edge in the mesh.
+        :param faces:
+            A numpy array of shape (F, 3) with the vertex indices of every triangle in the mesh.
+        :param locations:
+            A numpy array of shape (N, 3) with the locations of the vertices.
+        :param normals:
+            A numpy array of shape (N, 3) with the normals of the vertices.
+        :param hop_samples:
+            Number of multi-hop neighbours that are cached per vertex for every walking depth.
+        :param random_state:
+            A numpy RandomState used for the random walks, by default the global numpy generator.
+        """
+
+        # Number of vertices
+        self.number_vertices = number_vertices
+
+        # Vertex data
+        self.locations = numpy.asarray(locations, dtype=numpy.float64)
+        self.normals = numpy.asarray(normals, dtype=numpy.float64)
+
+        # Triangles, indexed by the BVH face index
+        self.faces = numpy.asarray(faces, dtype=numpy.int64).reshape((-1, 3))
+
+        # Number of cached neighbours per vertex and depth
+        self.hop_samples = max(1, int(hop_samples))
+
+        # Cached multi-hop neighbour tables, keyed by the walking depth
+        self.hop_tables = dict()
+
+        # The random generator of the walks
+        self.random_state = random_state if random_state is not None else numpy.random
+
+        # Build the CSR adjacency
+        self.indptr, self.indices = self.build_csr_adjacency(number_vertices, edges)
+
+        # The degree of every vertex
+        self.degrees = numpy.diff(self.indptr)
+
+    ################################################################################################
+    # @build_csr_adjacency
+    ################################################################################################
+    @staticmethod
+    def build_csr_adjacency(number_vertices,
+                            edges):
+        """Builds the symmetric one-ring adjacency of the mesh in a CSR layout.
+
+        :param number_vertices:
+            Number of vertices in the mesh.
+        :param edges:
+            A numpy array of shape (E, 2) with the vertex indices of every edge.
+        :return:
+            A tuple (indptr, indices), where the neighbours of the vertex i are
+            indices[indptr[i]:indptr[i + 1]].
+        """
+
+        # Make sure that we have a valid array even for empty meshes
+        edges = numpy.asarray(edges, dtype=numpy.int64).reshape((-1, 2))
+
+        # Each edge is added in both directions
+        rows = numpy.concatenate((edges[:, 0], edges[:, 1]))
+        cols = numpy.concatenate((edges[:, 1], edges[:, 0]))
+
+        # Sort the entries by row to group the neighbours of every vertex together
+        order = numpy.argsort(rows, kind='stable')
+
+        # Compute the row pointers from the degrees
+        indptr = numpy.zeros((number_vertices + 1,), dtype=numpy.int64)
+        numpy.cumsum(numpy.bincount(rows, minlength=number_vertices), out=indptr[1:])
+
+        # Return the CSR arrays
+        return indptr, cols[order]
+
+    ################################################################################################
+    # @average_curvature
+    ################################################################################################
+    def average_curvature(self):
+        """Computes the average curvature of all the vertices at once, equivalent to
+        nmv.physics.average_curvature applied on every vertex.
+
+        :return:
+            A numpy array of shape (N,) with the average curvature of every vertex.
+        """
+
+        # Row index of every entry in the CSR layout
+        rows = numpy.repeat(numpy.arange(self.number_vertices), self.degrees)
+
+        # Absolute dot product between the normals of the vertex and its neighbours
+        dots = numpy.abs((self.normals[rows] * self.normals[self.indices]).sum(axis=1))
+
+        # Average per vertex, the isolated vertices get a zero curvature
+        sums = numpy.bincount(rows, weights=dots, minlength=self.number_vertices)
+        return sums / numpy.maximum(self.degrees, 1)
+
+    ################################################################################################
+    # @random_walk
+    ################################################################################################
+    def random_walk(self,
+                    depth=0,
+                    starts=None):
+        """Walks (depth + 1) random edges starting from the given vertices.
+
+        :param depth:
+            Number of additional hops after the first one.
+        :param starts:
+            A numpy array of starting vertex indices. If None, every vertex is used once.
+        :return:
+            A numpy array of the same shape as starts with the vertices reached by the walks.
+        """
+
+        # By default, start from every vertex
+        if starts is None:
+            starts = numpy.arange(self.number_vertices)
+
+        # Current position of each walk
+        current = numpy.array(starts, dtype=numpy.int64)
+
+        for _ in range(depth + 1):
+
+            # The degree of the current vertices, the isolated vertices stay in place
+            degrees = self.degrees[current]
+            movable = degrees > 0
+
+            # Pick a random outgoing edge for every walk
+            offsets = self.random_state.randint(0, numpy.iinfo(numpy.int32).max, current.shape)
+            offsets = offsets % numpy.maximum(degrees, 1)
+
+            # Advance
+            current = numpy.where(
+                movable, self.indices[self.indptr[current] + offsets * movable], current)
+
+        # Return the end points of the walks
+        return current
+
+    ################################################################################################
+    # @get_hop_table
+    ################################################################################################
+    def get_hop_table(self,
+                      depth=0):
+        """Returns the cached table of multi-hop neighbours for a given depth, and builds it once
+        if it does not exist.
+
+        :param depth:
+            The walking depth.
+        :return:
+            A numpy array of shape (N, hop_samples) with the neighbours of every vertex.
+        """
+
+        # Build the table only once
+        if depth not in self.hop_tables:
+            starts = numpy.repeat(numpy.arange(self.number_vertices), self.hop_samples)
+            table = self.random_walk(depth, starts)
+            self.hop_tables[depth] = table.reshape((self.number_vertices, self.hop_samples))
+
+        # Return the cached table
+        return self.hop_tables[depth]
+
+    ################################################################################################
+    # @symmetry_candidates
+    ################################################################################################
+    @staticmethod
+    def symmetry_candidates(vectors,
+                            normals,
+                            hex_mode=False):
+        """Returns all the symmetric representatives of a batch of field vectors.
+
+        :param vectors:
+            A numpy array of shape (..., 3) of field vectors.
+        :param normals:
+            A numpy array of the same shape with the normals at the vectors.
+        :param hex_mode:
+            If True, use the six-fold symmetry, otherwise the four-fold one.
+        :return:
+            A numpy array of shape (S, ..., 3), where S is either 4 or 6.
+        """
+
+        # The orthogonal tangent
+        y = numpy.cross(vectors, normals)
+
+        # Six-fold symmetry
+        if hex_mode:
+            e = vectors * 0.5 + y * 0.866025
+            f = vectors * -0.5 + y * 0.866025
+            return numpy.stack((vectors, e, f, -vectors, -e, -f), axis=0)
+
+        # Four-fold symmetry
+        return numpy.stack((vectors, y, -vectors, -y), axis=0)
+
+    ################################################################################################
+    # @best_matching_vectors
+    ################################################################################################
+    @staticmethod
+    def best_matching_vectors(candidates,
+                              references):
+        """Vectorized version of nmv.physics.best_matching_vector.
+
+        :param candidates:
+            A numpy array of shape (S, ..., 3) of candidate vectors.
+        :param references:
+            A numpy array of shape (..., 3) of reference vectors, broadcast against the candidates.
+        :return:
+            A numpy array of shape (..., 3) with the best matching candidate for every reference.
+        """
+
+        # Score every candidate against its reference
+        scores = (candidates * references[numpy.newaxis]).sum(axis=-1)
+
+        # Select the best candidate
+        best = numpy.argmax(scores, axis=0)[numpy.newaxis, ..., numpy.newaxis]
+        return numpy.take_along_axis(candidates, best, axis=0)[0]
+
+    ################################################################################################
+    # @smooth
+    ################################################################################################
+    def smooth(self,
+               field,
+               weights,
+               iterations=100,
+               depth=3,
+               hex_mode=False):
+        """Smooths the cross field with the cached multi-hop neighbours.
+
+        Each iteration aligns the cached neighbours of every vertex to its current direction and
+        blends them in with a gather and a reduction over the neighbour table.
+
+        :param field:
+            A numpy array of shape (N, 3) with the current field.
+        :param weights:
+            A numpy array of shape (N,) with the per-vertex weights of the neighbour contribution.
+        :param iterations:
+            Number of smoothing iterations.
+        :param depth:
+            Walking depth of the neighbours.
+        :param hex_mode:
+            Use the six-fold symmetry if True.
+        :return:
+            The smoothed and normalized field.
+        """
+
+        # Nothing to smooth
+        if self.number_vertices == 0:
+            return field
+
+        # Cached neighbours and their normals
+        table = self.get_hop_table(depth)
+        table_normals = self.normals[table]
+
+        # Weights of the neighbours
+        w = weights[:, numpy.newaxis]
+
+        for _ in range(iterations):
+
+            # Align the symmetric representatives of the neighbours to the current field
+            candidates = self.symmetry_candidates(field[table], table_normals, hex_mode)
+            aligned = self.best_matching_vectors(candidates, field[:, numpy.newaxis, :])
+
+            # Blend
+            field = (field + aligned.mean(axis=1) * w) / (w + 1)
+
+            # Project on the tangent plane
+            field = field - self.normals * (field * self.normals).sum(axis=1)[:, numpy.newaxis]
+            field[numpy.isnan(field)] = 0
+
+        # Normalize
+        magnitudes = numpy.sqrt((field ** 2).sum(axis=1))
+        magnitudes[magnitudes == 0] = 1.0
+        return field / magnitudes[:, numpy.newaxis]
+
+    ################################################################################################
+    # @barycentric_weights
+    ################################################################################################
+    def barycentric_weights(self,
+                            points,
+                            face_indices):
+        """Computes the barycentric coordinates of a batch of points in their faces.
+
+        :param points:
+            A numpy array of shape (P, 3).
+        :param face_indices:
+            A numpy array of shape (P,) of the faces that contain the points.
+        :return:
+            A numpy array of shape (P, 3) of barycentric coordinates.
+        """
+
+        # The vertices of the triangles
+        triangles = self.locations[self.faces[face_indices]]
+        a = triangles[:, 0]
+
+        # Edges
+        v0 = triangles[:, 1] - a
+        v1 = triangles[:, 2] - a
+        v2 = points - a
+
+        # Dot products
+        d00 = (v0 * v0).sum(axis=1)
+        d01 = (v0 * v1).sum(axis=1)
+        d11 = (v1 * v1).sum(axis=1)
+        d20 = (v2 * v0).sum(axis=1)
+        d21 = (v2 * v1).sum(axis=1)
+
+        # Avoid division by zero for degenerate triangles
+        denominator = d00 * d11 - d01 * d01
+        degenerate = numpy.abs(denominator) < 1e-20
+        denominator[degenerate] = 1.0
+
+        v = (d11 * d20 - d01 * d21) / denominator
+        w = (d00 * d21 - d01 * d20) / denominator
+        u = 1.0 - v - w
+
+        # Degenerate triangles take their first vertex
+        weights = numpy.stack((u, v, w), axis=1)
+        weights[degenerate] = (1.0, 0.0, 0.0)
+        return weights
+
+    ################################################################################################
+    # @sample_points
+    ################################################################################################
+    def sample_points(self,
+                      bvh,
+                      points,
+                      field,
+                      scale,
+                      curvature,
+                      reference_directions=None,
+                      hex_mode=False):
+        """Samples the field for a batch of points.
+
+        :param bvh:
+            The BVH of the field mesh.
+        :param points:
+            A sequence of P points.
+        :param field:
+            The current field, a numpy array of shape (N, 3).
+        :param scale:
+            The per-vertex scale, a numpy array of shape (N,).
+        :param curvature:
+            The per-vertex curvature, a numpy array of shape (N,).
+        :param reference_directions:
+            An optional sequence of P reference directions. If None, the field at the first vertex
+            of the nearest face is used.
+        :param hex_mode:
+            Use the six-fold symmetry if True.
+        :return:
+            A tuple of numpy arrays (valid, locations, normals, directions, scales, curvatures).
+            The entries of the points that could not be projected on the mesh are invalid.
+        """
+
+        number_points = len(points)
+        valid = numpy.zeros((number_points,), dtype=bool)
+        locations = numpy.zeros((number_points, 3), dtype=numpy.float64)
+        normals = numpy.zeros((number_points, 3), dtype=numpy.float64)
+        face_indices = numpy.zeros((number_points,), dtype=numpy.int64)
+
+        # The BVH query is the only per-point step
+        for i, point in enumerate(points):
+            location, normal, index, _ = bvh.find_nearest(point)
+            if location is not None:
+                valid[i] = True
+                locations[i] = location
+                normals[i] = normal
+                face_indices[i] = index
+
+        # Nothing more to do
+        directions = numpy.zeros((number_points, 3), dtype=numpy.float64)
+        scales = numpy.zeros((number_points,), dtype=numpy.float64)
+        curvatures = numpy.zeros((number_points,), dtype=numpy.float64)
+        if not valid.any():
+            return valid, locations, normals, directions, scales, curvatures
+
+        # Only process the valid points from now on
+        faces = self.faces[face_indices[valid]]
+        face_locations = locations[valid]
+        face_normals = normals[valid]
+
+        # Reference directions
+        if reference_directions is None:
+            references = field[faces[:, 0]]
+        else:
+            references = numpy.asarray(reference_directions, dtype=numpy.float64)[valid]
+
+        # Align the field at the three corners of every face to the references
+        corner_fields = field[faces]
+        corner_normals = self.normals[faces]
+        candidates = self.symmetry_candidates(corner_fields, corner_normals, hex_mode)
+        aligned = self.best_matching_vectors(
+            candidates, numpy.repeat(references[:, numpy.newaxis, :], 3, axis=1))
+
+        # Interpolate
+        weights = self.barycentric_weights(face_locations, face_indices[valid])
+        sampled = (aligned * weights[:, :, numpy.newaxis]).sum(axis=1)
+
+        # Project on the tangent plane of the face and normalize
+        sampled -= face_normals * (sampled * face_normals).sum(axis=1)[:, numpy.newaxis]
+        magnitudes = numpy.sqrt((sampled ** 2).sum(axis=1))
+        magnitudes[magnitudes == 0] = 1.0
+        directions[valid] = sampled / magnitudes[:, numpy.newaxis]
+
+        # Interpolate the scale and curvature
+        scales[valid] = (scale[faces] * weights).sum(axis=1)
+        curvatures[valid] = (curvature[faces] * weights).sum(axis=1)
+
+        # Return the samples
+        return valid, locations, normals, directions, scales, curvatures
@@ -20,14 +20,109 @@
 ####################################################################################################
 
 # System
+import time
 import numpy
 import math
 
 # Blender
 import bpy
 import bmesh
+from mathutils.kdtree import KDTree
 
 import nmv.physics
+import nmv.utilities
+
+
+####################################################################################################
+# ParticleRemeshingStatistics
+####################################################################################################
+class ParticleRemeshingStatistics:
+    """Timing and quality statistics that are collected by the batch mode of the ParticleRemesher.
+    """
+
+    ################################################################################################
+    # @__init__
+    ################################################################################################
+    def __init__(self):
+        """Constructor
+        """
+
+        # A list of (phase, duration) tuples in the order of their execution
+        self.phase_timings = list()
+
+        # Total wall-clock time of the remeshing in seconds
+        self.total_time = 0.0
+
+        # Number of particles after the propagation
+        self.number_particles = 0
+
+        # Number of field smoothing steps that were executed
+        self.field_smoothing_steps = 0
+
+        # Number of repulsion iterations that were executed
+        self.repulsion_iterations = 0
+
+        # Mean particle displacement in the last repulsion iteration, relative to the particle size
+        self.particle_displacement = 0.0
+
+        # Coefficient of variation of the distances between neighbouring particles
+        self.particle_spacing_variation = 0.0
+
+        # True if the repulsion converged before reaching its iteration limit
+        self.converged = False
+
+        # True if the time budget was exhausted and some refinement phases were skipped
+        self.budget_exhausted = False
+
+        # Number of faces in the resulting mesh
+        self.number_faces = 0
+
+        # Mean edge length of the resulting mesh
+        self.edge_length_mean = 0.0
+
+        # Coefficient of variation of the edge lengths of the resulting mesh
+        self.edge_length_variation = 0.0
+
+    ################################################################################################
+    # @add_phase
+    ################################################################################################
+    def add_phase(self,
+                  phase,
+                  duration):
+        """Records the duration of a phase.
+
+        :param phase:
+            Phase name.
+        :param duration:
+            Duration in seconds.
+        """
+
+        self.phase_timings.append((phase, duration))
+
+    ################################################################################################
+    # @get_report
+    ################################################################################################
+    def get_report(self):
+        """Returns a formatted report of the statistics, compatible with the profiling statistics
+        strings of the builders.
+
+        :return:
+            A report string.
+        """
+
+        report = ''
+        for phase, duration in self.phase_timings:
+            report += '\t* Stats. @remeshing_%s: [%.3f]\n' % (phase, duration)
+        report += '\t* Stats. @remeshing_total: [%.3f]\n' % self.total_time
+        report += '\t* Remeshing Particles: [%d], Repulsion Iterations: [%d], Converged: [%s], ' \
+                  'Budget Exhausted: [%s]\n' % (self.number_particles, self.repulsion_iterations,
+                                                 self.converged, self.budget_exhausted)
+        report += '\t* Remeshing Displacement: [%.4f], Spacing Variation: [%.4f]\n' % \
+                  (self.particle_displacement, self.particle_spacing_variation)
+        report += '\t* Remeshing Faces: [%d], Edge Length Mean: [%.4f], ' \
+                  'Edge Length Variation: [%.4f]\n' % \
+                  (self.number_faces, self.edge_length_mean, self.edge_length_variation)
+        return report
 
 
 ####################################################################################################
@@ -52,7 +147,8 @@ class ParticleRemesher:
                  repulsion_iterations=5,
                  repulsion_strength=0.05,
                  subdivisions=1,
-                 polygon_mode='TRIANGLES'):
+                 polygon_mode='TRIANGLES',
+                 random_seed=None):
 
         self.field_resolution = field_resolution
         self.resolution = resolution
@@ -73,7 +169,21 @@ class ParticleRemesher:
         self.mirror_axes = [False, False, False]
         self.sharp_angle = 20 * (math.pi / 180.0)
 
-    def run(self, mesh_object, context, interactive=False, decimate_input=False):
+        # The random streams of the remesher, seeded from the run seed if given
+        self.random_context = nmv.utilities.RandomContext(random_seed)
+
+    ################################################################################################
+    # @prepare_mesh
+    ################################################################################################
+    @staticmethod
+    def prepare_mesh(mesh_object):
+        """Cleans, fills the holes and triangulates the input mesh.
+
+        :param mesh_object:
+            The input mesh object.
+        :return:
+            A bmesh object of the cleaned mesh.
+        """
 
         # Create a new bmesh from the given mesh object to improve the performance
         nmv.logger.info('Converting to BMesh')
@@ -96,70 +206,95 @@ class ParticleRemesher:
         # Update the mesh data in the system
         bmesh_object.to_mesh(mesh_object.data)
 
-        # Return and keep the state if interactive
-        if interactive:
-            yield
-
-        # Get the dimensions of the mesh
-        nmv.logger.info('Decimating')
-        model_size = max(mesh_object.dimensions)
-
-        # Decimate based in the field resolution
-        if decimate_input:
-            bpy.ops.mesh.decimate(ratio=self.field_resolution / len(bmesh_object.verts))
+        # Return the bmesh object
+        return bmesh_object
 
-        # Return and keep the state if interactive
-        if interactive:
-            yield
+    ################################################################################################
+    # @create_particle_system
+    ################################################################################################
+    def create_particle_system(self,
+                               mesh_object,
+                               model_size):
+        """Creates the surface particle system of the mesh.
+
+        :param mesh_object:
+            The input mesh object.
+        :param model_size:
+            The largest dimension of the mesh.
+        :return:
+            A reference to the particle system.
+        """
 
         nmv.logger.info('Creating a Particle System')
         particle_manager = nmv.physics.SurfaceParticleSystem(
-            mesh_object, model_size, self.resolution, self.mask_resolution)
+            mesh_object, model_size, self.resolution, self.mask_resolution,
+            random_state=self.random_context.get_numpy_random('particle_remesher'))
 
         # Update its parameter
         particle_manager.field_sampling_method = self.field_sampling_method
         particle_manager.triangle_mode = True  # (self.polygon_mode == "TRI")
         particle_manager.field.hex_mode = True  # (self.polygon_mode == "TRI")
 
-        # Draw if interactive
-        '''
-        if interactive:
-            particle_manager.field.draw.setup_handler()
-            particle_manager.draw.setup_handler()
-            particle_manager.field.preview_fast()
-        '''
+        # Return a reference to the particle system
+        return particle_manager
 
-        # Return and keep the state if interactive
-        if interactive:
-            yield
+    ################################################################################################
+    # @apply_grease_pencil
+    ################################################################################################
+    def apply_grease_pencil(self,
+                            particle_manager,
+                            context):
+        """Initializes the field and the particles from the grease pencil strokes, if any.
+
+        :param particle_manager:
+            The particle system.
+        :param context:
+            Blender context.
+        """
 
-        # Pencil
         if self.gp_influence > 0:
             particle_manager.field.initialize_from_grease_pencil(context)
             particle_manager.field.weights /= max(0.00000001, 1 - self.gp_influence)
             particle_manager.field.weights = particle_manager.field.weights.clip(0, 1)
             particle_manager.grease_pencil_gp_spawn_particles(context)
 
-        # Smooth
-        for i in range(3):
-            nmv.logger.info('Creating Cross Field [Step %d]' % i)
-            particle_manager.field.smooth(
-                self.field_smoothing_iterations[i], self.field_smoothing_depth[i])
+    ################################################################################################
+    # @smooth_cross_field
+    ################################################################################################
+    def smooth_cross_field(self,
+                           particle_manager,
+                           step):
+        """Runs a single step of the cross field smoothing.
+
+        :param particle_manager:
+            The particle system.
+        :param step:
+            The index of the smoothing step.
+        """
+
+        nmv.logger.info('Creating Cross Field [Step %d]' % step)
+        particle_manager.field.smooth(
+            self.field_smoothing_iterations[step], self.field_smoothing_depth[step])
+
+        # Axis mirroring
+        for axis in range(3):
+            if self.mirror_axes[axis]:
+                particle_manager.field.mirror(axis)
 
-            # Axis mirroring
-            for axis in range(3):
-                if self.mirror_axes[axis]:
-                    particle_manager.field.mirror(axis)
+    ################################################################################################
+    # @spawn_particles
+    ################################################################################################
+    def spawn_particles(self,
+                        particle_manager,
+                        bmesh_object):
+        """Spawns the initial particles along the sharp edges, singularities or curvature.
 
-            # Return and keep the state if interactive
-            if interactive:
-                yield
+        :param particle_manager:
+            The particle system.
+        :param bmesh_object:
+            The bmesh object of the input mesh.
+        """
 
-        # Update the view
-        '''
-        if interactive:
-            particle_manager.field.preview()
-        '''
         # The sharp angle must be less than 180 to proceed
         if self.sharp_angle < math.pi:
             nmv.logger.info('Spawning Particles')
@@ -175,42 +310,25 @@ class ParticleRemesher:
             nmv.logger.info('Curvature')
             particle_manager.curvature_spawn_particles(5)
 
-        # Propagate the results
-        for i, _ in enumerate(
-                particle_manager.propagate_particles(self.relaxation_steps,
-                                                     self.particle_relaxation)):
-            nmv.logger.detail('Propagating particles [%d]' % i)
-
-            '''
-            if interactive:
-                particle_manager.draw_particles(self.relaxation_steps)
-            '''
-
-            if interactive:
-                yield
-
-        for i, _ in enumerate(
-                particle_manager.repeal_particles(iterations=self.repulsion_iterations,
-                                                  factor=self.repulsion_strength)):
-            # NOTE: We don't need any drawing functions
-            # particle_manager.draw_particles()
-            # DebugText.lines = ["Particle repulsion:",
-            #                   f"Step {i + 1}"]
-            yield
-
-        for i in range(3):
-            if self.mirror_axes[i]:
-                particle_manager.mirror_particles(axis=i)
-
-        '''
-        # Update the drawing
-        if interactive:
-            particle_manager.draw_particles()
-        '''
-
-        # Return and keep the state if interactive
-        if interactive:
-            yield
+    ################################################################################################
+    # @tessellate
+    ################################################################################################
+    def tessellate(self,
+                   particle_manager,
+                   bmesh_object,
+                   mesh_object,
+                   context):
+        """Creates the final mesh from the particles and writes it to the mesh object.
+
+        :param particle_manager:
+            The particle system.
+        :param bmesh_object:
+            The bmesh object of the input mesh.
+        :param mesh_object:
+            The mesh object that will be updated with the result.
+        :param context:
+            Blender context.
+        """
 
         nmv.logger.info('Tessellating')
 
@@ -223,10 +341,6 @@ class ParticleRemesher:
             # Update the mesh
             bmesh_object.to_mesh(mesh_object.data)
 
-            # Return and keep the state if interactive
-            if interactive:
-                yield
-
             # For every subdivision
             for i in range(self.subdivisions):
 
@@ -300,7 +414,316 @@ class ParticleRemesher:
             # Update the mesh
             bmesh_object.to_mesh(mesh_object.data)
 
+    ################################################################################################
+    # @run
+    ################################################################################################
+    def run(self, mesh_object, context, interactive=False, decimate_input=False):
+
+        # Clean and triangulate the input mesh
+        bmesh_object = self.prepare_mesh(mesh_object)
+
+        # Return and keep the state if interactive
+        if interactive:
+            yield
+
+        # Get the dimensions of the mesh
+        nmv.logger.info('Decimating')
+        model_size = max(mesh_object.dimensions)
+
+        # Decimate based in the field resolution
+        if decimate_input:
+            bpy.ops.mesh.decimate(ratio=self.field_resolution / len(bmesh_object.verts))
+
+        # Return and keep the state if interactive
+        if interactive:
+            yield
+
+        # Create the particle system
+        particle_manager = self.create_particle_system(mesh_object, model_size)
+
+        # Draw if interactive
+        '''
+        if interactive:
+            particle_manager.field.draw.setup_handler()
+            particle_manager.draw.setup_handler()
+            particle_manager.field.preview_fast()
+        '''
+
+        # Return and keep the state if interactive
+        if interactive:
+            yield
+
+        # Pencil
+        self.apply_grease_pencil(particle_manager, context)
+
+        # Smooth
+        for i in range(3):
+            self.smooth_cross_field(particle_manager, i)
+
+            # Return and keep the state if interactive
+            if interactive:
+                yield
+
+        # Update the view
+        '''
+        if interactive:
+            particle_manager.field.preview()
+        '''
+        # Spawn the initial particles
+        self.spawn_particles(particle_manager, bmesh_object)
+
+        # Propagate the results
+        for i, _ in enumerate(
+                particle_manager.propagate_particles(self.relaxation_steps,
+                                                     self.particle_relaxation)):
+            nmv.logger.detail('Propagating particles [%d]' % i)
+
+            '''
+            if interactive:
+                particle_manager.draw_particles(self.relaxation_steps)
+            '''
+
+            if interactive:
+                yield
+
+        for i, _ in enumerate(
+                particle_manager.repeal_particles(iterations=self.repulsion_iterations,
+                                                  factor=self.repulsion_strength)):
+            # NOTE: We don't need any drawing functions
+            # particle_manager.draw_particles()
+            # DebugText.lines = ["Particle repulsion:",
+            #                   f"Step {i + 1}"]
+            yield
+
+        for i in range(3):
+            if self.mirror_axes[i]:
+                particle_manager.mirror_particles(axis=i)
+
+        '''
+        # Update the drawing
+        if interactive:
+            particle_manager.draw_particles()
+        '''
+
+        # Return and keep the state if interactive
+        if interactive:
+            yield
+
+        # Create the final mesh
+        self.tessellate(particle_manager, bmesh_object, mesh_object, context)
+
         # Final return
         if interactive:
             yield True
 
+    ################################################################################################
+    # @get_particle_locations
+    ################################################################################################
+    @staticmethod
+    def get_particle_locations(particles):
+        """Returns the locations of a list of particles as a numpy array.
+
+        :param particles:
+            A list of particles.
+        :return:
+            A numpy array of shape (N, 3).
+        """
+
+        return numpy.array([particle.co for particle in particles],
+                           dtype=numpy.float64).reshape((-1, 3))
+
+    ################################################################################################
+    # @compute_spacing_variation
+    ################################################################################################
+    @staticmethod
+    def compute_spacing_variation(locations):
+        """Computes the coefficient of variation of the distances between each particle and its
+        nearest neighbour.
+
+        :param locations:
+            A numpy array of the particle locations.
+        :return:
+            The coefficient of variation, or zero if there are less than two particles.
+        """
+
+        if len(locations) < 2:
+            return 0.0
+
+        # Build a KD-tree of the particles
+        tree = KDTree(len(locations))
+        for index, location in enumerate(locations):
+            tree.insert(location, index)
+        tree.balance()
+
+        # The first hit is the particle itself, the second is its nearest neighbour
+        distances = numpy.array([tree.find_n(location, 2)[-1][2] for location in locations])
+
+        mean = distances.mean()
+        return float(distances.std() / mean) if mean > 0 else 0.0
+
+    ################################################################################################
+    # @compute_mesh_quality
+    ################################################################################################
+    @staticmethod
+    def compute_mesh_quality(mesh_object,
+                             statistics):
+        """Computes the edge length statistics of the resulting mesh.
+
+        :param mesh_object:
+            The resulting mesh object.
+        :param statistics:
+            The statistics object that will be updated.
+        """
+
+        mesh = mesh_object.data
+        statistics.number_faces = len(mesh.polygons)
+        if len(mesh.edges) == 0:
+            return
+
+        # Get the vertices and the edges at once
+        locations = numpy.zeros(len(mesh.vertices) * 3, dtype=numpy.float32)
+        mesh.vertices.foreach_get('co', locations)
+        locations = locations.reshape((-1, 3)).astype(numpy.float64)
+        edges = numpy.zeros(len(mesh.edges) * 2, dtype=numpy.int32)
+        mesh.edges.foreach_get('vertices', edges)
+        edges = edges.reshape((-1, 2))
+
+        # Edge lengths
+        lengths = numpy.linalg.norm(locations[edges[:, 0]] - locations[edges[:, 1]], axis=1)
+        statistics.edge_length_mean = float(lengths.mean())
+        if statistics.edge_length_mean > 0:
+            statistics.edge_length_variation = float(lengths.std() / statistics.edge_length_mean)
+
+    ################################################################################################
+    # @run_batch
+    ################################################################################################
+    def run_batch(self,
+                  mesh_object,
+                  context,
+                  time_budget=None,
+                  max_repulsion_iterations=None,
+                  displacement_tolerance=0.01,
+                  spacing_variation_tolerance=0.005,
+                  decimate_input=False):
+        """Runs the remeshing to the end in a single call without yielding to the caller.
+
+        The cleaning, the first field smoothing step, the particle spawning and propagation and
+        the tessellation are always executed to guarantee a valid mesh. The remaining field
+        smoothing steps and the repulsion iterations are refinements that are only executed while
+        the time budget allows. The repulsion stops as soon as the mean particle displacement
+        drops below the displacement tolerance and the spacing between the particles does not
+        vary anymore.
+
+        :param mesh_object:
+            The input mesh object that will be remeshed in place.
+        :param context:
+            Blender context.
+        :param time_budget:
+            Wall-clock budget in seconds. If None or zero, the time is not limited.
+        :param max_repulsion_iterations:
+            Maximum number of repulsion iterations. If None, the repulsion_iterations of the
+            remesher is used.
+        :param displacement_tolerance:
+            Mean particle displacement per repulsion iteration, relative to the particle size,
+            below which the particles are considered to be converged.
+        :param spacing_variation_tolerance:
+            Change in the coefficient of variation of the particle spacing between two repulsion
+            iterations, below which the particles are considered to be converged.
+        :param decimate_input:
+            Decimate the input mesh based on the field resolution.
+        :return:
+            A ParticleRemeshingStatistics object with the timing and quality statistics.
+        """
+
+        statistics = ParticleRemeshingStatistics()
+        starting_time = time.time()
+
+        def budget_exhausted():
+            return time_budget is not None and 0 < time_budget < time.time() - starting_time
+
+        # Clean and triangulate the input mesh
+        phase_time = time.time()
+        bmesh_object = self.prepare_mesh(mesh_object)
+        model_size = max(mesh_object.dimensions)
+        if decimate_input:
+            bpy.ops.mesh.decimate(ratio=self.field_resolution / len(bmesh_object.verts))
+        statistics.add_phase('preparation', time.time() - phase_time)
+
+        # Create the particle system and its field
+        phase_time = time.time()
+        particle_manager = self.create_particle_system(mesh_object, model_size)
+        self.apply_grease_pencil(particle_manager, context)
+        statistics.add_phase('field_creation', time.time() - phase_time)
+
+        # The first smoothing step is mandatory, the others are refinements
+        phase_time = time.time()
+        for i in range(len(self.field_smoothing_iterations)):
+            if i > 0 and budget_exhausted():
+                statistics.budget_exhausted = True
+                break
+            self.smooth_cross_field(particle_manager, i)
+            statistics.field_smoothing_steps += 1
+        statistics.add_phase('field_smoothing', time.time() - phase_time)
+
+        # Spawn and propagate the particles
+        phase_time = time.time()
+        self.spawn_particles(particle_manager, bmesh_object)
+        for i, _ in enumerate(particle_manager.propagate_particles(self.relaxation_steps,
+                                                                  self.particle_relaxation)):
+            nmv.logger.detail('Propagating particles [%d]' % i)
+        statistics.number_particles = len(particle_manager.particles)
+        statistics.add_phase('propagation', time.time() - phase_time)
+
+        # Repulsion until convergence or until the budget is exhausted
+        phase_time = time.time()
+        if max_repulsion_iterations is None:
+            max_repulsion_iterations = self.repulsion_iterations
+        particles = list(particle_manager.particles)
+        locations = self.get_particle_locations(particles)
+        spacing_variation = self.compute_spacing_variation(locations)
+        if max_repulsion_iterations > 0 and not budget_exhausted():
+            for i in particle_manager.repeal_particles(iterations=max_repulsion_iterations,
+                                                      factor=self.repulsion_strength):
+                statistics.repulsion_iterations = i + 1
+
+                # Convergence metrics
+                new_locations = self.get_particle_locations(particles)
+                displacements = numpy.linalg.norm(new_locations - locations, axis=1)
+                statistics.particle_displacement = \
+                    float(displacements.mean()) / particle_manager.particle_size \
+                    if len(displacements) > 0 else 0.0
+                new_spacing_variation = self.compute_spacing_variation(new_locations)
+                spacing_change = abs(new_spacing_variation - spacing_variation)
+                locations = new_locations
+                spacing_variation = new_spacing_variation
+                nmv.logger.detail('Repulsion [%d]: displacement [%.4f], spacing variation [%.4f]'
+                                  % (i, statistics.particle_displacement, spacing_variation))
+
+                if statistics.particle_displacement < displacement_tolerance and \
+                        spacing_change < spacing_variation_tolerance:
+                    statistics.converged = True
+                    break
+
+                if budget_exhausted():
+                    statistics.budget_exhausted = True
+                    break
+        else:
+            statistics.budget_exhausted = max_repulsion_iterations > 0
+        statistics.particle_spacing_variation = spacing_variation
+
+        for i in range(3):
+            if self.mirror_axes[i]:
+                particle_manager.mirror_particles(axis=i)
+        statistics.add_phase('repulsion', time.time() - phase_time)
+
+        # Create the final mesh
+        phase_time = time.time()
+        self.tessellate(particle_manager, bmesh_object, mesh_object, context)
+        statistics.add_phase('tessellation', time.time() - phase_time)
+
+        # Quality
+        self.compute_mesh_quality(mesh_object, statistics)
+        statistics.total_time = time.time() - starting_time
+
+        # Return the statistics
+        return statistics
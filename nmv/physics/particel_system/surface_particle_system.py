@@ -45,11 +45,13 @@ class SurfaceParticleSystem:
                  mesh_object,
                  model_size=1,
                  resolution=60,
-                 mask_resolution=100):
+                 mask_resolution=100,
+                 random_state=None):
 
         self.triangle_mode = False
         self.particles = set()
-        self.field = nmv.physics.Field(mesh_object)
+        self.random_state = random_state if random_state is not None else numpy.random
+        self.field = nmv.physics.Field(mesh_object, random_state=random_state)
 
         # Drawing system
         self.ignore_drawing = True
@@ -142,13 +144,14 @@ class SurfaceParticleSystem:
 
         n = 10
         while True:
-            subdivide = []
-            for edge in new_bm.edges:
-                center = (edge.verts[0].co + edge.verts[1].co) / 2
-                location, normal, dir, s, c = self.field.sample_point(center)
-                size = nmv.physics.lerp(s, self.particle_size, self.particle_size_mask)
-                if edge.calc_length() > size * 0.1:
-                    subdivide.append(edge)
+            edges = list(new_bm.edges)
+
+            # Sample the field at the centers of all the edges at once
+            centers = [(edge.verts[0].co + edge.verts[1].co) / 2 for edge in edges]
+            _, _, _, _, scales, _ = self.field.sample_points(centers)
+            sizes = nmv.physics.lerp(scales, self.particle_size, self.particle_size_mask)
+            subdivide = [edge for edge, size in zip(edges, sizes)
+                         if edge.calc_length() > size * 0.1]
             if not subdivide or n <= 0:
                 break
             n -= 1
@@ -158,13 +161,16 @@ class SurfaceParticleSystem:
             if vert.calc_edge_angle(0) > sharp_angle or len(vert.link_edges) > 2:
                 sharp_particle_from_vert(vert)
 
-        dir = Vector(numpy.random.sample((3,))).normalized()
+        dir = Vector(self.random_state.random_sample((3,))).normalized()
 
-        for vert in sorted(new_bm.verts, key=lambda v: v.co.dot(dir)):
-            location, normal, dir, s, c = self.field.sample_point(vert.co)
-            size = nmv.physics.lerp(s, self.particle_size, self.particle_size_mask)
+        # Sample the field at all the sorted vertices at once
+        sorted_verts = sorted(new_bm.verts, key=lambda v: v.co.dot(dir))
+        _, locations, _, _, scales, _ = self.field.sample_points([v.co for v in sorted_verts])
+        sizes = nmv.physics.lerp(scales, self.particle_size, self.particle_size_mask)
+
+        for vert, location, size in zip(sorted_verts, locations, sizes):
             valid = True
-            for neighbor in self.grid.test_sphere(location, radius=size):
+            for neighbor in self.grid.test_sphere(Vector(location), radius=size):
                 valid = False
                 break
 
@@ -274,6 +280,23 @@ class SurfaceParticleSystem:
     # @repeal_particles
     ################################################################################################
     def repeal_particles(self, iterations=20, factor=0.01):
+        """Repels the particles from their nearest neighbours to even out their distribution.
+
+        The particles of an iteration are all moved from the positions of the previous iteration
+        and projected back to the surface with a single batched sampling of the field, i.e. a
+        Jacobi update instead of moving every particle after its predecessors. The result does not
+        depend on the order of the particles, and since a particle moves by only @factor of its
+        radius per iteration, it differs little from the sequential update.
+
+        The SHARP and GREASE particles are not moved, but they are kept in the neighbours tree of
+        every iteration, so they keep repelling the other particles after the first one.
+
+        :param iterations:
+            The number of the iterations.
+        :param factor:
+            The step of a particle in an iteration, relative to its radius.
+        """
+
         particles = list(self.particles)
         tree = KDTree(len(particles))
         for index, particle in enumerate(particles):
@@ -282,8 +305,14 @@ class SurfaceParticleSystem:
 
         for i in range(iterations):
             new_tree = KDTree(len(self.particles))
+
+            # The particles that will be moved in this iteration and their target locations
+            moving_indices = list()
+            targets = list()
+
             for index, particle in enumerate(particles):
                 if particle.tag in {"SHARP", "GREASE"}:
+                    new_tree.insert(particle.co, index)
                     continue
 
                 d = Vector()
@@ -307,12 +336,19 @@ class SurfaceParticleSystem:
                             d -= vec * 0.3 / (dist ** 3)
 
                 d.normalize()
-                location, normal, dir, s, c = self.field.sample_point(particle.co + (d * factor * particle.radius))
-                if location:
-                    particle.co = location
-                    particle.normal = normal
+                moving_indices.append(index)
+                targets.append(particle.co + (d * factor * particle.radius))
+
+            # Sample the field for all the moved particles at once
+            valid, locations, normals, directions, _, _ = self.field.sample_points(targets)
+
+            for j, index in enumerate(moving_indices):
+                particle = particles[index]
+                if valid[j]:
+                    particle.co = Vector(locations[j])
+                    particle.normal = Vector(normals[j])
                     self.grid.update(particle)
-                    particle.dir = dir
+                    particle.dir = Vector(directions[j])
 
                 new_tree.insert(particle.co, index)
             new_tree.balance()
@@ -575,7 +611,7 @@ class SurfaceParticleSystem:
 
         # TODO: What is this?
         for i in range(30):
-            cols = numpy.random.randint(0, edges_limit) % edges_count
+            cols = self.random_state.randint(0, edges_limit) % edges_count
             edge_indexes = edges[ids, cols]
             edge_mappings = particles_mapping[edge_indexes]
             distance = ((particles[particles_mapping] - locations) ** 2).sum(axis=1) * weights[particles_mapping]
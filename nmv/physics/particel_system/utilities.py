@@ -31,15 +31,18 @@ from mathutils import Vector, Matrix, Color
 ####################################################################################################
 # @random_tangent_vector
 ####################################################################################################
-def random_tangent_vector(normal):
+def random_tangent_vector(normal,
+                          random_state=numpy.random):
     """Returns a random tangent vector of a given normal vector.
 
     :param normal:
         A given normal.
+    :param random_state:
+        A numpy random generator, by default the global numpy generator.
     :return:
         Random tangent vector.
     """
-    return normal.cross(numpy.random.sample(3) - 0.5).normalized()
+    return normal.cross(random_state.random_sample(3) - 0.5).normalized()
 
 
 ####################################################################################################
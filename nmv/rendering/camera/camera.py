@@ -26,6 +26,7 @@ from mathutils import Vector
 import nmv.bbox
 import nmv.consts
 import nmv.enums
+import nmv.rendering
 import nmv.scene
 import nmv.utilities
 
@@ -165,15 +166,10 @@ class Camera:
         else:
             image_extension = 'png'
 
-        # Set the image file name
-        bpy.data.scenes['Scene'].render.filepath = '%s.%s' % (image_name, image_extension)
-
         nmv.scene.set_transparent_background()
 
-        # Render the image and ignore Blender verbosity
-        nmv.utilities.disable_std_output()
-        bpy.ops.render.render(write_still=True)
-        nmv.utilities.enable_std_output()
+        # Render the image with the active rendering profile
+        nmv.rendering.render_still_with_profile('%s.%s' % (image_name, image_extension))
 
     ################################################################################################
     # @get_camera_positions
@@ -470,6 +466,69 @@ class Camera:
             # Rotate the camera
             self.rotate_camera_for_front_view()
 
+    ################################################################################################
+    # @update_camera_view
+    ################################################################################################
+    def update_camera_view(self,
+                           bounding_box,
+                           camera_view=nmv.enums.Camera.View.FRONT):
+        """Moves and rotates the existing camera to a given view, without creating a new camera.
+        This allows rendering multiple views of the same scene with a single camera.
+
+        :param bounding_box:
+            The bounding box of all the objects that should be rendered.
+        :param camera_view:
+            The view of the camera: TOP, FRONT, or SIDE, by default FRONT.
+        """
+
+        # Compute the location of the camera based on the bounding box
+        camera_locations = self.get_camera_positions(bounding_box=bounding_box)
+
+        # Side view, along the x-axis
+        if camera_view == nmv.enums.Camera.View.SIDE:
+            self.camera.location = camera_locations[0]
+            self.rotate_camera_for_side_view()
+
+        # Top view, along the y-axis
+        elif camera_view == nmv.enums.Camera.View.TOP:
+            self.camera.location = camera_locations[1]
+            self.rotate_camera_for_top_view()
+
+        # Front view (or for 360), along the z-axis
+        else:
+            self.camera.location = camera_locations[2]
+            self.rotate_camera_for_front_view()
+
+    ################################################################################################
+    # @orbit_camera
+    ################################################################################################
+    def orbit_camera(self,
+                     bounding_box,
+                     angle):
+        """Orbits the existing camera around the Y-axis of a given bounding box, looking at its
+        center. The angle 0 is the FRONT view and 90 is the SIDE view. Unlike rotating the objects,
+        the scene itself is not modified.
+
+        :param bounding_box:
+            The bounding box of all the objects that should be rendered.
+        :param angle:
+            The angle of the camera around the Y-axis in degrees.
+        """
+
+        # Place the camera outside the bounding box along the XZ plane
+        center = bounding_box.center
+        distance = math.sqrt(bounding_box.bounds[0] * bounding_box.bounds[0] +
+                             bounding_box.bounds[2] * bounding_box.bounds[2])
+        radians = math.radians(angle)
+        self.camera.location = Vector((center[0] + distance * math.sin(radians),
+                                       center[1],
+                                       center[2] + distance * math.cos(radians)))
+
+        # Look at the center
+        self.camera.rotation_euler[0] = 0.0
+        self.camera.rotation_euler[1] = radians
+        self.camera.rotation_euler[2] = 0.0
+
     ################################################################################################
     # @render_scene
     ################################################################################################
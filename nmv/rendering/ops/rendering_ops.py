@@ -23,6 +23,7 @@ from mathutils import Vector
 import nmv.bbox
 import nmv.scene
 import nmv.camera
+import nmv.rendering
 
 
 ####################################################################################################
@@ -92,11 +93,8 @@ def render_scene_at_resolution(file_name='image',
     # Activate the selected camera for rendering
     nmv.camera.ops.set_active_camera(camera_object)
 
-    # Set the image file name
-    bpy.data.scenes['Scene'].render.filepath = '%s.png' % file_name
-
-    # Render the image
-    bpy.ops.render.render(write_still=True)
+    # Render the image with the active rendering profile
+    nmv.rendering.render_still_with_profile('%s.png' % file_name)
 
 
 ####################################################################################################
@@ -166,11 +164,8 @@ def render_scene_to_scale(file_name='image',
     # Activate the selected camera for rendering
     nmv.camera.ops.set_active_camera(camera_object)
 
-    # Set the image file name
-    bpy.data.scenes['Scene'].render.filepath = '%s.png' % file_name
-
-    # Render the image
-    bpy.ops.render.render(write_still=True)
+    # Render the image with the active rendering profile
+    nmv.rendering.render_still_with_profile('%s.png' % file_name)
 
 
 
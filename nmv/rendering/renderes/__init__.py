@@ -15,7 +15,11 @@
 # If not, see <http://www.gnu.org/licenses/>.
 ####################################################################################################
 
+from .render_profile import *
 from .renderer import *
 from .soma_renderer import *
 from .skeleton_renderer import *
 from .mesh_renderer import *
+from .multi_view_renderer import *
+from .tiled_renderer import *
+from .qa_renderer import *
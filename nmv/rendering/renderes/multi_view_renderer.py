@@ -0,0 +1,235 @@
+####################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+# System imports
+import time
+
+# Blender imports
+import bpy
+
+# Internal imports
+import nmv.bbox
+import nmv.consts
+import nmv.enums
+import nmv.rendering
+import nmv.scene
+
+
+####################################################################################################
+# @MultiViewRenderer
+####################################################################################################
+class MultiViewRenderer:
+    """Renders multiple views of the same scene in a single session.
+
+    The bounding box is given once, a single camera is created and moved between the views, and
+    the persistent data of Cycles is enabled during the session, so the scene is not re-synced and
+    its BVH is not rebuilt for every view. The FRONT, SIDE and TOP views and any custom angles
+    around the Y-axis are rendered with the same camera.
+    """
+
+    ################################################################################################
+    # @__init__
+    ################################################################################################
+    def __init__(self,
+                 bounding_box,
+                 image_directory=None,
+                 image_format=nmv.enums.Image.Extension.PNG,
+                 image_resolution=nmv.consts.Image.DEFAULT_RESOLUTION,
+                 image_scale_factor=None):
+        """Constructor
+
+        :param bounding_box:
+            The bounding box of the objects that will be rendered, computed once for all the views.
+        :param image_directory:
+            The directory where the images will be rendered. If the directory is set to None,
+            then the prefix is included in the names of the images.
+        :param image_format:
+            The file format of the images, by default .PNG.
+        :param image_resolution:
+            The base resolution of the images, used if the images are not rendered to scale.
+        :param image_scale_factor:
+            If given, the images are rendered to scale with this factor instead of the resolution.
+        """
+
+        # Rendering parameters
+        self.bounding_box = bounding_box
+        self.image_directory = image_directory
+        self.image_format = image_format
+        self.image_resolution = image_resolution
+        self.image_scale_factor = image_scale_factor
+
+        # A list of (camera view, image name) pairs
+        self.views = list()
+
+        # A list of (angle, image name) pairs
+        self.angles = list()
+
+        # A list of (image name, rendering time) pairs, filled after the rendering
+        self.timings = list()
+
+    ################################################################################################
+    # @add_view
+    ################################################################################################
+    def add_view(self,
+                 camera_view,
+                 image_name):
+        """Adds a view to the session.
+
+        :param camera_view:
+            The view of the camera: FRONT, SIDE or TOP.
+        :param image_name:
+            The name of the image of this view.
+        """
+
+        self.views.append([camera_view, image_name])
+
+    ################################################################################################
+    # @add_angle
+    ################################################################################################
+    def add_angle(self,
+                  angle,
+                  image_name):
+        """Adds a custom view at a given angle around the Y-axis to the session.
+
+        :param angle:
+            The angle of the camera around the Y-axis in degrees, where 0 is the FRONT view.
+        :param image_name:
+            The name of the image of this view.
+        """
+
+        self.angles.append([angle, image_name])
+
+    ################################################################################################
+    # @get_image_prefix
+    ################################################################################################
+    def get_image_prefix(self,
+                         image_name):
+        """Gets the path prefix of an image, i.e. w/o extension which will be added later.
+
+        :param image_name:
+            The name of the image.
+        :return:
+            The path prefix of the image.
+        """
+
+        if self.image_directory is not None:
+            return '%s/%s' % (self.image_directory, image_name)
+        return image_name
+
+    ################################################################################################
+    # @update_resolution
+    ################################################################################################
+    def update_resolution(self,
+                          camera,
+                          camera_view,
+                          bounding_box):
+        """Updates the resolution of the camera film for a given view.
+
+        :param camera:
+            The camera of the session.
+        :param camera_view:
+            The view of the camera.
+        :param bounding_box:
+            The bounding box of the view.
+        """
+
+        if self.image_scale_factor is None:
+            camera.update_camera_resolution(resolution=self.image_resolution,
+                                            camera_view=camera_view,
+                                            bounds=bounding_box.bounds)
+        else:
+            camera.update_camera_resolution_to_scale(scale_factor=self.image_scale_factor,
+                                                     camera_view=camera_view,
+                                                     bounds=bounding_box.bounds)
+
+    ################################################################################################
+    # @render_image
+    ################################################################################################
+    def render_image(self,
+                     camera,
+                     image_name):
+        """Renders the current view of the camera and records its timing.
+
+        :param camera:
+            The camera of the session.
+        :param image_name:
+            The name of the image.
+        """
+
+        start_time = time.time()
+        camera.render_image(image_name=self.get_image_prefix(image_name),
+                            image_format=self.image_format)
+        rendering_time = time.time() - start_time
+        self.timings.append([image_name, rendering_time])
+        nmv.logger.statistics('View [%s] rendered in [%f] seconds' % (image_name, rendering_time))
+
+    ################################################################################################
+    # @render
+    ################################################################################################
+    def render(self):
+        """Renders all the views and the angles of the session.
+
+        :return:
+            A list of (image name, rendering time) pairs, for every rendered image.
+        """
+
+        # Nothing to render
+        self.timings = list()
+        if len(self.views) == 0 and len(self.angles) == 0:
+            return self.timings
+
+        start_time = time.time()
+
+        # Keep the synced scene and its BVH between the views
+        render_settings = bpy.context.scene.render
+        use_persistent_data = render_settings.use_persistent_data
+        render_settings.use_persistent_data = True
+
+        # A single camera for the session
+        camera = nmv.rendering.Camera('nmvMultiViewCamera')
+        camera.setup_camera_for_scene(self.bounding_box, nmv.enums.Camera.View.FRONT)
+        camera.camera.data.type = 'ORTHO'
+
+        # Deselect all the object in the scene
+        nmv.scene.ops.deselect_all()
+
+        try:
+
+            # The principal views
+            for camera_view, image_name in self.views:
+                camera.update_camera_view(self.bounding_box, camera_view)
+                self.update_resolution(camera, camera_view, self.bounding_box)
+                self.render_image(camera, image_name)
+
+            # The custom angles use a bounding box that fits the morphology from all the angles
+            if len(self.angles) > 0:
+                bounding_box_360 = nmv.bbox.compute_360_bounding_box(
+                    self.bounding_box, self.bounding_box.center)
+                self.update_resolution(camera, nmv.enums.Camera.View.FRONT_360, bounding_box_360)
+                for angle, image_name in self.angles:
+                    camera.orbit_camera(bounding_box_360, angle)
+                    self.render_image(camera, image_name)
+
+        finally:
+
+            # Delete the camera and restore the settings
+            nmv.scene.ops.delete_object_in_scene(camera.camera)
+            render_settings.use_persistent_data = use_persistent_data
+
+        nmv.logger.statistics('[%d] views rendered in [%f] seconds' %
+                              (len(self.timings), time.time() - start_time))
+        return self.timings
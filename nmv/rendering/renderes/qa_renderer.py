@@ -0,0 +1,254 @@
+####################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+# System imports
+import os
+import time
+import numpy
+
+# Blender imports
+import bpy
+
+# Internal imports
+import nmv.consts
+import nmv.enums
+import nmv.rendering
+import nmv.scene
+import nmv.utilities
+
+
+####################################################################################################
+# @render_qa_image
+####################################################################################################
+def render_qa_image(bounding_box,
+                    image_name,
+                    image_directory=None,
+                    resolution=nmv.consts.QualityAssurance.DEFAULT_RESOLUTION):
+    """Renders a quick quality assurance image of the scene.
+
+    The image is rendered with the Workbench in solid shading, where every object is drawn with the
+    color of its material, so the arbors keep their colors when they are built with the flat
+    shader. The image is rendered from the FRONT view at a low resolution, without the rendering
+    profile, and the rendering settings of the scene are restored afterwards. With Blender 2.79,
+    the current engine is used.
+
+    :param bounding_box:
+        The bounding box of the scene.
+    :param image_name:
+        The name of the image.
+    :param image_directory:
+        The directory where the image will be rendered. If the directory is set to None,
+        then the prefix is included in @image_name.
+    :param resolution:
+        The resolution of the largest dimension of the image.
+    :return:
+        The path to the rendered image.
+    """
+
+    # Image path
+    image_path = '%s.png' % ('%s/%s' % (image_directory, image_name)
+                             if image_directory is not None else image_name)
+
+    # Keep the rendering settings of the scene
+    scene = bpy.context.scene
+    engine = scene.render.engine
+    file_format = scene.render.image_settings.file_format
+    resolution_percentage = scene.render.resolution_percentage
+
+    # The camera
+    camera = nmv.rendering.Camera('nmvQACamera')
+    camera.setup_camera_for_scene(bounding_box, nmv.enums.Camera.View.FRONT)
+    camera.update_camera_resolution(resolution=resolution,
+                                    camera_view=nmv.enums.Camera.View.FRONT,
+                                    bounds=bounding_box.bounds)
+    camera.set_active()
+    nmv.scene.ops.deselect_all()
+
+    start_time = time.time()
+    try:
+
+        # Solid shading with the colors of the materials
+        if nmv.utilities.is_blender_280():
+            scene.render.engine = 'BLENDER_WORKBENCH'
+            shading = scene.display.shading
+            light, color_type = shading.light, shading.color_type
+            render_aa = scene.display.render_aa
+            shading.light = 'STUDIO'
+            shading.color_type = 'MATERIAL'
+            scene.display.render_aa = nmv.consts.QualityAssurance.WORKBENCH_AA
+
+        # Render the image
+        scene.render.resolution_percentage = 100
+        scene.render.image_settings.file_format = nmv.enums.Image.Extension.PNG
+        nmv.scene.set_transparent_background()
+        scene.render.filepath = image_path
+        nmv.utilities.disable_std_output()
+        bpy.ops.render.render(write_still=True)
+        nmv.utilities.enable_std_output()
+
+    finally:
+
+        # Restore the settings and delete the camera
+        if nmv.utilities.is_blender_280():
+            shading.light, shading.color_type = light, color_type
+            scene.display.render_aa = render_aa
+        scene.render.engine = engine
+        scene.render.image_settings.file_format = file_format
+        scene.render.resolution_percentage = resolution_percentage
+        nmv.scene.ops.delete_object_in_scene(camera.camera)
+
+    nmv.logger.statistics('QA image [%s] rendered in [%f] seconds' %
+                          (os.path.basename(image_path), time.time() - start_time))
+
+    # Return the path to the image
+    return image_path
+
+
+####################################################################################################
+# @load_image_pixels
+####################################################################################################
+def load_image_pixels(image_path):
+    """Loads an image into an array whose first row is the top of the image.
+
+    :param image_path:
+        The path to the image.
+    :return:
+        An array of shape (rows, columns, 4).
+    """
+
+    image = bpy.data.images.load(image_path, check_existing=False)
+    try:
+        width, height, channels = image.size[0], image.size[1], image.channels
+        pixels = numpy.empty(width * height * channels, dtype=numpy.float32)
+        if hasattr(image.pixels, 'foreach_get'):
+            image.pixels.foreach_get(pixels)
+        else:
+            pixels[:] = image.pixels[:]
+    finally:
+        bpy.data.images.remove(image)
+
+    # Flip the rows and add an opaque alpha channel if it is missing
+    pixels = pixels.reshape((height, width, channels))[::-1]
+    if channels == 4:
+        return pixels
+    rgba = numpy.ones((height, width, 4), dtype=numpy.float32)
+    rgba[:, :, :min(channels, 3)] = pixels[:, :, :3]
+    return rgba
+
+
+####################################################################################################
+# @save_image_pixels
+####################################################################################################
+def save_image_pixels(pixels,
+                      image_path):
+    """Saves an array whose first row is the top of the image to a .PNG image.
+
+    :param pixels:
+        An array of shape (rows, columns, 4).
+    :param image_path:
+        The path to the image.
+    """
+
+    height, width = pixels.shape[0], pixels.shape[1]
+    image = bpy.data.images.new(os.path.basename(image_path), width, height, alpha=True)
+    try:
+        data = numpy.ascontiguousarray(pixels[::-1], dtype=numpy.float32).ravel()
+        if hasattr(image.pixels, 'foreach_set'):
+            image.pixels.foreach_set(data)
+        else:
+            image.pixels[:] = data.tolist()
+        image.filepath_raw = image_path
+        image.file_format = 'PNG'
+        image.save()
+    finally:
+        bpy.data.images.remove(image)
+
+
+####################################################################################################
+# @create_qa_contact_sheets
+####################################################################################################
+def create_qa_contact_sheets(qa_directory,
+                             suffix,
+                             resolution=nmv.consts.QualityAssurance.DEFAULT_RESOLUTION,
+                             columns=nmv.consts.QualityAssurance.CONTACT_SHEET_COLUMNS,
+                             rows=nmv.consts.QualityAssurance.CONTACT_SHEET_ROWS):
+    """Assembles the quality assurance images of a batch into contact sheets.
+
+    Every image is centered in a cell of the sheet and composited over an opaque background. A
+    sheet holds @columns x @rows images, and the next images go to the next sheet, so the memory
+    of a sheet is bounded regardless of the size of the batch. The names of the images in every
+    sheet are listed in a text file next to it, row by row.
+
+    :param qa_directory:
+        The directory where the quality assurance images are rendered.
+    :param suffix:
+        The suffix of the images, for example nmv.consts.Suffix.MORPHOLOGY_QA.
+    :param resolution:
+        The resolution of the quality assurance images, i.e. the size of a cell.
+    :param columns:
+        The number of the columns of a sheet.
+    :param rows:
+        The number of the rows of a sheet.
+    :return:
+        A list of the paths to the contact sheets.
+    """
+
+    # Collect the images of the batch
+    image_files = sorted(f for f in os.listdir(qa_directory) if f.endswith('%s.png' % suffix))
+    if len(image_files) == 0:
+        nmv.logger.log('WARNING: No QA images with the suffix [%s] in [%s]' %
+                       (suffix, qa_directory))
+        return list()
+
+    background = numpy.array(nmv.consts.QualityAssurance.CONTACT_SHEET_BACKGROUND,
+                             dtype=numpy.float32)
+    images_per_sheet = columns * rows
+    sheets = list()
+    for first in range(0, len(image_files), images_per_sheet):
+        sheet_files = image_files[first:first + images_per_sheet]
+        sheet_rows = (len(sheet_files) + columns - 1) // columns
+
+        # An opaque sheet
+        sheet = numpy.ones((sheet_rows * resolution, columns * resolution, 4), dtype=numpy.float32)
+        sheet[:, :, :3] = background
+
+        # Composite every image in its cell
+        for i, image_file in enumerate(sheet_files):
+            pixels = load_image_pixels('%s/%s' % (qa_directory, image_file))
+            height = min(pixels.shape[0], resolution)
+            width = min(pixels.shape[1], resolution)
+            y = (i // columns) * resolution + (resolution - height) // 2
+            x = (i % columns) * resolution + (resolution - width) // 2
+            alpha = pixels[:height, :width, 3:4]
+            sheet[y:y + height, x:x + width, :3] = \
+                pixels[:height, :width, :3] * alpha + background * (1.0 - alpha)
+
+        # Save the sheet and its index
+        sheet_prefix = '%s/%s%s_%04d' % (
+            qa_directory, nmv.consts.QualityAssurance.CONTACT_SHEET_PREFIX, suffix, len(sheets))
+        save_image_pixels(sheet, '%s.png' % sheet_prefix)
+        with open('%s.txt' % sheet_prefix, 'w') as index_file:
+            for i, image_file in enumerate(sheet_files):
+                index_file.write('%d %d %s\n' % (i // columns, i % columns,
+                                                 image_file[:-len('%s.png' % suffix)]))
+        sheets.append('%s.png' % sheet_prefix)
+
+    nmv.logger.log('[%d] QA images assembled in [%d] contact sheets in [%s]' %
+                   (len(image_files), len(sheets), qa_directory))
+
+    # Return the paths to the sheets
+    return sheets
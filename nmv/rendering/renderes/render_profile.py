@@ -0,0 +1,301 @@
+####################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+# System imports
+import math
+import os
+import time
+import numpy
+
+# Blender imports
+import bpy
+
+# Internal imports
+import nmv.consts
+import nmv.enums
+import nmv.utilities
+
+
+####################################################################################################
+# @RenderProfile
+####################################################################################################
+class RenderProfile:
+    """The rendering quality settings of a profile.
+
+    The materials only select the engine that their shaders require, and the profile controls the
+    cost of every image: the samples, the adaptive sampling, the denoiser, the tile size and the
+    number of threads. The profile is applied right before every image is rendered.
+    """
+
+    ################################################################################################
+    # @__init__
+    ################################################################################################
+    def __init__(self,
+                 profile=nmv.enums.Rendering.Profile.PREVIEW,
+                 threads=nmv.consts.RenderProfile.THREADS,
+                 tile_size=nmv.consts.RenderProfile.TILE_SIZE,
+                 estimate_noise=nmv.consts.RenderProfile.ESTIMATE_NOISE):
+        """Constructor
+
+        :param profile:
+            The rendering profile, DRAFT, PREVIEW or FINAL.
+        :param threads:
+            The number of rendering threads, zero to use all the cores.
+        :param tile_size:
+            The size of the render tiles in pixels.
+        :param estimate_noise:
+            Estimate and log the noise of every rendered image, which reads the image back.
+        """
+
+        # The profile
+        self.profile = profile
+
+        # Parameters
+        self.threads = threads
+        self.tile_size = tile_size
+        self.estimate_noise = estimate_noise
+
+        # Draft
+        if profile == nmv.enums.Rendering.Profile.DRAFT:
+            self.name = 'draft'
+            self.samples = nmv.consts.RenderProfile.DRAFT_SAMPLES
+            self.adaptive_threshold = nmv.consts.RenderProfile.DRAFT_ADAPTIVE_THRESHOLD
+            self.adaptive_min_samples = nmv.consts.RenderProfile.DRAFT_ADAPTIVE_MIN_SAMPLES
+            self.use_denoising = nmv.consts.RenderProfile.DRAFT_DENOISING
+            self.workbench_aa = nmv.consts.RenderProfile.DRAFT_WORKBENCH_AA
+            self.eevee_samples = nmv.consts.RenderProfile.DRAFT_EEVEE_SAMPLES
+
+        # Final
+        elif profile == nmv.enums.Rendering.Profile.FINAL:
+            self.name = 'final'
+            self.samples = nmv.consts.RenderProfile.FINAL_SAMPLES
+            self.adaptive_threshold = nmv.consts.RenderProfile.FINAL_ADAPTIVE_THRESHOLD
+            self.adaptive_min_samples = nmv.consts.RenderProfile.FINAL_ADAPTIVE_MIN_SAMPLES
+            self.use_denoising = nmv.consts.RenderProfile.FINAL_DENOISING
+            self.workbench_aa = nmv.consts.RenderProfile.FINAL_WORKBENCH_AA
+            self.eevee_samples = nmv.consts.RenderProfile.FINAL_EEVEE_SAMPLES
+
+        # Preview, by default
+        else:
+            self.name = 'preview'
+            self.samples = nmv.consts.RenderProfile.PREVIEW_SAMPLES
+            self.adaptive_threshold = nmv.consts.RenderProfile.PREVIEW_ADAPTIVE_THRESHOLD
+            self.adaptive_min_samples = nmv.consts.RenderProfile.PREVIEW_ADAPTIVE_MIN_SAMPLES
+            self.use_denoising = nmv.consts.RenderProfile.PREVIEW_DENOISING
+            self.workbench_aa = nmv.consts.RenderProfile.PREVIEW_WORKBENCH_AA
+            self.eevee_samples = nmv.consts.RenderProfile.PREVIEW_EEVEE_SAMPLES
+
+    ################################################################################################
+    # @apply
+    ################################################################################################
+    def apply(self,
+              scene=None):
+        """Applies the profile to the scene, for the engine selected by the materials.
+
+        The settings that are not available in the running version of Blender are skipped, for
+        example the adaptive sampling before 2.83.
+
+        :param scene:
+            The scene, by default the current one.
+        """
+
+        if scene is None:
+            scene = bpy.context.scene
+
+        # Threads
+        if self.threads > 0:
+            scene.render.threads_mode = 'FIXED'
+            scene.render.threads = self.threads
+        else:
+            scene.render.threads_mode = 'AUTO'
+
+        # Cycles
+        if scene.render.engine == 'CYCLES':
+            scene.cycles.samples = self.samples
+
+            # Adaptive sampling
+            set_if_available(scene.cycles, 'use_adaptive_sampling', True)
+            set_if_available(scene.cycles, 'adaptive_threshold', self.adaptive_threshold)
+            set_if_available(scene.cycles, 'adaptive_min_samples', self.adaptive_min_samples)
+
+            # Denoising, in the scene since 2.90 and in the view layer before
+            if hasattr(scene.cycles, 'use_denoising'):
+                scene.cycles.use_denoising = self.use_denoising
+                if self.use_denoising:
+                    set_if_available(scene.cycles, 'denoiser', 'OPENIMAGEDENOISE')
+            elif hasattr(bpy.context, 'view_layer') and \
+                    hasattr(bpy.context.view_layer, 'cycles'):
+                bpy.context.view_layer.cycles.use_denoising = self.use_denoising
+
+            # Tiles, before 3.0, since Cycles X tiles the image automatically
+            set_if_available(scene.render, 'tile_x', self.tile_size)
+            set_if_available(scene.render, 'tile_y', self.tile_size)
+
+        # EEVEE
+        elif scene.render.engine == 'BLENDER_EEVEE':
+            scene.eevee.taa_render_samples = self.eevee_samples
+
+        # Workbench
+        elif scene.render.engine == 'BLENDER_WORKBENCH':
+            scene.display.render_aa = self.workbench_aa
+
+
+# The active profile, applied before every rendered image
+ACTIVE_RENDER_PROFILE = RenderProfile()
+
+
+####################################################################################################
+# @set_if_available
+####################################################################################################
+def set_if_available(owner,
+                     attribute,
+                     value):
+    """Sets an attribute of a Blender structure if the running version of Blender supports it.
+
+    :param owner:
+        The Blender structure.
+    :param attribute:
+        The name of the attribute.
+    :param value:
+        The value of the attribute.
+    """
+
+    if hasattr(owner, attribute):
+        setattr(owner, attribute, value)
+
+
+####################################################################################################
+# @set_render_profile
+####################################################################################################
+def set_render_profile(profile,
+                       threads=nmv.consts.RenderProfile.THREADS,
+                       estimate_noise=nmv.consts.RenderProfile.ESTIMATE_NOISE):
+    """Selects the active rendering profile.
+
+    :param profile:
+        The rendering profile, DRAFT, PREVIEW or FINAL.
+    :param threads:
+        The number of rendering threads, zero to use all the cores.
+    :param estimate_noise:
+        Estimate and log the noise of every rendered image, which reads the image back.
+    """
+
+    global ACTIVE_RENDER_PROFILE
+    ACTIVE_RENDER_PROFILE = RenderProfile(profile=profile, threads=threads,
+                                          estimate_noise=estimate_noise)
+
+
+####################################################################################################
+# @get_render_profile
+####################################################################################################
+def get_render_profile():
+    """Gets the active rendering profile.
+
+    :return:
+        The active RenderProfile.
+    """
+
+    return ACTIVE_RENDER_PROFILE
+
+
+####################################################################################################
+# @estimate_image_noise
+####################################################################################################
+def estimate_image_noise(image_path):
+    """Estimates the standard deviation of the noise of a rendered image.
+
+    The luminance of the image is filtered with a Laplacian difference kernel that cancels smooth
+    regions, and the mean absolute response is converted to a standard deviation (Immerkaer 1996).
+    The edges of the arbors contribute to the estimate, so the value is meant to compare the
+    profiles for the same view, rather than as an absolute measure.
+
+    :param image_path:
+        The path to the rendered image.
+    :return:
+        The estimated standard deviation of the noise in [0, 1], or None if it cannot be computed.
+    """
+
+    if not os.path.exists(image_path):
+        return None
+
+    # Load the image
+    image = bpy.data.images.load(image_path, check_existing=False)
+    try:
+        width, height = image.size[0], image.size[1]
+        if width < 3 or height < 3:
+            return None
+
+        # Get the pixels as an array
+        pixels = numpy.empty(width * height * image.channels, dtype=numpy.float32)
+        if hasattr(image.pixels, 'foreach_get'):
+            image.pixels.foreach_get(pixels)
+        else:
+            pixels[:] = image.pixels[:]
+        pixels = pixels.reshape((height, width, image.channels))
+    finally:
+        bpy.data.images.remove(image)
+
+    # The luminance, weighted by the alpha to ignore the transparent background
+    luminance = 0.2126 * pixels[:, :, 0] + 0.7152 * pixels[:, :, 1] + 0.0722 * pixels[:, :, 2]
+    if pixels.shape[2] == 4:
+        luminance *= pixels[:, :, 3]
+
+    # Convolve with the kernel [[1, -2, 1], [-2, 4, -2], [1, -2, 1]]
+    y = luminance
+    response = (y[:-2, :-2] - 2.0 * y[:-2, 1:-1] + y[:-2, 2:] -
+                2.0 * y[1:-1, :-2] + 4.0 * y[1:-1, 1:-1] - 2.0 * y[1:-1, 2:] +
+                y[2:, :-2] - 2.0 * y[2:, 1:-1] + y[2:, 2:])
+
+    # The standard deviation of the noise
+    return math.sqrt(0.5 * math.pi) * float(numpy.abs(response).sum()) / \
+        (6.0 * (width - 2) * (height - 2))
+
+
+####################################################################################################
+# @render_still_with_profile
+####################################################################################################
+def render_still_with_profile(image_path):
+    """Renders the scene to an image with the active profile and logs the rendering time, and the
+    noise level of the image if the profile estimates it.
+
+    :param image_path:
+        The path to the image, with its extension.
+    """
+
+    # Apply the active profile
+    profile = get_render_profile()
+    profile.apply()
+
+    # Render the image
+    bpy.context.scene.render.filepath = image_path
+    start_time = time.time()
+
+    # Render the image and ignore Blender verbosity
+    nmv.utilities.disable_std_output()
+    bpy.ops.render.render(write_still=True)
+    nmv.utilities.enable_std_output()
+    rendering_time = time.time() - start_time
+
+    # Report, the noise is estimated on demand since it reads the image back from the disk
+    if not profile.estimate_noise:
+        nmv.logger.statistics('Image [%s] rendered with the [%s] profile in [%f] seconds' %
+                              (os.path.basename(image_path), profile.name, rendering_time))
+        return
+    noise = estimate_image_noise(image_path)
+    nmv.logger.statistics('Image [%s] rendered with the [%s] profile in [%f] seconds, noise [%s]' %
+                          (os.path.basename(image_path), profile.name, rendering_time,
+                           'N/A' if noise is None else '%.5f' % noise))
@@ -0,0 +1,570 @@
+####################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+# System imports
+import json
+import os
+import shutil
+import subprocess
+import time
+import numpy
+
+# Blender imports
+import bpy
+
+# Internal imports
+import nmv.consts
+import nmv.enums
+import nmv.file
+import nmv.rendering
+import nmv.scene
+
+
+####################################################################################################
+# @get_tiled_rendering_script
+####################################################################################################
+def get_tiled_rendering_script():
+    """Gets the path to the CLI script that is executed by the tile workers.
+
+    :return:
+        The path to the script.
+    """
+
+    return os.path.realpath('%s/../../interface/cli/tiled_rendering.py' %
+                            os.path.dirname(os.path.realpath(__file__)))
+
+
+####################################################################################################
+# @prepare_tiled_render_to_scale
+####################################################################################################
+def prepare_tiled_render_to_scale(bounding_box,
+                                  camera_view=nmv.enums.Camera.View.FRONT,
+                                  image_scale_factor=nmv.consts.Image.DEFAULT_IMAGE_SCALE_FACTOR,
+                                  image_name='image',
+                                  image_directory=None,
+                                  tile_size=nmv.consts.TiledRendering.DEFAULT_TILE_SIZE,
+                                  use_float=False):
+    """Prepares a tiled rendering job for an image to scale.
+
+    The camera and the film are set up exactly like render_to_scale(), then the scene is saved
+    with the camera to a .BLEND file that is loaded by the workers, and the film is split into a
+    grid of tiles that is written to a manifest. Nothing is rendered in this process.
+
+    :param bounding_box:
+        The bounding box of the view requested to be rendered.
+    :param camera_view:
+        The view of the camera, by default FRONT.
+    :param image_scale_factor:
+        The factor used to scale the resolution of the image.
+    :param image_name:
+        The name of the image.
+    :param image_directory:
+        The directory where the image will be rendered. If the directory is set to None,
+        then the prefix is included in @image_name.
+    :param tile_size:
+        The size of the tiles in pixels, rounded up to a multiple of 16.
+    :param use_float:
+        If True, the image is stitched into a 32-bit float TIFF, otherwise an 8-bit one.
+    :return:
+        The path to the manifest of the job.
+    """
+
+    # Image path prefix, i.e. w/o extension
+    image_prefix = \
+        '%s/%s' % (image_directory, image_name) if image_directory is not None else image_name
+
+    # The working directory of the job
+    tiles_directory = '%s%s' % (image_prefix, nmv.consts.TiledRendering.TILES_DIRECTORY_SUFFIX)
+    nmv.file.ops.clean_and_create_directory(tiles_directory)
+
+    # Set up the camera and the film, keep the camera in the saved scene
+    camera = nmv.rendering.Camera('nmvTiledCamera_%s' % camera_view)
+    camera.setup_camera_for_scene(bounding_box, camera_view)
+    camera.update_camera_resolution_to_scale(
+        scale_factor=image_scale_factor, camera_view=camera_view, bounds=bounding_box.bounds)
+    camera.set_active()
+    nmv.scene.ops.deselect_all()
+    nmv.scene.set_transparent_background()
+    bpy.context.scene.render.resolution_percentage = 100
+
+    # The film
+    width = bpy.context.scene.render.resolution_x
+    height = bpy.context.scene.render.resolution_y
+
+    # The tiles of the tiled TIFF must be multiples of 16
+    tile_size = max(16, ((tile_size + 15) // 16) * 16)
+
+    # The grid of the tiles in row-major order, from the top of the image
+    tiles = list()
+    for y in range(0, height, tile_size):
+        for x in range(0, width, tile_size):
+            tiles.append({'x': x, 'y': y,
+                          'width': min(tile_size, width - x),
+                          'height': min(tile_size, height - y),
+                          'file': '%s/tile_%06d.npy' % (tiles_directory, len(tiles))})
+
+    # Save the scene with the camera for the workers
+    scene_file = '%s/%s' % (tiles_directory, nmv.consts.TiledRendering.SCENE_FILE)
+    bpy.ops.wm.save_as_mainfile(filepath=scene_file, copy=True)
+
+    # Delete the camera from the current scene
+    nmv.scene.ops.delete_object_in_scene(camera.camera)
+
+    # Write the manifest
+    render_profile = nmv.rendering.get_render_profile()
+    manifest = {'scene_file': scene_file,
+                'image_file': '%s.tiff' % image_prefix,
+                'width': width,
+                'height': height,
+                'tile_size': tile_size,
+                'use_float': use_float,
+                'render_profile': render_profile.profile,
+                'render_threads': render_profile.threads,
+                'tiles': tiles}
+    manifest_file = '%s/%s' % (tiles_directory, nmv.consts.TiledRendering.MANIFEST_FILE)
+    with open(manifest_file, 'w') as file_handle:
+        json.dump(manifest, file_handle, indent=1)
+
+    nmv.logger.log('Tiled rendering of [%d x %d] pixels in [%d] tiles of [%d] pixels' %
+                   (width, height, len(tiles), tile_size))
+
+    # Return the path to the manifest
+    return manifest_file
+
+
+####################################################################################################
+# @read_manifest
+####################################################################################################
+def read_manifest(manifest_file):
+    """Reads the manifest of a tiled rendering job.
+
+    :param manifest_file:
+        The path to the manifest.
+    :return:
+        The manifest as a dictionary.
+    """
+
+    with open(manifest_file, 'r') as file_handle:
+        return json.load(file_handle)
+
+
+####################################################################################################
+# @render_tiles
+####################################################################################################
+def render_tiles(manifest_file,
+                 worker_index=0,
+                 number_workers=1):
+    """Renders the tiles of a worker. This function is executed in a worker process that has loaded
+    the scene of the job.
+
+    The tiles are distributed in a round-robin order over the workers. Every tile is rendered with
+    a cropped border, so the render buffers of a worker are bounded by the size of a tile, and it
+    is saved as an array whose first row is the top of the tile. The tiles that exist already are
+    skipped, so a failed job can be resumed.
+
+    :param manifest_file:
+        The path to the manifest of the job.
+    :param worker_index:
+        The index of this worker.
+    :param number_workers:
+        The total number of the workers.
+    """
+
+    manifest = read_manifest(manifest_file)
+    width = manifest['width']
+    height = manifest['height']
+    use_float = manifest['use_float']
+
+    # The rendering profile of the job
+    nmv.rendering.set_render_profile(manifest['render_profile'], manifest['render_threads'])
+
+    # Render the cropped borders only
+    render_settings = bpy.context.scene.render
+    render_settings.use_border = True
+    render_settings.use_crop_to_border = True
+
+    # Render float tiles to .EXR and the others to .PNG
+    if use_float:
+        render_settings.image_settings.file_format = 'OPEN_EXR'
+        render_settings.image_settings.color_depth = '32'
+        extension = 'exr'
+    else:
+        render_settings.image_settings.file_format = 'PNG'
+        render_settings.image_settings.color_depth = '8'
+        extension = 'png'
+    render_settings.image_settings.color_mode = 'RGBA'
+
+    start_time = time.time()
+    worker_tiles = manifest['tiles'][worker_index::number_workers]
+    for i, tile in enumerate(worker_tiles):
+
+        # Resume
+        if os.path.exists(tile['file']):
+            continue
+
+        # The border of the tile, where the origin of the border is the bottom of the image
+        render_settings.border_min_x = tile['x'] / float(width)
+        render_settings.border_max_x = (tile['x'] + tile['width']) / float(width)
+        render_settings.border_min_y = 1.0 - (tile['y'] + tile['height']) / float(height)
+        render_settings.border_max_y = 1.0 - tile['y'] / float(height)
+
+        # Render the tile
+        image_file = '%s.%s' % (os.path.splitext(tile['file'])[0], extension)
+        nmv.rendering.render_still_with_profile(image_file)
+
+        # Load the pixels, the first row of a Blender image is the bottom
+        image = bpy.data.images.load(image_file, check_existing=False)
+        try:
+            image_width, image_height, channels = image.size[0], image.size[1], image.channels
+            pixels = numpy.empty(image_width * image_height * channels, dtype=numpy.float32)
+            if hasattr(image.pixels, 'foreach_get'):
+                image.pixels.foreach_get(pixels)
+            else:
+                pixels[:] = image.pixels[:]
+        finally:
+            bpy.data.images.remove(image)
+        pixels = pixels.reshape((image_height, image_width, channels))[::-1]
+
+        # Fit the tile exactly, in case the border is rounded by one pixel
+        data = numpy.zeros((tile['height'], tile['width'], 4), dtype=numpy.float32)
+        rows = min(tile['height'], image_height)
+        columns = min(tile['width'], image_width)
+        data[:rows, :columns, :channels] = pixels[:rows, :columns, :4]
+        if channels < 4:
+            data[:rows, :columns, 3] = 1.0
+
+        # Save the tile, and write it atomically to resume safely
+        if not use_float:
+            data = numpy.clip(data * 255.0 + 0.5, 0, 255).astype(numpy.uint8)
+        temporary_file = '%s.part.npy' % os.path.splitext(tile['file'])[0]
+        numpy.save(temporary_file, data)
+        os.replace(temporary_file, tile['file'])
+        os.remove(image_file)
+
+        nmv.logger.log('Worker [%d]: tile [%d/%d] rendered' % (worker_index, i + 1,
+                                                               len(worker_tiles)))
+
+    nmv.logger.statistics('Worker [%d]: [%d] tiles rendered in [%f] seconds' %
+                          (worker_index, len(worker_tiles), time.time() - start_time))
+
+
+####################################################################################################
+# @stitch_tiles
+####################################################################################################
+def stitch_tiles(manifest_file,
+                 clean_tiles=True):
+    """Stitches the rendered tiles into a tiled TIFF image, one tile at a time.
+
+    :param manifest_file:
+        The path to the manifest of the job.
+    :param clean_tiles:
+        If True, the directory of the tiles is deleted after the stitching.
+    :return:
+        The path to the stitched image.
+    """
+
+    manifest = read_manifest(manifest_file)
+
+    # Verify that all the tiles are rendered
+    missing_tiles = [tile['file'] for tile in manifest['tiles'] if not os.path.exists(tile['file'])]
+    if len(missing_tiles) > 0:
+        raise RuntimeError('[%d] tiles are not rendered, e.g. [%s]' %
+                           (len(missing_tiles), missing_tiles[0]))
+
+    # Stream the tiles to the image, the tiles are already in the row-major order of the TIFF
+    start_time = time.time()
+    writer = nmv.file.TiledTiffWriter(manifest['image_file'], manifest['width'],
+                                      manifest['height'], manifest['tile_size'],
+                                      use_float=manifest['use_float'])
+    for tile in manifest['tiles']:
+        writer.write_tile(numpy.load(tile['file'], mmap_mode='r'))
+    writer.close()
+
+    nmv.logger.statistics('Image [%s] stitched in [%f] seconds' %
+                          (manifest['image_file'], time.time() - start_time))
+
+    # Clean
+    if clean_tiles:
+        shutil.rmtree(os.path.dirname(manifest_file))
+
+    # Return the path to the image
+    return manifest['image_file']
+
+
+####################################################################################################
+# @get_worker_command
+####################################################################################################
+def get_worker_command(blender_executable,
+                       manifest_file,
+                       worker_index,
+                       number_workers):
+    """Gets the shell command of a tile worker.
+
+    :param blender_executable:
+        The path to the Blender executable.
+    :param manifest_file:
+        The path to the manifest of the job.
+    :param worker_index:
+        The index of the worker.
+    :param number_workers:
+        The total number of the workers.
+    :return:
+        The command as a list of arguments.
+    """
+
+    manifest = read_manifest(manifest_file)
+    return [blender_executable, '-b', manifest['scene_file'], '--verbose', '0',
+            '--python', get_tiled_rendering_script(), '--',
+            '--manifest', manifest_file,
+            '--worker', str(worker_index),
+            '--workers', str(number_workers)]
+
+
+####################################################################################################
+# @run_tiled_render_locally
+####################################################################################################
+def run_tiled_render_locally(manifest_file,
+                             blender_executable='blender',
+                             number_workers=nmv.consts.TiledRendering.DEFAULT_WORKERS):
+    """Renders the tiles of a job in parallel worker processes on the local node, then stitches
+    the image in this process.
+
+    :param manifest_file:
+        The path to the manifest of the job.
+    :param blender_executable:
+        The path to the Blender executable.
+    :param number_workers:
+        The number of the worker processes.
+    :return:
+        The path to the stitched image.
+    """
+
+    start_time = time.time()
+
+    # Launch the workers
+    workers = list()
+    for worker_index in range(number_workers):
+        workers.append(subprocess.Popen(get_worker_command(
+            blender_executable, manifest_file, worker_index, number_workers)))
+
+    # Wait for the workers
+    failures = 0
+    for worker in workers:
+        if worker.wait() != 0:
+            failures += 1
+    if failures > 0:
+        raise RuntimeError('[%d] tile workers failed, re-run to resume' % failures)
+
+    nmv.logger.statistics('Tiles rendered by [%d] workers in [%f] seconds' %
+                          (number_workers, time.time() - start_time))
+
+    # Stitch the image
+    return stitch_tiles(manifest_file)
+
+
+####################################################################################################
+# @create_batch_job_string
+####################################################################################################
+def create_batch_job_string(job_name,
+                            logs_directory,
+                            commands,
+                            cpus_per_task=nmv.consts.TiledRendering.SLURM_CPUS_PER_TASK):
+    """Creates a SLURM batch job script.
+
+    :param job_name:
+        The name of the job.
+    :param logs_directory:
+        The directory where the logs of the job are written.
+    :param commands:
+        A list of shell commands, every command is a list of arguments.
+    :param cpus_per_task:
+        The number of CPUs of the job.
+    :return:
+        The batch job script as a string.
+    """
+
+    lines = ['#!/bin/bash',
+             '#SBATCH --job-name="%s"' % job_name,
+             '#SBATCH --nodes=1',
+             '#SBATCH --ntasks=1',
+             '#SBATCH --cpus-per-task=%d' % cpus_per_task,
+             '#SBATCH --mem=%d' % nmv.consts.TiledRendering.SLURM_MEMORY_MB,
+             '#SBATCH --time=%s' % nmv.consts.TiledRendering.SLURM_SESSION_TIME,
+             '#SBATCH --partition=%s' % nmv.consts.TiledRendering.SLURM_PARTITION,
+             '#SBATCH --output=%s/%s.out' % (logs_directory, job_name),
+             '#SBATCH --error=%s/%s.err' % (logs_directory, job_name),
+             '']
+    for command in commands:
+        lines.append(' '.join('"%s"' % argument for argument in command))
+    return '\n'.join(lines) + '\n'
+
+
+####################################################################################################
+# @create_tiled_render_slurm_jobs
+####################################################################################################
+def create_tiled_render_slurm_jobs(manifest_file,
+                                   blender_executable='blender',
+                                   number_workers=nmv.consts.TiledRendering.DEFAULT_WORKERS,
+                                   submit=True):
+    """Creates a SLURM job for every tile worker and a stitching job that depends on all of them,
+    and a script that submits them. The jobs are submitted if sbatch is available.
+
+    :param manifest_file:
+        The path to the manifest of the job.
+    :param blender_executable:
+        The path to the Blender executable.
+    :param number_workers:
+        The number of the worker jobs.
+    :param submit:
+        If True, the jobs are submitted with sbatch.
+    :return:
+        The path to the submission script.
+    """
+
+    tiles_directory = os.path.dirname(manifest_file)
+    logs_directory = '%s/logs' % tiles_directory
+    nmv.file.ops.clean_and_create_directory(logs_directory)
+
+    # The worker jobs
+    worker_scripts = list()
+    for worker_index in range(number_workers):
+        worker_script = '%s/worker_%04d.sh' % (tiles_directory, worker_index)
+        with open(worker_script, 'w') as file_handle:
+            file_handle.write(create_batch_job_string(
+                'nmv_tiles_%04d' % worker_index, logs_directory,
+                [get_worker_command(blender_executable, manifest_file, worker_index,
+                                    number_workers)]))
+        worker_scripts.append(worker_script)
+
+    # The stitching job
+    stitch_script = '%s/stitch.sh' % tiles_directory
+    manifest = read_manifest(manifest_file)
+    with open(stitch_script, 'w') as file_handle:
+        file_handle.write(create_batch_job_string(
+            'nmv_stitch', logs_directory,
+            [[blender_executable, '-b', manifest['scene_file'], '--verbose', '0',
+              '--python', get_tiled_rendering_script(), '--',
+              '--manifest', manifest_file, '--stitch']], cpus_per_task=1))
+
+    # The submission script, the stitching starts after all the workers succeed
+    submit_script = '%s/submit.sh' % tiles_directory
+    lines = ['#!/bin/bash', 'JOBS=""']
+    for worker_script in worker_scripts:
+        lines.append('JOBS="$JOBS:$(sbatch --parsable %s)"' % worker_script)
+    lines.append('sbatch --dependency=afterok$JOBS %s' % stitch_script)
+    with open(submit_script, 'w') as file_handle:
+        file_handle.write('\n'.join(lines) + '\n')
+    os.chmod(submit_script, 0o755)
+
+    # Submit
+    if submit and shutil.which('sbatch') is not None:
+        subprocess.call(['bash', submit_script])
+        nmv.logger.log('[%d] tile jobs submitted, the image will be written to [%s]' %
+                       (number_workers, manifest['image_file']))
+    else:
+        nmv.logger.log('Submit the tile jobs with [%s]' % submit_script)
+
+    # Return the path to the submission script
+    return submit_script
+
+
+####################################################################################################
+# @render_to_scale_tiled
+####################################################################################################
+def render_to_scale_tiled(bounding_box,
+                          camera_view=nmv.enums.Camera.View.FRONT,
+                          image_scale_factor=nmv.consts.Image.DEFAULT_IMAGE_SCALE_FACTOR,
+                          image_name='image',
+                          image_directory=None,
+                          tile_size=nmv.consts.TiledRendering.DEFAULT_TILE_SIZE,
+                          use_float=False,
+                          number_workers=nmv.consts.TiledRendering.DEFAULT_WORKERS,
+                          blender_executable='blender',
+                          use_slurm=False):
+    """Renders a frustum in the scene defined by a given bounding box to scale, like
+    render_to_scale(), but split into tiles that are rendered in parallel worker processes and
+    stitched into a tiled TIFF image. This is meant for images that are too large to be rendered
+    in a single Blender process.
+
+    :param bounding_box:
+        The bounding box of the view requested to be rendered.
+    :param camera_view:
+        The view of the camera, by default FRONT.
+    :param image_scale_factor:
+        The factor used to scale the resolution of the image.
+    :param image_name:
+        The name of the image.
+    :param image_directory:
+        The directory where the image will be rendered. If the directory is set to None,
+        then the prefix is included in @image_name.
+    :param tile_size:
+        The size of the tiles in pixels.
+    :param use_float:
+        If True, the image is a 32-bit float TIFF, otherwise an 8-bit one.
+    :param number_workers:
+        The number of the worker processes or jobs.
+    :param blender_executable:
+        The path to the Blender executable of the workers.
+    :param use_slurm:
+        If True, the workers are submitted as SLURM jobs and this function returns before the
+        image is stitched, otherwise the workers run on the local node.
+    :return:
+        The path to the stitched image, or to the SLURM submission script.
+    """
+
+    # Prepare the job
+    manifest_file = prepare_tiled_render_to_scale(
+        bounding_box=bounding_box, camera_view=camera_view, image_scale_factor=image_scale_factor,
+        image_name=image_name, image_directory=image_directory, tile_size=tile_size,
+        use_float=use_float)
+
+    # Run the workers
+    if use_slurm:
+        return create_tiled_render_slurm_jobs(manifest_file, blender_executable, number_workers)
+    return run_tiled_render_locally(manifest_file, blender_executable, number_workers)
+
+
+####################################################################################################
+# @render_to_scale_tiled_with_options
+####################################################################################################
+def render_to_scale_tiled_with_options(bounding_box,
+                                       camera_view,
+                                       image_name,
+                                       options):
+    """Renders a view to scale in tiles with the rendering options of the CLI.
+
+    :param bounding_box:
+        The bounding box of the view requested to be rendered.
+    :param camera_view:
+        The view of the camera.
+    :param image_name:
+        The name of the image.
+    :param options:
+        System options.
+    :return:
+        The path to the stitched image, or to the SLURM submission script.
+    """
+
+    return render_to_scale_tiled(
+        bounding_box=bounding_box, camera_view=camera_view,
+        image_scale_factor=options.rendering.resolution_scale_factor,
+        image_name=image_name, image_directory=options.io.images_directory,
+        tile_size=options.rendering.render_tile_size,
+        use_float=options.rendering.render_tile_hdr,
+        number_workers=options.rendering.render_tile_workers,
+        blender_executable=options.rendering.blender_executable,
+        use_slurm=options.rendering.render_tiles_on_cluster)
@@ -16,3 +16,4 @@
 ####################################################################################################
 
 from .scene_ops import *
+from .datablock_ops import *
@@ -0,0 +1,165 @@
+####################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+# Blender imports
+import bpy
+
+# Internal imports
+import nmv.consts
+import nmv.utilities
+
+
+####################################################################################################
+# @DatablockTracker
+####################################################################################################
+class DatablockTracker:
+    """Tracks the datablocks that are created in bpy.data during a run, e.g. the reconstruction of
+    a neuron in a batch, and frees them when the run is done.
+
+    Deleting the objects from the scene keeps their meshes, curves, materials and images in
+    bpy.data, so the memory of a process that handles many neurons grows with every one of them.
+    The tracker takes a snapshot of the existing datablocks when it is created, and the blocks that
+    are not in the snapshot when it is freed are removed, users first, and reported as leaked.
+    """
+
+    ################################################################################################
+    # @__init__
+    ################################################################################################
+    def __init__(self,
+                 label='Run'):
+        """Constructor
+
+        :param label:
+            The label of the tracked run, used in the report.
+        """
+
+        # The label of the run
+        self.label = label
+
+        # The keys of the existing datablocks per collection
+        self.snapshot = dict()
+        for collection_name, collection in self.get_collections():
+            self.snapshot[collection_name] = set(self.get_datablock_key(block)
+                                                 for block in collection)
+
+    ################################################################################################
+    # @get_datablock_key
+    ################################################################################################
+    @staticmethod
+    def get_datablock_key(block):
+        """Gets a key that identifies a datablock for the whole session.
+
+        A pointer alone is not enough, since the address of a block that is freed during the run,
+        e.g. by clearing the scene, can be reused by a new block that would then be taken for an
+        existing one. The session identifier of the block is used where Blender has it, otherwise
+        the pointer is paired with the name of the block.
+
+        :param block:
+            A datablock.
+        :return:
+            The key of the datablock.
+        """
+
+        if hasattr(block, 'session_uid'):
+            return block.session_uid
+        return block.name, block.as_pointer()
+
+    ################################################################################################
+    # @get_collections
+    ################################################################################################
+    @staticmethod
+    def get_collections():
+        """Gets the tracked collections of datablocks that are available in the running version of
+        Blender, in the order of their removal.
+
+        :return:
+            A list of (name, collection) pairs.
+        """
+
+        collections = list()
+        for collection_name in nmv.consts.Memory.TRACKED_DATABLOCKS:
+            if hasattr(bpy.data, collection_name):
+                collections.append([collection_name, getattr(bpy.data, collection_name)])
+        return collections
+
+    ################################################################################################
+    # @get_new_datablocks
+    ################################################################################################
+    def get_new_datablocks(self,
+                           collection_name,
+                           collection):
+        """Gets the datablocks of a collection that were created after the snapshot.
+
+        :param collection_name:
+            The name of the collection.
+        :param collection:
+            The collection in bpy.data.
+        :return:
+            A list of datablocks.
+        """
+
+        new_datablocks = list()
+        for block in collection:
+
+            # Existing before the run
+            if self.get_datablock_key(block) in self.snapshot[collection_name]:
+                continue
+
+            # The render result and the compositor images belong to Blender
+            if collection_name == 'images' and \
+                    block.type in nmv.consts.Memory.PERSISTENT_IMAGE_TYPES:
+                continue
+
+            new_datablocks.append(block)
+        return new_datablocks
+
+    ################################################################################################
+    # @free
+    ################################################################################################
+    def free(self):
+        """Frees all the datablocks that were created since the snapshot and reports them.
+
+        :return:
+            A dictionary of the number of the freed datablocks per collection.
+        """
+
+        freed = dict()
+        for collection_name, collection in self.get_collections():
+
+            # Remove the new blocks of the collection, with all their links
+            new_datablocks = self.get_new_datablocks(collection_name, collection)
+            for block in new_datablocks:
+                nmv.utilities.disable_std_output()
+                collection.remove(block, do_unlink=True)
+                nmv.utilities.enable_std_output()
+
+            if len(new_datablocks) > 0:
+                freed[collection_name] = len(new_datablocks)
+
+        # Report the leaked blocks
+        if len(freed) > 0:
+            nmv.logger.statistics('[%s] leaked datablocks freed: %s' % (self.label, ', '.join(
+                '%s [%d]' % (name.capitalize(), count) for name, count in sorted(freed.items()))))
+
+        # Verify that nothing is left
+        for collection_name, collection in self.get_collections():
+            remaining = len(self.get_new_datablocks(collection_name, collection))
+            if remaining > 0:
+                nmv.logger.log('WARNING: [%d] %s of [%s] cannot be freed' %
+                               (remaining, collection_name, self.label))
+
+        return freed
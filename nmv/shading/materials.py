@@ -93,9 +93,6 @@ def create_shadow_material(name,
     # Switch the rendering engine to cycles to be able to create the material
     current_scene.render.engine = 'CYCLES'
 
-    # Use 64 samples per pixel to create a nice image.
-    bpy.context.scene.cycles.samples = 64
-
     # Import the material from the library
     material_reference = import_shader(shader_name='shadow-material')
 
@@ -138,9 +135,6 @@ def create_super_electron_light_material(name,
     # Switch the rendering engine to cycles to be able to create the material
     current_scene.render.engine = 'CYCLES'
 
-    # Use only 2 samples
-    bpy.context.scene.cycles.samples = nmv.consts.Image.DEFAULT_SPP
-
     # Import the material from the library
     material_reference = import_shader(shader_name='super-electron-light-material')
 
@@ -173,9 +167,6 @@ def create_principled_shader(name,
     # Switch the rendering engine to cycles to be able to create the material
     current_scene.render.engine = 'CYCLES'
 
-    # Use only 2 samples
-    bpy.context.scene.cycles.samples = nmv.consts.Image.DEFAULT_SPP
-
     # Import the material from the library
     material_reference = import_shader(shader_name='principled')
 
@@ -207,9 +198,6 @@ def create_super_electron_dark_material(name,
     # Switch the rendering engine to cycles to be able to create the material
     current_scene.render.engine = 'CYCLES'
 
-    # Use only 2 samples
-    bpy.context.scene.cycles.samples = nmv.consts.Image.DEFAULT_SPP
-
     # Import the material from the library
     material_reference = import_shader(shader_name='super-electron-dark-material')
 
@@ -277,9 +265,6 @@ def create_flat_material(name,
         # Switch the rendering engine to cycles to be able to create the material
         current_scene.render.engine = 'CYCLES'
 
-        # Use only 2 samples
-        bpy.context.scene.cycles.samples = nmv.consts.Image.DEFAULT_SPP
-
         # Import the material from the library
         material_reference = import_shader(shader_name='flat-material')
 
@@ -351,9 +336,6 @@ def create_transparent_material(name,
         # Switch the rendering engine to cycles to be able to create the material
         current_scene.render.engine = 'CYCLES'
 
-        # Use only 2 samples
-        bpy.context.scene.cycles.samples = nmv.consts.Image.DEFAULT_SPP
-
         # Import the material from the library
         material_reference = import_shader(shader_name='flat-material')
 
@@ -422,8 +404,6 @@ def create_toon_material(name,
         # Switch the rendering engine to cycles to be able to create the material
         current_scene.render.engine = 'CYCLES'
 
-        bpy.context.scene.cycles.samples = 2
-
         # Import the material from the library
         material_reference = import_shader(shader_name='flat-material')
 
@@ -508,9 +488,6 @@ def create_wire_frame_material(name,
     # Switch the rendering engine to cycles to be able to create the material
     current_scene.render.engine = 'CYCLES'
 
-    # Use only 2 samples
-    bpy.context.scene.cycles.samples = nmv.consts.Image.DEFAULT_SPP
-
     # Import the material from the library
     material_reference = import_shader(shader_name='wire-frame')
 
@@ -553,9 +530,6 @@ def create_electron_light_material(name,
     # Switch the rendering engine to cycles to be able to create the material
     current_scene.render.engine = 'CYCLES'
 
-    # Use only 2 samples
-    bpy.context.scene.cycles.samples = nmv.consts.Image.DEFAULT_SPP
-
     # Import the material from the library
     material_reference = import_shader(shader_name='electron-light-material')
 
@@ -598,9 +572,6 @@ def create_electron_dark_material(name,
     # Switch the rendering engine to cycles to be able to create the material
     current_scene.render.engine = 'CYCLES'
 
-    # Use only 2 samples
-    bpy.context.scene.cycles.samples = nmv.consts.Image.DEFAULT_SPP
-
     # Import the material from the library
     material_reference = import_shader(shader_name='electron-dark-material')
 
@@ -802,9 +773,6 @@ def create_glossy_material(name,
     # Switch the rendering engine to cycles to be able to create the material
     current_scene.render.engine = 'CYCLES'
 
-    # Use 64 samples per pixel to create a nice image.
-    bpy.context.scene.cycles.samples = 64
-
     # Import the material from the library
     material_reference = import_shader(shader_name='glossy')
 
@@ -843,9 +811,6 @@ def create_glossy_bumpy_material(name,
     # Switch the rendering engine to cycles to be able to create the material
     current_scene.render.engine = 'CYCLES'
 
-    # Use 64 samples per pixel to create a nice image.
-    bpy.context.scene.cycles.samples = 64
-
     # Import the material from the library
     material_reference = import_shader(shader_name='glossy-bumpy')
 
@@ -32,3 +32,5 @@ from .skeleton_style_ops import *
 from .skeleton_verification_ops import *
 from .skeleton_soma_ops import *
 from .skeleton_spiny_ops import *
+from .skeleton_view_ops import *
+from .skeleton_validation_ops import *
\ No newline at end of file
@@ -538,14 +538,16 @@ def connect_single_child(section):
             # Append the sample to the parent samples
             section.samples.append(sample)
 
-        # Update the morphology skeleton
-        section.children = section.children[0].children
+        # Update the morphology skeleton, the children of the child become the children of the
+        # section
+        child = section.children[0]
+        section.children = child.children
+        section.children_ids = child.children_ids
 
-        # Update the section number of children
-        section.children = []
-
-        # Update the IDs of the children
-        section.children_ids = []
+        # Update the parents of the new children
+        for grand_child in section.children:
+            grand_child.parent = section
+            grand_child.parent_index = section.index
 
 
 ####################################################################################################
@@ -1118,7 +1120,8 @@ def get_random_spines_on_section(current_branching_level,
                                  max_branching_order,
                                  section,
                                  probability=50.0,
-                                 spines_list=[]):
+                                 spines_list=[],
+                                 random_generator=random):
     """Gets the data of some random spines on a given section.
 
     NOTE: The generated spines are totally random and does not follow any rules for growing the
@@ -1134,6 +1137,8 @@ def get_random_spines_on_section(current_branching_level,
         The probability of growing spine at a certain sample.
     :param spines_list:
         The list that integrates the generated spines recursively.
+    :param random_generator:
+        The random generator used to place the spines, by default the global random module.
     """
 
     # If this section is axon, the return and don't add any spines
@@ -1155,7 +1160,7 @@ def get_random_spines_on_section(current_branching_level,
             continue
 
         # Random spines
-        if probability > random.uniform(0.0, 1.0) * 100.0:
+        if probability > random_generator.uniform(0.0, 1.0) * 100.0:
 
             # Get the position of sample
             sample_position = sample.point
@@ -17,7 +17,6 @@
 
 
 # System imports
-import copy
 
 # Internal imports
 import nmv.consts
@@ -39,7 +38,7 @@ def update_section_parenting(section,
 
     # Detect if the section has no parent, then set it as a root
     # Use the first sample to identify if this section is a root or not
-    if str(section.samples[0].parent_index) == str(-1):
+    if str(section.get_first_sample_parent_index()) == str(-1):
 
         # This section is a root
         section.parent = None
@@ -55,7 +54,7 @@ def update_section_parenting(section,
 
         # If the last sample along the section has the same index of the first sample of the
         # auxiliary section, then the auxiliary section is a child
-        if section.samples[-1].index == i_section.samples[0].index:
+        if section.get_last_sample_index() == i_section.get_first_sample_index():
 
             # Add the auxiliary section as a child to the parent section
             section.children.append(i_section)
@@ -63,7 +62,7 @@ def update_section_parenting(section,
 
         # If the first sample along the section has the same index of the last sample of the
         # auxiliary section, then the auxiliary section is a parent
-        if section.samples[0].index == i_section.samples[-1].index:
+        if section.get_first_sample_index() == i_section.get_last_sample_index():
 
             # Set the auxiliary section to be a parent to this child section
             section.parent = i_section
@@ -195,8 +194,8 @@ def build_arbor_as_single_object(section, name,
     # poly_line_data list
     if (not section.has_children()) or (branching_order >= max_branching_order):
 
-        # Add the section object to the sections_objects list
-        poly_lines_data.append(copy.deepcopy(poly_line_data))
+        # Add the section object to the sections_objects list, the items are not modified later
+        poly_lines_data.append(list(poly_line_data))
 
         # Clean the polyline samples list
         poly_line_data[:] = []
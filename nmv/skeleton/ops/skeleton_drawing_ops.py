@@ -18,7 +18,6 @@
 # System imports
 import os
 import sys
-import copy
 
 # Blender imports
 import bpy
@@ -301,10 +300,11 @@ def get_connected_sections_poly_lines_recursively(section,
         # Construct the poly-line
         poly_line = nmv.geometry.PolyLine(
             name=poly_line_name,
-            samples=copy.deepcopy(poly_line_samples))
+            samples=list(poly_line_samples))
 
-        # Append the polyline to the list, and copy the data before clearing the list
-        poly_lines.append(copy.deepcopy(poly_line))
+        # Append the polyline to the list, the samples are copied before clearing the list, and
+        # every item is created per section and never modified, so a shallow copy is enough
+        poly_lines.append(poly_line)
 
         # Clean @poly_line_data to collect the data from the remaining sections
         poly_line_samples[:] = []
@@ -347,7 +347,7 @@ def get_connected_sections_poly_line_recursively(section,
         poly_line_name = '%s_%d' % (section.get_type_prefix(), section.index)
 
         # Append the polyline to the list, and copy the data before clearing the list
-        poly_lines_data.append([copy.deepcopy(poly_line_data), poly_line_name])
+        poly_lines_data.append([list(poly_line_data), poly_line_name])
 
         # Clean @poly_line_data to collect the data from the remaining sections
         poly_line_data[:] = []
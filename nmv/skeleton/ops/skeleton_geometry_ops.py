@@ -44,6 +44,13 @@ def compute_section_bounding_box(section,
         Return value for the p_max.
     """
 
+    # If the section is loaded lazily, use the bounding box of its descriptor, if known
+    if not section.is_materialized() and section.samples_descriptor.p_min is not None:
+        for i in range(3):
+            p_min[i] = min(p_min[i], section.samples_descriptor.p_min[i])
+            p_max[i] = max(p_max[i], section.samples_descriptor.p_max[i])
+        return
+
     # Iterate over all the samples of the section and get the min and max ones
     for sample in section.samples:
 
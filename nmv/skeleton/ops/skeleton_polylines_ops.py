@@ -16,7 +16,6 @@
 ####################################################################################################
 
 # System import
-import copy
 import random
 
 # Blender imports
@@ -263,7 +262,7 @@ def get_arbor_poly_lines_as_connected_sections(root,
         import nmv.geometry
         poly_line = nmv.geometry.PolyLine(
             name='%s_%d' % (poly_line_name, branching_order),
-            samples=copy.deepcopy(poly_line_data),
+            samples=list(poly_line_data),
             material_index=root.get_material_index() + (branching_order % 2))
 
         # Append the polyline to the list, and copy the data before clearing the list
@@ -809,8 +808,6 @@ def skin_section_into_mesh(section, smoothing_level=1):
         A mesh object reconstructed from skinning the given section.
     """
 
-    copy.deepcopy(section)
-
     # Create the initial vertex of the section skeleton at the section starting point
     section_bmesh_object = nmv.bmeshi.create_vertex(location=section.samples[0].point)
 
@@ -511,27 +511,20 @@ def remove_duplicate_samples(section,
         A threshold distance, by default 1.0 micron.
     """
 
-    # Iterate over all the samples along the section
-    for i, sample in enumerate(list(section.samples)):
-
-        # Ensure that we don't exceed the section length
-        if i == len(section.samples) - 2:
-            break
-
-        # Compute the distance between the two samples
-        distance = (section.samples[i + 1].point - section.samples[i].point).length
-
-        # If the distance is lower than the threshold
-        if distance < threshold:
-
-            # Then remove the duplicate sample
-            section.samples.remove(section.samples[i + 1])
+    # A section with less than three samples has no duplicates to remove
+    if len(section.samples) < 3:
+        return
 
-            # Repeat the process
-            remove_duplicate_samples(section=section, threshold=threshold)
+    # Keep a sample only if it is far enough from the last kept one, the first and last samples
+    # are always kept
+    samples = [section.samples[0]]
+    for sample in section.samples[1:-1]:
+        if (sample.point - samples[-1].point).length >= threshold:
+            samples.append(sample)
+    samples.append(section.samples[-1])
 
-            # Due to the recursive call of the function, there are no more samples to process,
-            break
+    # Update the samples
+    section.samples = samples
 
 
 ####################################################################################################
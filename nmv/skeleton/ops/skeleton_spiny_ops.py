@@ -91,7 +91,8 @@ def get_random_spines_across_section(section,
                                      number_of_spines_per_micron,
                                      max_branching_order,
                                      result=[],
-                                     use_skinning_to_build_proxy=False):
+                                     use_skinning_to_build_proxy=False,
+                                     random_generator=random):
     """Gets a list of random spine morphologies that are correctly aligned along the surface of
     a given morphology section.
 
@@ -108,6 +109,9 @@ def get_random_spines_across_section(section,
     :param use_skinning_to_build_proxy:
         If this flag is set to True, we will use the Skinning modifiers to build the proxy
         meshes instead of the poly-lines.
+    :param random_generator:
+        The random generator used to select the faces and the templates of the spines, by default
+        the global random module.
     :return:
         The results are generated in the results collecting list.
     """
@@ -155,7 +159,7 @@ def get_random_spines_across_section(section,
         number_spines = int(len(proxy_mesh_faces) * 0.5)
 
     # Randomly selected faces
-    randomly_selected_faces = random.sample(proxy_mesh_faces, number_spines)
+    randomly_selected_faces = random_generator.sample(proxy_mesh_faces, number_spines)
 
     # Get the radii
     for face in randomly_selected_faces:
@@ -175,7 +179,7 @@ def get_random_spines_across_section(section,
         spine_location = copy.deepcopy(face.center - (0.5 * segment_radius * face.normal))
 
         # Select a random spine structure from the templates
-        template_spine_structure = random.choice(template_spine_structures)
+        template_spine_structure = random_generator.choice(template_spine_structures)
 
         # Scale the spine
         nmv.scene.scale_object_uniformly(
@@ -0,0 +1,438 @@
+####################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+# System imports
+import json
+import time
+import numpy
+
+# Internal imports
+import nmv.consts
+import nmv.skeleton
+
+
+####################################################################################################
+# @PackedMorphology
+####################################################################################################
+class PackedMorphology:
+    """The arbors of a morphology packed into flat arrays, to validate all the sections at once.
+
+    The sections are listed in a depth-first order, with a parent before its children, and the
+    samples of every section are contiguous in the samples arrays. The sections are kept to repair
+    them after the validation.
+    """
+
+    ################################################################################################
+    # @__init__
+    ################################################################################################
+    def __init__(self,
+                 morphology):
+        """Constructor
+
+        :param morphology:
+            A given morphology to pack in a single traversal of its arbors.
+        """
+
+        # The sections and their types
+        self.sections = list()
+        self.section_types = list()
+
+        # The per-section arrays
+        parent_rows = list()
+        children_counts = list()
+        sample_counts = list()
+
+        # The per-sample arrays
+        points = list()
+        radii = list()
+
+        # All the roots, with no parents
+        stack = list()
+        for arbors in [morphology.apical_dendrites, morphology.basal_dendrites, morphology.axons]:
+            if arbors is not None:
+                for arbor in reversed(arbors):
+                    if arbor is not None:
+                        stack.append((arbor, -1))
+
+        # A single traversal over the sections
+        while len(stack) > 0:
+            section, parent_row = stack.pop()
+            row = len(self.sections)
+
+            self.sections.append(section)
+            self.section_types.append(section.get_type_string())
+            parent_rows.append(parent_row)
+            children_counts.append(len(section.children))
+
+            samples = section.samples if section.samples is not None else list()
+            sample_counts.append(len(samples))
+            for sample in samples:
+                points.append(sample.point[:])
+                radii.append(sample.radius)
+
+            # The children are visited next, in their order
+            for child in reversed(section.children):
+                stack.append((child, row))
+
+        # The section arrays
+        self.parent_rows = numpy.array(parent_rows, dtype=numpy.int64)
+        self.children_counts = numpy.array(children_counts, dtype=numpy.int64)
+        self.sample_counts = numpy.array(sample_counts, dtype=numpy.int64)
+        self.sample_offsets = numpy.zeros(len(self.sections), dtype=numpy.int64)
+        if len(self.sections) > 1:
+            self.sample_offsets[1:] = numpy.cumsum(self.sample_counts)[:-1]
+
+        # The sample arrays
+        self.points = numpy.array(points, dtype=numpy.float64).reshape((-1, 3))
+        self.radii = numpy.array(radii, dtype=numpy.float64)
+        self.samples_rows = numpy.repeat(numpy.arange(len(self.sections)), self.sample_counts)
+
+    ################################################################################################
+    # @get_number_sections
+    ################################################################################################
+    def get_number_sections(self):
+        """
+        :return:
+            The number of the packed sections.
+        """
+
+        return len(self.sections)
+
+    ################################################################################################
+    # @get_number_samples
+    ################################################################################################
+    def get_number_samples(self):
+        """
+        :return:
+            The number of the packed samples.
+        """
+
+        return len(self.radii)
+
+
+####################################################################################################
+# @append_issues
+####################################################################################################
+def append_issues(issues,
+                  rule,
+                  rows,
+                  samples,
+                  values):
+    """Appends the issues of a rule, as arrays, to the issues of a morphology.
+
+    :param issues:
+        A list of the arrays of the issues, (rows, samples, rules, values) per rule.
+    :param rule:
+        The rule that is broken.
+    :param rows:
+        An array of the rows of the sections of the issues.
+    :param samples:
+        An array of the indices of the samples of the issues in their sections.
+    :param values:
+        An array of the measured values of the issues.
+    """
+
+    if len(rows) > 0:
+        issues.append((numpy.asarray(rows, dtype=numpy.int64),
+                       numpy.asarray(samples, dtype=numpy.int64),
+                       numpy.full(len(rows), rule, dtype=object),
+                       numpy.asarray(values, dtype=numpy.float64)))
+
+
+####################################################################################################
+# @validate_packed_morphology
+####################################################################################################
+def validate_packed_morphology(packed_morphology,
+                               duplicates_threshold=
+                               nmv.consts.Validation.DUPLICATED_SAMPLES_THRESHOLD):
+    """Applies all the validation rules to a packed morphology, on its arrays.
+
+    The rules are those of the verification operations in skeleton_verification_ops, but every
+    rule is applied to all the sections and samples at once, and all the segments of a section are
+    verified including the last one.
+
+    :param packed_morphology:
+        A given packed morphology.
+    :param duplicates_threshold:
+        The distance below which two successive samples are duplicates.
+    :return:
+        A list of the issues, each is a tuple of the row of the section, the index of the sample in
+        the section, the rule and the measured value, in the order of the sections and samples.
+    """
+
+    packed = packed_morphology
+    consts = nmv.consts.Validation
+    issues = list()
+
+    rows = numpy.arange(packed.get_number_sections())
+    counts = packed.sample_counts
+    offsets = packed.sample_offsets
+    zeros = numpy.zeros(len(rows), dtype=numpy.int64)
+
+    # The number of samples per section
+    for rule, mask in [(consts.NO_SAMPLES, counts == 0),
+                       (consts.SINGLE_SAMPLE, counts == 1),
+                       (consts.TWO_SAMPLES, counts == 2)]:
+        append_issues(issues, rule, rows[mask], zeros[mask], counts[mask])
+
+    # The number of children per section
+    for rule, mask in [(consts.SINGLE_CHILD, packed.children_counts == 1),
+                       (consts.MULTIPLE_CHILDREN, packed.children_counts > 2)]:
+        append_issues(issues, rule, rows[mask], counts[mask] - 1, packed.children_counts[mask])
+
+    # The samples
+    sample_indices = numpy.arange(packed.get_number_samples()) - offsets[packed.samples_rows]
+    mask = numpy.logical_not(numpy.all(numpy.isfinite(packed.points), axis=1))
+    append_issues(issues, consts.INVALID_POINT, packed.samples_rows[mask], sample_indices[mask],
+                  numpy.zeros(numpy.count_nonzero(mask)))
+    mask = numpy.logical_not(packed.radii > 0)
+    append_issues(issues, consts.INVALID_RADIUS, packed.samples_rows[mask], sample_indices[mask],
+                  packed.radii[mask])
+
+    # The segments, between the successive samples of the same section
+    segments = numpy.flatnonzero(packed.samples_rows[:-1] == packed.samples_rows[1:])
+    segments_rows = packed.samples_rows[segments]
+    segments_lengths = numpy.linalg.norm(
+        packed.points[segments + 1] - packed.points[segments], axis=1)
+
+    mask = segments_lengths < packed.radii[segments]
+    append_issues(issues, consts.SHORT_SEGMENT, segments_rows[mask],
+                  sample_indices[segments[mask]], segments_lengths[mask])
+
+    # The duplicates, the last sample is the branching point and it is never a duplicate
+    mask = numpy.logical_and(segments_lengths < duplicates_threshold,
+                             sample_indices[segments] + 2 < counts[segments_rows])
+    append_issues(issues, consts.DUPLICATED_SAMPLES, segments_rows[mask],
+                  sample_indices[segments[mask]] + 1, segments_lengths[mask])
+
+    # The sections that have samples
+    sampled = counts > 0
+    first_radii = numpy.zeros(len(rows))
+    last_radii = numpy.zeros(len(rows))
+    first_radii[sampled] = packed.radii[offsets[sampled]]
+    last_radii[sampled] = packed.radii[offsets[sampled] + counts[sampled] - 1]
+
+    # The short sections, with respect to the radii of their first and last samples
+    sections_lengths = numpy.bincount(segments_rows, weights=segments_lengths,
+                                      minlength=len(rows))
+    mask = numpy.logical_and(counts >= 2,
+                             sections_lengths < 2.0 * (first_radii + last_radii))
+    append_issues(issues, consts.SHORT_SECTION, rows[mask], zeros[mask], sections_lengths[mask])
+
+    # The radii at the branching points
+    parents = packed.parent_rows
+    mask = numpy.logical_and(parents >= 0, sampled)
+    mask[mask] = numpy.logical_and(sampled[parents[mask]],
+                                   first_radii[mask] > last_radii[parents[mask]])
+    append_issues(issues, consts.RADIUS_AT_BRANCHING, rows[mask], zeros[mask], first_radii[mask])
+
+    # No issues
+    if len(issues) == 0:
+        return list()
+
+    # Order the issues by sections and samples
+    issues_rows, issues_samples, issues_rules, issues_values = \
+        [numpy.concatenate(column) for column in zip(*issues)]
+    order = numpy.lexsort((issues_samples, issues_rows))
+    return list(zip(issues_rows[order].tolist(), issues_samples[order].tolist(),
+                    issues_rules[order].tolist(), issues_values[order].tolist()))
+
+
+####################################################################################################
+# @create_issues_records
+####################################################################################################
+def create_issues_records(packed_morphology,
+                          issues):
+    """Creates the machine-readable records of the issues of a packed morphology.
+
+    :param packed_morphology:
+        A given packed morphology.
+    :param issues:
+        A list of the issues of the morphology, see @validate_packed_morphology.
+    :return:
+        A list of the records of the issues, each is a dictionary of the section, its type, the
+        sample, the rule, the severity and the measured value.
+    """
+
+    records = list()
+    for row, sample, rule, value in issues:
+        records.append({'section': packed_morphology.sections[row].index,
+                        'type': packed_morphology.section_types[row],
+                        'sample': sample,
+                        'rule': rule,
+                        'severity': nmv.consts.Validation.SEVERITIES[rule],
+                        'value': value})
+    return records
+
+
+####################################################################################################
+# @count_issues
+####################################################################################################
+def count_issues(issues,
+                 key):
+    """Counts the issues per rule or per severity.
+
+    :param issues:
+        A list of the issues of a morphology, see @validate_packed_morphology.
+    :param key:
+        'rule' or 'severity'.
+    :return:
+        A dictionary of the counts.
+    """
+
+    counts = dict()
+    for _, _, rule, _ in issues:
+        label = rule if key == 'rule' else nmv.consts.Validation.SEVERITIES[rule]
+        counts[label] = counts.get(label, 0) + 1
+    return counts
+
+
+####################################################################################################
+# @repair_packed_morphology
+####################################################################################################
+def repair_packed_morphology(packed_morphology,
+                             issues,
+                             repairs,
+                             duplicates_threshold=
+                             nmv.consts.Validation.DUPLICATED_SAMPLES_THRESHOLD):
+    """Applies the chosen repairs to the sections of a packed morphology that have issues.
+
+    The repairs are applied rule by rule in the order of @nmv.consts.Validation.REPAIRABLE_RULES,
+    with the repair operations of skeleton_repair_ops, and a section is repaired once per rule.
+    The arrays of the packed morphology are not updated, the morphology must be packed again to
+    validate it.
+
+    :param packed_morphology:
+        A given packed morphology.
+    :param issues:
+        A list of the issues of the morphology, see @validate_packed_morphology.
+    :param repairs:
+        A list of the rules to repair.
+    :param duplicates_threshold:
+        The distance below which two successive samples are duplicates.
+    :return:
+        A dictionary of the number of the repaired sections per rule.
+    """
+
+    packed = packed_morphology
+    consts = nmv.consts.Validation
+    repaired = dict()
+
+    for rule in consts.REPAIRABLE_RULES:
+        if rule not in repairs:
+            continue
+
+        # The sections of the issues of the rule
+        rows = sorted(set([row for row, _, issue_rule, _ in issues if issue_rule == rule]))
+        if len(rows) == 0:
+            continue
+
+        if rule == consts.DUPLICATED_SAMPLES:
+            for row in rows:
+                nmv.skeleton.ops.remove_duplicate_samples(packed.sections[row],
+                                                          threshold=duplicates_threshold)
+
+        # The parent is repaired, once for all its children
+        elif rule == consts.RADIUS_AT_BRANCHING:
+            rows = sorted(set([int(packed.parent_rows[row]) for row in rows]))
+            for row in rows:
+                nmv.skeleton.ops.repair_parents_with_smaller_radii(packed.sections[row])
+
+        elif rule == consts.SHORT_SECTION:
+            for row in rows:
+                nmv.skeleton.ops.repair_short_sections_by_compression(packed.sections[row])
+
+        # The children are connected before their parents, so a chain of single children is
+        # connected into a single section
+        elif rule == consts.SINGLE_CHILD:
+            for row in reversed(rows):
+                nmv.skeleton.ops.repair_sections_with_single_child(packed.sections[row])
+
+        repaired[rule] = len(rows)
+
+    # Return the number of the repaired sections
+    return repaired
+
+
+####################################################################################################
+# @validate_morphology
+####################################################################################################
+def validate_morphology(morphology,
+                        repairs=None,
+                        duplicates_threshold=nmv.consts.Validation.DUPLICATED_SAMPLES_THRESHOLD):
+    """Validates a morphology with all the rules in a single pass over its packed arrays, and
+    applies the chosen repairs in a second pass.
+
+    If repairs are applied, the morphology is validated again after the repairs, and it passes the
+    validation if it has no issues of an ERROR severity after the repairs.
+
+    :param morphology:
+        A given morphology.
+    :param repairs:
+        A list of the rules to repair, by default None to only validate the morphology.
+    :param duplicates_threshold:
+        The distance below which two successive samples are duplicates.
+    :return:
+        The report of the validation, a dictionary that can be written to a JSON file.
+    """
+
+    start_time = time.time()
+
+    # Validate
+    packed_morphology = PackedMorphology(morphology)
+    issues = validate_packed_morphology(packed_morphology, duplicates_threshold)
+    report = {'morphology': morphology.label,
+              'sections': packed_morphology.get_number_sections(),
+              'samples': packed_morphology.get_number_samples(),
+              'rules': count_issues(issues, 'rule'),
+              'severities': count_issues(issues, 'severity'),
+              'issues': create_issues_records(packed_morphology, issues)}
+
+    # Repair and validate again
+    if repairs is not None and len(repairs) > 0 and len(issues) > 0:
+        report['repairs'] = repair_packed_morphology(
+            packed_morphology, issues, repairs, duplicates_threshold)
+        packed_morphology = PackedMorphology(morphology)
+        issues = validate_packed_morphology(packed_morphology, duplicates_threshold)
+        report['remaining_severities'] = count_issues(issues, 'severity')
+        report['remaining_issues'] = create_issues_records(packed_morphology, issues)
+
+    report['passed'] = nmv.consts.Validation.ERROR not in count_issues(issues, 'severity')
+
+    nmv.logger.statistics('Morphology [%s] validated in [%f] seconds, [%d] issues, %s' %
+                          (morphology.label, time.time() - start_time, len(report['issues']),
+                           'PASSED' if report['passed'] else 'FAILED'))
+
+    # Return the report
+    return report
+
+
+####################################################################################################
+# @write_validation_report
+####################################################################################################
+def write_validation_report(report,
+                            file_path):
+    """Writes a validation report to a JSON file.
+
+    :param report:
+        The report of the validation of a morphology, or a list of reports.
+    :param file_path:
+        The path to the JSON file.
+    """
+
+    with open(file_path, 'w') as file_handle:
+        json.dump(report, file_handle, indent=1)
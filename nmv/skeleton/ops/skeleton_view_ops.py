@@ -0,0 +1,137 @@
+####################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+# System imports
+import copy
+
+# Internal imports
+import nmv.skeleton
+
+
+####################################################################################################
+# @copy_samples
+####################################################################################################
+def copy_samples(samples):
+    """Copies a list of samples, the points are copied and the other members are shared since
+    they are immutable.
+
+    :param samples:
+        A list of samples.
+    :return:
+        A new list of new samples.
+    """
+
+    samples_copy = list()
+    for sample in samples:
+        sample_copy = copy.copy(sample)
+        sample_copy.point = sample.point.copy()
+        samples_copy.append(sample_copy)
+    return samples_copy
+
+
+####################################################################################################
+# @create_section_view
+####################################################################################################
+def create_section_view(section):
+    """Creates a view of a section whose samples are copied from the original section only when
+    they are accessed for the first time, for example by a builder that visits the section.
+
+    The members of the section are copied right away, except its parent and children, which are
+    linked by @create_arbor_view. A section that is loaded lazily shares the descriptor of the
+    original section, and its samples are created from the raw arrays of the file without copying.
+
+    :param section:
+        The original section.
+    :return:
+        The view of the section.
+    """
+
+    # Copy the members of the section, they are either immutable or copied below
+    section_view = copy.copy(section)
+    section_view.parent = None
+    section_view.children = list()
+    section_view.children_ids = list(section.children_ids)
+    section_view.color = copy.copy(section.color)
+
+    # The original section is not materialized yet, its descriptor creates new samples anyway
+    if not section.is_materialized():
+        return section_view
+
+    # No samples to copy
+    original_samples = section.samples
+    if original_samples is None or len(original_samples) == 0:
+        section_view.samples = None if original_samples is None else list()
+        return section_view
+
+    # The samples are copied on the first access to the samples of the view
+    def loader():
+        return copy_samples(original_samples)
+
+    section_view.samples_descriptor = nmv.skeleton.SamplesDescriptor(
+        loader=loader, number_samples=len(original_samples),
+        first_sample_index=original_samples[0].index,
+        last_sample_index=original_samples[-1].index,
+        first_sample_parent_index=original_samples[0].parent_index,
+        p_min=None, p_max=None)
+    section_view._samples = None
+
+    # Return the view
+    return section_view
+
+
+####################################################################################################
+# @create_arbor_view
+####################################################################################################
+def create_arbor_view(root,
+                      parent_view=None):
+    """Creates a view of an arbor, section by section, and links the views of the sections.
+
+    :param root:
+        The root section of the arbor.
+    :param parent_view:
+        The view of the parent of the root, if any.
+    :return:
+        The view of the root section.
+    """
+
+    # The view of the root
+    root_view = create_section_view(root)
+    root_view.parent = parent_view
+
+    # The views of the children
+    for child in root.children:
+        root_view.children.append(create_arbor_view(child, root_view))
+
+    # Return the view of the root
+    return root_view
+
+
+####################################################################################################
+# @create_arbors_view
+####################################################################################################
+def create_arbors_view(arbors):
+    """Creates a view of a list of arbors.
+
+    :param arbors:
+        A list of the root sections of the arbors, or None.
+    :return:
+        A list of the views of the arbors, or None.
+    """
+
+    if arbors is None:
+        return None
+    return [create_arbor_view(arbor) for arbor in arbors]
@@ -16,6 +16,7 @@
 ####################################################################################################
 
 from .sample import *
+from .samples_descriptor import *
 from .section import *
 from .soma import *
 from .morphology import *
@@ -78,14 +78,15 @@ class Morphology:
         # Morphology apical dendrites
         self.apical_dendrites = apical_dendrites
 
-        # A copy of the original axons list, needed for comparison
-        self.original_axons = copy.deepcopy(axons)
+        # A copy of the original axons list, needed for comparison, the samples of a section are
+        # copied on their first access
+        self.original_axons = nmv.skeleton.ops.create_arbors_view(axons)
 
         # A copy of the original basal dendrites list, needed for comparison
-        self.original_basal_dendrites = copy.deepcopy(basal_dendrites)
+        self.original_basal_dendrites = nmv.skeleton.ops.create_arbors_view(basal_dendrites)
 
         # A copy of the original apical dendrites list, needed for comparison
-        self.origin_apical_dendrites = copy.deepcopy(apical_dendrites)
+        self.origin_apical_dendrites = nmv.skeleton.ops.create_arbors_view(apical_dendrites)
 
         # Morphology GID
         self.gid = gid
@@ -134,6 +135,38 @@ class Morphology:
         # The color of the soma, see @create_morphology_color_palette
         self.soma_color = None
 
+    ################################################################################################
+    # @create_copy_on_write_view
+    ################################################################################################
+    def create_copy_on_write_view(self):
+        """Creates a copy of the morphology for a builder, which is cheaper than a deep copy.
+
+        The sections are copied with their members, but the samples of a section are only copied
+        when they are accessed for the first time, so the sections that are not visited by the
+        builder, e.g. the ignored arbors or the sections beyond the maximum branching order, share
+        the samples of this morphology. The builders can modify the view freely, and this morphology
+        is not modified as long as it is not edited while the view is used.
+
+        :return:
+            A copy-on-write view of the morphology.
+        """
+
+        # Copy the small members, and share the arbors until they are replaced by views
+        morphology_view = copy.copy(self)
+        for member, value in self.__dict__.items():
+            if member not in ['axons', 'basal_dendrites', 'apical_dendrites', 'original_axons',
+                              'original_basal_dendrites', 'origin_apical_dendrites']:
+                setattr(morphology_view, member, copy.deepcopy(value))
+
+        # The views of the arbors
+        morphology_view.axons = nmv.skeleton.ops.create_arbors_view(self.axons)
+        morphology_view.basal_dendrites = nmv.skeleton.ops.create_arbors_view(self.basal_dendrites)
+        morphology_view.apical_dendrites = nmv.skeleton.ops.create_arbors_view(
+            self.apical_dendrites)
+
+        # Return the view
+        return morphology_view
+
     ################################################################################################
     # @build_samples_lists_recursively
     ################################################################################################
@@ -0,0 +1,86 @@
+####################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+####################################################################################################
+# SamplesDescriptor
+####################################################################################################
+class SamplesDescriptor:
+    """A descriptor of the samples of a section over the raw arrays of a morphology file.
+
+    The descriptor records what the construction of the skeleton needs to know about the section,
+    i.e. the number of its samples, the indices of its terminal samples and its bounding box, and
+    a loader that creates the sample objects from the raw arrays when the section is visited.
+    The loader is a function (and not a bound method of the reader), so that deep copies of the
+    skeleton share it instead of copying the raw arrays.
+    """
+
+    ################################################################################################
+    # @__init__
+    ################################################################################################
+    def __init__(self,
+                 loader,
+                 number_samples,
+                 first_sample_index,
+                 last_sample_index,
+                 first_sample_parent_index,
+                 p_min,
+                 p_max):
+        """Constructor
+
+        :param loader:
+            A function that returns the list of the samples of the section.
+        :param number_samples:
+            The number of the samples of the section.
+        :param first_sample_index:
+            The index of the first sample along the section, as it will be materialized.
+        :param last_sample_index:
+            The index of the last sample along the section, as it will be materialized.
+        :param first_sample_parent_index:
+            The index of the parent sample of the first sample along the section.
+        :param p_min:
+            The minimum point of the bounding box of the samples, (x, y, z), or None if the
+            samples must be materialized to compute it.
+        :param p_max:
+            The maximum point of the bounding box of the samples, (x, y, z), or None.
+        """
+
+        # The loader of the samples
+        self.loader = loader
+
+        # The number of the samples
+        self.number_samples = number_samples
+
+        # The terminal samples
+        self.first_sample_index = first_sample_index
+        self.last_sample_index = last_sample_index
+        self.first_sample_parent_index = first_sample_parent_index
+
+        # The bounding box of the samples
+        self.p_min = p_min
+        self.p_max = p_max
+
+    ################################################################################################
+    # @materialize
+    ################################################################################################
+    def materialize(self):
+        """Creates the samples of the section from the raw arrays.
+
+        :return:
+            A list of samples.
+        """
+
+        return self.loader()
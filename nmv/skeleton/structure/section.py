@@ -38,7 +38,8 @@ class Section:
                  samples=None,
                  type=None,
                  label='Section',
-                 tag='Section'):
+                 tag='Section',
+                 samples_descriptor=None):
         """Constructor
 
         :param index:
@@ -55,6 +56,9 @@ class Section:
             Arbor label to indicate which one is that.
         :param tag:
             A tag to identify the arbor when using it as a variable name.
+        :param samples_descriptor:
+            A descriptor of the samples over the raw arrays of the morphology file, used instead of
+            the samples to create them only when the section is visited, by default None.
         """
 
         # Section index
@@ -69,12 +73,15 @@ class Section:
         else:
             self.children_ids = list()
 
+        # The descriptor of the samples that are not materialized yet, for lazy loading
+        self.samples_descriptor = samples_descriptor
+
         # Segments samples (points along the section)
-        self.samples = samples
+        self._samples = samples
 
         # Add a reference to the section as a member variable of the sample, for accessibility !
-        if self.samples is not None:
-            for sample in self.samples:
+        if self._samples is not None:
+            for sample in self._samples:
                 sample.section = self
 
         # Section type: AXON (2), DENDRITE (3), APICAL_DENDRITE (4), or NONE
@@ -146,6 +153,122 @@ class Section:
         # Arbor color
         self.color = Vector((1.0, 1.0, 1.0))
 
+    ################################################################################################
+    # @samples
+    ################################################################################################
+    @property
+    def samples(self):
+        """The samples of the section, they are materialized from the descriptor of the section on
+        the first access if the morphology is loaded lazily.
+
+        :return:
+            A list of samples.
+        """
+
+        if self._samples is None and self.samples_descriptor is not None:
+            self.materialize_samples()
+        return self._samples
+
+    ################################################################################################
+    # @samples
+    ################################################################################################
+    @samples.setter
+    def samples(self,
+                samples):
+        """Sets the samples of the section, and drops its descriptor if any.
+
+        :param samples:
+            A list of samples.
+        """
+
+        self._samples = samples
+        self.samples_descriptor = None
+
+    ################################################################################################
+    # @materialize_samples
+    ################################################################################################
+    def materialize_samples(self):
+        """Creates the samples of the section from its descriptor.
+        """
+
+        # Create the samples and drop the descriptor
+        samples = self.samples_descriptor.materialize()
+        self.samples = samples
+
+        # Add a reference to the section to the samples
+        for sample in samples:
+            sample.section = self
+
+    ################################################################################################
+    # @is_materialized
+    ################################################################################################
+    def is_materialized(self):
+        """Checks if the samples of the section are created or not.
+
+        :return:
+            True if the samples exist, and False if the section is only described.
+        """
+
+        return self.samples_descriptor is None
+
+    ################################################################################################
+    # @get_number_samples
+    ################################################################################################
+    def get_number_samples(self):
+        """Gets the number of the samples of the section without materializing them.
+
+        :return:
+            The number of the samples of the section.
+        """
+
+        if self.samples_descriptor is not None:
+            return self.samples_descriptor.number_samples
+        if self._samples is None:
+            return 0
+        return len(self._samples)
+
+    ################################################################################################
+    # @get_first_sample_index
+    ################################################################################################
+    def get_first_sample_index(self):
+        """Gets the index of the first sample along the section without materializing it.
+
+        :return:
+            The index of the first sample.
+        """
+
+        if self.samples_descriptor is not None:
+            return self.samples_descriptor.first_sample_index
+        return self._samples[0].index
+
+    ################################################################################################
+    # @get_last_sample_index
+    ################################################################################################
+    def get_last_sample_index(self):
+        """Gets the index of the last sample along the section without materializing it.
+
+        :return:
+            The index of the last sample.
+        """
+
+        if self.samples_descriptor is not None:
+            return self.samples_descriptor.last_sample_index
+        return self._samples[-1].index
+
+    ################################################################################################
+    # @get_first_sample_parent_index
+    ################################################################################################
+    def get_first_sample_parent_index(self):
+        """Gets the parent index of the first sample along the section without materializing it.
+
+        :return:
+            The index of the parent sample of the first sample.
+        """
+
+        if self.samples_descriptor is not None:
+            return self.samples_descriptor.first_sample_parent_index
+        return self._samples[0].parent_index
+
     ################################################################################################
     # @get_type_string
     ################################################################################################
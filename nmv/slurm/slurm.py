@@ -191,6 +191,10 @@ def create_batch_job_script_for_gid(arguments,
     slurm_config.logs_directory = '%s/%s' % (arguments.output_directory,
                                              paths_consts.Paths.SLURM_LOGS_FOLDER)
 
+    # Request the memory from the history of the previous runs, if any
+    slurm_config.update_memory_from_history(
+        '%s/%s' % (arguments.output_directory, paths_consts.Paths.STATS_FOLDER))
+
     # Generate the batch job configuration string
     batch_job_config_string = create_batch_job_config_string(slurm_config)
 
@@ -240,6 +244,10 @@ def create_batch_job_script_for_multiple_gids(arguments,
     slurm_config.logs_directory = '%s/%s' % (arguments.output_directory,
                                              paths_consts.Paths.SLURM_LOGS_FOLDER)
 
+    # Request the memory from the history of the previous runs, if any
+    slurm_config.update_memory_from_history(
+        '%s/%s' % (arguments.output_directory, paths_consts.Paths.STATS_FOLDER))
+
     # Generate the batch job configuration string
     batch_job_config_string = create_batch_job_config_string(slurm_config)
 
@@ -291,6 +299,13 @@ def create_batch_job_script_for_morphology_file(arguments,
     slurm_config.logs_directory = '%s/%s' % (arguments.output_directory,
                                              paths_consts.Paths.SLURM_LOGS_FOLDER)
 
+    # Request the memory from the history of the previous runs for this morphology size, if any
+    morphology_path = morphology_file
+    if not os.path.isfile(morphology_path) and arguments.morphology_directory is not None:
+        morphology_path = '%s/%s' % (arguments.morphology_directory, morphology_file)
+    slurm_config.update_memory_from_history(
+        '%s/%s' % (arguments.output_directory, paths_consts.Paths.STATS_FOLDER), morphology_path)
+
     # Generate the batch job configuration string
     batch_job_config_string = create_batch_job_config_string(slurm_config)
 
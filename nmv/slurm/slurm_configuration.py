@@ -16,6 +16,16 @@
 ####################################################################################################
 
 
+# System imports
+import glob
+import json
+import math
+import os
+
+# Internal imports
+import memory_consts
+
+
 ################################################################################
 # @slurm_configuration
 ################################################################################
@@ -63,3 +73,95 @@ class SlurmConfiguration:
 
         # Logs directory, where the logs will be written
         self.logs_directory = ''
+
+    ################################################################################################
+    # @update_memory_from_history
+    ################################################################################################
+    def update_memory_from_history(self,
+                                   statistics_directory,
+                                   morphology_file=None):
+        """Updates the requested memory from the memory reports of the previous runs, if any.
+
+        :param statistics_directory:
+            The directory where the memory reports are written next to the .stats files.
+        :param morphology_file:
+            The morphology file of the job, if known, to predict the memory from its size.
+        """
+
+        memory_mb = suggest_memory_mb(statistics_directory, morphology_file)
+        if memory_mb is not None:
+            self.memory_mb = str(memory_mb)
+
+
+####################################################################################################
+# @read_memory_history
+####################################################################################################
+def read_memory_history(statistics_directory):
+    """Reads the memory reports of the previous runs.
+
+    :param statistics_directory:
+        The directory where the memory reports are written next to the .stats files.
+    :return:
+        A list of (morphology file size in bytes or None, peak memory in MB) pairs.
+    """
+
+    history = list()
+    pattern = '%s/*.%s' % (statistics_directory, memory_consts.Memory.REPORT_EXTENSION)
+    for report_path in sorted(glob.glob(pattern)):
+        try:
+            with open(report_path, 'r') as report_file:
+                report = json.load(report_file)
+            history.append([report.get('morphology_file_size'), float(report['peak_rss_mb'])])
+        except (IOError, OSError, ValueError, KeyError, TypeError):
+            continue
+    return history
+
+
+####################################################################################################
+# @suggest_memory_mb
+####################################################################################################
+def suggest_memory_mb(statistics_directory,
+                      morphology_file=None):
+    """Suggests the memory of a SLURM job from the memory reports of the previous runs.
+
+    If the size of the morphology file is known and the history covers different sizes, the peak
+    memory is fitted linearly to the file size and the fit is shifted up to cover all the previous
+    runs. Otherwise, the largest peak memory in the history is used. The prediction is multiplied by
+    a safety margin and rounded up.
+
+    :param statistics_directory:
+        The directory where the memory reports are written next to the .stats files.
+    :param morphology_file:
+        The morphology file of the job, if known.
+    :return:
+        The suggested memory in MB, or None if there is no history.
+    """
+
+    history = read_memory_history(statistics_directory)
+    if len(history) == 0:
+        return None
+
+    # The largest peak, used when the size of the morphology is unknown
+    predicted_mb = max(peak for size, peak in history)
+
+    # Predict the peak from the size of the morphology file
+    sized_history = [[size, peak] for size, peak in history if size is not None]
+    if morphology_file is not None and os.path.isfile(morphology_file) and \
+            len(set(size for size, peak in sized_history)) > 1:
+        number_runs = float(len(sized_history))
+        mean_size = sum(size for size, peak in sized_history) / number_runs
+        mean_peak = sum(peak for size, peak in sized_history) / number_runs
+        variance = sum((size - mean_size) ** 2 for size, peak in sized_history)
+        covariance = sum((size - mean_size) * (peak - mean_peak) for size, peak in sized_history)
+        slope = max(covariance / variance, 0.0)
+        intercept = mean_peak - slope * mean_size
+
+        # Shift the fit to cover the runs that are above it
+        shift = max(peak - (intercept + slope * size) for size, peak in sized_history)
+        predicted_mb = intercept + slope * os.path.getsize(morphology_file) + shift
+
+    # Add the margin and round up
+    granularity = memory_consts.Memory.SLURM_MEMORY_GRANULARITY_MB
+    memory_mb = predicted_mb * memory_consts.Memory.SLURM_MEMORY_MARGIN
+    memory_mb = int(math.ceil(memory_mb / granularity) * granularity)
+    return max(memory_mb, memory_consts.Memory.SLURM_MINIMUM_MEMORY_MB)
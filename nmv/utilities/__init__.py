@@ -24,4 +24,6 @@ from .time_line import *
 from .timer import *
 from .version import *
 from .system import *
-
+from .random_context import *
+from .background_task import *
+from .memory import *
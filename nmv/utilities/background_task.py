@@ -0,0 +1,246 @@
+####################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+# System imports
+import threading
+import time
+
+
+####################################################################################################
+# @TaskCancelled
+####################################################################################################
+class TaskCancelled(Exception):
+    """Raised inside a background task when the task is cancelled.
+    """
+    pass
+
+
+####################################################################################################
+# @BackgroundTask
+####################################################################################################
+class BackgroundTask:
+    """Runs a function in a background thread with progress reporting and cancellation.
+
+    The function is called as function(task, *args), where the task is this object. The function
+    reports its progress with set_progress() and checks for cancellation with check_cancelled()
+    between its steps. The function must NOT access any Blender data, since the Blender API is not
+    thread-safe. The main thread polls the task, i.e. from the timer of a modal operator, and
+    commits the result to the scene once the task is done.
+    """
+
+    ################################################################################################
+    # @__init__
+    ################################################################################################
+    def __init__(self,
+                 function,
+                 *args):
+        """Constructor
+
+        :param function:
+            The function that will be executed in the background.
+        :param args:
+            The arguments of the function, after the task.
+        """
+
+        # The function and its arguments
+        self.function = function
+        self.args = args
+
+        # The result of the function, or the error if it fails
+        self.result = None
+        self.error = None
+
+        # The progress, a fraction in [0, 1] and a message, guarded by a lock
+        self.lock = threading.Lock()
+        self.progress = 0.0
+        self.message = ''
+
+        # Cancellation flag
+        self.cancel_event = threading.Event()
+
+        # The thread
+        self.thread = None
+
+        # Timing
+        self.start_time = 0.0
+
+    ################################################################################################
+    # @run
+    ################################################################################################
+    def run(self):
+        """The body of the thread.
+        """
+
+        try:
+            self.result = self.function(self, *self.args)
+        except TaskCancelled:
+            self.result = None
+        except Exception as e:
+            self.error = e
+
+    ################################################################################################
+    # @start
+    ################################################################################################
+    def start(self):
+        """Starts the task in a daemon thread.
+        """
+
+        self.start_time = time.time()
+        self.thread = threading.Thread(target=self.run)
+        self.thread.daemon = True
+        self.thread.start()
+
+    ################################################################################################
+    # @is_done
+    ################################################################################################
+    def is_done(self):
+        """Checks if the task has finished, either successfully, with an error or cancelled.
+
+        :return:
+            True if the task has finished, otherwise False.
+        """
+
+        return self.thread is not None and not self.thread.is_alive()
+
+    ################################################################################################
+    # @cancel
+    ################################################################################################
+    def cancel(self):
+        """Requests the cancellation of the task. The task stops at its next check.
+        """
+
+        self.cancel_event.set()
+
+    ################################################################################################
+    # @is_cancelled
+    ################################################################################################
+    def is_cancelled(self):
+        """Checks if the cancellation of the task is requested.
+
+        :return:
+            True if the task is cancelled, otherwise False.
+        """
+
+        return self.cancel_event.is_set()
+
+    ################################################################################################
+    # @check_cancelled
+    ################################################################################################
+    def check_cancelled(self):
+        """Raises TaskCancelled if the cancellation of the task is requested. This function is
+        called by the background function between its steps.
+        """
+
+        if self.cancel_event.is_set():
+            raise TaskCancelled()
+
+    ################################################################################################
+    # @set_progress
+    ################################################################################################
+    def set_progress(self,
+                     progress,
+                     message=None):
+        """Updates the progress of the task, called by the background function.
+
+        :param progress:
+            The progress as a fraction in [0, 1].
+        :param message:
+            An optional message that describes the current step.
+        """
+
+        with self.lock:
+            self.progress = min(max(float(progress), 0.0), 1.0)
+            if message is not None:
+                self.message = message
+
+        # Every progress update is also a cancellation point
+        self.check_cancelled()
+
+    ################################################################################################
+    # @get_progress
+    ################################################################################################
+    def get_progress(self):
+        """Returns the progress of the task, called by the main thread.
+
+        :return:
+            A tuple (progress, message).
+        """
+
+        with self.lock:
+            return self.progress, self.message
+
+    ################################################################################################
+    # @get_elapsed_time
+    ################################################################################################
+    def get_elapsed_time(self):
+        """Returns the time since the task was started.
+
+        :return:
+            The elapsed time in seconds.
+        """
+
+        return time.time() - self.start_time
+
+
+####################################################################################################
+# @run_stages
+####################################################################################################
+def run_stages(stages):
+    """Runs all the stages of a staged function at once and returns its result.
+
+    A staged function is a generator that yields the progress, a fraction in [0, 1], and the name
+    of every stage before running it. A modal operator can run it a stage per timer step instead,
+    to keep the UI responsive and cancel between the stages.
+
+    :param stages:
+        The generator of the staged function.
+    :return:
+        The return value of the staged function.
+    """
+
+    while True:
+        try:
+            next(stages)
+        except StopIteration as stop:
+            return stop.value
+
+
+####################################################################################################
+# @scale_stages
+####################################################################################################
+def scale_stages(stages,
+                 start,
+                 end):
+    """Maps the progress of a staged function into a range of the progress of another one, to run
+    it as a part of it with yield from, and returns its result.
+
+    :param stages:
+        The generator of the staged function.
+    :param start:
+        The progress of the other function at the first stage.
+    :param end:
+        The progress of the other function once all the stages are done.
+    :return:
+        The return value of the staged function.
+    """
+
+    while True:
+        try:
+            progress, message = next(stages)
+        except StopIteration as stop:
+            return stop.value
+        yield start + (end - start) * progress, message
@@ -0,0 +1,266 @@
+####################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+# System imports
+import json
+import sys
+
+# Internal imports
+import nmv.consts
+
+
+####################################################################################################
+# @get_resident_memory_mb
+####################################################################################################
+def get_resident_memory_mb():
+    """Gets the current resident set size (RSS) of the process.
+
+    :return:
+        The resident memory in MB, or the peak resident memory if the current one is not reported
+        by the operating system.
+    """
+
+    # Linux reports the current resident memory
+    try:
+        with open('/proc/self/status', 'r') as status_file:
+            for line in status_file:
+                if line.startswith('VmRSS:'):
+                    return float(line.split()[1]) / 1024.0
+    except (IOError, OSError):
+        pass
+
+    # Otherwise, use the peak
+    return get_peak_resident_memory_mb()
+
+
+####################################################################################################
+# @get_peak_resident_memory_mb
+####################################################################################################
+def get_peak_resident_memory_mb():
+    """Gets the peak resident set size of the process since its start.
+
+    :return:
+        The peak resident memory in MB, or zero if it cannot be queried.
+    """
+
+    try:
+        import resource
+    except ImportError:
+        return 0.0
+
+    # The peak is reported in bytes on macOS and in KB on Linux
+    peak = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    if sys.platform == 'darwin':
+        return float(peak) / (1024.0 * 1024.0)
+    return float(peak) / 1024.0
+
+
+####################################################################################################
+# @get_datablock_counts
+####################################################################################################
+def get_datablock_counts():
+    """Gets the number of the datablocks in the current Blender file, per type.
+
+    :return:
+        A dictionary with the number of objects, meshes, curves, materials and images, empty if
+        the function is not running in Blender.
+    """
+
+    try:
+        import bpy
+    except ImportError:
+        return dict()
+
+    # Count the datablocks of every collection
+    counts = dict()
+    for datablock in nmv.consts.Memory.DATABLOCKS:
+        counts[datablock] = len(getattr(bpy.data, datablock))
+    return counts
+
+
+####################################################################################################
+# @MemoryProfile
+####################################################################################################
+class MemoryProfile:
+    """Records the memory of the process and the number of the Blender datablocks around every
+    stage of a builder, to locate the stage that exhausts the memory of a job.
+    """
+
+    ################################################################################################
+    # @__init__
+    ################################################################################################
+    def __init__(self,
+                 label):
+        """Constructor
+
+        :param label:
+            The label of the profiled run, for example the name of the builder.
+        """
+
+        # The label of the run
+        self.label = label
+
+        # A list of the stages, every stage is a dictionary
+        self.stages = list()
+
+    ################################################################################################
+    # @measure
+    ################################################################################################
+    @staticmethod
+    def measure():
+        """Measures the current memory and datablocks.
+
+        :return:
+            A dictionary with the resident and the peak memory in MB and the datablock counts.
+        """
+
+        resident_memory_mb = get_resident_memory_mb()
+        return {'rss_mb': resident_memory_mb,
+                'peak_rss_mb': max(get_peak_resident_memory_mb(), resident_memory_mb),
+                'datablocks': get_datablock_counts()}
+
+    ################################################################################################
+    # @record_stage
+    ################################################################################################
+    def record_stage(self,
+                     stage,
+                     before,
+                     after):
+        """Records a stage from the measures that are taken before and after it.
+
+        :param stage:
+            The name of the stage.
+        :param before:
+            The measure before the stage.
+        :param after:
+            The measure after the stage.
+        """
+
+        self.stages.append({'stage': stage,
+                            'rss_before_mb': before['rss_mb'],
+                            'rss_after_mb': after['rss_mb'],
+                            'peak_rss_mb': after['peak_rss_mb'],
+                            'datablocks_before': before['datablocks'],
+                            'datablocks_after': after['datablocks']})
+
+    ################################################################################################
+    # @get_peak_resident_memory_mb
+    ################################################################################################
+    def get_peak_resident_memory_mb(self):
+        """Gets the peak resident memory of the process at the end of the profiled stages.
+
+        :return:
+            The peak resident memory in MB.
+        """
+
+        if len(self.stages) == 0:
+            return get_peak_resident_memory_mb()
+        return max(stage['peak_rss_mb'] for stage in self.stages)
+
+    ################################################################################################
+    # @get_report
+    ################################################################################################
+    def get_report(self):
+        """Gets a report of the profile, formatted like the profiling stats.
+
+        :return:
+            The report string.
+        """
+
+        report = '%s Memory Stats.: \n' % self.label
+        for stage in self.stages:
+            datablocks = ', '.join(
+                '%s [%d -> %d]' % (datablock.capitalize(), stage['datablocks_before'][datablock],
+                                   stage['datablocks_after'][datablock])
+                for datablock in sorted(stage['datablocks_after']))
+            report += '\t* Memory @%s: RSS [%.1f -> %.1f] MB, Peak [%.1f] MB' % \
+                      (stage['stage'], stage['rss_before_mb'], stage['rss_after_mb'],
+                       stage['peak_rss_mb'])
+            report += (', %s\n' % datablocks) if len(datablocks) > 0 else '\n'
+        return report
+
+    ################################################################################################
+    # @write
+    ################################################################################################
+    def write(self,
+              file_path,
+              properties=None):
+        """Writes the profile to a JSON file, which is read back to suggest the memory of the
+        SLURM jobs from the history of the previous runs.
+
+        :param file_path:
+            The path to the output file.
+        :param properties:
+            A dictionary of the properties of the run, for example the size of the morphology.
+        """
+
+        data = dict() if properties is None else dict(properties)
+        data['label'] = self.label
+        data['peak_rss_mb'] = self.get_peak_resident_memory_mb()
+        data['stages'] = self.stages
+        with open(file_path, 'w') as report_file:
+            json.dump(data, report_file, indent=2)
+
+
+# The active memory profile, the stages profiled with @profile_function are recorded in it
+ACTIVE_MEMORY_PROFILE = None
+
+
+####################################################################################################
+# @start_memory_profile
+####################################################################################################
+def start_memory_profile(label):
+    """Starts a new memory profile, the stages that are profiled afterwards are recorded in it.
+
+    :param label:
+        The label of the profiled run.
+    :return:
+        A reference to the new profile.
+    """
+
+    global ACTIVE_MEMORY_PROFILE
+    ACTIVE_MEMORY_PROFILE = MemoryProfile(label=label)
+    return ACTIVE_MEMORY_PROFILE
+
+
+####################################################################################################
+# @get_memory_profile
+####################################################################################################
+def get_memory_profile():
+    """Gets the active memory profile.
+
+    :return:
+        The active MemoryProfile, or None if no profile is started.
+    """
+
+    return ACTIVE_MEMORY_PROFILE
+
+
+####################################################################################################
+# @stop_memory_profile
+####################################################################################################
+def stop_memory_profile():
+    """Stops the active memory profile.
+
+    :return:
+        A reference to the stopped profile, or None if no profile is started.
+    """
+
+    global ACTIVE_MEMORY_PROFILE
+    memory_profile = ACTIVE_MEMORY_PROFILE
+    ACTIVE_MEMORY_PROFILE = None
+    return memory_profile
@@ -0,0 +1,122 @@
+####################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+# System imports
+import hashlib
+import random
+import numpy
+
+
+####################################################################################################
+# @RandomContext
+####################################################################################################
+class RandomContext:
+    """The source of randomness of a single run.
+
+    Every consumer draws from its own named stream, and the seed of every stream is derived from
+    the seed of the run and the name of the stream. Therefore, the numbers that a builder gets do
+    not depend on the order or the number of the other builders that use randomness in the same
+    run. If the run is not seeded, the streams are seeded from the system entropy.
+    """
+
+    ################################################################################################
+    # @__init__
+    ################################################################################################
+    def __init__(self,
+                 seed=None):
+        """Constructor
+
+        :param seed:
+            The seed of the run, or None for a non-deterministic run.
+        """
+
+        # The seed of the run
+        self.seed = seed
+
+    ################################################################################################
+    # @is_deterministic
+    ################################################################################################
+    def is_deterministic(self):
+        """Checks if the run is seeded or not.
+
+        :return:
+            True if the run is seeded, otherwise False.
+        """
+
+        return self.seed is not None
+
+    ################################################################################################
+    # @get_stream_seed
+    ################################################################################################
+    def get_stream_seed(self,
+                        stream,
+                        default=None):
+        """Derives the seed of a named stream from the seed of the run.
+
+        The derivation uses a cryptographic hash, which is stable across processes and Python
+        versions, unlike the built-in hash of strings.
+
+        :param stream:
+            The name of the stream.
+        :param default:
+            The value returned if the run is not seeded.
+        :return:
+            A 32-bit seed, or the default value if the run is not seeded.
+        """
+
+        # Not seeded
+        if self.seed is None:
+            return default
+
+        # Hash the seed of the run and the name of the stream
+        digest = hashlib.sha256(('%s:%s' % (str(self.seed), stream)).encode('utf-8')).digest()
+
+        # Use the first four bytes as a seed
+        return int.from_bytes(digest[:4], byteorder='little')
+
+    ################################################################################################
+    # @get_random
+    ################################################################################################
+    def get_random(self,
+                   stream):
+        """Returns a new Python random generator for a named stream.
+
+        The returned object has the same interface as the random module, i.e. random(), uniform(),
+        choice() and sample().
+
+        :param stream:
+            The name of the stream.
+        :return:
+            A new random.Random generator.
+        """
+
+        return random.Random(self.get_stream_seed(stream))
+
+    ################################################################################################
+    # @get_numpy_random
+    ################################################################################################
+    def get_numpy_random(self,
+                         stream):
+        """Returns a new numpy random generator for a named stream.
+
+        :param stream:
+            The name of the stream.
+        :return:
+            A new numpy.random.RandomState generator.
+        """
+
+        return numpy.random.RandomState(self.get_stream_seed(stream))
@@ -18,6 +18,9 @@
 # System imports
 import time
 
+# Internal imports
+import nmv.utilities
+
 
 ####################################################################################################
 # @Timer
@@ -81,6 +84,11 @@ def profile_function(function, *args):
         Function result, Profiling string.
     """
 
+    # Measure the memory before the function, if a memory profile is active
+    memory_profile = nmv.utilities.get_memory_profile()
+    if memory_profile is not None:
+        memory_before = memory_profile.measure()
+
     # Start the timer
     starting_time = time.time()
 
@@ -90,6 +98,10 @@ def profile_function(function, *args):
     # Stop the timer
     ending_time = time.time()
 
+    # Record the memory of the stage
+    if memory_profile is not None:
+        memory_profile.record_stage(function.__name__, memory_before, memory_profile.measure())
+
     # Compute the execution time
     execution_time = ending_time - starting_time
 
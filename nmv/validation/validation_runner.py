@@ -0,0 +1,286 @@
+###################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+# System imports
+import json
+import os
+import subprocess
+import time
+
+# Internal imports
+import nmv.catalogue
+import nmv.consts
+import nmv.file
+import nmv.options
+import nmv.skeleton
+
+
+####################################################################################################
+# @get_validation_script
+####################################################################################################
+def get_validation_script():
+    """Gets the path to the CLI script that is executed by the validation workers.
+
+    :return:
+        The path to the script.
+    """
+
+    return os.path.realpath('%s/../interface/cli/morphology_validation.py' %
+                            os.path.dirname(os.path.realpath(__file__)))
+
+
+####################################################################################################
+# @create_validation_manifest
+####################################################################################################
+def create_validation_manifest(input_directory,
+                               output_directory,
+                               number_workers=nmv.consts.Validation.DEFAULT_WORKERS,
+                               repairs=None,
+                               duplicates_threshold=
+                               nmv.consts.Validation.DUPLICATED_SAMPLES_THRESHOLD):
+    """Creates the manifest of the validation of all the morphologies in a directory.
+
+    :param input_directory:
+        The directory of the morphologies, possibly in sub-directories.
+    :param output_directory:
+        The directory where the reports and the repaired morphologies are written.
+    :param number_workers:
+        The number of the workers that validate the morphologies.
+    :param repairs:
+        A list of the rules to repair, by default None to only validate the morphologies.
+    :param duplicates_threshold:
+        The distance below which two successive samples are duplicates.
+    :return:
+        The path to the manifest.
+    """
+
+    # Collect the morphologies
+    items = list()
+    for directory, _, files in os.walk(input_directory):
+        for file_name in sorted(files):
+            if os.path.splitext(file_name)[1].lower() not in \
+                    nmv.consts.Validation.MORPHOLOGY_EXTENSIONS:
+                continue
+            file_path = os.path.join(directory, file_name)
+            items.append({'file': file_path,
+                          'directory': os.path.relpath(directory, input_directory),
+                          'size': os.path.getsize(file_path)})
+    if len(items) == 0:
+        raise RuntimeError('The directory [%s] does NOT contain any morphologies' %
+                           input_directory)
+
+    # Balance the workers with the sizes of the files
+    nmv.catalogue.shard_catalogue_items(items, number_workers)
+
+    # Every morphology is reported to its own file
+    reports_directory = '%s/%s' % (output_directory, nmv.consts.Validation.REPORTS_DIRECTORY)
+    if not nmv.file.ops.path_exists(reports_directory):
+        nmv.file.ops.clean_and_create_directory(reports_directory)
+    for i, item in enumerate(items):
+        item['report'] = '%s/report_%06d.json' % (reports_directory, i)
+
+    # Write the manifest
+    manifest = {'output_directory': output_directory,
+                'repairs': repairs if repairs is not None else list(),
+                'duplicates_threshold': duplicates_threshold,
+                'items': items}
+    manifest_file = '%s/%s' % (output_directory, nmv.consts.Validation.MANIFEST_FILE)
+    with open(manifest_file, 'w') as file_handle:
+        json.dump(manifest, file_handle, indent=1)
+
+    nmv.logger.log('Validation of [%d] morphologies' % len(items))
+
+    # Return the path to the manifest
+    return manifest_file
+
+
+####################################################################################################
+# @validate_morphologies
+####################################################################################################
+def validate_morphologies(manifest_file,
+                          worker_index=0):
+    """Validates, and repairs, the morphologies of a worker. This function is executed in a worker
+    process.
+
+    The report of every morphology is written to its own file, and the repaired morphologies are
+    written as .SWC files. The morphologies that are reported already are skipped, so a failed
+    validation can be resumed. The next morphologies are read on background threads while the
+    current one is validated.
+
+    :param manifest_file:
+        The path to the manifest of the validation.
+    :param worker_index:
+        The index of this worker.
+    """
+
+    with open(manifest_file, 'r') as file_handle:
+        manifest = json.load(file_handle)
+
+    start_time = time.time()
+
+    # The items of this worker, except the reported ones
+    worker_items = [item for item in manifest['items']
+                    if item['worker'] == worker_index and not os.path.exists(item['report'])]
+
+    # The next morphologies are read while the current one is validated
+    options = nmv.options.NeuroMorphoVisOptions()
+    prefetcher = nmv.file.MorphologyPrefetcher(
+        [nmv.file.create_options_for_morphology_file(options, item['file'])
+         for item in worker_items],
+        prefetch_count=nmv.consts.Validation.PREFETCH_COUNT,
+        number_threads=nmv.consts.Validation.PREFETCH_COUNT,
+        reader=nmv.file.read_morphology_from_file)
+
+    for item, (item_options, loading_flag, morphology) in zip(worker_items, prefetcher):
+
+        # A morphology that cannot be read or validated fails the validation
+        if not loading_flag or morphology is None:
+            report = {'morphology': item_options.morphology.label, 'passed': False,
+                      'error': 'Cannot read the morphology'}
+        else:
+            try:
+                report = nmv.skeleton.ops.validate_morphology(
+                    morphology, repairs=manifest['repairs'],
+                    duplicates_threshold=manifest['duplicates_threshold'])
+            except Exception as e:
+                report = {'morphology': item_options.morphology.label, 'passed': False,
+                          'error': str(e)}
+
+        # Write the repaired morphology
+        report['file'] = item['file']
+        if 'repairs' in report:
+            repaired_directory = os.path.normpath('%s/%s/%s' % (
+                manifest['output_directory'], nmv.consts.Validation.REPAIRED_DIRECTORY,
+                item['directory']))
+            os.makedirs(repaired_directory, exist_ok=True)
+            nmv.file.write_morphology_to_swc_file(morphology, repaired_directory)
+            report['repaired_file'] = '%s/%s.swc' % (repaired_directory, morphology.label)
+
+        # The report, written last, marks the morphology as done
+        nmv.skeleton.ops.write_validation_report(report, item['report'])
+
+    nmv.logger.statistics('Worker [%d]: [%d] morphologies validated in [%f] seconds' %
+                          (worker_index, len(worker_items), time.time() - start_time))
+
+
+####################################################################################################
+# @merge_validation_reports
+####################################################################################################
+def merge_validation_reports(manifest_file):
+    """Merges the reports of the morphologies into the report of the validation, and lists the
+    morphologies that passed the validation, or their repaired files, to gate the next stages.
+
+    :param manifest_file:
+        The path to the manifest of the validation.
+    :return:
+        The path to the report of the validation.
+    """
+
+    with open(manifest_file, 'r') as file_handle:
+        manifest = json.load(file_handle)
+
+    # Collect the reports, a missing report is that of a failed worker
+    reports = list()
+    for item in manifest['items']:
+        if os.path.exists(item['report']):
+            with open(item['report'], 'r') as file_handle:
+                reports.append(json.load(file_handle))
+        else:
+            reports.append({'file': item['file'], 'passed': False,
+                            'error': 'The morphology is not validated'})
+
+    # The morphologies that passed
+    passed_files = [report.get('repaired_file', report['file'])
+                    for report in reports if report['passed']]
+    with open('%s/%s' % (manifest['output_directory'], nmv.consts.Validation.PASSED_FILE),
+              'w') as file_handle:
+        file_handle.write(''.join(['%s\n' % passed_file for passed_file in passed_files]))
+
+    # The report
+    report_file = '%s/%s' % (manifest['output_directory'], nmv.consts.Validation.REPORT_FILE)
+    nmv.skeleton.ops.write_validation_report(
+        {'morphologies': len(reports), 'passed': len(passed_files), 'reports': reports},
+        report_file)
+
+    nmv.logger.log('[%d/%d] morphologies passed the validation' %
+                   (len(passed_files), len(reports)))
+
+    # Return the path to the report
+    return report_file
+
+
+####################################################################################################
+# @get_validation_worker_command
+####################################################################################################
+def get_validation_worker_command(blender_executable,
+                                  manifest_file,
+                                  worker_index):
+    """Gets the shell command of a validation worker.
+
+    :param blender_executable:
+        The path to the Blender executable.
+    :param manifest_file:
+        The path to the manifest of the validation.
+    :param worker_index:
+        The index of the worker.
+    :return:
+        The command as a list of arguments.
+    """
+
+    return [blender_executable, '-b', '--verbose', '0', '--python', get_validation_script(),
+            '--', '--manifest', manifest_file, '--worker', str(worker_index)]
+
+
+####################################################################################################
+# @run_validation_locally
+####################################################################################################
+def run_validation_locally(manifest_file,
+                           blender_executable='blender',
+                           number_workers=nmv.consts.Validation.DEFAULT_WORKERS):
+    """Validates the morphologies in parallel worker processes on the local node, then merges the
+    reports in this process. A single worker validates the morphologies in this process.
+
+    :param manifest_file:
+        The path to the manifest of the validation.
+    :param blender_executable:
+        The path to the Blender executable.
+    :param number_workers:
+        The number of the worker processes, as in the manifest.
+    :return:
+        The path to the report of the validation.
+    """
+
+    start_time = time.time()
+
+    # Not worth launching a worker
+    if number_workers < 2:
+        validate_morphologies(manifest_file, 0)
+
+    # Launch the workers and wait for them, the morphologies of a failed worker fail
+    else:
+        workers = [subprocess.Popen(get_validation_worker_command(
+            blender_executable, manifest_file, worker_index))
+            for worker_index in range(number_workers)]
+        failures = len([worker for worker in workers if worker.wait() != 0])
+        if failures > 0:
+            nmv.logger.log('WARNING: [%d] validation workers failed, re-run to resume' % failures)
+
+    nmv.logger.statistics('Morphologies validated by [%d] workers in [%f] seconds' %
+                          (number_workers, time.time() - start_time))
+
+    # Merge the reports
+    return merge_validation_reports(manifest_file)
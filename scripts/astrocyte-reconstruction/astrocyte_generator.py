@@ -21,6 +21,7 @@ import os
 import time
 import subprocess
 import argparse
+import numpy
 sys.path.append(os.path.dirname(os.path.realpath(__file__)))
 
 # Blender imports
@@ -28,6 +29,7 @@ import bpy
 from mathutils import Vector
 
 # Internal imports
+import nmv.builders
 import nmv.scene
 import nmv.mesh
 import nmv.enums
@@ -38,158 +40,125 @@ import nmv.utilities
 from archngv import NGVCircuit
 
 import astrocyte_data
-import astro_meta_builder
 
 
 ####################################################################################################
-# @create_end_feet_proxy_mesh
+# @get_endfoot_area
 ####################################################################################################
-def create_end_feet_proxy_mesh(area,
-                               index,
-                               soma_centroid=None):
-    """Creates the end-feet proxy mesh.
+def get_endfoot_area(area):
+    """Converts an end-feet area from the circuit into an array-based EndfootArea.
 
     :param area:
-        The area of the end feet.
-    :param index:
-        The index.
+        The area of the end feet, as stored in the gliovascular connectome.
     :return:
-        A reference to the created proxy mesh.
+        A reference to the EndfootArea.
     """
 
-    # List of vertices and faces of the created mesh
-    verts = list()
-    faces = list()
-
-    # Points and triangles from the area
-    points = area.points
+    # The triangles are either stored in an array, or as a list of triangle objects
     triangles = area.triangles
+    if not isinstance(triangles, numpy.ndarray):
+        triangles = numpy.array([triangle.data[:3] for triangle in triangles], dtype=numpy.int64)
 
-    # Append verts
-    for point in points:
-        if soma_centroid is None:
-            location = Vector((point[0], point[1], point[2]))
-        else:
-            location = Vector((point[0], point[1], point[2])) - soma_centroid
+    # Return a reference to the area
+    return nmv.builders.EndfootArea(
+        points=numpy.asarray(area.points), triangles=triangles, thickness=area.thickness)
+
+
+####################################################################################################
+# @generate_astrocyte
+####################################################################################################
+def generate_astrocyte(astro_generator,
+                       areas,
+                       soma_style,
+                       center_morphology=True,
+                       center_mesh=False):
+    """Generate astrocyte mesh for a specific astrocyte in the circuit.
+
+    :param astro_generator:
+        The AstrocyteData of the astrocyte.
+    :param areas:
+        The end-feet areas of the circuit, loaded once and shared between all the astrocytes.
+    :param soma_style:
+        The style of the soma, whether metaball or softbody.
+    :param center_morphology:
+        Center the morphology at the origin.
+    :param center_mesh:
+        Keep the final mesh at the origin, otherwise it is translated to the soma position.
+    :return:
+        A reference to the astrocyte mesh and the reconstruction time.
+    """
 
-        verts.append(location)
+    # Clear the scene
+    nmv.scene.clear_scene()
 
-    # Append faces
-    for triangle in triangles:
-        face = Vector((int(triangle.data[0]), int(triangle.data[1]), int(triangle.data[2])))
-        faces.append(face)
-    thickness = area.thickness
+    soma_centroid = astro_generator.circuit_data['soma_position']
+    soma_centroid = Vector((soma_centroid[0], soma_centroid[1], soma_centroid[2]))
+    soma_radius = astro_generator.circuit_data['soma_radius']
 
-    # Create the end feet proxy mesh
-    end_feet_proxy_mesh = nmv.mesh.create_mesh_from_raw_data(verts=verts, faces=faces,
-                                                             name='%s_endfeet' % index)
+    # Load the .h5 morphology
+    reader = nmv.file.readers.H5Reader(h5_file=astro_generator.filepath,
+                                       center_morphology=center_morphology)
+    morphology_object = reader.read_file()
 
-    # Resample the mesh
-    bpy.ops.object.modifier_add(type='SUBSURF')
-    bpy.context.object.modifiers["Subdivision"].subdivision_type = 'SIMPLE'
-    bpy.context.object.modifiers["Subdivision"].levels = 4
-    bpy.context.object.modifiers["Subdivision"].show_only_control_edges = True
-    bpy.context.object.modifiers["Subdivision"].uv_smooth = 'PRESERVE_CORNERS'
+    # The end-feet areas of the astrocyte as arrays, no proxy meshes are created in the scene
+    endfeet_areas = [get_endfoot_area(areas[process.endfoot_area_mesh.index])
+                     for process in astro_generator.perivascular_processes]
 
-    if nmv.utilities.is_blender_290():
-        bpy.ops.object.modifier_apply(modifier="Subdivision")
-    else:
-        bpy.ops.object.modifier_apply(apply_as='DATA', modifier="Subdivision")
+    # Create the builder
+    builder = nmv.builders.AstrocyteMetaBuilder(
+        morphology=morphology_object,
+        soma_radius=soma_radius,
+        endfeet_areas=endfeet_areas,
+        endfeet_origin=soma_centroid if center_morphology else None,
+        soma_style=soma_style)
+
+    # Reconstructing the mesh and return a reference to the astrocyte mesh
+    start_time = time.time()
+    astrocyte_mesh = builder.reconstruct_mesh()
+    end_time = time.time()
+
+    # Translate the astrocyte mesh
+    if not center_mesh:
+        nmv.scene.set_object_location(scene_object=astrocyte_mesh, location=soma_centroid)
 
-    # Return a reference to the mesh
-    return end_feet_proxy_mesh
+    # Return a reference to the astrocyte mesh
+    return astrocyte_mesh, (end_time - start_time)
 
 
 ####################################################################################################
-# @create_end_feet_proxy_mesh
+# @generate_astrocytes
 ####################################################################################################
-def generate_astrocyte(circuit_path,
-                       astrocyte_gid,
-                       soma_style):
-    """Generate astrocyte mesh for a specific GID in the circuit.
+def generate_astrocytes(circuit_path,
+                        astrocyte_gids,
+                        soma_style):
+    """Generate the astrocyte meshes of a list of GIDs in the same Blender session.
+
+    The circuit and its end-feet areas are loaded only once for all the astrocytes.
 
     :param circuit_path:
         The NGV circuit.
-    :param astrocyte_gid:
-        The GID of the astrocyte.
+    :param astrocyte_gids:
+        The GIDs of the astrocytes.
     :param soma_style:
         The style of the soma, whether metaball or softbody.
     :return:
-        A reference to the astrocyte mesh
+        A generator of (gid, astrocyte mesh, reconstruction time) per astrocyte.
     """
 
-    # List astrocyte GIDs
-    gids = [astrocyte_gid]
-
+    # Load the circuit once
     circuit = NGVCircuit(circuit_path)
 
     # End-feet areas
     areas = circuit.gliovascular_connectome.surface_meshes
 
-    # Neurons IDs
-    # neurons = circuit.neuroglial_connectome.astrocyte_neurons(astrocyte_gid)
-
     # Access the astrocytes data
-    astrocytes_data = astrocyte_data.get_astrocyte_data(gids, circuit_path)
-
-    # Clear the scene
-    nmv.scene.clear_scene()
-
-    # Center the morphology at the origin
-    center_morphology = True
-
-    # Center the final mesh
-    center_mesh = False
+    astrocytes_data = astrocyte_data.get_astrocyte_data(astrocyte_gids, circuit_path)
 
     # Astrocyte data
-    for astro_generator in astrocytes_data:
-
-        soma_centroid = astro_generator.circuit_data['soma_position']
-        soma_centroid = Vector((soma_centroid[0], soma_centroid[1], soma_centroid[2]))
-        soma_radius = astro_generator.circuit_data['soma_radius']
-
-        # Load the .h5 morphology
-        reader = nmv.file.readers.H5Reader(h5_file=astro_generator.filepath,
-                                           center_morphology=center_morphology)
-        morphology_object = reader.read_file()
-
-        end_feet_proxy_meshes = list()
-        end_feet_thicknesses = list()
-        for j, process in enumerate(astro_generator.perivascular_processes):
-
-            # Area
-            area = areas[process.endfoot_area_mesh.index]
-
-            # Proxy end feet
-            if center_morphology:
-                end_feet_proxy_meshes.append(create_end_feet_proxy_mesh(area, j, soma_centroid))
-            else:
-                end_feet_proxy_meshes.append(create_end_feet_proxy_mesh(area, j))
-
-            end_feet_thicknesses.append(area.thickness)
-
-        # Create the builder
-        builder = astro_meta_builder.AstroMetaBuilder(
-            morphology=morphology_object,
-            soma_radius=soma_radius,
-            end_feet_proxy_meshes=end_feet_proxy_meshes,
-            end_feet_thicknesses=end_feet_thicknesses,
-            soma_style=soma_style)
-
-        # Reconstructing the mesh and return a reference to the astrocyte mesh
-        start_time = time.time()
-        astrocyte_mesh = builder.reconstruct_mesh()
-        end_time = time.time()
-
-        # Translate the astrocyte mesh
-        if not center_mesh:
-            nmv.scene.set_object_location(scene_object=astrocyte_mesh, location=soma_centroid)
-
-        # Delete all the end-feet data
-        nmv.scene.delete_list_objects(end_feet_proxy_meshes)
-
-        # Return a reference to the astrocyte mesh
-        return astrocyte_mesh, (end_time - start_time)
+    for gid, astro_generator in zip(astrocyte_gids, astrocytes_data):
+        astrocyte_mesh, generation_time = generate_astrocyte(
+            astro_generator=astro_generator, areas=areas, soma_style=soma_style)
+        yield gid, astrocyte_mesh, generation_time
 
 
 ####################################################################################################
@@ -243,7 +212,11 @@ def parse_command_line_arguments(arguments=None):
 
     arg_help = 'The GID of the astrocyte'
     parser.add_argument('--gid',
-                        action='store', dest='gid', help=arg_help)
+                        action='store', dest='gid', default=None, help=arg_help)
+
+    arg_help = 'A comma-separated list of GIDs that will be generated in the same session'
+    parser.add_argument('--gids',
+                        action='store', dest='gids', default=None, help=arg_help)
 
     arg_help = 'The style of the soma'
     parser.add_argument('--soma-style',
@@ -278,28 +251,20 @@ def parse_command_line_arguments(arguments=None):
 
 
 ####################################################################################################
-# @ Main
+# @export_astrocyte_mesh
 ####################################################################################################
-if __name__ == "__main__":
-
-    # Get all arguments after the '--'
-    args = sys.argv
-    sys.argv = args[args.index("--") + 0:]
-
-    # Parse the command line arguments
-    args = parse_command_line_arguments()
-
-    # One must export a valid mesh
-    if (not args.export_blend) and (not args.export_obj):
-        print('You must export either a .BLEND or .OBJ mesh')
-        exit(0)
-
-    # Generate the astrocyte
-    astrocyte_mesh, generation_time = generate_astrocyte(
-        circuit_path=args.circuit_path, astrocyte_gid=int(args.gid), soma_style=args.soma_style)
-
-    # Write the stats about the generation time
-    timing_file = '%s/%s.timing' % (args.output_directory, str(args.gid))
+def export_astrocyte_mesh(astrocyte_mesh,
+                          gid,
+                          args):
+    """Exports the mesh of a generated astrocyte for simulation and/or visualization.
+
+    :param astrocyte_mesh:
+        A reference to the astrocyte mesh.
+    :param gid:
+        The GID of the astrocyte.
+    :param args:
+        Input arguments.
+    """
 
     # Export the meshes for simulation
     if 'simulation' in args.mesh_type or 'both' in args.mesh_type:
@@ -317,11 +282,11 @@ if __name__ == "__main__":
         # Export the mesh to a .BLEND file
         if args.export_blend:
             nmv.file.export_scene_to_blend_file(output_directory=skinned_directory,
-                                                output_file_name=args.gid)
+                                                output_file_name=str(gid))
 
         # Export the mesh to an .OBJ file
         nmv.file.export_mesh_object_to_file(mesh_object=astrocyte_mesh,
-                                            output_file_name=args.gid,
+                                            output_file_name=str(gid),
                                             output_directory=skinned_directory,
                                             file_format=nmv.enums.Meshing.ExportFormat.OBJ)
 
@@ -331,7 +296,7 @@ if __name__ == "__main__":
             if not os.path.exists(optimized_directory):
                 os.makedirs(optimized_directory)
 
-            skinned_obj_mesh = '%s/%s.obj' % (skinned_directory, args.gid)
+            skinned_obj_mesh = '%s/%s.obj' % (skinned_directory, str(gid))
             create_optimized_mesh(skinned_obj_mesh=skinned_obj_mesh,
                                   ultra_clean_mesh_executable=args.ultra_clean_mesh_executable,
                                   output_directory=optimized_directory)
@@ -356,10 +321,46 @@ if __name__ == "__main__":
         # Export the mesh to a .BLEND file
         if args.export_blend:
             nmv.file.export_scene_to_blend_file(output_directory=visualization_directory,
-                                                output_file_name=args.gid)
+                                                output_file_name=str(gid))
 
         # Export the mesh to an .OBJ file
         nmv.file.export_mesh_object_to_file(mesh_object=astrocyte_mesh,
-                                            output_file_name=args.gid,
+                                            output_file_name=str(gid),
                                             output_directory=visualization_directory,
                                             file_format=nmv.enums.Meshing.ExportFormat.OBJ)
+
+
+####################################################################################################
+# @ Main
+####################################################################################################
+if __name__ == "__main__":
+
+    # Get all arguments after the '--'
+    args = sys.argv
+    sys.argv = args[args.index("--") + 0:]
+
+    # Parse the command line arguments
+    args = parse_command_line_arguments()
+
+    # One must export a valid mesh
+    if (not args.export_blend) and (not args.export_obj):
+        print('You must export either a .BLEND or .OBJ mesh')
+        exit(0)
+
+    # The GIDs of the astrocytes that are generated in this session
+    if args.gids is not None:
+        gids = [int(gid) for gid in args.gids.split(',') if gid.strip()]
+    else:
+        gids = [int(args.gid)]
+
+    # Generate the astrocytes one after another, the circuit is loaded only once
+    for gid, astrocyte_mesh, generation_time in generate_astrocytes(
+            circuit_path=args.circuit_path, astrocyte_gids=gids, soma_style=args.soma_style):
+
+        # Write the stats about the generation time
+        timing_file = open('%s/%s.timing' % (args.output_directory, str(gid)), 'w')
+        timing_file.write('%f\n' % generation_time)
+        timing_file.close()
+
+        # Export the meshes
+        export_astrocyte_mesh(astrocyte_mesh=astrocyte_mesh, gid=gid, args=args)
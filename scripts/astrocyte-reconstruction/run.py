@@ -19,6 +19,7 @@
 import os
 import argparse
 import subprocess
+from concurrent.futures import ThreadPoolExecutor
 
 
 ####################################################################################################
@@ -36,7 +37,7 @@ def get_gids_from_file(gids_file):
 
     file = open(gids_file, 'r')
     for line in file:
-        gids_list.append(line.replace('\n', ' '))
+        gids_list.extend(line.split())
     file.close()
 
     # Return the GIDs list
@@ -44,16 +45,45 @@ def get_gids_from_file(gids_file):
 
 
 ####################################################################################################
-# @parse_command_line_arguments
+# @partition_gids
+####################################################################################################
+def partition_gids(gids,
+                   number_cores,
+                   gids_per_process):
+    """Splits the GIDs into chunks, each chunk is generated by a single Blender process.
+
+    The chunks are interleaved to balance the load between the workers, since the neighbouring
+    GIDs are usually located in the same region of the circuit and have similar complexity.
+
+    :param gids:
+        List of GIDs.
+    :param number_cores:
+        Number of workers that run concurrently.
+    :param gids_per_process:
+        Maximum number of GIDs per Blender process.
+    :return:
+        A list of GID chunks.
+    """
+
+    # Enough chunks to keep all the cores busy and to respect the maximum chunk size
+    number_chunks = max(number_cores, (len(gids) + gids_per_process - 1) // gids_per_process)
+    number_chunks = max(1, min(number_chunks, len(gids)))
+
+    # Interleave the GIDs
+    return [gids[i::number_chunks] for i in range(number_chunks)]
+
+
+####################################################################################################
+# @construct_generation_command
 ####################################################################################################
 def construct_generation_command(args,
-                                 gids):
-    """Construct the command line per gid.
+                                 gids_chunks):
+    """Construct the command line per chunk of GIDs.
 
     :param args:
         Input arguments.
-    :param gids:
-        List of GIDs.
+    :param gids_chunks:
+        List of GID chunks.
     :return:
         A list of command.
     """
@@ -61,13 +91,13 @@ def construct_generation_command(args,
     # A list of commands that will be executed either in serial or in parallel
     commands_list = list()
 
-    # Per astrocyte
-    for gid in gids:
+    # Per chunk of astrocytes, the circuit is loaded once per chunk
+    for gids in gids_chunks:
 
         # Make the command
         shell_command = '%s' % args.blender_executable
         shell_command += ' -b --verbose 0 --python astrocyte_generator.py --'
-        shell_command += ' --gid=%s' % gid
+        shell_command += ' --gids=%s' % ','.join([str(gid) for gid in gids])
         shell_command += ' --output-directory=%s' % args.output_directory
         shell_command += ' --circuit-path=%s' % args.circuit_path
         shell_command += ' --soma-style=%s' % args.soma_style
@@ -96,9 +126,10 @@ def run_command(command):
     :param command:
         A given command to be executed
     :return:
+        The exit code of the command.
     """
     print(command)
-    subprocess.call(command, shell=True)
+    return subprocess.call(command, shell=True)
 
 
 ####################################################################################################
@@ -136,6 +167,11 @@ def parse_command_line_arguments(arguments=None):
     parser.add_argument('--number-cores',
                         action='store', dest='number_cores', default='4', type=int, help=arg_help)
 
+    arg_help = 'Maximum number of astrocytes generated by a single Blender process'
+    parser.add_argument('--gids-per-process',
+                        action='store', dest='gids_per_process', default='8', type=int,
+                        help=arg_help)
+
     arg_help = 'The path to the NGV circuit'
     parser.add_argument('--circuit-path',
                         action='store', dest='circuit_path', help=arg_help)
@@ -191,25 +227,31 @@ if __name__ == "__main__":
         exit(0)
 
     # Get the GIDs
-    if args.gids_range is not '0':
+    if args.gids_range != '0':
         gids_string = args.gids_range.split('-')
         gids = list(range(int(gids_string[0]), int(gids_string[1]) + 1))
     else:
         gids = get_gids_from_file(gids_file=args.gids_file)
 
+    # Split the GIDs between the Blender processes
+    number_cores = args.number_cores if 'parallel' in args.execution else 1
+    gids_chunks = partition_gids(gids=gids,
+                                 number_cores=number_cores,
+                                 gids_per_process=max(1, args.gids_per_process))
+
     # Build the commands
-    commands = construct_generation_command(args, gids)
+    commands = construct_generation_command(args, gids_chunks)
 
     # Create the output directory if it doesn't exist
     if not os.path.exists(args.output_directory):
         os.makedirs(args.output_directory)
 
-    # Execute the commands
-    if 'parallel' in args.execution:
-        from joblib import Parallel, delayed
-        Parallel(n_jobs=args.number_cores)(delayed(run_command)(i) for i in commands)
-    else:
-        for command in commands:
-            run_command(command)
-
+    # Execute the commands, every command is a separate Blender process, therefore threads are
+    # sufficient to keep the worker processes busy
+    with ThreadPoolExecutor(max_workers=number_cores) as executor:
+        exit_codes = list(executor.map(run_command, commands))
 
+    # Report the failing chunks
+    for command, exit_code in zip(commands, exit_codes):
+        if exit_code != 0:
+            print('FAILED [%d]: %s' % (exit_code, command))
@@ -50,6 +50,9 @@ ULTRA_CLEAN_MESH_EXECUTABLE='/gpfs/bbp.cscs.ch/project/proj3/development/Ultrali
 # Execution, serial or parallel
 EXECUTION='parallel'
 
+# Maximum number of astrocytes generated by a single Blender process
+GIDS_PER_PROCESS=8
+
 # Number of cores parallel processing 
 NUMBER_CORES=15
 
@@ -85,4 +88,5 @@ $PWD/../../../../../python/bin/python3.7m run.py
     --decimation-factor=$DECIMATION_FACTOR                                                          \
     --output-directory=$OUTPUT_DIRECTORY                                                            \
     --number-cores=$NUMBER_CORES                                                                    \
+    --gids-per-process=$GIDS_PER_PROCESS                                                            \
     $BOOL_ARGS
@@ -0,0 +1,248 @@
+####################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+# System imports
+import os
+import numpy
+
+
+# The sample types, similar to the SWC specifications
+SOMA_TYPE = 1
+AXON_TYPE = 2
+BASAL_DENDRITE_TYPE = 3
+APICAL_DENDRITE_TYPE = 4
+
+
+####################################################################################################
+# @PackedMorphology
+####################################################################################################
+class PackedMorphology:
+    """A morphology skeleton stored as flat sample arrays, without any dependency on Blender.
+
+    Every sample has a position, a radius, a type and the index of its parent sample, where the
+    root samples have a parent index of -1. The morphology is centered at the soma.
+    """
+
+    ################################################################################################
+    # @__init__
+    ################################################################################################
+    def __init__(self,
+                 points,
+                 radii,
+                 types,
+                 parents,
+                 soma_radius):
+        """Constructor
+
+        :param points:
+            An array of shape (N, 3) with the positions of the samples.
+        :param radii:
+            An array of shape (N,) with the radii of the samples.
+        :param types:
+            An array of shape (N,) with the types of the samples.
+        :param parents:
+            An array of shape (N,) with the indices of the parent samples, -1 for the roots.
+        :param soma_radius:
+            The mean radius of the soma.
+        """
+
+        # Samples
+        self.points = numpy.asarray(points, dtype=numpy.float64).reshape((-1, 3))
+        self.radii = numpy.asarray(radii, dtype=numpy.float64)
+        self.types = numpy.asarray(types, dtype=numpy.int32)
+        self.parents = numpy.asarray(parents, dtype=numpy.int64)
+
+        # Soma
+        self.soma_radius = float(soma_radius)
+
+    ################################################################################################
+    # @get_segments
+    ################################################################################################
+    def get_segments(self):
+        """Returns the segments of the arbors, i.e. every non-soma sample and its parent.
+
+        :return:
+            A tuple (starts, ends, starts_radii, ends_radii, types) of arrays, where the type of
+            every segment is the type of its child sample.
+        """
+
+        # Every sample with a parent, except the soma samples
+        children = numpy.where((self.parents >= 0) & (self.types != SOMA_TYPE))[0]
+        parents = self.parents[children]
+
+        # The segments that emanate from the soma are not tapered from the soma radius
+        starts_radii = numpy.where(self.types[parents] == SOMA_TYPE,
+                                   self.radii[children], self.radii[parents])
+
+        # Return the segments
+        return self.points[parents], self.points[children], \
+            starts_radii, self.radii[children], self.types[children]
+
+
+####################################################################################################
+# @get_soma_radius
+####################################################################################################
+def get_soma_radius(soma_points,
+                    soma_radii):
+    """Computes the mean radius of the soma from its samples, either a single sample with a radius
+    or a contour of samples.
+
+    :param soma_points:
+        An array of shape (S, 3) with the soma samples, already centered.
+    :param soma_radii:
+        An array of shape (S,) with the radii of the soma samples.
+    :return:
+        The mean radius of the soma.
+    """
+
+    # No soma
+    if len(soma_points) == 0:
+        return 0.0
+
+    # The larger of the mean sample radius and the mean distance of the contour from the center
+    return max(float(numpy.mean(soma_radii)),
+               float(numpy.mean(numpy.linalg.norm(soma_points, axis=1))))
+
+
+####################################################################################################
+# @read_swc_morphology
+####################################################################################################
+def read_swc_morphology(morphology_file):
+    """Reads an .SWC morphology file into a packed morphology.
+
+    :param morphology_file:
+        The path to the morphology file.
+    :return:
+        A PackedMorphology.
+    """
+
+    # Parse all the numeric lines at once, ignoring the comments
+    data = numpy.loadtxt(morphology_file, comments='#', ndmin=2)
+    data = data[:, :7]
+
+    # The columns of the SWC file
+    indices = data[:, 0].astype(numpy.int64)
+    types = data[:, 1].astype(numpy.int32)
+    points = data[:, 2:5]
+    radii = data[:, 5]
+    parent_indices = data[:, 6].astype(numpy.int64)
+
+    # Unknown types are considered basal dendrites, like the SWC reader of NeuroMorphoVis
+    types[(types > APICAL_DENDRITE_TYPE) | ((types == 0) & (parent_indices > -1))] = \
+        BASAL_DENDRITE_TYPE
+
+    # Map the sample indices to the rows of the arrays
+    lookup = numpy.full(max(int(indices.max()), int(parent_indices.max())) + 2, -1, numpy.int64)
+    lookup[indices] = numpy.arange(len(indices))
+    parents = numpy.where(parent_indices >= 0, lookup[numpy.maximum(parent_indices, 0)], -1)
+
+    # Center the morphology at the soma
+    soma_mask = types == SOMA_TYPE
+    if numpy.any(soma_mask):
+        points = points - points[soma_mask].mean(axis=0)
+    else:
+        points = points - points[parents < 0][0]
+
+    # Construct the morphology
+    return PackedMorphology(points=points, radii=radii, types=types, parents=parents,
+                            soma_radius=get_soma_radius(points[soma_mask], radii[soma_mask]))
+
+
+####################################################################################################
+# @read_h5_morphology
+####################################################################################################
+def read_h5_morphology(morphology_file):
+    """Reads an .H5 morphology file into a packed morphology.
+
+    The first section is the soma contour. The samples of every other section are chained, and the
+    first sample of a section is connected to the last sample of its parent section, or to the
+    center of the soma for the first order sections.
+
+    :param morphology_file:
+        The path to the morphology file.
+    :return:
+        A PackedMorphology.
+    """
+
+    # Read the datasets
+    import h5py
+    with h5py.File(morphology_file, 'r') as data:
+        points_data = numpy.array(data['/points'], dtype=numpy.float64)
+        structure = numpy.array(data['/structure'], dtype=numpy.int64)
+
+    # The .H5 files report the diameters
+    positions = points_data[:, 0:3]
+    radii = points_data[:, 3] * 0.5
+
+    # The offsets of the sections in the points dataset
+    starts = structure[:, 0]
+    ends = numpy.append(starts[1:], len(positions))
+
+    # The soma contour, the first section
+    soma_points = positions[starts[0]:ends[0]]
+    soma_radii = radii[starts[0]:ends[0]]
+    soma_center = soma_points.mean(axis=0) if len(soma_points) else numpy.zeros(3)
+
+    # The first arbor sample, all the points belong to the soma in a soma-only morphology
+    arbors_start = starts[1] if len(structure) > 1 else len(positions)
+
+    # The arbor samples, where the soma center is prepended as sample 0
+    arbor_points = [soma_center.reshape((1, 3)), positions[arbors_start:]]
+    arbor_radii = [numpy.zeros(1), radii[arbors_start:]]
+
+    # Types and parents of the arbor samples, chained along every section
+    number_samples = len(positions) - arbors_start + 1
+    types = numpy.full(number_samples, SOMA_TYPE, dtype=numpy.int32)
+    parents = numpy.arange(-1, number_samples - 1, dtype=numpy.int64)
+    for i in range(1, len(structure)):
+
+        # The rows of the section
+        first = starts[i] - arbors_start + 1
+        last = ends[i] - arbors_start + 1
+        types[first:last] = structure[i][1]
+
+        # Connect the first sample to the parent section, or to the soma
+        parent_section = int(structure[i][2])
+        parents[first] = ends[parent_section] - arbors_start if parent_section > 0 else 0
+
+    # Construct the morphology centered at the soma
+    points = numpy.concatenate(arbor_points) - soma_center
+    return PackedMorphology(points=points, radii=numpy.concatenate(arbor_radii), types=types,
+                            parents=parents,
+                            soma_radius=get_soma_radius(soma_points - soma_center, soma_radii))
+
+
+####################################################################################################
+# @read_morphology
+####################################################################################################
+def read_morphology(morphology_file):
+    """Reads an .SWC or an .H5 morphology file into a packed morphology.
+
+    :param morphology_file:
+        The path to the morphology file.
+    :return:
+        A PackedMorphology.
+    """
+
+    # Select the reader based on the extension
+    extension = os.path.splitext(morphology_file)[1].lower()
+    if extension == '.swc':
+        return read_swc_morphology(morphology_file)
+    elif extension == '.h5':
+        return read_h5_morphology(morphology_file)
+    else:
+        raise ValueError('Unsupported morphology format [%s]' % morphology_file)
@@ -0,0 +1,290 @@
+####################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+# System imports
+import numpy
+
+# Internal imports
+import packed_morphology
+
+
+# The projection axes (horizontal, vertical) of every view, similar to the views of the cameras
+PROJECTIONS = {'front': (0, 1),
+               'side': (2, 1),
+               'top': (0, 2)}
+
+# The drawing order of the arbors, the soma is drawn on top of them
+DRAWING_ORDER = (packed_morphology.BASAL_DENDRITE_TYPE,
+                 packed_morphology.APICAL_DENDRITE_TYPE,
+                 packed_morphology.AXON_TYPE)
+
+# The maximum number of pixels that are evaluated at once
+PIXELS_PER_BATCH = 1 << 22
+
+
+####################################################################################################
+# @ProjectedMorphology
+####################################################################################################
+class ProjectedMorphology:
+    """The segments of a morphology projected to the pixel space of an image.
+    """
+
+    ################################################################################################
+    # @__init__
+    ################################################################################################
+    def __init__(self,
+                 morphology,
+                 projection,
+                 resolution,
+                 margin=0.05,
+                 radius_scale=1.0):
+        """Constructor
+
+        :param morphology:
+            A given PackedMorphology.
+        :param projection:
+            The projection of the morphology, 'front', 'side' or 'top'.
+        :param resolution:
+            The resolution of the longest side of the image in pixels.
+        :param margin:
+            The margin around the morphology, as a fraction of the resolution.
+        :param radius_scale:
+            A scale factor for the radii of the segments.
+        """
+
+        # The axes of the projection
+        horizontal, vertical = PROJECTIONS[projection]
+
+        # The segments of the morphology
+        starts, ends, starts_radii, ends_radii, self.types = morphology.get_segments()
+
+        # The 2D points, the vertical axis of the image is flipped
+        flip = numpy.array([1.0, -1.0])
+        starts = starts[:, [horizontal, vertical]] * flip
+        ends = ends[:, [horizontal, vertical]] * flip
+        soma_center = numpy.zeros(2)
+
+        # The bounding box of the morphology including the radii and the soma
+        all_points = numpy.concatenate((starts, ends, soma_center.reshape((1, 2))))
+        all_radii = numpy.concatenate((starts_radii, ends_radii, [morphology.soma_radius])) * \
+            radius_scale
+        p_min = (all_points - all_radii[:, None]).min(axis=0)
+        p_max = (all_points + all_radii[:, None]).max(axis=0)
+        extent = numpy.maximum(p_max - p_min, 1e-6)
+
+        # The scale from microns to pixels
+        drawable = resolution * (1.0 - 2.0 * margin)
+        self.scale = drawable / extent.max()
+
+        # The size of the image, the short side is fitted to the morphology
+        self.width = int(numpy.ceil(extent[0] * self.scale + 2.0 * margin * resolution))
+        self.height = int(numpy.ceil(extent[1] * self.scale + 2.0 * margin * resolution))
+        offset = numpy.array([self.width, self.height]) * 0.5 - \
+            (p_min + p_max) * 0.5 * self.scale
+
+        # The segments in pixels
+        self.starts = starts * self.scale + offset
+        self.ends = ends * self.scale + offset
+        self.starts_radii = starts_radii * radius_scale * self.scale
+        self.ends_radii = ends_radii * radius_scale * self.scale
+
+        # The soma in pixels
+        self.soma_center = soma_center * self.scale + offset
+        self.soma_radius = morphology.soma_radius * radius_scale * self.scale
+
+
+####################################################################################################
+# @rasterize_segments
+####################################################################################################
+def rasterize_segments(coverage,
+                       starts,
+                       ends,
+                       starts_radii,
+                       ends_radii,
+                       minimum_radius=0.5):
+    """Rasterizes a list of tapered segments into a coverage buffer with anti-aliasing.
+
+    The coverage of a pixel is the distance of its center inside the tapered segment clamped to a
+    single pixel, and overlapping segments keep the maximum coverage. The segments are sorted by
+    the size of their bounding boxes and evaluated in batches, where every batch is a single array
+    operation over the pixels of the bounding boxes of its segments.
+
+    :param coverage:
+        A 2D float buffer of shape (height, width) that is updated in place.
+    :param starts:
+        An array of shape (K, 2) with the first points of the segments in pixels.
+    :param ends:
+        An array of shape (K, 2) with the last points of the segments in pixels.
+    :param starts_radii:
+        An array of shape (K,) with the radii at the first points in pixels.
+    :param ends_radii:
+        An array of shape (K,) with the radii at the last points in pixels.
+    :param minimum_radius:
+        The minimum radius in pixels, to keep the thin branches visible.
+    """
+
+    # Nothing to draw
+    if len(starts) == 0:
+        return
+
+    height, width = coverage.shape
+    flat_coverage = coverage.reshape(-1)
+
+    # The radii are clamped to keep the thin branches visible
+    starts_radii = numpy.maximum(starts_radii, minimum_radius)
+    ends_radii = numpy.maximum(ends_radii, minimum_radius)
+
+    # The bounding boxes of the segments, clipped to the image
+    reach = numpy.maximum(starts_radii, ends_radii)[:, None] + 1.0
+    lower = numpy.floor(numpy.minimum(starts, ends) - reach).astype(numpy.int64)
+    upper = numpy.ceil(numpy.maximum(starts, ends) + reach).astype(numpy.int64)
+    lower = numpy.maximum(lower, 0)
+    upper = numpy.minimum(upper, numpy.array([width - 1, height - 1]))
+    sizes = upper - lower + 1
+
+    # Ignore the segments outside the image
+    visible = numpy.all(sizes > 0, axis=1)
+
+    # Sort the segments by the size of their bounding boxes, to have compact batches
+    order = numpy.where(visible)[0]
+    boxes = sizes[order].max(axis=1)
+    order = order[numpy.argsort(boxes, kind='stable')]
+    boxes = numpy.sort(boxes, kind='stable')
+
+    # The direction and the squared length of the segments
+    directions = ends - starts
+    lengths = (directions * directions).sum(axis=1)
+    lengths[lengths == 0] = 1.0
+
+    # Process the segments in batches
+    i = 0
+    while i < len(order):
+
+        # The boxes are sorted, so the last box of a batch is the largest one
+        count = max(1, PIXELS_PER_BATCH // int(boxes[i]) ** 2)
+        last = min(i + count, len(order)) - 1
+        count = max(1, min(count, PIXELS_PER_BATCH // int(boxes[last]) ** 2))
+        batch = order[i:i + count]
+        box = int(boxes[min(i + count, len(order)) - 1])
+        i += count
+
+        # The pixel grid of every segment in the batch, (B, box, box)
+        grid = numpy.arange(box)
+        xs = lower[batch, 0][:, None, None] + grid[None, None, :]
+        ys = lower[batch, 1][:, None, None] + grid[None, :, None]
+
+        # The projection of the pixel centers on the segments
+        dx = xs + 0.5 - starts[batch, 0][:, None, None]
+        dy = ys + 0.5 - starts[batch, 1][:, None, None]
+        direction_x = directions[batch, 0][:, None, None]
+        direction_y = directions[batch, 1][:, None, None]
+        t = numpy.clip((dx * direction_x + dy * direction_y) / lengths[batch][:, None, None],
+                       0.0, 1.0)
+
+        # The distance to the axis and the interpolated radius
+        distance = numpy.hypot(dx - t * direction_x, dy - t * direction_y)
+        radius = starts_radii[batch][:, None, None] + \
+            t * (ends_radii[batch] - starts_radii[batch])[:, None, None]
+
+        # Anti-aliased coverage, one pixel wide transition
+        pixel_coverage = numpy.clip(radius + 0.5 - distance, 0.0, 1.0)
+
+        # Only the pixels inside the bounding boxes
+        inside = (xs <= upper[batch, 0][:, None, None]) & \
+                 (ys <= upper[batch, 1][:, None, None]) & (pixel_coverage > 0.0)
+
+        # Keep the maximum coverage per pixel
+        numpy.maximum.at(flat_coverage, (ys * width + xs)[inside], pixel_coverage[inside])
+
+
+####################################################################################################
+# @rasterize_morphology
+####################################################################################################
+def rasterize_morphology(projected_morphology,
+                         colors,
+                         background=(1.0, 1.0, 1.0),
+                         minimum_radius=0.5):
+    """Rasterizes a projected morphology into an RGB image.
+
+    Every arbor type is rasterized into its own coverage layer, and the layers are composited over
+    the background in the drawing order, with the soma on top.
+
+    :param projected_morphology:
+        A given ProjectedMorphology.
+    :param colors:
+        A dictionary that maps every sample type to an (r, g, b) color in [0, 1].
+    :param background:
+        The (r, g, b) background color in [0, 1].
+    :param minimum_radius:
+        The minimum radius of the segments in pixels.
+    :return:
+        An array of shape (height, width, 3) of type uint8.
+    """
+
+    # The image
+    image = numpy.empty((projected_morphology.height, projected_morphology.width, 3))
+    image[:] = numpy.asarray(background, dtype=numpy.float64)
+
+    # A coverage layer that is reused for every arbor type
+    coverage = numpy.zeros((projected_morphology.height, projected_morphology.width))
+
+    # The arbors
+    for arbor_type in DRAWING_ORDER:
+        mask = projected_morphology.types == arbor_type
+        if not numpy.any(mask):
+            continue
+
+        coverage[:] = 0.0
+        rasterize_segments(coverage,
+                           projected_morphology.starts[mask], projected_morphology.ends[mask],
+                           projected_morphology.starts_radii[mask],
+                           projected_morphology.ends_radii[mask],
+                           minimum_radius=minimum_radius)
+        composite_layer(image, coverage, colors[arbor_type])
+
+    # The soma
+    if projected_morphology.soma_radius > 0.0:
+        coverage[:] = 0.0
+        soma_center = projected_morphology.soma_center.reshape((1, 2))
+        soma_radius = numpy.array([projected_morphology.soma_radius])
+        rasterize_segments(coverage, soma_center, soma_center, soma_radius, soma_radius,
+                           minimum_radius=minimum_radius)
+        composite_layer(image, coverage, colors[packed_morphology.SOMA_TYPE])
+
+    # Quantize the image
+    return numpy.clip(image * 255.0 + 0.5, 0, 255).astype(numpy.uint8)
+
+
+####################################################################################################
+# @composite_layer
+####################################################################################################
+def composite_layer(image,
+                    coverage,
+                    color):
+    """Composites a coverage layer with a flat color over an image in place.
+
+    :param image:
+        A float image of shape (height, width, 3).
+    :param coverage:
+        A coverage layer of shape (height, width).
+    :param color:
+        The (r, g, b) color of the layer.
+    """
+
+    alpha = coverage[:, :, None]
+    image *= 1.0 - alpha
+    image += alpha * numpy.asarray(color, dtype=numpy.float64)
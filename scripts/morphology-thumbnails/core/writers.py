@@ -0,0 +1,133 @@
+####################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+# System imports
+import struct
+import zlib
+import numpy
+
+# Internal imports
+import packed_morphology
+import rasterizer
+
+
+####################################################################################################
+# @write_png
+####################################################################################################
+def write_png(image,
+              file_path):
+    """Writes an 8-bit RGB image to a .PNG file, using only the standard library.
+
+    :param image:
+        An array of shape (height, width, 3) of type uint8.
+    :param file_path:
+        The path to the output file.
+    """
+
+    height, width = image.shape[0], image.shape[1]
+
+    # Every row starts with a filter type byte, zero for no filtering
+    rows = numpy.zeros((height, width * 3 + 1), dtype=numpy.uint8)
+    rows[:, 1:] = image.reshape((height, width * 3))
+
+    # A chunk is its length, its tag, its data and the CRC of the tag and the data
+    def chunk(tag, data):
+        return struct.pack('>I', len(data)) + tag + data + \
+            struct.pack('>I', zlib.crc32(tag + data) & 0xffffffff)
+
+    # Write the file
+    with open(file_path, 'wb') as png_file:
+        png_file.write(b'\x89PNG\r\n\x1a\n')
+        png_file.write(chunk(b'IHDR', struct.pack('>IIBBBBB', width, height, 8, 2, 0, 0, 0)))
+        png_file.write(chunk(b'IDAT', zlib.compress(rows.tobytes(), 6)))
+        png_file.write(chunk(b'IEND', b''))
+
+
+####################################################################################################
+# @get_svg_color
+####################################################################################################
+def get_svg_color(color):
+    """Converts an (r, g, b) color in [0, 1] into an SVG hex color.
+
+    :param color:
+        A given color.
+    :return:
+        The color as a hex string.
+    """
+
+    return '#%02x%02x%02x' % tuple(int(round(min(max(c, 0.0), 1.0) * 255)) for c in color)
+
+
+####################################################################################################
+# @write_svg
+####################################################################################################
+def write_svg(projected_morphology,
+              colors,
+              file_path,
+              background=(1.0, 1.0, 1.0),
+              minimum_radius=0.5):
+    """Writes a projected morphology to a vector .SVG file.
+
+    Every segment is a line with round caps and a width equal to its mean diameter, and the
+    segments of every arbor type are grouped with a single color.
+
+    :param projected_morphology:
+        A given ProjectedMorphology.
+    :param colors:
+        A dictionary that maps every sample type to an (r, g, b) color in [0, 1].
+    :param file_path:
+        The path to the output file.
+    :param background:
+        The (r, g, b) background color in [0, 1].
+    :param minimum_radius:
+        The minimum radius of the segments in pixels.
+    """
+
+    lines = list()
+    lines.append('<svg xmlns="http://www.w3.org/2000/svg" width="%d" height="%d" '
+                 'viewBox="0 0 %d %d">' % (projected_morphology.width, projected_morphology.height,
+                                           projected_morphology.width, projected_morphology.height))
+    lines.append('<rect width="100%%" height="100%%" fill="%s"/>' % get_svg_color(background))
+
+    # The arbors
+    widths = numpy.maximum(projected_morphology.starts_radii, minimum_radius) + \
+        numpy.maximum(projected_morphology.ends_radii, minimum_radius)
+    for arbor_type in rasterizer.DRAWING_ORDER:
+        indices = numpy.where(projected_morphology.types == arbor_type)[0]
+        if len(indices) == 0:
+            continue
+
+        lines.append('<g stroke="%s" stroke-linecap="round">' % get_svg_color(colors[arbor_type]))
+        for i in indices:
+            lines.append('<line x1="%.2f" y1="%.2f" x2="%.2f" y2="%.2f" stroke-width="%.2f"/>' %
+                         (projected_morphology.starts[i][0], projected_morphology.starts[i][1],
+                          projected_morphology.ends[i][0], projected_morphology.ends[i][1],
+                          widths[i]))
+        lines.append('</g>')
+
+    # The soma
+    if projected_morphology.soma_radius > 0.0:
+        lines.append('<circle cx="%.2f" cy="%.2f" r="%.2f" fill="%s"/>' %
+                     (projected_morphology.soma_center[0], projected_morphology.soma_center[1],
+                      max(projected_morphology.soma_radius, minimum_radius),
+                      get_svg_color(colors[packed_morphology.SOMA_TYPE])))
+    lines.append('</svg>')
+
+    # Write the file
+    with open(file_path, 'w') as svg_file:
+        svg_file.write('\n'.join(lines))
+        svg_file.write('\n')
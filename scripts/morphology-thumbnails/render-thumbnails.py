@@ -0,0 +1,221 @@
+####################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+# System imports
+import sys, os
+import argparse
+import multiprocessing
+import time
+import_paths = ['core']
+for import_path in import_paths:
+    sys.path.append(('%s/%s' % (os.path.dirname(os.path.realpath(__file__)), import_path)))
+
+# Internal imports
+import packed_morphology
+import rasterizer
+import writers
+
+
+# The default colors of the arbors, similar to the default colors of NeuroMorphoVis
+DEFAULT_COLORS = {packed_morphology.SOMA_TYPE: '1.0,0.8,0.15',
+                  packed_morphology.AXON_TYPE: '0.4,0.7,1.0',
+                  packed_morphology.BASAL_DENDRITE_TYPE: '0.9,0.1,0.075',
+                  packed_morphology.APICAL_DENDRITE_TYPE: '0.4,0.9,0.2'}
+
+
+####################################################################################################
+# @parse_command_line_arguments
+####################################################################################################
+def parse_command_line_arguments():
+    """Parses the input arguments.
+
+    :return:
+        Arguments list.
+    """
+
+    # add all the options
+    description = 'Renders thumbnails of morphology skeletons, without Blender'
+    parser = argparse.ArgumentParser(description=description)
+
+    arg_help = 'Input directory, where the .SWC and .H5 morphologies are stored'
+    parser.add_argument('--input-directory',
+                        action='store', dest='input_directory', help=arg_help)
+
+    arg_help = 'Output directory, where the thumbnails will be written'
+    parser.add_argument('--output-directory',
+                        action='store', dest='output_directory', help=arg_help)
+
+    arg_help = 'Projections, a comma-separated list of front, side and top'
+    parser.add_argument('--projections',
+                        action='store', default='front', dest='projections', help=arg_help)
+
+    arg_help = 'Output formats, a comma-separated list of png and svg'
+    parser.add_argument('--formats',
+                        action='store', default='png', dest='formats', help=arg_help)
+
+    arg_help = 'The resolution of the longest side of the thumbnail in pixels'
+    parser.add_argument('--resolution',
+                        action='store', type=int, default=512, dest='resolution', help=arg_help)
+
+    arg_help = 'A scale factor for the radii of the arbors'
+    parser.add_argument('--radius-scale',
+                        action='store', type=float, default=1.0, dest='radius_scale', help=arg_help)
+
+    arg_help = 'The minimum radius of the arbors in pixels'
+    parser.add_argument('--minimum-radius',
+                        action='store', type=float, default=0.5, dest='minimum_radius',
+                        help=arg_help)
+
+    arg_help = 'Background color, r,g,b in [0, 1]'
+    parser.add_argument('--background-color',
+                        action='store', default='1.0,1.0,1.0', dest='background_color',
+                        help=arg_help)
+
+    arg_help = 'Soma color, r,g,b in [0, 1]'
+    parser.add_argument('--soma-color',
+                        action='store', default=DEFAULT_COLORS[packed_morphology.SOMA_TYPE],
+                        dest='soma_color', help=arg_help)
+
+    arg_help = 'Axons color, r,g,b in [0, 1]'
+    parser.add_argument('--axons-color',
+                        action='store', default=DEFAULT_COLORS[packed_morphology.AXON_TYPE],
+                        dest='axons_color', help=arg_help)
+
+    arg_help = 'Basal dendrites color, r,g,b in [0, 1]'
+    parser.add_argument('--basal-dendrites-color',
+                        action='store',
+                        default=DEFAULT_COLORS[packed_morphology.BASAL_DENDRITE_TYPE],
+                        dest='basal_dendrites_color', help=arg_help)
+
+    arg_help = 'Apical dendrites color, r,g,b in [0, 1]'
+    parser.add_argument('--apical-dendrites-color',
+                        action='store',
+                        default=DEFAULT_COLORS[packed_morphology.APICAL_DENDRITE_TYPE],
+                        dest='apical_dendrites_color', help=arg_help)
+
+    arg_help = 'Number of worker processes, by default all the cores'
+    parser.add_argument('--number-cores',
+                        action='store', type=int, default=multiprocessing.cpu_count(),
+                        dest='number_cores', help=arg_help)
+
+    # Parse the arguments
+    return parser.parse_args()
+
+
+####################################################################################################
+# @parse_color
+####################################################################################################
+def parse_color(color_string):
+    """Parses an r,g,b color string.
+
+    :param color_string:
+        A given color string.
+    :return:
+        A tuple of three floats.
+    """
+
+    return tuple(float(c) for c in color_string.split(','))
+
+
+####################################################################################################
+# @render_thumbnails
+####################################################################################################
+def render_thumbnails(task):
+    """Renders all the thumbnails of a single morphology. This is the work of a single worker.
+
+    :param task:
+        A tuple (morphology_file, args).
+    :return:
+        A tuple (morphology_file, error, duration), where the error is None on success.
+    """
+
+    morphology_file, args = task
+    start = time.time()
+    try:
+
+        # Read the morphology
+        morphology = packed_morphology.read_morphology(morphology_file)
+
+        # The colors
+        colors = {packed_morphology.SOMA_TYPE: parse_color(args.soma_color),
+                  packed_morphology.AXON_TYPE: parse_color(args.axons_color),
+                  packed_morphology.BASAL_DENDRITE_TYPE: parse_color(args.basal_dendrites_color),
+                  packed_morphology.APICAL_DENDRITE_TYPE: parse_color(args.apical_dendrites_color)}
+        background = parse_color(args.background_color)
+
+        # Render every projection
+        label = os.path.splitext(os.path.basename(morphology_file))[0]
+        for projection in args.projections.split(','):
+            projected_morphology = rasterizer.ProjectedMorphology(
+                morphology, projection, args.resolution, radius_scale=args.radius_scale)
+            prefix = '%s/%s_%s' % (args.output_directory, label, projection)
+
+            if 'png' in args.formats:
+                image = rasterizer.rasterize_morphology(
+                    projected_morphology, colors, background, args.minimum_radius)
+                writers.write_png(image, '%s.png' % prefix)
+
+            if 'svg' in args.formats:
+                writers.write_svg(projected_morphology, colors, '%s.svg' % prefix, background,
+                                  args.minimum_radius)
+
+    except Exception as e:
+        return morphology_file, str(e), time.time() - start
+
+    # Done
+    return morphology_file, None, time.time() - start
+
+
+####################################################################################################
+# @ Run the main function if invoked from the command line.
+####################################################################################################
+if __name__ == "__main__":
+
+    # Parse the command line arguments
+    args = parse_command_line_arguments()
+
+    # Verify the projections
+    for projection in args.projections.split(','):
+        if projection not in rasterizer.PROJECTIONS:
+            print('ERROR: Unknown projection [%s]' % projection)
+            exit(1)
+
+    # Create the output directory
+    if not os.path.exists(args.output_directory):
+        os.makedirs(args.output_directory)
+
+    # Get all the morphologies in the input directory
+    morphology_files = sorted(
+        '%s/%s' % (args.input_directory, f) for f in os.listdir(args.input_directory)
+        if os.path.splitext(f)[1].lower() in ['.swc', '.h5'])
+
+    # Render one morphology per worker
+    tasks = [(morphology_file, args) for morphology_file in morphology_files]
+    number_failures = 0
+    start = time.time()
+    with multiprocessing.Pool(processes=max(1, args.number_cores)) as pool:
+        for i, (morphology_file, error, duration) in enumerate(
+                pool.imap_unordered(render_thumbnails, tasks, chunksize=4)):
+            if error is not None:
+                number_failures += 1
+                print('* [%d/%d] FAILED [%s]: %s' % (i + 1, len(tasks), morphology_file, error))
+            else:
+                print('* [%d/%d] [%s] in [%.3f] seconds' % (i + 1, len(tasks), morphology_file,
+                                                            duration))
+
+    print('Rendered [%d] morphologies in [%.3f] seconds, [%d] failed' %
+          (len(tasks) - number_failures, time.time() - start, number_failures))
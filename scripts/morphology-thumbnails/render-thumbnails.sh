@@ -0,0 +1,43 @@
+#!/usr/bin/env bash
+####################################################################################################
+# Copyright (c) 2016 - 2020, EPFL / Blue Brain Project
+#               Marwan Abdellah <marwan.abdellah@epfl.ch>
+#
+# This file is part of NeuroMorphoVis <https://github.com/BlueBrain/NeuroMorphoVis>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 of the License.
+#
+# This Blender-based tool is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+####################################################################################################
+
+# Python 3 executable with numpy, h5py is only needed for .H5 morphologies
+PYTHON=python3
+
+# The input directory where the morphologies exist
+INPUT_DIRECTORY='/ssd1/projects/morphologies'
+
+# Output directory
+OUTPUT_DIRECTORY='/home/abdellah/neuromorphovis-output/thumbnails'
+
+# Projections: front, side, top
+PROJECTIONS='front,side,top'
+
+# Output formats: png, svg
+FORMATS='png'
+
+# Resolution of the thumbnails
+RESOLUTION=512
+
+####################################################################################################
+$PYTHON render-thumbnails.py                                                                        \
+    --input-directory=$INPUT_DIRECTORY                                                             \
+    --output-directory=$OUTPUT_DIRECTORY                                                           \
+    --projections=$PROJECTIONS                                                                     \
+    --formats=$FORMATS                                                                             \
+    --resolution=$RESOLUTION
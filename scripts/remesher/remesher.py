@@ -30,6 +30,7 @@ import nmv.shading
 import nmv.skeleton
 import nmv.utilities
 import nmv.scene
+import nmv.geometry
 import nmv.physics
 import nmv.options
 
@@ -91,12 +92,8 @@ class MetaBuilderRemesher:
 
         # Run the particles simulation remesher
         mesher = nmv.physics.ParticleRemesher(resolution=20, mask_resolution=20)
-        stepper = mesher.run(mesh_object=self.input_mesh, context=bpy.context, interactive=True)
-
-        for i in range(1000000):
-            finished = next(stepper)
-            if finished:
-                break
+        remeshing_statistics = mesher.run_batch(mesh_object=self.input_mesh, context=bpy.context)
+        nmv.logger.info(remeshing_statistics.get_report())
 
     ################################################################################################
     # @build_meta_field_with_meta_balls
@@ -105,25 +102,20 @@ class MetaBuilderRemesher:
         """Builds the meta filed with meta balls
         """
 
-        # Build the soma profile from the soft-body mesh
-        for face in self.input_mesh.data.polygons:
-
-            # Add a new meta element
-            meta_element = self.meta_skeleton.elements.new()
-
-            # Compute the largest radius in the triangle, but since we re-mesh the soma, we will
-            # get almost equi-sides faces
-            radius = nmv.mesh.get_largest_radius_in_face(
-                mesh_object=self.input_mesh, face_index=face.index)
-
-            # Compute the radius of the meta-element by trial-and-error
-            meta_element.radius = radius * 2 * self.magic_scale_factor
+        # Compute the largest radius in all the triangles at once, but since we re-mesh the soma,
+        # we will get almost equi-sides faces
+        centers, normals, radii = nmv.mesh.get_largest_radii_of_faces(mesh_object=self.input_mesh)
 
-            if meta_element.radius < self.smallest_radius:
-                self.smallest_radius = meta_element.radius
+        # Compute the radii of the meta-elements by trial-and-error
+        meta_radii = radii * 2 * self.magic_scale_factor
+        if len(meta_radii) > 0:
+            self.smallest_radius = min(self.smallest_radius, float(meta_radii.min()))
 
-            # Update its coordinates
-            meta_element.co = face.center - (face.normal * radius * self.magic_scale_factor)
+        # Build the meta field in bulk
+        nmv.geometry.add_meta_elements_in_bulk(
+            meta_skeleton=self.meta_skeleton,
+            locations=centers - normals * (radii * self.magic_scale_factor)[:, None],
+            radii=meta_radii)
 
     ################################################################################################
     # @initialize_meta_object
@@ -198,7 +190,7 @@ class MetaBuilderRemesher:
 
         # Clean the mesh object and remove the non-manifold edges
         nmv.logger.info('Cleaning Mesh Non-manifold Edges & Vertices')
-        nmv.mesh.clean_mesh_object(self.meta_mesh)
+        nmv.mesh.clean_mesh_object(self.meta_mesh, use_operators=False)
 
         # Remove the small partitions
         nmv.logger.info('Removing Partitions')